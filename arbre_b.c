@@ -0,0 +1,771 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arbre_b.h"
+#include "outils.h"
+
+#include <assert.h>
+#include <string.h>
+
+/*
+ * Nombres minimaux d'associations d'une feuille et de clés d'un noeud
+ * interne, sauf pour la racine.
+ */
+#define ARBRE_B_MIN_FEUILLE ( ARBRE_B_ORDRE / 2 )
+#define ARBRE_B_MIN_NOEUD ( ( ARBRE_B_ORDRE - 1 ) / 2 )
+
+static inline int comparer_cles(
+	const Arbre_b* arbre, const intptr_t a, const intptr_t b
+){
+	if( arbre->comparer ){
+		return arbre->comparer( a, b );
+	}
+	return ( a > b ) - ( a < b );
+}
+
+static intptr_t copier_cle( const Arbre_b* arbre, const intptr_t cle ){
+	if( arbre->copier && cle ){
+		return arbre->copier( cle );
+	}
+	return cle;
+}
+
+static void supprimer_cle( const Arbre_b* arbre, intptr_t cle ){
+	if( arbre->supprimer && cle ){
+		arbre->supprimer( cle );
+	}
+}
+
+/*
+ * Renvoie le nombre de clés de cles[0..nb[ strictement plus petites que
+ * 'cle' (ou plus petites ou égales si 'ou_egales' est vrai). Les clés
+ * entières sont toutes comparées, sans branchement ; les autres le sont
+ * par dichotomie, pour limiter les appels à la fonction de comparaison.
+ */
+static inline unsigned int compter_inferieures(
+	const Arbre_b* arbre, const intptr_t* cles, unsigned int nb,
+	const intptr_t cle, int ou_egales
+){
+	if( ! arbre->comparer ){
+		unsigned int res = 0;
+		unsigned int i;
+		if( ou_egales ){
+			for( i=0; i<nb; i++ ){
+				res += ( cles[i] <= cle );
+			}
+		}else{
+			for( i=0; i<nb; i++ ){
+				res += ( cles[i] < cle );
+			}
+		}
+		return res;
+	}
+	unsigned int debut = 0;
+	unsigned int fin = nb;
+	while( debut < fin ){
+		unsigned int milieu = ( debut + fin ) / 2;
+		int c = arbre->comparer( cles[milieu], cle );
+		if( c < 0 || ( ou_egales && c == 0 ) ){
+			debut = milieu + 1;
+		}else{
+			fin = milieu;
+		}
+	}
+	return debut;
+}
+
+/* Place de 'cle' dans une feuille. */
+static inline unsigned int place_dans_feuille(
+	const Arbre_b* arbre, const Arbre_b_feuille* feuille, const intptr_t cle
+){
+	return compter_inferieures( arbre, feuille->cles, feuille->nb, cle, 0 );
+}
+
+/* Indice du fils d'un noeud interne où se trouve 'cle'. */
+static inline unsigned int fils_de_la_cle(
+	const Arbre_b* arbre, const Arbre_b_noeud* noeud, const intptr_t cle
+){
+	return compter_inferieures( arbre, noeud->cles, noeud->nb, cle, 1 );
+}
+
+static Arbre_b_feuille* creer_feuille( Arbre_b* arbre ){
+	Arbre_b_feuille* feuille = allouer_bloc( &arbre->feuilles );
+	feuille->nb = 0;
+	feuille->suivante = NULL;
+	feuille->precedente = NULL;
+	return feuille;
+}
+
+static Arbre_b_noeud* creer_noeud( Arbre_b* arbre ){
+	Arbre_b_noeud* noeud = allouer_bloc( &arbre->noeuds );
+	noeud->nb = 0;
+	return noeud;
+}
+
+/* Nombre d'associations du sous-arbre de hauteur 'hauteur'. */
+static size_t taille_sous_arbre( const void* sous_arbre, unsigned int hauteur ){
+	if( hauteur == 0 ){
+		return ( (const Arbre_b_feuille*) sous_arbre )->nb;
+	}
+	const Arbre_b_noeud* noeud = (const Arbre_b_noeud*) sous_arbre;
+	size_t res = 0;
+	unsigned int i;
+	for( i=0; i<=noeud->nb; i++ ){
+		res += noeud->tailles[i];
+	}
+	return res;
+}
+
+void initialiser_arbre_b(
+	Arbre_b* arbre,
+	int (*comparer)( const intptr_t cle1, const intptr_t cle2 ),
+	intptr_t (*copier)( const intptr_t cle ),
+	void (*supprimer)( intptr_t cle )
+){
+	arbre->racine = NULL;
+	arbre->hauteur = 0;
+	arbre->nb_elements = 0;
+	arbre->premiere = NULL;
+	arbre->derniere = NULL;
+	arbre->comparer = comparer;
+	arbre->copier = copier;
+	arbre->supprimer = supprimer;
+	_Static_assert(
+		sizeof(Arbre_b_feuille) % ARBRE_B_LIGNE_DE_CACHE == 0 &&
+		sizeof(Arbre_b_noeud) % ARBRE_B_LIGNE_DE_CACHE == 0,
+		"Les feuilles et les noeuds occupent des lignes de cache entières."
+	);
+	initialiser_pool( &arbre->feuilles, sizeof(Arbre_b_feuille) );
+	initialiser_pool( &arbre->noeuds, sizeof(Arbre_b_noeud) );
+}
+
+static void supprimer_separateurs(
+	Arbre_b* arbre, void* sous_arbre, unsigned int hauteur
+){
+	if( hauteur == 0 ){
+		return;
+	}
+	Arbre_b_noeud* noeud = (Arbre_b_noeud*) sous_arbre;
+	unsigned int i;
+	for( i=0; i<noeud->nb; i++ ){
+		supprimer_cle( arbre, noeud->cles[i] );
+	}
+	for( i=0; i<=noeud->nb; i++ ){
+		supprimer_separateurs( arbre, noeud->fils[i], hauteur - 1 );
+	}
+}
+
+void vider_arbre_b( Arbre_b* arbre ){
+	if( arbre->supprimer && arbre->racine ){
+		Arbre_b_feuille* feuille;
+		unsigned int i;
+		for( feuille = arbre->premiere; feuille; feuille = feuille->suivante ){
+			for( i=0; i<feuille->nb; i++ ){
+				supprimer_cle( arbre, feuille->cles[i] );
+			}
+		}
+		supprimer_separateurs( arbre, arbre->racine, arbre->hauteur );
+	}
+	vider_pool( &arbre->feuilles );
+	vider_pool( &arbre->noeuds );
+	initialiser_arbre_b(
+		arbre, arbre->comparer, arbre->copier, arbre->supprimer
+	);
+}
+
+/*
+ * Ajout.
+ *
+ * Quand un noeud plein reçoit une association ou un fils de plus, il est
+ * coupé en deux : le noeud de droite et la clé qui le sépare du noeud de
+ * gauche remontent alors dans le parent.
+ */
+typedef struct {
+	intptr_t separateur;
+	void* droite;
+	size_t taille_droite;
+} Eclatement;
+
+static int inserer_dans_feuille(
+	Arbre_b* arbre, Arbre_b_feuille* feuille, unsigned int place,
+	intptr_t cle, intptr_t valeur, Eclatement* eclatement
+){
+	if( feuille->nb < ARBRE_B_ORDRE ){
+		unsigned int nb = feuille->nb - place;
+		memmove( feuille->cles + place + 1, feuille->cles + place, nb * sizeof(intptr_t) );
+		memmove( feuille->valeurs + place + 1, feuille->valeurs + place, nb * sizeof(intptr_t) );
+		feuille->cles[place] = cle;
+		feuille->valeurs[place] = valeur;
+		feuille->nb++;
+		return 0;
+	}
+	intptr_t cles[ARBRE_B_ORDRE + 1];
+	intptr_t valeurs[ARBRE_B_ORDRE + 1];
+	memcpy( cles, feuille->cles, place * sizeof(intptr_t) );
+	memcpy( valeurs, feuille->valeurs, place * sizeof(intptr_t) );
+	cles[place] = cle;
+	valeurs[place] = valeur;
+	memcpy( cles + place + 1, feuille->cles + place, ( ARBRE_B_ORDRE - place ) * sizeof(intptr_t) );
+	memcpy( valeurs + place + 1, feuille->valeurs + place, ( ARBRE_B_ORDRE - place ) * sizeof(intptr_t) );
+
+	unsigned int gauche = ( ARBRE_B_ORDRE + 1 ) / 2;
+	unsigned int droite = ARBRE_B_ORDRE + 1 - gauche;
+	Arbre_b_feuille* nouvelle = creer_feuille( arbre );
+	memcpy( feuille->cles, cles, gauche * sizeof(intptr_t) );
+	memcpy( feuille->valeurs, valeurs, gauche * sizeof(intptr_t) );
+	feuille->nb = gauche;
+	memcpy( nouvelle->cles, cles + gauche, droite * sizeof(intptr_t) );
+	memcpy( nouvelle->valeurs, valeurs + gauche, droite * sizeof(intptr_t) );
+	nouvelle->nb = droite;
+
+	nouvelle->suivante = feuille->suivante;
+	nouvelle->precedente = feuille;
+	if( feuille->suivante ){
+		feuille->suivante->precedente = nouvelle;
+	}else{
+		arbre->derniere = nouvelle;
+	}
+	feuille->suivante = nouvelle;
+
+	eclatement->separateur = copier_cle( arbre, nouvelle->cles[0] );
+	eclatement->droite = nouvelle;
+	eclatement->taille_droite = droite;
+	return 1;
+}
+
+/*
+ * Ajoute au noeud la clé 'separateur' à la place 'place' et le fils
+ * 'droite' juste après elle.
+ */
+static int inserer_dans_noeud(
+	Arbre_b* arbre, Arbre_b_noeud* noeud, unsigned int place,
+	const Eclatement* fils, Eclatement* eclatement
+){
+	if( noeud->nb < ARBRE_B_ORDRE - 1 ){
+		unsigned int nb = noeud->nb - place;
+		memmove( noeud->cles + place + 1, noeud->cles + place, nb * sizeof(intptr_t) );
+		memmove( noeud->fils + place + 2, noeud->fils + place + 1, nb * sizeof(void*) );
+		memmove( noeud->tailles + place + 2, noeud->tailles + place + 1, nb * sizeof(size_t) );
+		noeud->cles[place] = fils->separateur;
+		noeud->fils[place + 1] = fils->droite;
+		noeud->tailles[place + 1] = fils->taille_droite;
+		noeud->nb++;
+		return 0;
+	}
+	intptr_t cles[ARBRE_B_ORDRE];
+	void* sous_arbres[ARBRE_B_ORDRE + 1];
+	size_t tailles[ARBRE_B_ORDRE + 1];
+	unsigned int nb = ARBRE_B_ORDRE - 1 - place;
+	memcpy( cles, noeud->cles, place * sizeof(intptr_t) );
+	cles[place] = fils->separateur;
+	memcpy( cles + place + 1, noeud->cles + place, nb * sizeof(intptr_t) );
+	memcpy( sous_arbres, noeud->fils, ( place + 1 ) * sizeof(void*) );
+	sous_arbres[place + 1] = fils->droite;
+	memcpy( sous_arbres + place + 2, noeud->fils + place + 1, nb * sizeof(void*) );
+	memcpy( tailles, noeud->tailles, ( place + 1 ) * sizeof(size_t) );
+	tailles[place + 1] = fils->taille_droite;
+	memcpy( tailles + place + 2, noeud->tailles + place + 1, nb * sizeof(size_t) );
+
+	// Le noeud garde les 'gauche' premières clés, la clé suivante remonte et
+	// les autres vont dans le nouveau noeud.
+	unsigned int gauche = ARBRE_B_ORDRE / 2;
+	unsigned int droite = ARBRE_B_ORDRE - 1 - gauche;
+	Arbre_b_noeud* nouveau = creer_noeud( arbre );
+	memcpy( noeud->cles, cles, gauche * sizeof(intptr_t) );
+	memcpy( noeud->fils, sous_arbres, ( gauche + 1 ) * sizeof(void*) );
+	memcpy( noeud->tailles, tailles, ( gauche + 1 ) * sizeof(size_t) );
+	noeud->nb = gauche;
+	memcpy( nouveau->cles, cles + gauche + 1, droite * sizeof(intptr_t) );
+	memcpy( nouveau->fils, sous_arbres + gauche + 1, ( droite + 1 ) * sizeof(void*) );
+	memcpy( nouveau->tailles, tailles + gauche + 1, ( droite + 1 ) * sizeof(size_t) );
+	nouveau->nb = droite;
+
+	eclatement->separateur = cles[gauche];
+	eclatement->droite = nouveau;
+	eclatement->taille_droite = taille_sous_arbre( nouveau, 1 );
+	return 1;
+}
+
+/*
+ * Ajoute l'association au sous-arbre. Renvoie 1 si la racine du sous-arbre
+ * a été coupée en deux. '*nouvelle' vaut 1 si la clé n'était pas dans
+ * l'arbre.
+ */
+static int inserer(
+	Arbre_b* arbre, void* sous_arbre, unsigned int hauteur,
+	const intptr_t cle, intptr_t valeur, Eclatement* eclatement, int* nouvelle
+){
+	if( hauteur == 0 ){
+		Arbre_b_feuille* feuille = (Arbre_b_feuille*) sous_arbre;
+		unsigned int place = place_dans_feuille( arbre, feuille, cle );
+		if(
+			place < feuille->nb &&
+			comparer_cles( arbre, feuille->cles[place], cle ) == 0
+		){
+			feuille->valeurs[place] = valeur;
+			*nouvelle = 0;
+			return 0;
+		}
+		*nouvelle = 1;
+		return inserer_dans_feuille(
+			arbre, feuille, place, copier_cle( arbre, cle ), valeur, eclatement
+		);
+	}
+	Arbre_b_noeud* noeud = (Arbre_b_noeud*) sous_arbre;
+	unsigned int i = fils_de_la_cle( arbre, noeud, cle );
+	Eclatement fils;
+	if( ! inserer( arbre, noeud->fils[i], hauteur - 1, cle, valeur, &fils, nouvelle ) ){
+		noeud->tailles[i] += *nouvelle;
+		return 0;
+	}
+	noeud->tailles[i] = noeud->tailles[i] + 1 - fils.taille_droite;
+	return inserer_dans_noeud( arbre, noeud, i, &fils, eclatement );
+}
+
+int ajouter_arbre_b( Arbre_b* arbre, const intptr_t cle, intptr_t valeur ){
+	if( ! arbre->racine ){
+		Arbre_b_feuille* feuille = creer_feuille( arbre );
+		arbre->racine = feuille;
+		arbre->hauteur = 0;
+		arbre->premiere = feuille;
+		arbre->derniere = feuille;
+	}
+	Eclatement eclatement;
+	int nouvelle;
+	if( inserer( arbre, arbre->racine, arbre->hauteur, cle, valeur, &eclatement, &nouvelle ) ){
+		Arbre_b_noeud* racine = creer_noeud( arbre );
+		racine->nb = 1;
+		racine->cles[0] = eclatement.separateur;
+		racine->fils[0] = arbre->racine;
+		racine->fils[1] = eclatement.droite;
+		racine->tailles[1] = eclatement.taille_droite;
+		racine->tailles[0] = arbre->nb_elements + 1 - eclatement.taille_droite;
+		arbre->racine = racine;
+		arbre->hauteur++;
+	}
+	arbre->nb_elements += nouvelle;
+	return nouvelle;
+}
+
+/*
+ * Retrait.
+ *
+ * Quand un fils n'est plus assez plein, il emprunte une association (ou un
+ * fils) à un frère voisin, ou bien, si ce frère est lui-même à moitié
+ * plein, les deux frères sont fusionnés.
+ */
+
+/* Retire la clé k et le fils k+1 du noeud. */
+static void enlever_du_noeud( Arbre_b_noeud* noeud, unsigned int k ){
+	unsigned int nb = noeud->nb - k - 1;
+	memmove( noeud->cles + k, noeud->cles + k + 1, nb * sizeof(intptr_t) );
+	memmove( noeud->fils + k + 1, noeud->fils + k + 2, nb * sizeof(void*) );
+	memmove( noeud->tailles + k + 1, noeud->tailles + k + 2, nb * sizeof(size_t) );
+	noeud->nb--;
+}
+
+/* Fusionne les fils k et k+1 du noeud, qui sont des feuilles. */
+static void fusionner_feuilles(
+	Arbre_b* arbre, Arbre_b_noeud* parent, unsigned int k
+){
+	Arbre_b_feuille* gauche = (Arbre_b_feuille*) parent->fils[k];
+	Arbre_b_feuille* droite = (Arbre_b_feuille*) parent->fils[k+1];
+	memcpy( gauche->cles + gauche->nb, droite->cles, droite->nb * sizeof(intptr_t) );
+	memcpy( gauche->valeurs + gauche->nb, droite->valeurs, droite->nb * sizeof(intptr_t) );
+	gauche->nb += droite->nb;
+	gauche->suivante = droite->suivante;
+	if( droite->suivante ){
+		droite->suivante->precedente = gauche;
+	}else{
+		arbre->derniere = gauche;
+	}
+	liberer_bloc( &arbre->feuilles, droite );
+	parent->tailles[k] += parent->tailles[k+1];
+	supprimer_cle( arbre, parent->cles[k] );
+	enlever_du_noeud( parent, k );
+}
+
+/* Fusionne les fils k et k+1 du noeud, qui sont des noeuds internes. */
+static void fusionner_noeuds(
+	Arbre_b* arbre, Arbre_b_noeud* parent, unsigned int k
+){
+	Arbre_b_noeud* gauche = (Arbre_b_noeud*) parent->fils[k];
+	Arbre_b_noeud* droite = (Arbre_b_noeud*) parent->fils[k+1];
+	// Le séparateur descend entre les clés des deux noeuds.
+	gauche->cles[gauche->nb] = parent->cles[k];
+	memcpy( gauche->cles + gauche->nb + 1, droite->cles, droite->nb * sizeof(intptr_t) );
+	memcpy( gauche->fils + gauche->nb + 1, droite->fils, ( droite->nb + 1 ) * sizeof(void*) );
+	memcpy( gauche->tailles + gauche->nb + 1, droite->tailles, ( droite->nb + 1 ) * sizeof(size_t) );
+	gauche->nb += droite->nb + 1;
+	liberer_bloc( &arbre->noeuds, droite );
+	parent->tailles[k] += parent->tailles[k+1];
+	enlever_du_noeud( parent, k );
+}
+
+static void reequilibrer_feuille(
+	Arbre_b* arbre, Arbre_b_noeud* parent, unsigned int i
+){
+	Arbre_b_feuille* feuille = (Arbre_b_feuille*) parent->fils[i];
+	if( i > 0 ){
+		Arbre_b_feuille* gauche = (Arbre_b_feuille*) parent->fils[i-1];
+		if( gauche->nb <= ARBRE_B_MIN_FEUILLE ){
+			fusionner_feuilles( arbre, parent, i-1 );
+			return;
+		}
+		memmove( feuille->cles + 1, feuille->cles, feuille->nb * sizeof(intptr_t) );
+		memmove( feuille->valeurs + 1, feuille->valeurs, feuille->nb * sizeof(intptr_t) );
+		gauche->nb--;
+		feuille->cles[0] = gauche->cles[gauche->nb];
+		feuille->valeurs[0] = gauche->valeurs[gauche->nb];
+		feuille->nb++;
+		parent->tailles[i-1]--;
+		parent->tailles[i]++;
+		supprimer_cle( arbre, parent->cles[i-1] );
+		parent->cles[i-1] = copier_cle( arbre, feuille->cles[0] );
+		return;
+	}
+	Arbre_b_feuille* droite = (Arbre_b_feuille*) parent->fils[i+1];
+	if( droite->nb <= ARBRE_B_MIN_FEUILLE ){
+		fusionner_feuilles( arbre, parent, i );
+		return;
+	}
+	feuille->cles[feuille->nb] = droite->cles[0];
+	feuille->valeurs[feuille->nb] = droite->valeurs[0];
+	feuille->nb++;
+	droite->nb--;
+	memmove( droite->cles, droite->cles + 1, droite->nb * sizeof(intptr_t) );
+	memmove( droite->valeurs, droite->valeurs + 1, droite->nb * sizeof(intptr_t) );
+	parent->tailles[i+1]--;
+	parent->tailles[i]++;
+	supprimer_cle( arbre, parent->cles[i] );
+	parent->cles[i] = copier_cle( arbre, droite->cles[0] );
+}
+
+static void reequilibrer_noeud(
+	Arbre_b* arbre, Arbre_b_noeud* parent, unsigned int i
+){
+	Arbre_b_noeud* noeud = (Arbre_b_noeud*) parent->fils[i];
+	if( i > 0 ){
+		Arbre_b_noeud* gauche = (Arbre_b_noeud*) parent->fils[i-1];
+		if( gauche->nb <= ARBRE_B_MIN_NOEUD ){
+			fusionner_noeuds( arbre, parent, i-1 );
+			return;
+		}
+		// Le dernier fils de 'gauche' devient le premier fils de 'noeud' ; le
+		// séparateur descend et la dernière clé de 'gauche' le remplace.
+		memmove( noeud->cles + 1, noeud->cles, noeud->nb * sizeof(intptr_t) );
+		memmove( noeud->fils + 1, noeud->fils, ( noeud->nb + 1 ) * sizeof(void*) );
+		memmove( noeud->tailles + 1, noeud->tailles, ( noeud->nb + 1 ) * sizeof(size_t) );
+		size_t taille = gauche->tailles[gauche->nb];
+		noeud->cles[0] = parent->cles[i-1];
+		noeud->fils[0] = gauche->fils[gauche->nb];
+		noeud->tailles[0] = taille;
+		noeud->nb++;
+		parent->cles[i-1] = gauche->cles[gauche->nb - 1];
+		gauche->nb--;
+		parent->tailles[i-1] -= taille;
+		parent->tailles[i] += taille;
+		return;
+	}
+	Arbre_b_noeud* droite = (Arbre_b_noeud*) parent->fils[i+1];
+	if( droite->nb <= ARBRE_B_MIN_NOEUD ){
+		fusionner_noeuds( arbre, parent, i );
+		return;
+	}
+	size_t taille = droite->tailles[0];
+	noeud->cles[noeud->nb] = parent->cles[i];
+	noeud->fils[noeud->nb + 1] = droite->fils[0];
+	noeud->tailles[noeud->nb + 1] = taille;
+	noeud->nb++;
+	parent->cles[i] = droite->cles[0];
+	memmove( droite->cles, droite->cles + 1, ( droite->nb - 1 ) * sizeof(intptr_t) );
+	memmove( droite->fils, droite->fils + 1, droite->nb * sizeof(void*) );
+	memmove( droite->tailles, droite->tailles + 1, droite->nb * sizeof(size_t) );
+	droite->nb--;
+	parent->tailles[i+1] -= taille;
+	parent->tailles[i] += taille;
+}
+
+static int retirer(
+	Arbre_b* arbre, void* sous_arbre, unsigned int hauteur,
+	const intptr_t cle, intptr_t* valeur
+){
+	if( hauteur == 0 ){
+		Arbre_b_feuille* feuille = (Arbre_b_feuille*) sous_arbre;
+		unsigned int place = place_dans_feuille( arbre, feuille, cle );
+		if(
+			place == feuille->nb ||
+			comparer_cles( arbre, feuille->cles[place], cle ) != 0
+		){
+			return 0;
+		}
+		if( valeur ){
+			*valeur = feuille->valeurs[place];
+		}
+		supprimer_cle( arbre, feuille->cles[place] );
+		feuille->nb--;
+		unsigned int nb = feuille->nb - place;
+		memmove( feuille->cles + place, feuille->cles + place + 1, nb * sizeof(intptr_t) );
+		memmove( feuille->valeurs + place, feuille->valeurs + place + 1, nb * sizeof(intptr_t) );
+		return 1;
+	}
+	Arbre_b_noeud* noeud = (Arbre_b_noeud*) sous_arbre;
+	unsigned int i = fils_de_la_cle( arbre, noeud, cle );
+	if( ! retirer( arbre, noeud->fils[i], hauteur - 1, cle, valeur ) ){
+		return 0;
+	}
+	noeud->tailles[i]--;
+	if( hauteur == 1 ){
+		if( ( (Arbre_b_feuille*) noeud->fils[i] )->nb < ARBRE_B_MIN_FEUILLE ){
+			reequilibrer_feuille( arbre, noeud, i );
+		}
+	}else if( ( (Arbre_b_noeud*) noeud->fils[i] )->nb < ARBRE_B_MIN_NOEUD ){
+		reequilibrer_noeud( arbre, noeud, i );
+	}
+	return 1;
+}
+
+int retirer_arbre_b( Arbre_b* arbre, const intptr_t cle, intptr_t* valeur ){
+	if( ! arbre->racine ){
+		return 0;
+	}
+	if( ! retirer( arbre, arbre->racine, arbre->hauteur, cle, valeur ) ){
+		return 0;
+	}
+	arbre->nb_elements--;
+	if( arbre->hauteur > 0 ){
+		Arbre_b_noeud* racine = (Arbre_b_noeud*) arbre->racine;
+		if( racine->nb == 0 ){
+			arbre->racine = racine->fils[0];
+			arbre->hauteur--;
+			liberer_bloc( &arbre->noeuds, racine );
+		}
+	}else if( arbre->nb_elements == 0 ){
+		liberer_bloc( &arbre->feuilles, arbre->racine );
+		arbre->racine = NULL;
+		arbre->premiere = NULL;
+		arbre->derniere = NULL;
+	}
+	return 1;
+}
+
+Arbre_b_position trouver_arbre_b( const Arbre_b* arbre, const intptr_t cle ){
+	Arbre_b_position res = { NULL, 0 };
+	if( ! arbre->racine ){
+		return res;
+	}
+	void* sous_arbre = arbre->racine;
+	unsigned int hauteur;
+	for( hauteur = arbre->hauteur; hauteur > 0; hauteur-- ){
+		Arbre_b_noeud* noeud = (Arbre_b_noeud*) sous_arbre;
+		sous_arbre = noeud->fils[ fils_de_la_cle( arbre, noeud, cle ) ];
+	}
+	Arbre_b_feuille* feuille = (Arbre_b_feuille*) sous_arbre;
+	unsigned int place = place_dans_feuille( arbre, feuille, cle );
+	if(
+		place < feuille->nb &&
+		comparer_cles( arbre, feuille->cles[place], cle ) == 0
+	){
+		res.feuille = feuille;
+		res.indice = place;
+	}
+	return res;
+}
+
+void construire_arbre_b(
+	Arbre_b* arbre, const intptr_t* cles, const intptr_t* valeurs, size_t nb
+){
+	assert( ! arbre->racine );
+	if( nb == 0 ){
+		return;
+	}
+	// Les noeuds d'un niveau se partagent les noeuds du niveau inférieur le
+	// plus équitablement possible : chacun est au moins à moitié plein.
+	size_t nb_noeuds = ( nb + ARBRE_B_ORDRE - 1 ) / ARBRE_B_ORDRE;
+	void** niveau = xmalloc( nb_noeuds * sizeof(void*) );
+	intptr_t* minima = xmalloc( nb_noeuds * sizeof(intptr_t) );
+	size_t* tailles = xmalloc( nb_noeuds * sizeof(size_t) );
+	reserver_pool( &arbre->feuilles, nb_noeuds );
+	Arbre_b_feuille* precedente = NULL;
+	size_t i, j, k = 0;
+	for( i=0; i<nb_noeuds; i++ ){
+		size_t taille = nb / nb_noeuds + ( i < nb % nb_noeuds );
+		Arbre_b_feuille* feuille = creer_feuille( arbre );
+		for( j=0; j<taille; j++ ){
+			feuille->cles[j] = copier_cle( arbre, cles[k+j] );
+			feuille->valeurs[j] = valeurs ? valeurs[k+j] : (intptr_t) NULL;
+		}
+		feuille->nb = taille;
+		feuille->precedente = precedente;
+		if( precedente ){
+			precedente->suivante = feuille;
+		}
+		precedente = feuille;
+		niveau[i] = feuille;
+		minima[i] = feuille->cles[0];
+		tailles[i] = taille;
+		k += taille;
+	}
+	arbre->premiere = (Arbre_b_feuille*) niveau[0];
+	arbre->derniere = precedente;
+
+	unsigned int hauteur = 0;
+	while( nb_noeuds > 1 ){
+		size_t nb_parents = ( nb_noeuds + ARBRE_B_ORDRE - 1 ) / ARBRE_B_ORDRE;
+		reserver_pool( &arbre->noeuds, nb_parents );
+		k = 0;
+		for( i=0; i<nb_parents; i++ ){
+			size_t nb_fils = nb_noeuds / nb_parents + ( i < nb_noeuds % nb_parents );
+			Arbre_b_noeud* noeud = creer_noeud( arbre );
+			size_t taille = 0;
+			for( j=0; j<nb_fils; j++ ){
+				noeud->fils[j] = niveau[k+j];
+				noeud->tailles[j] = tailles[k+j];
+				taille += tailles[k+j];
+				if( j > 0 ){
+					noeud->cles[j-1] = copier_cle( arbre, minima[k+j] );
+				}
+			}
+			noeud->nb = nb_fils - 1;
+			// Le niveau est réécrit sur place : i <= k.
+			minima[i] = minima[k];
+			niveau[i] = noeud;
+			tailles[i] = taille;
+			k += nb_fils;
+		}
+		nb_noeuds = nb_parents;
+		hauteur++;
+	}
+	arbre->racine = niveau[0];
+	arbre->hauteur = hauteur;
+	arbre->nb_elements = nb;
+	xfree( niveau );
+	xfree( minima );
+	xfree( tailles );
+}
+
+void copier_arbre_b(
+	Arbre_b* copie, const Arbre_b* arbre,
+	intptr_t (*copier_valeur)( const intptr_t valeur )
+){
+	assert( ! copie->racine );
+	if( ! arbre->nb_elements ){
+		return;
+	}
+	intptr_t* cles = xmalloc( arbre->nb_elements * sizeof(intptr_t) );
+	intptr_t* valeurs = xmalloc( arbre->nb_elements * sizeof(intptr_t) );
+	size_t nb = 0;
+	const Arbre_b_feuille* feuille;
+	unsigned int i;
+	for( feuille = arbre->premiere; feuille; feuille = feuille->suivante ){
+		for( i=0; i<feuille->nb; i++ ){
+			cles[nb] = feuille->cles[i];
+			valeurs[nb] = copier_valeur ?
+				copier_valeur( feuille->valeurs[i] ) : feuille->valeurs[i];
+			nb++;
+		}
+	}
+	construire_arbre_b( copie, cles, valeurs, nb );
+	xfree( cles );
+	xfree( valeurs );
+}
+
+Arbre_b_position premiere_position_arbre_b( const Arbre_b* arbre ){
+	Arbre_b_position res = { arbre->premiere, 0 };
+	return res;
+}
+
+Arbre_b_position derniere_position_arbre_b( const Arbre_b* arbre ){
+	Arbre_b_position res = { arbre->derniere, 0 };
+	if( arbre->derniere ){
+		res.indice = arbre->derniere->nb - 1;
+	}
+	return res;
+}
+
+Arbre_b_position position_suivante_arbre_b(
+	const Arbre_b* arbre, Arbre_b_position position
+){
+	if( ! position.feuille ){
+		return premiere_position_arbre_b( arbre );
+	}
+	if( position.indice + 1 < position.feuille->nb ){
+		position.indice++;
+		return position;
+	}
+	position.feuille = position.feuille->suivante;
+	position.indice = 0;
+	return position;
+}
+
+Arbre_b_position position_precedente_arbre_b(
+	const Arbre_b* arbre, Arbre_b_position position
+){
+	if( ! position.feuille ){
+		return derniere_position_arbre_b( arbre );
+	}
+	if( position.indice > 0 ){
+		position.indice--;
+		return position;
+	}
+	position.feuille = position.feuille->precedente;
+	position.indice = position.feuille ? position.feuille->nb - 1 : 0;
+	return position;
+}
+
+Arbre_b_position ieme_position_arbre_b( const Arbre_b* arbre, size_t rang ){
+	Arbre_b_position res = { NULL, 0 };
+	if( rang >= arbre->nb_elements ){
+		return res;
+	}
+	void* sous_arbre = arbre->racine;
+	unsigned int hauteur;
+	for( hauteur = arbre->hauteur; hauteur > 0; hauteur-- ){
+		Arbre_b_noeud* noeud = (Arbre_b_noeud*) sous_arbre;
+		unsigned int i = 0;
+		while( rang >= noeud->tailles[i] ){
+			rang -= noeud->tailles[i];
+			i++;
+		}
+		sous_arbre = noeud->fils[i];
+	}
+	res.feuille = (Arbre_b_feuille*) sous_arbre;
+	res.indice = rang;
+	return res;
+}
+
+size_t rang_arbre_b( const Arbre_b* arbre, const intptr_t cle ){
+	if( ! arbre->racine ){
+		return 0;
+	}
+	size_t res = 0;
+	void* sous_arbre = arbre->racine;
+	unsigned int hauteur;
+	for( hauteur = arbre->hauteur; hauteur > 0; hauteur-- ){
+		Arbre_b_noeud* noeud = (Arbre_b_noeud*) sous_arbre;
+		unsigned int fils = fils_de_la_cle( arbre, noeud, cle );
+		unsigned int i;
+		for( i=0; i<fils; i++ ){
+			res += noeud->tailles[i];
+		}
+		sous_arbre = noeud->fils[fils];
+	}
+	return res + place_dans_feuille( arbre, (Arbre_b_feuille*) sous_arbre, cle );
+}
@@ -0,0 +1,222 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file arbre_b.h */
+
+#ifndef __ARBRE_B_H__
+#define __ARBRE_B_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "pool.h"
+
+/**
+ * @brief Nombre maximal de fils d'un noeud interne, et nombre maximal
+ * d'associations d'une feuille.
+ *
+ * Les clés d'un noeud occupent ainsi deux lignes de cache de 64 octets.
+ */
+#define ARBRE_B_ORDRE 16
+
+/**
+ * @brief Taille d'une ligne de cache. Les feuilles et les noeuds occupent
+ * un nombre entier de lignes (voir arbre_b.c).
+ */
+#define ARBRE_B_LIGNE_DE_CACHE 64
+
+/**
+ * @brief Définit le type d'une feuille d'un B+-arbre.
+ *
+ * Les clés et les valeurs sont rangées dans la feuille même, dans l'ordre
+ * croissant des clés. Les feuilles sont chaînées dans l'ordre des clés : un
+ * parcours de l'arbre est un parcours de tableaux.
+ *
+ * 'remplissage' complète la feuille jusqu'à un multiple de 
+ * ARBRE_B_LIGNE_DE_CACHE octets (320 octets sur une machine 64 bits).
+ */
+typedef struct Arbre_b_feuille {
+	intptr_t cles[ARBRE_B_ORDRE];
+	intptr_t valeurs[ARBRE_B_ORDRE];
+	struct Arbre_b_feuille* suivante;
+	struct Arbre_b_feuille* precedente;
+	unsigned int nb;
+	char remplissage[
+		ARBRE_B_LIGNE_DE_CACHE - (
+			2 * ARBRE_B_ORDRE * sizeof(intptr_t) + 
+			2 * sizeof(void*) + sizeof(unsigned int)
+		) % ARBRE_B_LIGNE_DE_CACHE
+	];
+} Arbre_b_feuille;
+
+/**
+ * @brief Définit le type d'un noeud interne d'un B+-arbre.
+ *
+ * Un noeud a 'nb' clés et 'nb' + 1 fils. Les clés du fils i sont plus
+ * grandes ou égales à cles[i-1] et strictement plus petites que cles[i].
+ * 'tailles[i]' est le nombre d'associations du fils i, ce qui permet de
+ * trouver l'association d'un rang donné en temps logarithmique.
+ */
+typedef struct Arbre_b_noeud {
+	intptr_t cles[ARBRE_B_ORDRE - 1];
+	unsigned int nb;
+	void* fils[ARBRE_B_ORDRE];
+	size_t tailles[ARBRE_B_ORDRE];
+} Arbre_b_noeud;
+
+/**
+ * @brief Définit le type d'un B+-arbre, qui associe des valeurs à des clés.
+ *
+ * Les associations sont dans les feuilles, qui sont toutes à la même
+ * profondeur 'hauteur' ; les noeuds internes ne contiennent que des copies
+ * de clés, qui servent à choisir le fils où descendre. Tout noeud, sauf la
+ * racine, est au moins à moitié plein.
+ *
+ * Si 'comparer' vaut NULL, les clés sont des entiers, comparés directement.
+ * Sinon, les clés sont copiées par 'copier' et supprimées par 'supprimer'
+ * (quand ces fonctions ne valent pas NULL), comme celles d'une table.
+ *
+ * Les noeuds et les feuilles sont alloués dans deux pools propres à l'arbre.
+ */
+typedef struct Arbre_b {
+	void* racine;
+	unsigned int hauteur;
+	size_t nb_elements;
+	Arbre_b_feuille* premiere;
+	Arbre_b_feuille* derniere;
+	int (*comparer)( const intptr_t cle1, const intptr_t cle2 );
+	intptr_t (*copier)( const intptr_t cle );
+	void (*supprimer)( intptr_t cle );
+	Pool feuilles;
+	Pool noeuds;
+} Arbre_b;
+
+/**
+ * @brief Définit une position dans un B+-arbre : une feuille et l'indice
+ * d'une association de cette feuille.
+ *
+ * La position vide a une feuille NULL.
+ */
+typedef struct {
+	Arbre_b_feuille* feuille;
+	unsigned int indice;
+} Arbre_b_position;
+
+/**
+ * @brief Initialise un arbre vide. Aucune mémoire n'est allouée avant le
+ * premier ajout.
+ */
+void initialiser_arbre_b(
+	Arbre_b* arbre,
+	int (*comparer)( const intptr_t cle1, const intptr_t cle2 ),
+	intptr_t (*copier)( const intptr_t cle ),
+	void (*supprimer)( intptr_t cle )
+);
+
+/**
+ * @brief Supprime toutes les clés de l'arbre et rend toute sa mémoire.
+ * L'arbre, vide, peut être réutilisé ensuite.
+ */
+void vider_arbre_b( Arbre_b* arbre );
+
+/**
+ * @brief Associe 'valeur' à 'cle', qui est copiée si elle n'est pas déjà
+ * dans l'arbre. Renvoie 1 si la clé est nouvelle, 0 si sa valeur a été
+ * remplacée.
+ */
+int ajouter_arbre_b( Arbre_b* arbre, const intptr_t cle, intptr_t valeur );
+
+/**
+ * @brief Retire la clé de l'arbre, et écrit sa valeur dans '*valeur' si
+ * 'valeur' ne vaut pas NULL. Renvoie 1 si la clé était dans l'arbre.
+ */
+int retirer_arbre_b( Arbre_b* arbre, const intptr_t cle, intptr_t* valeur );
+
+/**
+ * @brief Renvoie la position de la clé, ou la position vide si elle n'est
+ * pas dans l'arbre.
+ */
+Arbre_b_position trouver_arbre_b( const Arbre_b* arbre, const intptr_t cle );
+
+/**
+ * @brief Remplit un arbre vide avec les 'nb' associations
+ * cles[i] --> valeurs[i] (NULL si 'valeurs' vaut NULL), en temps linéaire.
+ *
+ * Les clés doivent être deux à deux distinctes et triées dans l'ordre
+ * croissant. Elles sont copiées, comme par ajouter_arbre_b(). Les feuilles
+ * de l'arbre obtenu sont contiguës en mémoire.
+ */
+void construire_arbre_b(
+	Arbre_b* arbre, const intptr_t* cles, const intptr_t* valeurs, size_t nb
+);
+
+/**
+ * @brief Remplit l'arbre vide 'copie', qui a les mêmes fonctions que 'arbre',
+ * avec une copie des associations de 'arbre', en temps linéaire.
+ *
+ * Si 'copier_valeur' ne vaut pas NULL, les valeurs de la copie sont les
+ * images des valeurs de 'arbre' par 'copier_valeur'.
+ */
+void copier_arbre_b(
+	Arbre_b* copie, const Arbre_b* arbre,
+	intptr_t (*copier_valeur)( const intptr_t valeur )
+);
+
+/**
+ * @brief Renvoie la position de la plus petite clé, ou la position vide si
+ * l'arbre est vide.
+ */
+Arbre_b_position premiere_position_arbre_b( const Arbre_b* arbre );
+
+/**
+ * @brief Renvoie la position de la plus grande clé, ou la position vide si
+ * l'arbre est vide.
+ */
+Arbre_b_position derniere_position_arbre_b( const Arbre_b* arbre );
+
+/**
+ * @brief Renvoie la position suivante, ou la position vide après la plus
+ * grande clé. La position suivant la position vide est la première.
+ */
+Arbre_b_position position_suivante_arbre_b(
+	const Arbre_b* arbre, Arbre_b_position position
+);
+
+/**
+ * @brief Renvoie la position précédente, ou la position vide avant la plus
+ * petite clé. La position précédant la position vide est la dernière.
+ */
+Arbre_b_position position_precedente_arbre_b(
+	const Arbre_b* arbre, Arbre_b_position position
+);
+
+/**
+ * @brief Renvoie la position de l'association de rang 'rang' (précédée de
+ * 'rang' associations), ou la position vide si l'arbre a au plus 'rang'
+ * associations, en temps logarithmique.
+ */
+Arbre_b_position ieme_position_arbre_b( const Arbre_b* arbre, size_t rang );
+
+/**
+ * @brief Renvoie le nombre de clés de l'arbre strictement plus petites que
+ * 'cle', en temps logarithmique.
+ */
+size_t rang_arbre_b( const Arbre_b* arbre, const intptr_t cle );
+
+#endif
@@ -19,10 +19,10 @@
  */
 
 #include "automate.h"
-#include "table.h"
+#include "bitset.h"
+#include "conteneurs.h"
 #include "ensemble.h"
 #include "outils.h"
-#include "fifo.h"
 
 #include <search.h>
 #include <stdio.h>
@@ -34,87 +34,78 @@
 
 #include <math.h>
 
-/* Compare la valeur max à notre élement, si celle ci est inférieure à l'élement, alors max prend la valeur de l'élement */
-void action_get_max_etat( const intptr_t element, void* data){
-	int * max = (int*) data;
-	if ( *max < element ) *max = element;
-}
-
-/* Pour chaque état de l'automate, applique action_get_max et nous renvoie la valeur max, qui correspond à notre état maximum */
+/* Les états sont rangés dans l'ordre croissant : le plus grand est le dernier */
 int get_max_etat( const Automate* automate ){
-	int max = INT_MIN;
-
-	pour_tout_element( automate->etats, action_get_max_etat, &max);
-
-	return max;
-}
-
-void action_get_min_etat( const intptr_t element, void* data ){
-	int * min = (int*) data;
-	if( *min > element ) *min = element;
+	if( ensemble_est_vide( automate->etats ) ) return INT_MIN;
+	return max_ensemble( automate->etats );
 }
 
 int get_min_etat( const Automate* automate ){
-	int min = INT_MAX;
-
-	pour_tout_element( automate->etats, action_get_min_etat, &min );
-
-	return min;
+	if( ensemble_est_vide( automate->etats ) ) return INT_MAX;
+	return min_ensemble( automate->etats );
 }
 
 
-int comparer_cle(const Cle *a, const Cle *b) {
-	if( a->origine < b->origine )
-		return -1;
-	if( a->origine > b->origine )
-		return 1;
-	if( a->lettre < b->lettre )
-		return -1;
-	if( a->lettre > b->lettre )
-		return 1;
-	return 0;
-}
-
-void print_cle( const Cle * a){
-	printf( "(%d, %c)" , a->origine, (char) (a->lettre) );
-}
-
-void supprimer_cle( Cle* cle ){
-	xfree( cle );
-}
+/*
+ * La table des transitions associe au couple (origine, lettre), codé sur 64 
+ * bits (l'origine dans les 32 bits de poids fort, la lettre dans l'octet de 
+ * poids faible), l'ensemble des états d'arrivée. Les clés sont rangées dans 
+ * les cases mêmes de la table, et le hachage et la comparaison des clés sont
+ * développés sur place (voir conteneurs.h).
+ */
+DEFINIR_TABLE_DE_HACHAGE(
+	Table_transitions, table_transitions, uint64_t, Ensemble*,
+	CONTENEURS_HACHER_ENTIER, CONTENEURS_EGAUX
+)
 
-void initialiser_cle( Cle* cle, int origine, char lettre ){
-	cle->origine = origine;
-	cle->lettre = (int) lettre;
+static uint64_t cle_de_transition( int origine, char lettre ){
+	return ( (uint64_t) (uint32_t) origine << 32 ) | (unsigned char) lettre;
 }
 
-Cle * creer_cle( int origine, char lettre ){
-	Cle * result = xmalloc( sizeof(Cle) );
-	initialiser_cle( result, origine, lettre );
-	return result;
+static Cle decoder_cle( uint64_t cle ){
+	Cle res;
+	res.origine = (int32_t) ( cle >> 32 );
+	res.lettre = (char) ( cle & 0xff );
+	return res;
 }
 
-Cle * copier_cle( const Cle* cle ){
-	return creer_cle( cle->origine, cle->lettre );
+static void print_cle( const Cle * a ){
+	printf( "(%d, %c)" , a->origine, (char) (a->lettre) );
 }
 
-Automate * creer_automate(){
+static Automate * initialiser_automate( Arene* arene ){
+	Arene* precedente = utiliser_arene( arene );
 	Automate * automate = xmalloc( sizeof(Automate) );
+	automate->arene = arene;
 	automate->etats = creer_ensemble( NULL, NULL, NULL );
 	automate->alphabet = creer_ensemble( NULL, NULL, NULL );
-	automate->transitions = creer_table(
-		( int(*)(const intptr_t, const intptr_t) ) comparer_cle , 
-		( intptr_t (*)( const intptr_t ) ) copier_cle,
-		( void(*)(intptr_t) ) supprimer_cle
-	);
+	// Les transitions ne sont jamais parcourues dans un ordre particulier :
+	// une table de hachage suffit et accélère delta() et voisins().
+	automate->transitions = xmalloc( sizeof(Table_transitions) );
+	initialiser_table_transitions( automate->transitions );
 	automate->initiaux = creer_ensemble( NULL, NULL, NULL );
 	automate->finaux = creer_ensemble( NULL, NULL, NULL );
 	automate->vide = creer_ensemble( NULL, NULL, NULL ); 
+	utiliser_arene( precedente );
 	return automate;
 }
 
+Automate * creer_automate(){
+	return initialiser_automate( NULL );
+}
+
+Automate * creer_automate_dans_une_arene(){
+	return initialiser_automate( creer_arene() );
+}
+
+/* Crée un automate vide, dans une nouvelle arène si 'modele' est dans une 
+ arène. */
+static Automate * creer_automate_semblable( const Automate* modele ){
+	return modele->arene ? creer_automate_dans_une_arene() : creer_automate();
+}
+
 Automate * translater_automate_entier( const Automate* automate, int translation ){
-	Automate * res = creer_automate();
+	Automate * res = creer_automate_semblable( automate );
 
 	Ensemble_iterateur it;
 	for( 
@@ -150,15 +141,16 @@ Automate * translater_automate_entier( const Automate* automate, int translation
 		ajouter_lettre( res, (char) get_element( it ) );
 	}
 
-	Table_iterateur it1;
+	const Table_transitions* transitions = automate->transitions;
+	size_t i;
 	Ensemble_iterateur it2;
 	for(
-		it1 = premier_iterateur_table( automate->transitions );
-		! iterateur_est_vide( it1 );
-		it1 = iterateur_suivant_table( it1 )
+		i = suivante_table_transitions( transitions, 0 );
+		i < transitions->capacite;
+		i = suivante_table_transitions( transitions, i + 1 )
 	){
-		Cle * cle = (Cle*) get_cle( it1 );
-		Ensemble * fins = (Ensemble*) get_valeur( it1 );
+		Cle cle = decoder_cle( transitions->cases[i].cle );
+		const Ensemble * fins = transitions->cases[i].valeur;
 		for(
 			it2 = premier_iterateur_ensemble( fins );
 			! iterateur_ensemble_est_vide( it2 );
@@ -166,7 +158,7 @@ Automate * translater_automate_entier( const Automate* automate, int translation
 		){
 			int fin = get_element( it2 );
 			ajouter_transition(
-				res, cle->origine + translation, cle->lettre, fin + translation
+				res, cle.origine + translation, cle.lettre, fin + translation
 			);
 		}
 	};
@@ -177,13 +169,25 @@ Automate * translater_automate_entier( const Automate* automate, int translation
 
 void liberer_automate( Automate * automate ){
 	assert( automate );
+	if( automate->arene ){
+		// L'automate lui-même est dans l'arène.
+		liberer_arene( automate->arene );
+		return;
+	}
 	liberer_ensemble( automate->vide );
 	liberer_ensemble( automate->finaux );
 	liberer_ensemble( automate->initiaux );
-	pour_toute_valeur_table(
-		automate->transitions, ( void(*)(intptr_t) ) liberer_ensemble
-	);
-	liberer_table( automate->transitions );
+	Table_transitions* transitions = automate->transitions;
+	size_t i;
+	for(
+		i = suivante_table_transitions( transitions, 0 );
+		i < transitions->capacite;
+		i = suivante_table_transitions( transitions, i + 1 )
+	){
+		liberer_ensemble( transitions->cases[i].valeur );
+	}
+	liberer_table_transitions( transitions );
+	xfree( transitions );
 	liberer_ensemble( automate->alphabet );
 	liberer_ensemble( automate->etats );
 	xfree(automate);
@@ -205,12 +209,20 @@ const Ensemble * get_alphabet( const Automate* automate ){
 	return automate->alphabet;
 }
 
+/*
+ * Les fonctions qui modifient un automate allouent dans son arène (ou hors
+ * de toute arène), quelle que soit l'arène utilisée par l'appelant.
+ */
 void ajouter_etat( Automate * automate, int etat ){
+	Arene* precedente = utiliser_arene( automate->arene );
 	ajouter_element( automate->etats, etat );
+	utiliser_arene( precedente );
 }
 
 void ajouter_lettre( Automate * automate, char lettre ){
+	Arene* precedente = utiliser_arene( automate->arene );
 	ajouter_element( automate->alphabet, lettre );
+	utiliser_arene( precedente );
 }
 
 void ajouter_transition(
@@ -220,42 +232,40 @@ void ajouter_transition(
 	ajouter_etat( automate, fin );
 	ajouter_lettre( automate, lettre );
 
-	Cle cle;
-	initialiser_cle( &cle, origine, lettre );
-	Table_iterateur it = trouver_table( automate->transitions, (intptr_t) &cle );
-	Ensemble * ens;
-	if( iterateur_est_vide( it ) ){
-		ens = creer_ensemble( NULL, NULL, NULL );
-		add_table( automate->transitions, (intptr_t) &cle, (intptr_t) ens );
-	}else{
-		ens = (Ensemble*) get_valeur( it );
+	Arene* precedente = utiliser_arene( automate->arene );
+	Ensemble** fins = obtenir_table_transitions(
+		automate->transitions, cle_de_transition( origine, lettre )
+	);
+	if( ! *fins ){
+		*fins = creer_ensemble( NULL, NULL, NULL );
 	}
-	ajouter_element( ens, fin );
+	ajouter_element( *fins, fin );
+	utiliser_arene( precedente );
 }
 
 void ajouter_etat_final(
 	Automate * automate, int etat_final
 ){
 	ajouter_etat( automate, etat_final );
+	Arene* precedente = utiliser_arene( automate->arene );
 	ajouter_element( automate->finaux, etat_final );
+	utiliser_arene( precedente );
 }
 
 void ajouter_etat_initial(
 	Automate * automate, int etat_initial
 ){
 	ajouter_etat( automate, etat_initial );
+	Arene* precedente = utiliser_arene( automate->arene );
 	ajouter_element( automate->initiaux, etat_initial );
+	utiliser_arene( precedente );
 }
 
 const Ensemble * voisins( const Automate* automate, int origine, char lettre ){
-	Cle cle;
-	initialiser_cle( &cle, origine, lettre );
-	Table_iterateur it = trouver_table( automate->transitions, (intptr_t) &cle );
-	if( ! iterateur_est_vide( it ) ){
-		return (Ensemble*) get_valeur( it );
-	}else{
-		return automate->vide;
-	}
+	Ensemble** fins = trouver_table_transitions(
+		automate->transitions, cle_de_transition( origine, lettre )
+	);
+	return fins ? *fins : automate->vide;
 }
 
 Ensemble * delta1(
@@ -271,6 +281,10 @@ Ensemble * delta(
 ){
 	Ensemble * res = creer_ensemble( NULL, NULL, NULL );
 
+	// Les ensembles d'arrivée sont réunis dans un nouvel ensemble : 
+	// l'automate n'est que lu, et peut l'être par plusieurs threads à la 
+	// fois. Quand les ensembles sont des tableaux de bits, le premier est 
+	// recopié et les suivants sont ajoutés mot par mot.
 	Ensemble_iterateur it;
 	for( 
 		it = premier_iterateur_ensemble( etats_courants );
@@ -306,79 +320,58 @@ void pour_toute_transition(
 	void (* action )( int origine, char lettre, int fin, void* data ),
 	void* data
 ){
-	Table_iterateur it1;
+	const Table_transitions* transitions = automate->transitions;
+	size_t i;
 	Ensemble_iterateur it2;
 	for(
-		it1 = premier_iterateur_table( automate->transitions );
-		! iterateur_est_vide( it1 );
-		it1 = iterateur_suivant_table( it1 )
+		i = suivante_table_transitions( transitions, 0 );
+		i < transitions->capacite;
+		i = suivante_table_transitions( transitions, i + 1 )
 	){
-		Cle * cle = (Cle*) get_cle( it1 );
-		Ensemble * fins = (Ensemble*) get_valeur( it1 );
+		Cle cle = decoder_cle( transitions->cases[i].cle );
+		const Ensemble * fins = transitions->cases[i].valeur;
 		for(
 			it2 = premier_iterateur_ensemble( fins );
 			! iterateur_ensemble_est_vide( it2 );
 			it2 = iterateur_suivant_ensemble( it2 )
 		){
 			int fin = get_element( it2 );
-			action( cle->origine, cle->lettre, fin, data );
+			action( cle.origine, cle.lettre, fin, data );
 		}
 	};
 }
 
 Automate* copier_automate( const Automate* automate ){
-	Automate * res = creer_automate();
-	Ensemble_iterateur it1;
-	// On ajoute les états de l'automate
-	for(
-		it1 = premier_iterateur_ensemble( get_etats( automate ) );
-		! iterateur_ensemble_est_vide( it1 );
-		it1 = iterateur_suivant_ensemble( it1 )
-	){
-		ajouter_etat( res, get_element( it1 ) );
+	Arene* arene = automate->arene ? creer_arene() : NULL;
+	Arene* precedente = utiliser_arene( arene );
+	Automate * res = xmalloc( sizeof(Automate) );
+	res->arene = arene;
+	res->etats = copier_ensemble( get_etats( automate ) );
+	res->alphabet = copier_ensemble( get_alphabet( automate ) );
+	res->initiaux = copier_ensemble( get_initiaux( automate ) );
+	res->finaux = copier_ensemble( get_finaux( automate ) );
+	res->vide = creer_ensemble( NULL, NULL, NULL );
+	// La table des transitions est dupliquée telle quelle, case par case ; 
+	// seuls les ensembles d'arrivée, qui appartiennent à l'automate, sont 
+	// copiés.
+	const Table_transitions* transitions = automate->transitions;
+	res->transitions = xmalloc( sizeof(Table_transitions) );
+	*res->transitions = *transitions;
+	if( transitions->capacite ){
+		size_t octets = transitions->capacite * sizeof(Table_transitions_case);
+		res->transitions->cases = xmalloc( octets );
+		memcpy( res->transitions->cases, transitions->cases, octets );
 	}
-	// On ajoute les états initiaux
+	size_t i;
 	for(
-		it1 = premier_iterateur_ensemble( get_initiaux( automate ) );
-		! iterateur_ensemble_est_vide( it1 );
-		it1 = iterateur_suivant_ensemble( it1 )
+		i = suivante_table_transitions( res->transitions, 0 );
+		i < res->transitions->capacite;
+		i = suivante_table_transitions( res->transitions, i + 1 )
 	){
-		ajouter_etat_initial( res, get_element( it1 ) );
-	}
-	// On ajoute les états finaux
-	for(
-		it1 = premier_iterateur_ensemble( get_finaux( automate ) );
-		! iterateur_ensemble_est_vide( it1 );
-		it1 = iterateur_suivant_ensemble( it1 )
-	){
-		ajouter_etat_final( res, get_element( it1 ) );
-	}
-	// On ajoute les lettres
-	for(
-		it1 = premier_iterateur_ensemble( get_alphabet( automate ) );
-		! iterateur_ensemble_est_vide( it1 );
-		it1 = iterateur_suivant_ensemble( it1 )
-	){
-		ajouter_lettre( res, (char) get_element( it1 ) );
-	}
-	// On ajoute les transitions
-	Table_iterateur it2;
-	for(
-		it2 = premier_iterateur_table( automate->transitions );
-		! iterateur_est_vide( it2 );
-		it2 = iterateur_suivant_table( it2 )
-	){
-		Cle * cle = (Cle*) get_cle( it2 );
-		Ensemble * fins = (Ensemble*) get_valeur( it2 );
-		for(
-			it1 = premier_iterateur_ensemble( fins );
-			! iterateur_ensemble_est_vide( it1 );
-			it1 = iterateur_suivant_ensemble( it1 )
-		){
-			int fin = get_element( it1 );
-			ajouter_transition( res, cle->origine, cle->lettre, fin );
-		}
+		res->transitions->cases[i].valeur = 
+			copier_ensemble( res->transitions->cases[i].valeur );
 	}
+	utiliser_arene( precedente );
 	return res;
 }
 
@@ -386,8 +379,8 @@ Automate * translater_automate(
 	const Automate * automate, const Automate * automate_a_eviter
 ){
 	if(
-		taille_ensemble( get_etats(automate) ) == 0 ||
-		taille_ensemble( get_etats(automate_a_eviter) ) == 0
+		ensemble_est_vide( get_etats(automate) ) ||
+		ensemble_est_vide( get_etats(automate_a_eviter) )
 	){
 		return copier_automate( automate );
     }
@@ -419,10 +412,6 @@ int est_une_lettre_de_l_automate( const Automate* automate, char lettre ){
 	return est_dans_l_ensemble( get_alphabet( automate ), lettre );
 }
 
-void print_ensemble_2( const intptr_t ens ){
-	print_ensemble( (Ensemble*) ens, NULL );
-}
-
 void print_lettre( intptr_t c ){
 	printf("%c", (char) c );
 }
@@ -436,32 +425,26 @@ void print_automate( const Automate * automate ){
 	print_ensemble( get_finaux( automate ), NULL );
 	printf("\n- Alphabet : ");
 	print_ensemble( get_alphabet( automate ), print_lettre );
-	printf("\n- Transitions : ");
-	print_table( 
-		automate->transitions,
-		( void (*)( const intptr_t ) ) print_cle, 
-		( void (*)( const intptr_t ) ) print_ensemble_2,
-		""
-	);
-	printf("\n");
+	printf("\n- Transitions : { ");
+	const Table_transitions* transitions = automate->transitions;
+	size_t i;
+	for(
+		i = suivante_table_transitions( transitions, 0 );
+		i < transitions->capacite;
+		i = suivante_table_transitions( transitions, i + 1 )
+	){
+		Cle cle = decoder_cle( transitions->cases[i].cle );
+		print_cle( &cle );
+		printf( " --> " );
+		print_ensemble( transitions->cases[i].valeur, NULL );
+		printf( ", " );
+	}
+	printf(" }\n");
 }
 
 int le_mot_est_reconnu( const Automate* automate, const char* mot ){
 	Ensemble * arrivee = delta_star( automate, get_initiaux(automate) , mot ); 
-	
-	int result = 0;
-
-	Ensemble_iterateur it;
-	for(
-		it = premier_iterateur_ensemble( arrivee );
-		! iterateur_ensemble_est_vide( it );
-		it = iterateur_suivant_ensemble( it )
-	){
-		if( est_un_etat_final_de_l_automate( automate, get_element(it) ) ){
-			result = 1;
-			break;
-		}
-	}
+	int result = ensembles_se_coupent( arrivee, get_finaux( automate ) );
 	liberer_ensemble( arrivee );
 	return result;
 }
@@ -509,94 +492,202 @@ void action_ajouter_transition(int origine, char lettre, int fin, void* data){
 }
 
 // Creer un automate a qui est l'union de automate_1 et automate_2
-// manque à gérer le cas de l'ensemble vide dans l'automate
 Automate * creer_union_des_automates(const Automate * automate_1, const Automate * automate_2){
     Automate* a = copier_automate(automate_1);
-    Ensemble* new_etats = copier_ensemble(get_initiaux(automate_2));
-    pour_tout_element(new_etats, action_ajouter_etats_initiaux, a);
-    new_etats = copier_ensemble(get_finaux(automate_2));
-    pour_tout_element(new_etats, action_ajouter_etats_finaux, a);
-    new_etats = copier_ensemble(get_etats(automate_2));
-    pour_tout_element(new_etats, action_ajouter_etats, a);
-
-    new_etats = copier_ensemble(get_alphabet(automate_2));
-    pour_tout_element(new_etats, action_ajouter_alphabet, a);
+    // Les ensembles de automate_2 sont seulement lus : inutile de les copier.
+    pour_tout_element(get_initiaux(automate_2), action_ajouter_etats_initiaux, a);
+    pour_tout_element(get_finaux(automate_2), action_ajouter_etats_finaux, a);
+    pour_tout_element(get_etats(automate_2), action_ajouter_etats, a);
+    pour_tout_element(get_alphabet(automate_2), action_ajouter_alphabet, a);
 
     pour_toute_transition(automate_2,action_ajouter_transition, a);
 
     return a;
 }
 
-void action_recuperer_accessibles_etat(intptr_t element, void* data){
-  Automate* a = (Automate*) data;
-  Ensemble* e = copier_ensemble(a->vide);
-  vider_ensemble(a->vide);
+DEFINIR_VECTEUR( Vecteur_etats, vecteur_etats, int32_t )
+
+/* Version de accessibles() pour un automate compact, dont les états 
+ indexent des tableaux. Les successeurs de chaque état, toutes lettres 
+ confondues, sont d'abord rangés dans deux tableaux (lignes creuses 
+ compressées), en un seul parcours de la table des transitions ; le parcours
+ en largeur ne fait ensuite que des accès à des tableaux, et marque les 
+ états atteints dans un tableau de bits. Cette version parcourt toutes les
+ transitions, même celles des états inaccessibles : elle ne sert donc pas à
+ etats_accessibles(), qui part d'un seul état. */
+static Ensemble* accessibles_compact( const Automate * automate ){
+    const Table_transitions* transitions = automate->transitions;
+    size_t nb_etats = taille_ensemble(get_etats(automate));
+    size_t nb_mots = ( nb_etats + BITSET_BITS_PAR_MOT - 1 ) / BITSET_BITS_PAR_MOT;
+    size_t i, m;
+    uint32_t* debuts = xmalloc(( nb_etats + 2 ) * sizeof(uint32_t));
+    memset(debuts, 0, ( nb_etats + 2 ) * sizeof(uint32_t));
+    for(
+        i = suivante_table_transitions(transitions, 0);
+        i < transitions->capacite;
+        i = suivante_table_transitions(transitions, i + 1)
+    ){
+        Cle cle = decoder_cle(transitions->cases[i].cle);
+        debuts[cle.origine + 2] += taille_ensemble(transitions->cases[i].valeur);
+    }
+    for( i=2; i<nb_etats+2; i++ ){
+        debuts[i] += debuts[i-1];
+    }
+    uint32_t* successeurs = xmalloc(( debuts[nb_etats+1] ? debuts[nb_etats+1] : 1 ) * sizeof(uint32_t));
+    Ensemble_iterateur it;
+    for(
+        i = suivante_table_transitions(transitions, 0);
+        i < transitions->capacite;
+        i = suivante_table_transitions(transitions, i + 1)
+    ){
+        Cle cle = decoder_cle(transitions->cases[i].cle);
+        for(
+            it = premier_iterateur_ensemble(transitions->cases[i].valeur);
+            ! iterateur_ensemble_est_vide(it);
+            it = iterateur_suivant_ensemble(it)
+        ){
+            successeurs[debuts[cle.origine + 1]++] = get_element(it);
+        }
+    }
 
-  Ensemble_iterateur it = premier_iterateur_ensemble(e);
-  int etat = get_element(it);
+    uint64_t* atteints = xmalloc(( nb_mots ? nb_mots : 1 ) * sizeof(uint64_t));
+    memset(atteints, 0, nb_mots * sizeof(uint64_t));
+    Vecteur_etats a_visiter;
+    size_t suivant = 0;
+    initialiser_vecteur_etats(&a_visiter);
+    reserver_vecteur_etats(&a_visiter, nb_etats);
+    for(
+        it = premier_iterateur_ensemble(get_initiaux(automate));
+        ! iterateur_ensemble_est_vide(it);
+        it = iterateur_suivant_ensemble(it)
+    ){
+        intptr_t etat = get_element(it);
+        atteints[BITSET_MOT(etat)] |= BITSET_MASQUE(etat);
+        ajouter_vecteur_etats(&a_visiter, etat);
+    }
+    while( suivant < taille_vecteur_etats(&a_visiter) ){
+        int etat = a_visiter.elements[suivant++];
+        uint32_t k;
+        for( k = debuts[etat]; k < debuts[etat+1]; k++ ){
+            uint32_t fin = successeurs[k];
+            if( ! ( atteints[BITSET_MOT(fin)] & BITSET_MASQUE(fin) ) ){
+                atteints[BITSET_MOT(fin)] |= BITSET_MASQUE(fin);
+                ajouter_vecteur_etats(&a_visiter, fin);
+            }
+        }
+    }
 
-  ajouter_elements(a->vide, delta1(a, etat, element));
+    // Les états atteints, lus dans l'ordre croissant, donnent un tableau 
+    // trié : l'ensemble est construit en temps linéaire.
+    intptr_t* tries = xmalloc(( suivant ? suivant : 1 ) * sizeof(intptr_t));
+    size_t nb = 0;
+    for( m=0; m<nb_mots; m++ ){
+        uint64_t mot = atteints[m];
+        while( mot ){
+            tries[nb++] = m * BITSET_BITS_PAR_MOT + __builtin_ctzll(mot);
+            mot &= mot - 1;
+        }
+    }
+    Ensemble* res = creer_ensemble_depuis_tableau(NULL, NULL, NULL, tries, nb);
+    xfree(tries);
+    xfree(atteints);
+    xfree(successeurs);
+    xfree(debuts);
+    liberer_vecteur_etats(&a_visiter);
+    return res;
 }
 
-/* Avec un Ensemble_iterateur, nous parcourons l'alphabet de l'automate passé en paramètre
- Nous avons créé un Ensemble*, etat_acc, pour stocker les états qui sont accessibles à partir de "etat" par au moins une lettre de l'alphabet.
-Pour chaque lettre, on utilise la fonction delat1 qui renvoi un Ensemble d'état accessible depuis "etat" et une lettre.
-Nous envoyons etats_acc.*/
-Ensemble* etats_accessibles( const Automate * automate, int etat ){
-    Automate* a = copier_automate(automate);
-    Ensemble* alp = copier_ensemble(get_alphabet(automate));
-    Ensemble* etats_acc;
-    Ensemble_iterateur it = premier_iterateur_ensemble(alp);
-
-    char lettre = get_element(it);
-
-    etats_acc = copier_ensemble(delta1(a, etat, lettre));
-    it = iterateur_suivant_ensemble(it);
-    while(!iterateur_est_vide(it)){
-        lettre = get_element(it);
-        ajouter_elements(etats_acc, delta1(a, etat, lettre));
-        it = iterateur_suivant_ensemble(it);
+/* Parcours en largeur de l'automate à partir des états de 'depart' : renvoie
+ l'ensemble des états que l'on atteint en lisant un mot quelconque, y compris
+ le mot vide. Chaque état n'entre qu'une fois dans la file. */
+static Ensemble* etats_atteints( const Automate * automate, const Ensemble * depart ){
+    Ensemble* atteints = copier_ensemble(depart);
+    // Chaque état entre au plus une fois dans la file : un tableau d'états,
+    // lu dans l'ordre où les états y sont ajoutés, suffit.
+    Vecteur_etats a_visiter;
+    size_t suivant = 0;
+    initialiser_vecteur_etats(&a_visiter);
+    reserver_vecteur_etats(&a_visiter, taille_ensemble(get_etats(automate)) + taille_ensemble(depart));
+    Ensemble_iterateur it;
+    for(
+        it = premier_iterateur_ensemble(depart);
+        ! iterateur_ensemble_est_vide(it);
+        it = iterateur_suivant_ensemble(it)
+    ){
+        ajouter_vecteur_etats(&a_visiter, get_element(it));
     }
-    
-    return etats_acc;
+    while( suivant < taille_vecteur_etats(&a_visiter) ){
+        int etat = a_visiter.elements[suivant++];
+        Ensemble_iterateur lettre;
+        for(
+            lettre = premier_iterateur_ensemble(get_alphabet(automate));
+            ! iterateur_ensemble_est_vide(lettre);
+            lettre = iterateur_suivant_ensemble(lettre)
+        ){
+            const Ensemble* fins = voisins(automate, etat, get_element(lettre));
+            for(
+                it = premier_iterateur_ensemble(fins);
+                ! iterateur_ensemble_est_vide(it);
+                it = iterateur_suivant_ensemble(it)
+            ){
+                if( ! est_dans_l_ensemble(atteints, get_element(it)) ){
+                    ajouter_element(atteints, get_element(it));
+                    ajouter_vecteur_etats(&a_visiter, get_element(it));
+                }
+            }
+        }
+    }
+    liberer_vecteur_etats(&a_visiter);
+    return atteints;
 }
 
-// On récupère l'ensemble d'états accessibles pour une lettre et l'ensemble d'états initiaux
-// On stocke dans le champs vide de l'automate les ensembles que renvoit delta.
-void action_recuperer_accessibles(intptr_t element, void* data){
-    Automate* a = (Automate*) data;
-    Ensemble* ens = copier_ensemble(get_initiaux(a));
-    ajouter_elements(a->vide, delta(a, ens, element));
+Ensemble* etats_accessibles( const Automate * automate, int etat ){
+    Ensemble* depart = creer_ensemble(NULL, NULL, NULL);
+    ajouter_element(depart, etat);
+    Ensemble* etats_acc = etats_atteints(automate, depart);
+    liberer_ensemble(depart);
+    return etats_acc;
 }
 
-/* Pour chaque lettre de l'alphabet, on appelle action_recuperer_accessibles
- Afin de recupérer un ensemble avec tous les états accessibles pour chaque lettre de l'alphabet de l'automate.
- Pour récupérer cet ensemble on utilise le champs vide de l'automate en s'assurant d'y remettre son contenu à la fin. */
 Ensemble* accessibles( const Automate * automate ){
-    Automate* a = copier_automate(automate);
-    Ensemble* alp = copier_ensemble(get_alphabet(automate));
-    Ensemble* old_vide = copier_ensemble(a->vide);
-    Ensemble* result;
+    if( automate_est_compact(automate) ){
+        return accessibles_compact(automate);
+    }
+    return etats_atteints(automate, get_initiaux(automate));
+}
 
-    pour_tout_element(alp, action_recuperer_accessibles, a);
-    result = copier_ensemble(a->vide);
-    vider_ensemble( a->vide);
-    deplacer_ensemble(a->vide, old_vide);
+typedef struct {
+    Automate* automate;
+    const Ensemble* etats;
+} data_automate_accessible_t;
 
-    return result;
+void action_ajouter_transition_accessible(int origine, char lettre, int fin, void* data){
+    data_automate_accessible_t* d = (data_automate_accessible_t*) data;
+    if( est_dans_l_ensemble(d->etats, origine) ){
+        ajouter_transition(d->automate, origine, lettre, fin);
+    }
 }
 
-/* On utilise la fonction creer_difference_ensemble afin d'obtenir les états non accessibles de l'automate
-  On remplace dans la copie de l'automate a l'ensemble d'états par les états non accessibles
- On utilise la fonction translater_automate sur automate et a afin que l'automate accessible ait les états de automate mais évite ceux de a(les non accessibles).*/
+/* L'automate accessible garde l'alphabet, les états accessibles, les états 
+ initiaux et finaux accessibles, et les transitions qui partent d'un état
+ accessible (leur état d'arrivée l'est alors aussi). */
 Automate *automate_accessible( const Automate * automate ){
-    Automate* a = copier_automate(automate);
+    Automate* a = creer_automate_semblable(automate);
     Ensemble* etat_acc = accessibles(automate);
-    Ensemble* etat_non_acc = creer_difference_ensemble(get_etats(automate), etat_acc);
-
-    transferer_elements(a->etats, etat_non_acc);
-    Automate* accessible = translater_automate(automate, a);
-    return accessible;
+    data_automate_accessible_t data;
+    data.automate = a;
+    data.etats = etat_acc;
+
+    pour_tout_element(etat_acc, action_ajouter_etats, a);
+    pour_tout_element(get_initiaux(automate), action_ajouter_etats_initiaux, a);
+    Ensemble* finaux = creer_intersection_ensemble(get_finaux(automate), etat_acc);
+    pour_tout_element(finaux, action_ajouter_etats_finaux, a);
+    pour_tout_element(get_alphabet(automate), action_ajouter_alphabet, a);
+    pour_toute_transition(automate, action_ajouter_transition_accessible, &data);
+
+    liberer_ensemble(finaux);
+    liberer_ensemble(etat_acc);
+    return a;
 }
 
 // Ajoute les transitions d'un premier automate à un second en inversant l'origine et la fin des transitions
@@ -607,20 +698,12 @@ void action_ajouter_transition_inverse(int origine, char lettre, int fin, void*
 
 /* On crée un automate 'a' qui a les états initiaux et finaux inverse de l'automate passé en paramètre. On lui ajoute le meme alphabet et les memes états que l'automate de départ (celui passé en paramètre). Pour chaque transition de l'automate de départ, on applqiue la fonction action_ajouter_transition_inverse à celle ci, ainsi on obtient une transition inversée ( 1 --a--> 2 devient alors 2 --a--> 1).   */ 
 Automate *miroir( const Automate * automate){
-  Automate* a = creer_automate();
-  Ensemble* ens;
-  
-  ens = copier_ensemble(get_initiaux(automate));
-  pour_tout_element(ens, action_ajouter_etats_finaux, a);
-  
-  ens = copier_ensemble(get_finaux(automate));
-  pour_tout_element(ens, action_ajouter_etats_initiaux, a);
-  
-  ens = copier_ensemble(get_alphabet(automate));
-  pour_tout_element(ens, action_ajouter_alphabet, a);
-  
-  ens = copier_ensemble(get_etats(automate));
-  pour_tout_element(ens, action_ajouter_etats, a);
+  Automate* a = creer_automate_semblable(automate);
+
+  pour_tout_element(get_initiaux(automate), action_ajouter_etats_finaux, a);
+  pour_tout_element(get_finaux(automate), action_ajouter_etats_initiaux, a);
+  pour_tout_element(get_alphabet(automate), action_ajouter_alphabet, a);
+  pour_tout_element(get_etats(automate), action_ajouter_etats, a);
   
   pour_toute_transition(automate, action_ajouter_transition_inverse, a);
   
@@ -652,24 +735,22 @@ Automate *miroir( const Automate * automate){
 */
 Automate * creer_automate_du_melange(const Automate* automate_1,  const Automate* automate_2){ 
   
-  Ensemble* alphabet1 = copier_ensemble(get_alphabet(automate_1));
-  Ensemble* alphabet2 = copier_ensemble(get_alphabet(automate_2));
-  Ensemble* alphabet = creer_union_ensemble(alphabet1, alphabet2);
+  Ensemble* alphabet = creer_union_ensemble(get_alphabet(automate_1), get_alphabet(automate_2));
   
-  Ensemble* init1 = copier_ensemble(get_initiaux(automate_1));
-  Ensemble* init2 = copier_ensemble(get_initiaux(automate_2));
+  const Ensemble* init1 = get_initiaux(automate_1);
+  const Ensemble* init2 = get_initiaux(automate_2);
   Ensemble_iterateur it_init1 = premier_iterateur_ensemble(init1);
   Ensemble_iterateur it_init2 = premier_iterateur_ensemble(init2);
   
-  Ensemble* final1 = copier_ensemble(get_finaux(automate_1));
-  Ensemble* final2 = copier_ensemble(get_finaux(automate_2));
+  const Ensemble* final1 = get_finaux(automate_1);
+  const Ensemble* final2 = get_finaux(automate_2);
   Ensemble_iterateur it_final1 = premier_iterateur_ensemble(final1);
   Ensemble_iterateur it_final2 = premier_iterateur_ensemble(final2);
 
-  Automate* autMelange = creer_automate();
+  Automate* autMelange = creer_automate_semblable(automate_1);
   /* Ajouts etats initiaux */
-  while(!iterateur_est_vide(it_init1)){
-    while(!iterateur_est_vide(it_init2)){
+  while(!iterateur_ensemble_est_vide(it_init1)){
+    while(!iterateur_ensemble_est_vide(it_init2)){
       ajouter_etat_initial(autMelange, get_element(it_init1) * 10 + get_element(it_init2));
       it_init2 = iterateur_suivant_ensemble(it_init2);
     }
@@ -677,8 +758,8 @@ Automate * creer_automate_du_melange(const Automate* automate_1,  const Automate
     it_init1 = iterateur_suivant_ensemble(it_init1);
   }
   /* Ajouts etats finaux */
-  while(!iterateur_est_vide(it_final1)){
-    while(!iterateur_est_vide(it_final2)){
+  while(!iterateur_ensemble_est_vide(it_final1)){
+    while(!iterateur_ensemble_est_vide(it_final2)){
       ajouter_etat_final(autMelange, get_element(it_final1) * 10 + get_element(it_final2));
       it_final2 = iterateur_suivant_ensemble(it_final2);
     }
@@ -686,11 +767,11 @@ Automate * creer_automate_du_melange(const Automate* automate_1,  const Automate
     it_final1 = iterateur_suivant_ensemble(it_final1);
   }
     
-  Ensemble* etats1 = copier_ensemble(get_etats(automate_1));
+  const Ensemble* etats1 = get_etats(automate_1);
   Ensemble_iterateur it_etat1 = premier_iterateur_ensemble(etats1); 
   Ensemble_iterateur it_alphabet, it_etat_access1;
   
-  Ensemble* etats2 = copier_ensemble(get_etats(automate_2));
+  const Ensemble* etats2 = get_etats(automate_2);
   Ensemble_iterateur it_etat2, it_etat_access2;
   
   char lettre;
@@ -699,29 +780,29 @@ Automate * creer_automate_du_melange(const Automate* automate_1,  const Automate
  /* On obtient un etat de la forme 10 ou 11, le premier chiffre représente l'état de l'automate 1, le second celui du deuxième automate */
 
   /* Parcours de l'automate 1 */  
-  while(!iterateur_est_vide(it_etat1)){
+  while(!iterateur_ensemble_est_vide(it_etat1)){
 
     etat1 = get_element(it_etat1);
     it_alphabet = premier_iterateur_ensemble(alphabet);
 
-    while(!iterateur_est_vide(it_alphabet)){
+    while(!iterateur_ensemble_est_vide(it_alphabet)){
 
       lettre = get_element(it_alphabet);
       it_etat_access1 = premier_iterateur_ensemble(etats1);
 
-      while(!iterateur_est_vide(it_etat_access1)){
+      while(!iterateur_ensemble_est_vide(it_etat_access1)){
 
 	etat_access1 = get_element(it_etat_access1);
 
 	  if(est_une_transition_de_l_automate(automate_1, etat1, lettre, etat_access1)){
 	    it_etat2 = premier_iterateur_ensemble(etats2);
 
-	    while(!iterateur_est_vide(it_etat2)){
+	    while(!iterateur_ensemble_est_vide(it_etat2)){
 
 	      etat2 = get_element(it_etat2);
 	      it_etat_access2 = premier_iterateur_ensemble(etats2);
 
-	      while(!iterateur_est_vide(it_etat_access2)){
+	      while(!iterateur_ensemble_est_vide(it_etat_access2)){
 
 		etat_access2 = get_element(it_etat_access2);
 
@@ -748,29 +829,29 @@ Automate * creer_automate_du_melange(const Automate* automate_1,  const Automate
   
   it_etat2 = premier_iterateur_ensemble(etats2);
 
-  while(!iterateur_est_vide(it_etat2)){
+  while(!iterateur_ensemble_est_vide(it_etat2)){
 
     etat2 = get_element(it_etat2);
     it_alphabet = premier_iterateur_ensemble(alphabet);
 
-    while(!iterateur_est_vide(it_alphabet)){
+    while(!iterateur_ensemble_est_vide(it_alphabet)){
 
       lettre = get_element(it_alphabet);
       it_etat_access2 = premier_iterateur_ensemble(etats2);
 
-      while(!iterateur_est_vide(it_etat_access2)){
+      while(!iterateur_ensemble_est_vide(it_etat_access2)){
 
 	etat_access2 = get_element(it_etat_access2);
 
 	  if(est_une_transition_de_l_automate(automate_2, etat2, lettre, etat_access2)){
 	    it_etat1 = premier_iterateur_ensemble(etats1);
 
-	    while(!iterateur_est_vide(it_etat1)){
+	    while(!iterateur_ensemble_est_vide(it_etat1)){
 
 	      etat1 = get_element(it_etat1);
 	      it_etat_access1 = premier_iterateur_ensemble(etats1);
 
-	      while(!iterateur_est_vide(it_etat_access1)){
+	      while(!iterateur_ensemble_est_vide(it_etat_access1)){
 
 		etat_access1 = get_element(it_etat_access1);
 
@@ -793,7 +874,157 @@ Automate * creer_automate_du_melange(const Automate* automate_1,  const Automate
     it_etat2 = iterateur_suivant_ensemble(it_etat2);
   }
 
+  liberer_ensemble(alphabet);
   return autMelange;
 }
 
+int nouveau_numero( const Renumerotation* renumerotation, int ancien ){
+	int debut = 0;
+	int fin = renumerotation->nb_etats;
+	while( debut < fin ){
+		int milieu = debut + ( fin - debut ) / 2;
+		if( renumerotation->anciens[milieu] < ancien ){
+			debut = milieu + 1;
+		}else{
+			fin = milieu;
+		}
+	}
+	if( debut < renumerotation->nb_etats && renumerotation->anciens[debut] == ancien ){
+		return debut;
+	}
+	return -1;
+}
 
+void liberer_renumerotation( Renumerotation* renumerotation ){
+	xfree( renumerotation->anciens );
+	renumerotation->anciens = NULL;
+	renumerotation->nb_etats = 0;
+}
+
+int automate_est_compact( const Automate* automate ){
+	if( ensemble_est_vide( automate->etats ) ) return 1;
+	return min_ensemble( automate->etats ) == 0
+		&& max_ensemble( automate->etats ) == 
+			(intptr_t) taille_ensemble( automate->etats ) - 1;
+}
+
+/*
+ * Les nouveaux numéros des états, pour creer_automate_compact(). Quand les
+ * anciens états sont assez serrés (au plus 8 entiers par état), 
+ * directement le nouveau numéro ; sinon 'nouveaux' vaut NULL et le numéro
+ * est cherché par dichotomie (voir nouveau_numero()).
+ */
+typedef struct {
+	const Renumerotation* renumerotation;
+	int premier;
+	int* nouveaux;
+} Index_renumerotation;
+
+static void indexer_renumerotation(
+	Index_renumerotation* index, const Renumerotation* r
+){
+	index->renumerotation = r;
+	index->premier = 0;
+	index->nouveaux = NULL;
+	if( r->nb_etats == 0 ) return;
+	int64_t etendue = (int64_t) r->anciens[ r->nb_etats - 1 ] - r->anciens[0] + 1;
+	if( etendue > 8 * (int64_t) r->nb_etats ) return;
+	index->premier = r->anciens[0];
+	index->nouveaux = xmalloc( etendue * sizeof(int) );
+	int i;
+	for( i=0; i<r->nb_etats; i++ ){
+		index->nouveaux[ r->anciens[i] - index->premier ] = i;
+	}
+}
+
+static int numero_indexe( const Index_renumerotation* index, int ancien ){
+	if( index->nouveaux ){
+		return index->nouveaux[ ancien - index->premier ];
+	}
+	return nouveau_numero( index->renumerotation, ancien );
+}
+
+/*
+ * Renvoie un nouvel ensemble qui contient les nouveaux numéros des états de
+ * 'etats'. La renumérotation conserve l'ordre : le tableau reste trié, et
+ * l'ensemble est construit en temps linéaire. 'tampon' doit pouvoir 
+ * contenir taille_ensemble( etats ) éléments.
+ */
+static Ensemble* renumeroter_ensemble(
+	const Ensemble* etats, const Index_renumerotation* index, intptr_t* tampon
+){
+	unsigned int nb = ensemble_vers_tableau( etats, tampon );
+	unsigned int i;
+	for( i=0; i<nb; i++ ){
+		tampon[i] = numero_indexe( index, tampon[i] );
+	}
+	return creer_ensemble_depuis_tableau( NULL, NULL, NULL, tampon, nb );
+}
+
+Automate* creer_automate_compact(
+	const Automate* automate, Renumerotation* renumerotation
+){
+	Renumerotation r;
+	int i;
+	r.nb_etats = taille_ensemble( automate->etats );
+	r.anciens = xmalloc( ( r.nb_etats ? r.nb_etats : 1 ) * sizeof(int) );
+	intptr_t* tampon = xmalloc( ( r.nb_etats ? r.nb_etats : 1 ) * sizeof(intptr_t) );
+	ensemble_vers_tableau( automate->etats, tampon );
+	for( i=0; i<r.nb_etats; i++ ){
+		r.anciens[i] = tampon[i];
+	}
+	Index_renumerotation index;
+	indexer_renumerotation( &index, &r );
+
+	// Tous les ensembles de l'automate compact sont construits d'un bloc à
+	// partir de tableaux triés, sans passer par ajouter_transition().
+	Automate* compact = creer_automate_semblable( automate );
+	Arene* precedente = utiliser_arene( compact->arene );
+	for( i=0; i<r.nb_etats; i++ ){
+		tampon[i] = i;
+	}
+	liberer_ensemble( compact->etats );
+	compact->etats = creer_ensemble_depuis_tableau(
+		NULL, NULL, NULL, tampon, r.nb_etats
+	);
+	liberer_ensemble( compact->alphabet );
+	compact->alphabet = copier_ensemble( automate->alphabet );
+	liberer_ensemble( compact->initiaux );
+	compact->initiaux = renumeroter_ensemble( automate->initiaux, &index, tampon );
+	liberer_ensemble( compact->finaux );
+	compact->finaux = renumeroter_ensemble( automate->finaux, &index, tampon );
+
+	// La renumérotation est injective : les clés restent distinctes et sont
+	// placées directement, dans une table de même capacité que celle de 
+	// l'automate.
+	const Table_transitions* transitions = automate->transitions;
+	Table_transitions* table = compact->transitions;
+	if( transitions->nb_elements ){
+		redimensionner_table_transitions( table, transitions->capacite );
+	}
+	size_t k;
+	for(
+		k = suivante_table_transitions( transitions, 0 );
+		k < transitions->capacite;
+		k = suivante_table_transitions( transitions, k + 1 )
+	){
+		Cle cle = decoder_cle( transitions->cases[k].cle );
+		Table_transitions_case c;
+		memset( &c, 0, sizeof(c) );
+		c.cle = cle_de_transition( numero_indexe( &index, cle.origine ), cle.lettre );
+		c.hache = CONTENEURS_HACHER_ENTIER( c.cle );
+		c.valeur = renumeroter_ensemble( transitions->cases[k].valeur, &index, tampon );
+		placer_table_transitions( table, c );
+		table->nb_elements++;
+	}
+	utiliser_arene( precedente );
+	xfree( index.nouveaux );
+	xfree( tampon );
+
+	if( renumerotation ){
+		*renumerotation = r;
+	}else{
+		liberer_renumerotation( &r );
+	}
+	return compact;
+}
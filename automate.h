@@ -25,6 +25,11 @@
 
 #include "ensemble.h"
 
+typedef struct Arene Arene;
+
+/* La table des transitions d'un automate, définie dans automate.c. */
+struct Table_transitions;
+
 /**
  * @brief Le type d'un automate.
  * 
@@ -40,9 +45,12 @@ struct Automate {
     Ensemble * vide; //!<
 	Ensemble * etats;
 	Ensemble * alphabet;
-	Table* transitions;
+	struct Table_transitions* transitions;
 	Ensemble * initiaux;
 	Ensemble * finaux;
+	// L'arène où sont alloués l'automate et tout son contenu, ou NULL si 
+	// l'automate est alloué par xmalloc(). Voir creer_automate_dans_une_arene().
+	Arene* arene;
 };
 
 typedef struct Automate Automate;
@@ -59,6 +67,23 @@ typedef struct Cle {
  */
 Automate * creer_automate();
 
+/**
+ * @brief Crée un automate vide dont toute la mémoire vient d'une arène qui
+ * lui est propre (voir outils.h).
+ *
+ * Construire l'automate ne coûte qu'un découpage de bloc par allocation, et
+ * liberer_automate() rend toute sa mémoire d'un coup, au lieu de libérer 
+ * ses ensembles un par un. En contrepartie, la mémoire que l'automate 
+ * n'utilise plus (par exemple quand un ensemble s'agrandit) n'est rendue 
+ * qu'à sa destruction.
+ *
+ * Les automates construits à partir de cet automate (copie, miroir, union,
+ * ...) ont, eux aussi, leur propre arène.
+ *
+ * @return L'automate créé.
+ */
+Automate * creer_automate_dans_une_arene();
+
 /**
  * @brief Détruit un automate.
  * 
@@ -448,4 +473,65 @@ Automate * creer_union_des_automates(
  */ 
 Automate *miroir( const Automate * automate);
 
+/**
+ * @brief Une renumérotation des états d'un automate.
+ *
+ * Les anciens états reçoivent, dans l'ordre croissant, les numéros 0 à 
+ * nb_etats - 1 : le nouveau numéro d'un état est son rang parmi les états 
+ * de l'automate, et le tableau 'anciens' est trié.
+ */
+typedef struct {
+	int nb_etats;
+	int* anciens; //!< anciens[i] est l'ancien numéro de l'état i.
+} Renumerotation;
+
+/**
+ * @brief Renvoie le nouveau numéro d'un ancien état, en temps logarithmique,
+ *        ou -1 si ce n'est pas un ancien état.
+ */
+int nouveau_numero( const Renumerotation* renumerotation, int ancien );
+
+/**
+ * @brief Libère la mémoire d'une renumérotation.
+ */
+void liberer_renumerotation( Renumerotation* renumerotation );
+
+/**
+ * @brief Renvoie vrai si les états de l'automate sont exactement les entiers
+ *        de 0 à n - 1, où n est le nombre d'états.
+ *
+ * Les états d'un automate compact peuvent indexer des tableaux : certains
+ * algorithmes, comme accessibles(), utilisent alors des tableaux de bits au
+ * lieu d'ensembles. Le test compare la taille de l'ensemble des états à 
+ * son plus petit et à son plus grand élément (voir min_ensemble()) : il se
+ * fait en temps logarithmique si les états sont rangés dans un arbre, mais
+ * il est linéaire, dans le pire des cas, en le nombre de mots d'un tableau
+ * de bits ou d'un bloc compressé.
+ *
+ * @param automate Un automate.
+ * @return 1 ou 0
+ */
+int automate_est_compact( const Automate* automate );
+
+/**
+ * @brief Crée une copie de l'automate dont les états sont renumérotés de 0 à
+ *        n - 1, dans l'ordre croissant (voir Renumerotation).
+ *
+ * L'automate obtenu est compact (voir automate_est_compact()). Si
+ * 'renumerotation' ne vaut pas NULL, la correspondance entre les anciens et
+ * les nouveaux numéros y est écrite ; elle doit ensuite être libérée par
+ * liberer_renumerotation().
+ *
+ * Les numéros des états construits par creer_automate_du_melange() ou par 
+ * translater_automate_entier(), par exemple, ne sont pas compacts : cette 
+ * fonction permet de les rendre compacts.
+ *
+ * @param automate Un automate.
+ * @param renumerotation La renumérotation à remplir, ou NULL.
+ * @return L'automate compact.
+ */
+Automate* creer_automate_compact(
+	const Automate* automate, Renumerotation* renumerotation
+);
+
 #endif
@@ -0,0 +1,566 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "automate_compile.h"
+#include "bitset.h"
+#include "ensemble.h"
+#include "outils.h"
+
+#include <string.h>
+
+#include <assert.h>
+
+/*
+ * Renvoie l'indice de 'etat' dans le tableau trié 'etats', ou -1.
+ */
+static int chercher_etat( const int* etats, int nb_etats, int etat ){
+	int debut = 0;
+	int fin = nb_etats;
+	while( debut < fin ){
+		int milieu = debut + ( fin - debut ) / 2;
+		if( etats[milieu] < etat ){
+			debut = milieu + 1;
+		}else{
+			fin = milieu;
+		}
+	}
+	if( debut < nb_etats && etats[debut] == etat ){
+		return debut;
+	}
+	return -1;
+}
+
+int numero_de_l_etat( const Automate_compile* compile, int etat ){
+	return chercher_etat( compile->etats, compile->nb_etats, etat );
+}
+
+/*
+ * Renvoie le tableau, trié, des états de l'automate, et écrit leur nombre
+ * dans '*nb_etats'.
+ */
+static int* numeroter_etats( const Automate* automate, int* nb_etats ){
+	const Ensemble* etats = get_etats( automate );
+	int i;
+	*nb_etats = taille_ensemble( etats );
+	intptr_t* elements = xmalloc( ( *nb_etats ? *nb_etats : 1 ) * sizeof(intptr_t) );
+	int* res = xmalloc( ( *nb_etats ? *nb_etats : 1 ) * sizeof(int) );
+	ensemble_vers_tableau( etats, elements );
+	for( i=0; i<*nb_etats; i++ ){
+		res[i] = elements[i];
+	}
+	xfree( elements );
+	return res;
+}
+
+/*
+ * Numérote les lettres de l'automate dans l'ordre croissant : écrit dans
+ * numeros[c] le numéro de la lettre (unsigned char) c, ou -1 si c n'est pas
+ * une lettre de l'automate. Renvoie le tableau des lettres, et écrit leur
+ * nombre dans '*nb_lettres'.
+ */
+static char* numeroter_lettres(
+	const Automate* automate, int numeros[256], int* nb_lettres
+){
+	const Ensemble* alphabet = get_alphabet( automate );
+	intptr_t elements[256];
+	int i;
+	*nb_lettres = ensemble_vers_tableau( alphabet, elements );
+	char* res = xmalloc( *nb_lettres ? *nb_lettres : 1 );
+	for( i=0; i<256; i++ ){
+		numeros[i] = -1;
+	}
+	for( i=0; i<*nb_lettres; i++ ){
+		res[i] = elements[i];
+		numeros[ (unsigned char) elements[i] ] = i;
+	}
+	return res;
+}
+
+/*
+ * État de la compilation, partagé par les deux passes sur les transitions.
+ * 'ranger' vaut 0 pendant la première passe, qui compte les transitions de
+ * chaque ligne, et 1 pendant la seconde, qui les range.
+ * 'origine' et 'numero_origine' retiennent le dernier état d'origine
+ * rencontré : pour_toute_transition() donne à la suite toutes les
+ * transitions d'une même origine et d'une même lettre.
+ */
+typedef struct {
+	Automate_compile* compile;
+	int ranger;
+	int origine;
+	int numero_origine;
+} Compilation;
+
+static size_t ligne_de_la_transition(
+	Compilation* compilation, int origine, char lettre
+){
+	Automate_compile* compile = compilation->compile;
+	if( origine != compilation->origine || compilation->numero_origine < 0 ){
+		compilation->origine = origine;
+		compilation->numero_origine = numero_de_l_etat( compile, origine );
+	}
+	int numero_lettre = compile->numeros_lettres[ (unsigned char) lettre ];
+	return (size_t) numero_lettre * compile->nb_etats
+		+ compilation->numero_origine;
+}
+
+/*
+ * Les lignes sont comptées dans debuts[i+2], pour que le remplissage, qui
+ * avance debuts[i+1], laisse dans debuts[i] le début de la ligne i.
+ */
+static void compiler_transition( int origine, char lettre, int fin, void* data ){
+	Compilation* compilation = data;
+	Automate_compile* compile = compilation->compile;
+	size_t ligne = ligne_de_la_transition( compilation, origine, lettre );
+	if( ! compilation->ranger ){
+		compile->debuts[ ligne + 2 ]++;
+		return;
+	}
+	compile->fins[ compile->debuts[ ligne + 1 ]++ ] =
+		numero_de_l_etat( compile, fin );
+}
+
+static uint64_t* etats_vers_bits(
+	const Automate_compile* compile, const Ensemble* etats
+){
+	uint64_t* res = creer_etats_compile( compile );
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( etats );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		int numero = numero_de_l_etat( compile, get_element( it ) );
+		if( numero >= 0 ){
+			res[ BITSET_MOT( numero ) ] |= BITSET_MASQUE( numero );
+		}
+	}
+	return res;
+}
+
+static Ensemble* bits_vers_etats(
+	const Automate_compile* compile, const uint64_t* bits
+){
+	intptr_t* etats = xmalloc(
+		( compile->nb_etats ? compile->nb_etats : 1 ) * sizeof(intptr_t)
+	);
+	unsigned int nb = 0;
+	size_t m;
+	for( m=0; m<compile->nb_mots; m++ ){
+		uint64_t mot = bits[m];
+		while( mot ){
+			etats[nb++] = compile->etats[ m * 64 + __builtin_ctzll( mot ) ];
+			mot &= mot - 1;
+		}
+	}
+	Ensemble* res = creer_ensemble_depuis_tableau( NULL, NULL, NULL, etats, nb );
+	xfree( etats );
+	return res;
+}
+
+uint64_t* creer_etats_compile( const Automate_compile* compile ){
+	size_t taille = ( compile->nb_mots ? compile->nb_mots : 1 ) * sizeof(uint64_t);
+	uint64_t* res = xmalloc( taille );
+	memset( res, 0, taille );
+	return res;
+}
+
+Automate_compile* compiler_automate( const Automate* automate ){
+	Automate_compile* compile = xmalloc( sizeof(Automate_compile) );
+
+	// Les états et les lettres sont numérotés dans l'ordre croissant.
+	compile->etats = numeroter_etats( automate, &compile->nb_etats );
+	compile->lettres = numeroter_lettres(
+		automate, compile->numeros_lettres, &compile->nb_lettres
+	);
+	compile->nb_mots =
+		( compile->nb_etats + BITSET_BITS_PAR_MOT - 1 ) / BITSET_BITS_PAR_MOT;
+
+	// Deux passes sur les transitions : on compte les transitions de chaque
+	// ligne, puis on les range.
+	size_t nb_lignes = (size_t) compile->nb_lettres * compile->nb_etats;
+	compile->debuts = xmalloc( ( nb_lignes + 2 ) * sizeof(uint32_t) );
+	memset( compile->debuts, 0, ( nb_lignes + 2 ) * sizeof(uint32_t) );
+	Compilation compilation = { compile, 0, 0, -1 };
+	pour_toute_transition( automate, compiler_transition, &compilation );
+	size_t ligne;
+	for( ligne = 2; ligne < nb_lignes + 2; ligne++ ){
+		assert( compile->debuts[ligne] <= UINT32_MAX - compile->debuts[ligne-1] );
+		compile->debuts[ligne] += compile->debuts[ligne-1];
+	}
+	uint32_t nb_transitions = compile->debuts[ nb_lignes + 1 ];
+	compile->fins = xmalloc( ( nb_transitions ? nb_transitions : 1 ) * sizeof(uint32_t) );
+	compilation.ranger = 1;
+	compilation.numero_origine = -1;
+	pour_toute_transition( automate, compiler_transition, &compilation );
+
+	compile->initiaux = etats_vers_bits( compile, get_initiaux( automate ) );
+	compile->finaux = etats_vers_bits( compile, get_finaux( automate ) );
+	return compile;
+}
+
+void liberer_automate_compile( Automate_compile* compile ){
+	xfree( compile->etats );
+	xfree( compile->lettres );
+	xfree( compile->debuts );
+	xfree( compile->fins );
+	xfree( compile->initiaux );
+	xfree( compile->finaux );
+	xfree( compile );
+}
+
+/*
+ * Ajoute à 'arrivee', qui doit être vide, les états atteints en lisant la
+ * lettre de numéro 'numero_lettre' depuis les états de 'depart'. Renvoie 0
+ * si 'arrivee' reste vide.
+ */
+static int lire_lettre(
+	const Automate_compile* compile, const uint64_t* depart,
+	int numero_lettre, uint64_t* arrivee
+){
+	const uint32_t* debuts = compile->debuts +
+		(size_t) numero_lettre * compile->nb_etats;
+	const uint32_t* fins = compile->fins;
+	int atteints = 0;
+	size_t m;
+	for( m=0; m<compile->nb_mots; m++ ){
+		uint64_t mot = depart[m];
+		while( mot ){
+			size_t e = m * BITSET_BITS_PAR_MOT + __builtin_ctzll( mot );
+			uint32_t k;
+			mot &= mot - 1;
+			for( k = debuts[e]; k < debuts[e+1]; k++ ){
+				arrivee[ BITSET_MOT( fins[k] ) ] |= BITSET_MASQUE( fins[k] );
+				atteints = 1;
+			}
+		}
+	}
+	return atteints;
+}
+
+int delta_compile_bits(
+	const Automate_compile* compile, const uint64_t* depart, char lettre,
+	uint64_t* arrivee
+){
+	memset( arrivee, 0, compile->nb_mots * sizeof(uint64_t) );
+	int numero_lettre = compile->numeros_lettres[ (unsigned char) lettre ];
+	if( numero_lettre < 0 ){
+		return 0;
+	}
+	return lire_lettre( compile, depart, numero_lettre, arrivee );
+}
+
+Ensemble * delta_compile(
+	const Automate_compile* compile, const Ensemble * etats_courants,
+	char lettre
+){
+	uint64_t* depart = etats_vers_bits( compile, etats_courants );
+	uint64_t* arrivee = creer_etats_compile( compile );
+	delta_compile_bits( compile, depart, lettre, arrivee );
+	Ensemble* res = bits_vers_etats( compile, arrivee );
+	xfree( depart );
+	xfree( arrivee );
+	return res;
+}
+
+/*
+ * Lit le mot depuis les 'nb' états de la liste 'courants'. Les états
+ * courants d'un automate non déterministe sont en général peu nombreux : ils
+ * sont rangés dans une liste, et le tableau de bits 'vus', qui doit être
+ * nul, ne sert qu'à éviter les doublons. Lire une lettre prend ainsi un temps
+ * proportionnel au nombre de transitions empruntées, quel que soit le nombre
+ * d'états de l'automate.
+ *
+ * Les listes 'courants' et 'autres', de nb_etats cases, servent tour à tour
+ * de liste de départ et d'arrivée. Renvoie le nombre d'états atteints, 
+ * écrits dans '*arrivee', qui vaut 'courants' ou 'autres'. 'vus' est nul
+ * au retour.
+ */
+static size_t lire_mot(
+	const Automate_compile* compile, const char* mot,
+	uint32_t* courants, size_t nb, uint32_t* autres, uint64_t* vus,
+	uint32_t** arrivee
+){
+	const uint32_t* fins = compile->fins;
+	size_t i;
+	for( ; *mot && nb; mot++ ){
+		int numero_lettre = compile->numeros_lettres[ (unsigned char) *mot ];
+		if( numero_lettre < 0 ){
+			nb = 0;
+			break;
+		}
+		const uint32_t* debuts = compile->debuts +
+			(size_t) numero_lettre * compile->nb_etats;
+		size_t nb_atteints = 0;
+		for( i=0; i<nb; i++ ){
+			uint32_t e = courants[i], k;
+			for( k = debuts[e]; k < debuts[e+1]; k++ ){
+				uint32_t fin = fins[k];
+				uint64_t masque = BITSET_MASQUE( fin );
+				if( ! ( vus[ BITSET_MOT( fin ) ] & masque ) ){
+					vus[ BITSET_MOT( fin ) ] |= masque;
+					autres[ nb_atteints++ ] = fin;
+				}
+			}
+		}
+		for( i=0; i<nb_atteints; i++ ){
+			vus[ BITSET_MOT( autres[i] ) ] = 0;
+		}
+		uint32_t* t = courants;
+		courants = autres;
+		autres = t;
+		nb = nb_atteints;
+	}
+	*arrivee = courants;
+	return nb;
+}
+
+/*
+ * Écrit dans 'liste' les numéros des états de 'bits', et renvoie leur
+ * nombre.
+ */
+static size_t bits_vers_liste(
+	const Automate_compile* compile, const uint64_t* bits, uint32_t* liste
+){
+	size_t nb = 0, m;
+	for( m=0; m<compile->nb_mots; m++ ){
+		uint64_t mot = bits[m];
+		while( mot ){
+			liste[nb++] = m * BITSET_BITS_PAR_MOT + __builtin_ctzll( mot );
+			mot &= mot - 1;
+		}
+	}
+	return nb;
+}
+
+Ensemble * delta_star_compile(
+	const Automate_compile* compile, const Ensemble * etats_courants,
+	const char* mot
+){
+	size_t taille = compile->nb_etats ? compile->nb_etats : 1;
+	uint32_t* courants = xmalloc( 2 * taille * sizeof(uint32_t) );
+	uint64_t* bits = etats_vers_bits( compile, etats_courants );
+	size_t nb = bits_vers_liste( compile, bits, courants );
+	memset( bits, 0, compile->nb_mots * sizeof(uint64_t) );
+	uint32_t* arrivee;
+	nb = lire_mot( compile, mot, courants, nb, courants + taille, bits, &arrivee );
+	size_t i;
+	for( i=0; i<nb; i++ ){
+		bits[ BITSET_MOT( arrivee[i] ) ] |= BITSET_MASQUE( arrivee[i] );
+	}
+	Ensemble* res = bits_vers_etats( compile, bits );
+	xfree( courants );
+	xfree( bits );
+	return res;
+}
+
+int le_mot_est_reconnu_compile(
+	const Automate_compile* compile, const char* mot
+){
+	uint32_t listes[ 2 * AUTOMATE_COMPILE_ETATS_SUR_LA_PILE ];
+	uint64_t marques[ AUTOMATE_COMPILE_ETATS_SUR_LA_PILE / BITSET_BITS_PAR_MOT ];
+	uint32_t* courants = listes;
+	uint64_t* vus = marques;
+	size_t taille = compile->nb_etats;
+	if( taille > AUTOMATE_COMPILE_ETATS_SUR_LA_PILE ){
+		courants = xmalloc( 2 * taille * sizeof(uint32_t) );
+		vus = xmalloc( compile->nb_mots * sizeof(uint64_t) );
+	}
+	memset( vus, 0, compile->nb_mots * sizeof(uint64_t) );
+	size_t nb = bits_vers_liste( compile, compile->initiaux, courants );
+	uint32_t* arrivee;
+	nb = lire_mot( compile, mot, courants, nb, courants + taille, vus, &arrivee );
+	int result = 0;
+	size_t i;
+	for( i=0; i<nb && ! result; i++ ){
+		result = ( compile->finaux[ BITSET_MOT( arrivee[i] ) ]
+			& BITSET_MASQUE( arrivee[i] ) ) != 0;
+	}
+	if( courants != listes ){
+		xfree( courants );
+		xfree( vus );
+	}
+	return result;
+}
+
+/*
+ * Table des transitions d'un automate déterministe, en cours de
+ * construction : etats[ i * nb_lettres + l ] est le numéro de l'état
+ * atteint depuis l'état i avec la lettre de numéro l, ou 0.
+ */
+typedef struct {
+	const int* etats_tries;
+	int nb_etats;
+	const int* numeros_lettres;
+	int nb_lettres;
+	uint32_t* etats;
+	int deterministe;
+} Construction_dense;
+
+static void ranger_transition_dense( int origine, char lettre, int fin, void* data ){
+	Construction_dense* construction = data;
+	size_t i = (size_t) (
+		1 + chercher_etat( construction->etats_tries, construction->nb_etats, origine )
+	) * construction->nb_lettres
+		+ construction->numeros_lettres[ (unsigned char) lettre ];
+	if( construction->etats[i] ){
+		construction->deterministe = 0;
+	}
+	construction->etats[i] = 1 + chercher_etat(
+		construction->etats_tries, construction->nb_etats, fin
+	);
+}
+
+/*
+ * Renvoie 1 si les lettres de numéros l1 et l2 mènent aux mêmes états
+ * depuis tous les états.
+ */
+static int colonnes_egales(
+	const uint32_t* etats, size_t nb_etats, int nb_lettres, int l1, int l2
+){
+	size_t i;
+	for( i=0; i<nb_etats; i++ ){
+		if( etats[ i * nb_lettres + l1 ] != etats[ i * nb_lettres + l2 ] ){
+			return 0;
+		}
+	}
+	return 1;
+}
+
+Automate_dense* compiler_automate_dense( const Automate* automate ){
+	if( taille_ensemble( get_initiaux( automate ) ) > 1 ){
+		return NULL;
+	}
+
+	int numeros_lettres[256];
+	int nb_etats, nb_lettres, l, k, c;
+	size_t i;
+	int* etats = numeroter_etats( automate, &nb_etats );
+	xfree( numeroter_lettres( automate, numeros_lettres, &nb_lettres ) );
+
+	// Le puits est l'état 0 : les autres états sont décalés de 1.
+	size_t nb_lignes = (size_t) nb_etats + 1;
+	Construction_dense construction = {
+		etats, nb_etats, numeros_lettres, nb_lettres, NULL, 1
+	};
+	size_t taille = nb_lignes * nb_lettres;
+	construction.etats = xmalloc( ( taille ? taille : 1 ) * sizeof(uint32_t) );
+	memset( construction.etats, 0, taille * sizeof(uint32_t) );
+	pour_toute_transition( automate, ranger_transition_dense, &construction );
+	if( ! construction.deterministe ){
+		xfree( construction.etats );
+		xfree( etats );
+		return NULL;
+	}
+
+	// Classes des lettres : deux lettres sont dans la même classe si leurs
+	// colonnes sont égales. Les colonnes sont d'abord comparées par leur
+	// empreinte, pour ne comparer entièrement que les colonnes probablement
+	// égales.
+	uint64_t empreintes[256];
+	int classe_de_lettre[256];
+	int representants[256];
+	int nb_classes = 1;
+	for( l=0; l<nb_lettres; l++ ){
+		uint64_t empreinte = 14695981039346656037ull;
+		int vide = 1;
+		for( i=0; i<nb_lignes; i++ ){
+			uint32_t e = construction.etats[ i * nb_lettres + l ];
+			vide &= e == 0;
+			empreinte = ( empreinte ^ e ) * 1099511628211ull;
+		}
+		empreintes[l] = empreinte;
+		classe_de_lettre[l] = 0;
+		if( vide ) continue;
+		for( k=1; k<nb_classes; k++ ){
+			int r = representants[k];
+			if(
+				empreintes[r] == empreinte
+				&& colonnes_egales( construction.etats, nb_lignes, nb_lettres, r, l )
+			){
+				classe_de_lettre[l] = k;
+				break;
+			}
+		}
+		if( ! classe_de_lettre[l] ){
+			representants[nb_classes] = l;
+			classe_de_lettre[l] = nb_classes++;
+		}
+	}
+
+	Automate_dense* dense = xmalloc( sizeof(Automate_dense) );
+	dense->nb_etats = nb_lignes;
+	dense->nb_classes = nb_classes;
+	dense->etats = etats;
+	for( c=0; c<256; c++ ){
+		dense->classes[c] = numeros_lettres[c] < 0 ?
+			0 : classe_de_lettre[ numeros_lettres[c] ];
+	}
+	assert( nb_lignes * nb_classes <= UINT32_MAX );
+	dense->suivants = xmalloc( nb_lignes * nb_classes * sizeof(uint32_t) );
+	for( i=0; i<nb_lignes; i++ ){
+		dense->suivants[ i * nb_classes ] = 0;
+		for( k=1; k<nb_classes; k++ ){
+			dense->suivants[ i * nb_classes + k ] = nb_classes *
+				construction.etats[ i * nb_lettres + representants[k] ];
+		}
+	}
+	xfree( construction.etats );
+
+	size_t nb_mots = ( nb_lignes + BITSET_BITS_PAR_MOT - 1 ) / BITSET_BITS_PAR_MOT;
+	dense->finaux = xmalloc( nb_mots * sizeof(uint64_t) );
+	memset( dense->finaux, 0, nb_mots * sizeof(uint64_t) );
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( get_finaux( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		int numero = 1 + chercher_etat( etats, nb_etats, get_element( it ) );
+		dense->finaux[ BITSET_MOT( numero ) ] |= BITSET_MASQUE( numero );
+	}
+	dense->initial = 0;
+	if( ! ensemble_est_vide( get_initiaux( automate ) ) ){
+		dense->initial = nb_classes * ( 1 + chercher_etat(
+			etats, nb_etats, min_ensemble( get_initiaux( automate ) )
+		) );
+	}
+	return dense;
+}
+
+void liberer_automate_dense( Automate_dense* dense ){
+	xfree( dense->suivants );
+	xfree( dense->finaux );
+	xfree( dense->etats );
+	xfree( dense );
+}
+
+int le_mot_est_reconnu_dense( const Automate_dense* dense, const char* mot ){
+	const uint32_t* suivants = dense->suivants;
+	const uint16_t* classes = dense->classes;
+	const unsigned char* c = (const unsigned char*) mot;
+	uint32_t etat = dense->initial;
+	// Le puits est le seul état de numéro multiplié nul.
+	for( ; *c && etat; c++ ){
+		etat = suivants[ etat + classes[*c] ];
+	}
+	uint32_t numero = etat / dense->nb_classes;
+	return ( dense->finaux[ BITSET_MOT( numero ) ] & BITSET_MASQUE( numero ) ) != 0;
+}
@@ -0,0 +1,213 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file automate_compile.h */
+
+#ifndef __AUTOMATE_COMPILE_H__
+#define __AUTOMATE_COMPILE_H__
+
+#include "automate.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Le type d'un automate compilé : une copie figée d'un automate,
+ * rangée dans des tableaux pour que la lecture d'un mot soit rapide.
+ *
+ * Les états de l'automate sont renumérotés de 0 à nb_etats - 1, dans l'ordre
+ * croissant : le numéro d'un état est son rang dans get_etats(). De même,
+ * les lettres sont numérotées de 0 à nb_lettres - 1.
+ *
+ * Les transitions sont codées par lignes creuses compressées (CSR) : les
+ * numéros des états d'arrivée des transitions qui partent de l'état de
+ * numéro e avec la lettre de numéro l sont, dans l'ordre croissant,
+ *   fins[ debuts[i] ], ..., fins[ debuts[i+1] - 1 ]
+ * avec i = l * nb_etats + e. Les lignes d'une même lettre sont donc
+ * contiguës : lire une lettre depuis plusieurs états parcourt un seul
+ * morceau de 'debuts' et de 'fins'.
+ *
+ * Les ensembles d'états d'un automate compilé sont des tableaux de bits de
+ * nb_mots mots de 64 bits, indexés par les numéros des états (voir
+ * bitset.h).
+ *
+ * Un automate compilé ne dépend plus de l'automate dont il est issu, et il
+ * ne peut pas être modifié.
+ */
+typedef struct {
+	int nb_etats;
+	int nb_lettres;
+	size_t nb_mots;
+	int* etats; //!< etats[e] est l'état de l'automate de numéro e.
+	char* lettres; //!< lettres[l] est la lettre de numéro l.
+	int numeros_lettres[256]; //!< Numéro de la lettre (unsigned char) c, ou -1.
+	uint32_t* debuts;
+	uint32_t* fins;
+	uint64_t* initiaux;
+	uint64_t* finaux;
+} Automate_compile;
+
+/**
+ * @brief Compile un automate.
+ *
+ * La compilation se fait en temps O( m log n + n k ), où m est le nombre de
+ * transitions, n le nombre d'états et k le nombre de lettres de l'automate.
+ * Le tableau 'debuts' a n k + 2 cases.
+ *
+ * @param automate Un automate.
+ * @return L'automate compilé, à libérer avec liberer_automate_compile().
+ */
+Automate_compile* compiler_automate( const Automate* automate );
+
+/**
+ * @brief Libère la mémoire d'un automate compilé.
+ */
+void liberer_automate_compile( Automate_compile* compile );
+
+/**
+ * @brief Renvoie le numéro d'un état dans l'automate compilé, ou -1 si
+ * l'état n'est pas un état de l'automate.
+ */
+int numero_de_l_etat( const Automate_compile* compile, int etat );
+
+/**
+ * @brief Renvoie un tableau de bits vide, de la taille des ensembles d'états
+ * de l'automate compilé, à libérer avec xfree().
+ */
+uint64_t* creer_etats_compile( const Automate_compile* compile );
+
+/**
+ * @brief Calcule dans 'arrivee' l'ensemble des états accessibles à partir
+ * des états de 'depart' en lisant la lettre 'lettre'.
+ *
+ * Les ensembles 'depart' et 'arrivee' sont des tableaux de bits distincts
+ * (voir creer_etats_compile()). Le temps de calcul est proportionnel au
+ * nombre de transitions empruntées, plus nb_mots.
+ *
+ * @return 1 si 'arrivee' n'est pas vide, 0 sinon.
+ */
+int delta_compile_bits(
+	const Automate_compile* compile, const uint64_t* depart, char lettre,
+	uint64_t* arrivee
+);
+
+/**
+ * @brief Équivalent de delta() pour un automate compilé.
+ *
+ * Les états de 'etats_courants' et de l'ensemble renvoyé sont ceux de
+ * l'automate d'origine ; les états de 'etats_courants' qui ne sont pas des
+ * états de l'automate sont ignorés. La mémoire de l'ensemble renvoyé est
+ * laissée à la charge de l'utilisateur.
+ */
+Ensemble * delta_compile(
+	const Automate_compile* compile, const Ensemble * etats_courants,
+	char lettre
+);
+
+/**
+ * @brief Équivalent de delta_star() pour un automate compilé.
+ *
+ * Les états sont ceux de l'automate d'origine, comme pour delta_compile().
+ * La lecture s'arrête dès que l'ensemble des états courants est vide.
+ */
+Ensemble * delta_star_compile(
+	const Automate_compile* compile, const Ensemble * etats_courants,
+	const char* mot
+);
+
+/**
+ * @brief Équivalent de le_mot_est_reconnu() pour un automate compilé.
+ *
+ * Les états courants sont rangés dans une liste : lire une lettre prend un
+ * temps proportionnel au nombre de transitions empruntées, quel que soit le
+ * nombre d'états de l'automate. Aucune mémoire n'est allouée sur le tas si
+ * l'automate a au plus AUTOMATE_COMPILE_ETATS_SUR_LA_PILE états.
+ *
+ * @return 1 si le mot est reconnu, 0 sinon.
+ */
+int le_mot_est_reconnu_compile(
+	const Automate_compile* compile, const char* mot
+);
+
+/**
+ * @brief Nombre maximal d'états d'un automate compilé pour lequel
+ * le_mot_est_reconnu_compile() garde ses ensembles d'états sur la pile.
+ */
+#define AUTOMATE_COMPILE_ETATS_SUR_LA_PILE 4096
+
+/**
+ * @brief Le type d'un automate déterministe compilé en une table de
+ * transitions dense.
+ *
+ * Les octets qui se comportent de la même manière depuis tous les états
+ * sont regroupés en classes : classes[c] est la classe de l'octet c. La
+ * classe 0 regroupe les octets qui ne mènent à aucun état, en particulier
+ * ceux qui ne sont pas des lettres de l'automate.
+ *
+ * L'état 0 est un puits, qui n'est pas final et ne mène qu'à lui-même ; les
+ * états 1 à nb_etats - 1 sont les états de l'automate, dans l'ordre
+ * croissant : l'état i est l'état etats[i-1] de l'automate.
+ *
+ * L'état atteint en lisant un octet de classe k depuis l'état i est
+ * suivants[ i * nb_classes + k ] / nb_classes. Les numéros des états sont
+ * rangés dans la table, et dans 'initial', multipliés par nb_classes : lire
+ * un octet coûte ainsi un accès à 'classes' et un accès à 'suivants',
+ * sans multiplication.
+ */
+typedef struct {
+	int nb_etats;
+	int nb_classes;
+	uint16_t classes[256]; //!< Jusqu'à 257 classes, avec la classe 0.
+	uint32_t* suivants;
+	uint32_t initial;
+	uint64_t* finaux; //!< Tableau de bits des numéros (non multipliés) des états finaux.
+	int* etats;
+} Automate_dense;
+
+/**
+ * @brief Compile un automate déterministe en une table de transitions dense.
+ *
+ * L'automate est déterministe s'il a au plus un état initial et au plus une
+ * transition par état et par lettre ; il n'a pas besoin d'être complet.
+ * La table a nb_etats * nb_classes cases de 32 bits, et sa construction
+ * demande temporairement nb_etats * nb_lettres cases.
+ *
+ * @param automate Un automate.
+ * @return L'automate compilé, à libérer avec liberer_automate_dense(), ou
+ * NULL si l'automate n'est pas déterministe.
+ */
+Automate_dense* compiler_automate_dense( const Automate* automate );
+
+/**
+ * @brief Libère la mémoire d'un automate déterministe compilé.
+ */
+void liberer_automate_dense( Automate_dense* dense );
+
+/**
+ * @brief Équivalent de le_mot_est_reconnu() pour un automate déterministe
+ * compilé.
+ *
+ * La lecture s'arrête dès que le puits est atteint.
+ *
+ * @return 1 si le mot est reconnu, 0 sinon.
+ */
+int le_mot_est_reconnu_dense( const Automate_dense* dense, const char* mot );
+
+#endif
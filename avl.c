@@ -27,6 +27,21 @@
 #include <string.h>
 #include "avl.h"
 
+/* Returns the number of nodes in the subtree rooted at |node|. */
+static unsigned int
+node_size (const struct avl_node *node)
+{
+  return node != NULL ? node->avl_size : 0;
+}
+
+/* Recomputes the size of |node|'s subtree from those of its children. */
+static void
+update_size (struct avl_node *node)
+{
+  node->avl_size = 1 + node_size (node->avl_link[0])
+                     + node_size (node->avl_link[1]);
+}
+
 /* Creates and returns a new table
    with comparison function |compare| using parameter |param|
    and memory allocator |allocator|.
@@ -46,14 +61,29 @@ avl_create (avl_comparison_func *compare, void *param,
   if (tree == NULL)
     return NULL;
 
+  avl_init (tree, compare, param, allocator);
+
+  return tree;
+}
+
+/* Initializes |tree|, whose storage is provided by the caller,
+   as an empty table with comparison function |compare| using
+   parameter |param| and memory allocator |allocator|.
+   |allocator| is only used for the nodes of |tree|. */
+void
+avl_init (struct avl_table *tree, avl_comparison_func *compare,
+          void *param, struct libavl_allocator *allocator)
+{
+  assert (tree != NULL && compare != NULL);
+
+  if (allocator == NULL)
+    allocator = &avl_allocator_default;
+
   tree->avl_root = NULL;
   tree->avl_compare = compare;
   tree->avl_param = param;
   tree->avl_alloc = allocator;
   tree->avl_count = 0;
-  tree->avl_generation = 0;
-
-  return tree;
 }
 
 /* Search |tree| for an item matching |item|, and return it if found.
@@ -86,48 +116,53 @@ avl_find (const struct avl_table *tree, const void *item)
 void **
 avl_probe (struct avl_table *tree, void *item)
 {
-  struct avl_node *y, *z; /* Top node to update balance factor, and parent. */
+  struct avl_node *y;     /* Top node to update balance factor. */
   struct avl_node *p, *q; /* Iterator, and parent. */
   struct avl_node *n;     /* Newly inserted node. */
   struct avl_node *w;     /* New root of rebalanced subtree. */
-  int dir;                /* Direction to descend. */
-
-  unsigned char da[AVL_MAX_HEIGHT]; /* Cached comparison results. */
-  int k = 0;              /* Number of cached results. */
+  int dir = 0;            /* Direction to descend. */
 
   assert (tree != NULL && item != NULL);
 
-  z = (struct avl_node *) &tree->avl_root;
   y = tree->avl_root;
-  dir = 0;
-  for (q = z, p = y; p != NULL; q = p, p = p->avl_link[dir])
+  for (q = NULL, p = tree->avl_root; p != NULL; q = p, p = p->avl_link[dir])
     {
       int cmp = tree->avl_compare (item, p->avl_data, tree->avl_param);
       if (cmp == 0)
         return &p->avl_data;
+      dir = cmp > 0;
 
       if (p->avl_balance != 0)
-        z = q, y = p, k = 0;
-      da[k++] = dir = cmp > 0;
+        y = p;
     }
 
-  n = q->avl_link[dir] =
-    tree->avl_alloc->libavl_malloc (tree->avl_alloc, sizeof *n);
+  n = tree->avl_alloc->libavl_malloc (tree->avl_alloc, sizeof *n);
   if (n == NULL)
     return NULL;
 
   tree->avl_count++;
-  n->avl_data = item;
   n->avl_link[0] = n->avl_link[1] = NULL;
+  n->avl_parent = q;
+  n->avl_data = item;
   n->avl_balance = 0;
-  if (y == NULL)
+  n->avl_size = 1;
+  if (q != NULL)
+    q->avl_link[dir] = n;
+  else
+    tree->avl_root = n;
+  for (p = q; p != NULL; p = p->avl_parent)
+    p->avl_size++;
+  if (tree->avl_root == n)
     return &n->avl_data;
 
-  for (p = y, k = 0; p != n; p = p->avl_link[da[k]], k++)
-    if (da[k] == 0)
-      p->avl_balance--;
-    else
-      p->avl_balance++;
+  for (p = n; p != y; p = q)
+    {
+      q = p->avl_parent;
+      if (q->avl_link[0] == p)
+        q->avl_balance--;
+      else
+        q->avl_balance++;
+    }
 
   if (y->avl_balance == -2)
     {
@@ -138,6 +173,12 @@ avl_probe (struct avl_table *tree, void *item)
           y->avl_link[0] = x->avl_link[1];
           x->avl_link[1] = y;
           x->avl_balance = y->avl_balance = 0;
+          x->avl_parent = y->avl_parent;
+          y->avl_parent = x;
+          if (y->avl_link[0] != NULL)
+            y->avl_link[0]->avl_parent = y;
+          update_size (y);
+          update_size (x);
         }
       else
         {
@@ -154,6 +195,15 @@ avl_probe (struct avl_table *tree, void *item)
           else /* |w->avl_balance == +1| */
             x->avl_balance = -1, y->avl_balance = 0;
           w->avl_balance = 0;
+          w->avl_parent = y->avl_parent;
+          x->avl_parent = y->avl_parent = w;
+          if (x->avl_link[1] != NULL)
+            x->avl_link[1]->avl_parent = x;
+          if (y->avl_link[0] != NULL)
+            y->avl_link[0]->avl_parent = y;
+          update_size (x);
+          update_size (y);
+          update_size (w);
         }
     }
   else if (y->avl_balance == +2)
@@ -165,6 +215,12 @@ avl_probe (struct avl_table *tree, void *item)
           y->avl_link[1] = x->avl_link[0];
           x->avl_link[0] = y;
           x->avl_balance = y->avl_balance = 0;
+          x->avl_parent = y->avl_parent;
+          y->avl_parent = x;
+          if (y->avl_link[1] != NULL)
+            y->avl_link[1]->avl_parent = y;
+          update_size (y);
+          update_size (x);
         }
       else
         {
@@ -181,13 +237,24 @@ avl_probe (struct avl_table *tree, void *item)
           else /* |w->avl_balance == -1| */
             x->avl_balance = +1, y->avl_balance = 0;
           w->avl_balance = 0;
+          w->avl_parent = y->avl_parent;
+          x->avl_parent = y->avl_parent = w;
+          if (x->avl_link[0] != NULL)
+            x->avl_link[0]->avl_parent = x;
+          if (y->avl_link[1] != NULL)
+            y->avl_link[1]->avl_parent = y;
+          update_size (x);
+          update_size (y);
+          update_size (w);
         }
     }
   else
     return &n->avl_data;
-  z->avl_link[y != z->avl_link[0]] = w;
+  if (w->avl_parent != NULL)
+    w->avl_parent->avl_link[y != w->avl_parent->avl_link[0]] = w;
+  else
+    tree->avl_root = w;
 
-  tree->avl_generation++;
   return &n->avl_data;
 }
 
@@ -225,81 +292,99 @@ avl_replace (struct avl_table *table, void *item)
 void *
 avl_delete (struct avl_table *tree, const void *item)
 {
-  /* Stack of nodes. */
-  struct avl_node *pa[AVL_MAX_HEIGHT]; /* Nodes. */
-  unsigned char da[AVL_MAX_HEIGHT];    /* |avl_link[]| indexes. */
-  int k;                               /* Stack pointer. */
-
-  struct avl_node *p;   /* Traverses tree to find node to delete. */
-  int cmp;              /* Result of comparison between |item| and |p|. */
+  struct avl_node *p; /* Traverses tree to find node to delete. */
+  struct avl_node *q; /* Parent of |p|. */
+  int dir = 0;        /* Side of |q| on which |p| is linked. */
 
   assert (tree != NULL && item != NULL);
 
-  k = 0;
-  p = (struct avl_node *) &tree->avl_root;
-  for (cmp = -1; cmp != 0;
-       cmp = tree->avl_compare (item, p->avl_data, tree->avl_param))
-    {
-      int dir = cmp > 0;
+  if (tree->avl_root == NULL)
+    return NULL;
 
-      pa[k] = p;
-      da[k++] = dir;
+  p = tree->avl_root;
+  for (;;)
+    {
+      int cmp = tree->avl_compare (item, p->avl_data, tree->avl_param);
+      if (cmp == 0)
+        break;
 
+      dir = cmp > 0;
       p = p->avl_link[dir];
       if (p == NULL)
         return NULL;
     }
   item = p->avl_data;
 
+  /* The root is reached through a pseudo-node whose left link is
+     |tree->avl_root|. */
+  q = p->avl_parent;
+  if (q == NULL)
+    {
+      q = (struct avl_node *) &tree->avl_root;
+      dir = 0;
+    }
+
   if (p->avl_link[1] == NULL)
-    pa[k - 1]->avl_link[da[k - 1]] = p->avl_link[0];
+    {
+      q->avl_link[dir] = p->avl_link[0];
+      if (q->avl_link[dir] != NULL)
+        q->avl_link[dir]->avl_parent = p->avl_parent;
+    }
   else
     {
       struct avl_node *r = p->avl_link[1];
       if (r->avl_link[0] == NULL)
         {
           r->avl_link[0] = p->avl_link[0];
+          q->avl_link[dir] = r;
+          r->avl_parent = p->avl_parent;
+          if (r->avl_link[0] != NULL)
+            r->avl_link[0]->avl_parent = r;
           r->avl_balance = p->avl_balance;
-          pa[k - 1]->avl_link[da[k - 1]] = r;
-          da[k] = 1;
-          pa[k++] = r;
+          q = r;
+          dir = 1;
         }
       else
         {
-          struct avl_node *s;
-          int j = k++;
-
-          for (;;)
-            {
-              da[k] = 0;
-              pa[k++] = r;
-              s = r->avl_link[0];
-              if (s->avl_link[0] == NULL)
-                break;
-
-              r = s;
-            }
-
-          s->avl_link[0] = p->avl_link[0];
+          struct avl_node *s = r->avl_link[0];
+          while (s->avl_link[0] != NULL)
+            s = s->avl_link[0];
+          r = s->avl_parent;
           r->avl_link[0] = s->avl_link[1];
+          s->avl_link[0] = p->avl_link[0];
           s->avl_link[1] = p->avl_link[1];
+          q->avl_link[dir] = s;
+          if (s->avl_link[0] != NULL)
+            s->avl_link[0]->avl_parent = s;
+          s->avl_link[1]->avl_parent = s;
+          s->avl_parent = p->avl_parent;
+          if (r->avl_link[0] != NULL)
+            r->avl_link[0]->avl_parent = r;
           s->avl_balance = p->avl_balance;
-
-          pa[j - 1]->avl_link[da[j - 1]] = s;
-          da[j] = 1;
-          pa[j] = s;
+          q = r;
+          dir = 0;
         }
     }
-
   tree->avl_alloc->libavl_free (tree->avl_alloc, p);
 
-  assert (k > 0);
-  while (--k > 0)
+  /* The nodes whose subtree lost a node are |q| and its ancestors.
+     Rebalancing below only rotates subtrees, which keeps their sizes. */
+  for (p = q; p != NULL && p != (struct avl_node *) &tree->avl_root;
+       p = p->avl_parent)
+    update_size (p);
+
+  while (q != (struct avl_node *) &tree->avl_root)
     {
-      struct avl_node *y = pa[k];
+      struct avl_node *y = q;
+
+      if (y->avl_parent != NULL)
+        q = y->avl_parent;
+      else
+        q = (struct avl_node *) &tree->avl_root;
 
-      if (da[k] == 0)
+      if (dir == 0)
         {
+          dir = q->avl_link[0] != y;
           y->avl_balance++;
           if (y->avl_balance == +1)
             break;
@@ -309,7 +394,7 @@ avl_delete (struct avl_table *tree, const void *item)
               if (x->avl_balance == -1)
                 {
                   struct avl_node *w;
-                  assert (x->avl_balance == -1);
+
                   w = x->avl_link[0];
                   x->avl_link[0] = w->avl_link[1];
                   w->avl_link[1] = x;
@@ -322,13 +407,28 @@ avl_delete (struct avl_table *tree, const void *item)
                   else /* |w->avl_balance == -1| */
                     x->avl_balance = +1, y->avl_balance = 0;
                   w->avl_balance = 0;
-                  pa[k - 1]->avl_link[da[k - 1]] = w;
+                  w->avl_parent = y->avl_parent;
+                  x->avl_parent = y->avl_parent = w;
+                  if (x->avl_link[0] != NULL)
+                    x->avl_link[0]->avl_parent = x;
+                  if (y->avl_link[1] != NULL)
+                    y->avl_link[1]->avl_parent = y;
+                  update_size (x);
+                  update_size (y);
+                  update_size (w);
+                  q->avl_link[dir] = w;
                 }
               else
                 {
                   y->avl_link[1] = x->avl_link[0];
                   x->avl_link[0] = y;
-                  pa[k - 1]->avl_link[da[k - 1]] = x;
+                  x->avl_parent = y->avl_parent;
+                  y->avl_parent = x;
+                  if (y->avl_link[1] != NULL)
+                    y->avl_link[1]->avl_parent = y;
+                  update_size (y);
+                  update_size (x);
+                  q->avl_link[dir] = x;
                   if (x->avl_balance == 0)
                     {
                       x->avl_balance = -1;
@@ -342,6 +442,7 @@ avl_delete (struct avl_table *tree, const void *item)
         }
       else
         {
+          dir = q->avl_link[0] != y;
           y->avl_balance--;
           if (y->avl_balance == -1)
             break;
@@ -351,7 +452,7 @@ avl_delete (struct avl_table *tree, const void *item)
               if (x->avl_balance == +1)
                 {
                   struct avl_node *w;
-                  assert (x->avl_balance == +1);
+
                   w = x->avl_link[1];
                   x->avl_link[1] = w->avl_link[0];
                   w->avl_link[0] = x;
@@ -364,13 +465,28 @@ avl_delete (struct avl_table *tree, const void *item)
                   else /* |w->avl_balance == +1| */
                     x->avl_balance = -1, y->avl_balance = 0;
                   w->avl_balance = 0;
-                  pa[k - 1]->avl_link[da[k - 1]] = w;
+                  w->avl_parent = y->avl_parent;
+                  x->avl_parent = y->avl_parent = w;
+                  if (x->avl_link[1] != NULL)
+                    x->avl_link[1]->avl_parent = x;
+                  if (y->avl_link[0] != NULL)
+                    y->avl_link[0]->avl_parent = y;
+                  update_size (x);
+                  update_size (y);
+                  update_size (w);
+                  q->avl_link[dir] = w;
                 }
               else
                 {
                   y->avl_link[0] = x->avl_link[1];
                   x->avl_link[1] = y;
-                  pa[k - 1]->avl_link[da[k - 1]] = x;
+                  x->avl_parent = y->avl_parent;
+                  y->avl_parent = x;
+                  if (y->avl_link[0] != NULL)
+                    y->avl_link[0]->avl_parent = y;
+                  update_size (y);
+                  update_size (x);
+                  q->avl_link[dir] = x;
                   if (x->avl_balance == 0)
                     {
                       x->avl_balance = +1;
@@ -385,38 +501,9 @@ avl_delete (struct avl_table *tree, const void *item)
     }
 
   tree->avl_count--;
-  tree->avl_generation++;
   return (void *) item;
 }
 
-/* Refreshes the stack of parent pointers in |trav|
-   and updates its generation number. */
-static void
-trav_refresh (struct avl_traverser *trav)
-{
-  assert (trav != NULL);
-
-  trav->avl_generation = trav->avl_table->avl_generation;
-
-  if (trav->avl_node != NULL)
-    {
-      avl_comparison_func *cmp = trav->avl_table->avl_compare;
-      void *param = trav->avl_table->avl_param;
-      struct avl_node *node = trav->avl_node;
-      struct avl_node *i;
-
-      trav->avl_height = 0;
-      for (i = trav->avl_table->avl_root; i != node; )
-        {
-          assert (trav->avl_height < AVL_MAX_HEIGHT);
-          assert (i != NULL);
-
-          trav->avl_stack[trav->avl_height++] = i;
-          i = i->avl_link[cmp (node->avl_data, i->avl_data, param) > 0];
-        }
-    }
-}
-
 /* Initializes |trav| for use with |tree|
    and selects the null node. */
 void
@@ -424,8 +511,6 @@ avl_t_init (struct avl_traverser *trav, struct avl_table *tree)
 {
   trav->avl_table = tree;
   trav->avl_node = NULL;
-  trav->avl_height = 0;
-  trav->avl_generation = tree->avl_generation;
 }
 
 /* Initializes |trav| for |tree|
@@ -439,17 +524,11 @@ avl_t_first (struct avl_traverser *trav, struct avl_table *tree)
   assert (tree != NULL && trav != NULL);
 
   trav->avl_table = tree;
-  trav->avl_height = 0;
-  trav->avl_generation = tree->avl_generation;
 
   x = tree->avl_root;
   if (x != NULL)
     while (x->avl_link[0] != NULL)
-      {
-        assert (trav->avl_height < AVL_MAX_HEIGHT);
-        trav->avl_stack[trav->avl_height++] = x;
-        x = x->avl_link[0];
-      }
+      x = x->avl_link[0];
   trav->avl_node = x;
 
   return x != NULL ? x->avl_data : NULL;
@@ -466,17 +545,11 @@ avl_t_last (struct avl_traverser *trav, struct avl_table *tree)
   assert (tree != NULL && trav != NULL);
 
   trav->avl_table = tree;
-  trav->avl_height = 0;
-  trav->avl_generation = tree->avl_generation;
 
   x = tree->avl_root;
   if (x != NULL)
     while (x->avl_link[1] != NULL)
-      {
-        assert (trav->avl_height < AVL_MAX_HEIGHT);
-        trav->avl_stack[trav->avl_height++] = x;
-        x = x->avl_link[1];
-      }
+      x = x->avl_link[1];
   trav->avl_node = x;
 
   return x != NULL ? x->avl_data : NULL;
@@ -490,31 +563,25 @@ avl_t_last (struct avl_traverser *trav, struct avl_table *tree)
 void *
 avl_t_find (struct avl_traverser *trav, struct avl_table *tree, void *item)
 {
-  struct avl_node *p, *q;
+  struct avl_node *p;
 
   assert (trav != NULL && tree != NULL && item != NULL);
   trav->avl_table = tree;
-  trav->avl_height = 0;
-  trav->avl_generation = tree->avl_generation;
-  for (p = tree->avl_root; p != NULL; p = q)
+  for (p = tree->avl_root; p != NULL; )
     {
       int cmp = tree->avl_compare (item, p->avl_data, tree->avl_param);
 
       if (cmp < 0)
-        q = p->avl_link[0];
+        p = p->avl_link[0];
       else if (cmp > 0)
-        q = p->avl_link[1];
+        p = p->avl_link[1];
       else /* |cmp == 0| */
         {
           trav->avl_node = p;
           return p->avl_data;
         }
-
-      assert (trav->avl_height < AVL_MAX_HEIGHT);
-      trav->avl_stack[trav->avl_height++] = p;
     }
 
-  trav->avl_height = 0;
   trav->avl_node = NULL;
   return NULL;
 }
@@ -540,7 +607,6 @@ avl_t_insert (struct avl_traverser *trav, struct avl_table *tree, void *item)
       trav->avl_node =
         ((struct avl_node *)
          ((char *) p - offsetof (struct avl_node, avl_data)));
-      trav->avl_generation = tree->avl_generation - 1;
       return *p;
     }
   else
@@ -560,13 +626,6 @@ avl_t_copy (struct avl_traverser *trav, const struct avl_traverser *src)
     {
       trav->avl_table = src->avl_table;
       trav->avl_node = src->avl_node;
-      trav->avl_generation = src->avl_generation;
-      if (trav->avl_generation == trav->avl_table->avl_generation)
-        {
-          trav->avl_height = src->avl_height;
-          memcpy (trav->avl_stack, (const void *) src->avl_stack,
-                  sizeof *trav->avl_stack * trav->avl_height);
-        }
     }
 
   return trav->avl_node != NULL ? trav->avl_node->avl_data : NULL;
@@ -574,7 +633,9 @@ avl_t_copy (struct avl_traverser *trav, const struct avl_traverser *src)
 
 /* Returns the next data item in inorder
    within the tree being traversed with |trav|,
-   or if there are no more data items returns |NULL|. */
+   or if there are no more data items returns |NULL|.
+   The successor is found through the parent pointers,
+   in amortized constant time. */
 void *
 avl_t_next (struct avl_traverser *trav)
 {
@@ -582,26 +643,14 @@ avl_t_next (struct avl_traverser *trav)
 
   assert (trav != NULL);
 
-  if (trav->avl_generation != trav->avl_table->avl_generation)
-    trav_refresh (trav);
-
   x = trav->avl_node;
   if (x == NULL)
-    {
-      return avl_t_first (trav, trav->avl_table);
-    }
+    return avl_t_first (trav, trav->avl_table);
   else if (x->avl_link[1] != NULL)
     {
-      assert (trav->avl_height < AVL_MAX_HEIGHT);
-      trav->avl_stack[trav->avl_height++] = x;
       x = x->avl_link[1];
-
       while (x->avl_link[0] != NULL)
-        {
-          assert (trav->avl_height < AVL_MAX_HEIGHT);
-          trav->avl_stack[trav->avl_height++] = x;
-          x = x->avl_link[0];
-        }
+        x = x->avl_link[0];
     }
   else
     {
@@ -609,20 +658,14 @@ avl_t_next (struct avl_traverser *trav)
 
       do
         {
-          if (trav->avl_height == 0)
-            {
-              trav->avl_node = NULL;
-              return NULL;
-            }
-
           y = x;
-          x = trav->avl_stack[--trav->avl_height];
+          x = x->avl_parent;
         }
-      while (y == x->avl_link[1]);
+      while (x != NULL && y == x->avl_link[1]);
     }
   trav->avl_node = x;
 
-  return x->avl_data;
+  return x != NULL ? x->avl_data : NULL;
 }
 
 /* Returns the previous data item in inorder
@@ -635,26 +678,14 @@ avl_t_prev (struct avl_traverser *trav)
 
   assert (trav != NULL);
 
-  if (trav->avl_generation != trav->avl_table->avl_generation)
-    trav_refresh (trav);
-
   x = trav->avl_node;
   if (x == NULL)
-    {
-      return avl_t_last (trav, trav->avl_table);
-    }
+    return avl_t_last (trav, trav->avl_table);
   else if (x->avl_link[0] != NULL)
     {
-      assert (trav->avl_height < AVL_MAX_HEIGHT);
-      trav->avl_stack[trav->avl_height++] = x;
       x = x->avl_link[0];
-
       while (x->avl_link[1] != NULL)
-        {
-          assert (trav->avl_height < AVL_MAX_HEIGHT);
-          trav->avl_stack[trav->avl_height++] = x;
-          x = x->avl_link[1];
-        }
+        x = x->avl_link[1];
     }
   else
     {
@@ -662,20 +693,14 @@ avl_t_prev (struct avl_traverser *trav)
 
       do
         {
-          if (trav->avl_height == 0)
-            {
-              trav->avl_node = NULL;
-              return NULL;
-            }
-
           y = x;
-          x = trav->avl_stack[--trav->avl_height];
+          x = x->avl_parent;
         }
-      while (y == x->avl_link[0]);
+      while (x != NULL && y == x->avl_link[0]);
     }
   trav->avl_node = x;
 
-  return x->avl_data;
+  return x != NULL ? x->avl_data : NULL;
 }
 
 /* Returns |trav|'s current item. */
@@ -701,6 +726,112 @@ avl_t_replace (struct avl_traverser *trav, void *new)
   return old;
 }
 
+/* Initializes |trav| for |tree|
+   and selects and returns a pointer to the item of rank |k|,
+   that is, the item preceded by exactly |k| items in inorder.
+   If |tree| has no more than |k| items, selects the null item
+   and returns |NULL|.
+   The subtree sizes lead directly to the item, in O(log n) time. */
+void *
+avl_t_select (struct avl_traverser *trav, struct avl_table *tree, size_t k)
+{
+  struct avl_node *p;
+
+  assert (trav != NULL && tree != NULL);
+
+  trav->avl_table = tree;
+  for (p = tree->avl_root; p != NULL; )
+    {
+      size_t left = node_size (p->avl_link[0]);
+
+      if (k < left)
+        p = p->avl_link[0];
+      else if (k > left)
+        {
+          k -= left + 1;
+          p = p->avl_link[1];
+        }
+      else
+        break;
+    }
+  trav->avl_node = p;
+
+  return p != NULL ? p->avl_data : NULL;
+}
+
+/* Returns the rank of |trav|'s current item,
+   that is, the number of items that precede it in inorder.
+   |trav| must not have the null item selected. */
+size_t
+avl_t_rank (const struct avl_traverser *trav)
+{
+  const struct avl_node *p, *q;
+  size_t rank;
+
+  assert (trav != NULL && trav->avl_node != NULL);
+
+  p = trav->avl_node;
+  rank = node_size (p->avl_link[0]);
+  for (q = p->avl_parent; q != NULL; p = q, q = q->avl_parent)
+    if (q->avl_link[1] == p)
+      rank += node_size (q->avl_link[0]) + 1;
+
+  return rank;
+}
+
+/* Returns the number of items in |tree| that are less than |item|,
+   which need not be in |tree|, in O(log n) time. */
+size_t
+avl_rank (const struct avl_table *tree, const void *item)
+{
+  const struct avl_node *p;
+  size_t rank = 0;
+
+  assert (tree != NULL && item != NULL);
+  for (p = tree->avl_root; p != NULL; )
+    {
+      int cmp = tree->avl_compare (item, p->avl_data, tree->avl_param);
+
+      if (cmp < 0)
+        p = p->avl_link[0];
+      else if (cmp > 0)
+        {
+          rank += node_size (p->avl_link[0]) + 1;
+          p = p->avl_link[1];
+        }
+      else /* |cmp == 0| */
+        return rank + node_size (p->avl_link[0]);
+    }
+
+  return rank;
+}
+
+/* Frees all the nodes of |tree|, leaving it empty.
+   If |destroy != NULL|, applies it to each data item in inorder. */
+static void
+destroy_nodes (struct avl_table *tree, avl_item_func *destroy)
+{
+  struct avl_node *p, *q;
+
+  for (p = tree->avl_root; p != NULL; p = q)
+    if (p->avl_link[0] == NULL)
+      {
+        q = p->avl_link[1];
+        if (destroy != NULL && p->avl_data != NULL)
+          destroy (p->avl_data, tree->avl_param);
+        tree->avl_alloc->libavl_free (tree->avl_alloc, p);
+      }
+    else
+      {
+        q = p->avl_link[0];
+        p->avl_link[0] = q->avl_link[1];
+        q->avl_link[1] = p;
+      }
+
+  tree->avl_root = NULL;
+  tree->avl_count = 0;
+}
+
 static void
 copy_error_recovery (struct avl_node **stack, int height,
                      struct avl_table *new, avl_item_func *destroy)
@@ -709,37 +840,33 @@ copy_error_recovery (struct avl_node **stack, int height,
 
   for (; height > 2; height -= 2)
     stack[height - 1]->avl_link[1] = NULL;
-  avl_destroy (new, destroy);
+  destroy_nodes (new, destroy);
 }
 
-/* Copies |org| to a newly created tree, which is returned.
-   If |copy != NULL|, each data item in |org| is first passed to |copy|,
-   and the return values are inserted into the tree,
+/* Copies the nodes of |org| into |new|, which must be empty,
+   for instance freshly initialized by avl_init().
+   The shape of |org| is reproduced node by node, in linear time,
+   without any comparison.
+   If |copy != NULL|, each data item in |org| is passed to |copy|
+   along with |param|, and the return values are stored in |new|,
    with |NULL| return values taken as indications of failure.
-   On failure, destroys the partially created new tree,
-   applying |destroy|, if non-null, to each item in the new tree so far,
-   and returns |NULL|.
-   If |allocator != NULL|, it is used for allocation in the new tree.
-   Otherwise, the same allocator used for |org| is used. */
-struct avl_table *
-avl_copy (const struct avl_table *org, avl_copy_func *copy,
-          avl_item_func *destroy, struct libavl_allocator *allocator)
+   On failure, empties |new|, applying |destroy|, if non-null,
+   to each item copied so far, and returns 0.
+   Returns nonzero on success. */
+int
+avl_copy_into (struct avl_table *new, const struct avl_table *org,
+               avl_copy_func *copy, avl_item_func *destroy, void *param)
 {
   struct avl_node *stack[2 * (AVL_MAX_HEIGHT + 1)];
   int height = 0;
 
-  struct avl_table *new;
   const struct avl_node *x;
   struct avl_node *y;
 
-  assert (org != NULL);
-  new = avl_create (org->avl_compare, org->avl_param,
-                    allocator != NULL ? allocator : org->avl_alloc);
-  if (new == NULL)
-    return NULL;
+  assert (new != NULL && org != NULL && new->avl_count == 0);
   new->avl_count = org->avl_count;
   if (new->avl_count == 0)
-    return new;
+    return 1;
 
   x = (const struct avl_node *) &org->avl_root;
   y = (struct avl_node *) &new->avl_root;
@@ -761,9 +888,11 @@ avl_copy (const struct avl_table *org, avl_copy_func *copy,
                 }
 
               copy_error_recovery (stack, height, new, destroy);
-              return NULL;
+              return 0;
             }
 
+          y->avl_link[0]->avl_parent =
+            y != (struct avl_node *) &new->avl_root ? y : NULL;
           stack[height++] = (struct avl_node *) x;
           stack[height++] = y;
           x = x->avl_link[0];
@@ -774,16 +903,17 @@ avl_copy (const struct avl_table *org, avl_copy_func *copy,
       for (;;)
         {
           y->avl_balance = x->avl_balance;
+          y->avl_size = x->avl_size;
           if (copy == NULL)
             y->avl_data = x->avl_data;
           else
             {
-              y->avl_data = copy (x->avl_data, org->avl_param);
+              y->avl_data = copy (x->avl_data, param);
               if (y->avl_data == NULL)
                 {
                   y->avl_link[1] = NULL;
                   copy_error_recovery (stack, height, new, destroy);
-                  return NULL;
+                  return 0;
                 }
             }
 
@@ -795,9 +925,10 @@ avl_copy (const struct avl_table *org, avl_copy_func *copy,
               if (y->avl_link[1] == NULL)
                 {
                   copy_error_recovery (stack, height, new, destroy);
-                  return NULL;
+                  return 0;
                 }
 
+              y->avl_link[1]->avl_parent = y;
               x = x->avl_link[1];
               y = y->avl_link[1];
               break;
@@ -806,7 +937,7 @@ avl_copy (const struct avl_table *org, avl_copy_func *copy,
             y->avl_link[1] = NULL;
 
           if (height <= 2)
-            return new;
+            return 1;
 
           y = stack[--height];
           x = stack[--height];
@@ -814,30 +945,125 @@ avl_copy (const struct avl_table *org, avl_copy_func *copy,
     }
 }
 
+/* Copies |org| to a newly created tree, which is returned.
+   If |copy != NULL|, each data item in |org| is first passed to |copy|,
+   and the return values are inserted into the tree,
+   with |NULL| return values taken as indications of failure.
+   On failure, destroys the partially created new tree,
+   applying |destroy|, if non-null, to each item in the new tree so far,
+   and returns |NULL|.
+   If |allocator != NULL|, it is used for allocation in the new tree.
+   Otherwise, the same allocator used for |org| is used. */
+struct avl_table *
+avl_copy (const struct avl_table *org, avl_copy_func *copy,
+          avl_item_func *destroy, struct libavl_allocator *allocator)
+{
+  struct avl_table *new;
+
+  assert (org != NULL);
+  new = avl_create (org->avl_compare, org->avl_param,
+                    allocator != NULL ? allocator : org->avl_alloc);
+  if (new == NULL)
+    return NULL;
+  if (!avl_copy_into (new, org, copy, destroy, org->avl_param))
+    {
+      new->avl_alloc->libavl_free (new->avl_alloc, new);
+      return NULL;
+    }
+  return new;
+}
+
+/* Frees the subtree rooted at |node|, allocated from |tree|'s allocator.
+   The data items are left alone. */
+static void
+free_subtree (struct avl_table *tree, struct avl_node *node)
+{
+  if (node == NULL)
+    return;
+  free_subtree (tree, node->avl_link[0]);
+  free_subtree (tree, node->avl_link[1]);
+  tree->avl_alloc->libavl_free (tree->avl_alloc, node);
+}
+
+/* Builds a perfectly balanced subtree holding the |n| items of |items|,
+   in order, and stores its root into |*root| and its height into |*height|.
+   The left subtree of each node never holds more items than the right one,
+   so every balance factor is 0 or +1.
+   Returns nonzero on success, or 0 if memory allocation failed,
+   in which case no node is left allocated. */
+static int
+build_subtree (struct avl_table *tree, void **items, size_t n,
+               struct avl_node **root, int *height)
+{
+  struct avl_node *node;
+  size_t left = (n - 1) / 2;
+  int left_height, right_height;
+
+  if (n == 0)
+    {
+      *root = NULL;
+      *height = 0;
+      return 1;
+    }
+
+  node = tree->avl_alloc->libavl_malloc (tree->avl_alloc, sizeof *node);
+  if (node == NULL)
+    return 0;
+  node->avl_data = items[left];
+  if (!build_subtree (tree, items, left, &node->avl_link[0], &left_height))
+    {
+      tree->avl_alloc->libavl_free (tree->avl_alloc, node);
+      return 0;
+    }
+  if (!build_subtree (tree, items + left + 1, n - left - 1,
+                      &node->avl_link[1], &right_height))
+    {
+      free_subtree (tree, node->avl_link[0]);
+      tree->avl_alloc->libavl_free (tree->avl_alloc, node);
+      return 0;
+    }
+  node->avl_parent = NULL;
+  if (node->avl_link[0] != NULL)
+    node->avl_link[0]->avl_parent = node;
+  if (node->avl_link[1] != NULL)
+    node->avl_link[1]->avl_parent = node;
+  node->avl_balance = right_height - left_height;
+  node->avl_size = n;
+  *root = node;
+  *height = (right_height > left_height ? right_height : left_height) + 1;
+  return 1;
+}
+
+/* Fills |tree|, which must be empty, with the |n| items of |items|,
+   which must be sorted in strictly increasing order
+   according to |tree|'s comparison function.
+   The items are not compared: the tree is built directly,
+   perfectly balanced, in linear time.
+   Returns nonzero on success, or 0 if memory allocation failed,
+   in which case |tree| is left empty. */
+int
+avl_build (struct avl_table *tree, void **items, size_t n)
+{
+  int height;
+
+  assert (tree != NULL && tree->avl_count == 0 && (items != NULL || n == 0));
+  if (!build_subtree (tree, items, n, &tree->avl_root, &height))
+    {
+      tree->avl_root = NULL;
+      return 0;
+    }
+  tree->avl_count = n;
+  return 1;
+}
+
 /* Frees storage allocated for |tree|.
    If |destroy != NULL|, applies it to each data item in inorder. */
 void
 avl_destroy (struct avl_table *tree, avl_item_func *destroy)
 {
-  struct avl_node *p, *q;
-
   assert (tree != NULL);
 
-  for (p = tree->avl_root; p != NULL; p = q)
-    if (p->avl_link[0] == NULL)
-      {
-        q = p->avl_link[1];
-        if (destroy != NULL && p->avl_data != NULL)
-          destroy (p->avl_data, tree->avl_param);
-        tree->avl_alloc->libavl_free (tree->avl_alloc, p);
-      }
-    else
-      {
-        q = p->avl_link[0];
-        p->avl_link[0] = q->avl_link[1];
-        q->avl_link[1] = p;
-      }
-
+  destroy_nodes (tree, destroy);
   tree->avl_alloc->libavl_free (tree->avl_alloc, tree);
 }
 
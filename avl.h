@@ -60,33 +60,37 @@ struct avl_table
     void *avl_param;                    /* Extra argument to |avl_compare|. */
     struct libavl_allocator *avl_alloc; /* Memory allocator. */
     size_t avl_count;                   /* Number of items in tree. */
-    unsigned long avl_generation;       /* Generation number. */
   };
 
 /* An AVL tree node. */
 struct avl_node
   {
     struct avl_node *avl_link[2];  /* Subtrees. */
+    struct avl_node *avl_parent;   /* Parent node, or |NULL| for the root. */
     void *avl_data;                /* Pointer to data. */
     signed char avl_balance;       /* Balance factor. */
+    unsigned int avl_size;         /* Number of nodes in this subtree. */
   };
 
-/* AVL traverser structure. */
+/* AVL traverser structure.
+   Thanks to the parent pointers, a traverser only needs its current node,
+   and it stays valid across insertions and deletions of other nodes. */
 struct avl_traverser
   {
     struct avl_table *avl_table;        /* Tree being traversed. */
     struct avl_node *avl_node;          /* Current node in tree. */
-    struct avl_node *avl_stack[AVL_MAX_HEIGHT];
-                                        /* All the nodes above |avl_node|. */
-    size_t avl_height;                  /* Number of nodes in |avl_parent|. */
-    unsigned long avl_generation;       /* Generation number. */
   };
 
 /* Table functions. */
 struct avl_table *avl_create (avl_comparison_func *, void *,
                               struct libavl_allocator *);
+void avl_init (struct avl_table *, avl_comparison_func *, void *,
+               struct libavl_allocator *);
 struct avl_table *avl_copy (const struct avl_table *, avl_copy_func *,
                             avl_item_func *, struct libavl_allocator *);
+int avl_copy_into (struct avl_table *, const struct avl_table *,
+                   avl_copy_func *, avl_item_func *, void *);
+int avl_build (struct avl_table *, void **, size_t);
 void avl_destroy (struct avl_table *, avl_item_func *);
 void **avl_probe (struct avl_table *, void *);
 void *avl_insert (struct avl_table *, void *);
@@ -109,6 +113,11 @@ void *avl_t_next (struct avl_traverser *);
 void *avl_t_prev (struct avl_traverser *);
 void *avl_t_cur (struct avl_traverser *);
 void *avl_t_replace (struct avl_traverser *, void *);
+void *avl_t_select (struct avl_traverser *, struct avl_table *, size_t);
+size_t avl_t_rank (const struct avl_traverser *);
+
+/* Order statistics. */
+size_t avl_rank (const struct avl_table *, const void *);
 int avl_t_is_null(struct avl_traverser *);
 
 #endif /* avl.h */
@@ -0,0 +1,132 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Compare une table codée par un arbre AVL à une table codée par un 
+ * B+-arbre, pour 10^4, 10^5, ... clés entières, en nanosecondes par 
+ * opération :
+ *   - ajouts des clés dans un ordre aléatoire ;
+ *   - recherches dans un autre ordre aléatoire ;
+ *   - parcours de toutes les associations dans l'ordre des clés ;
+ *   - suppressions des clés dans un troisième ordre aléatoire.
+ *
+ * Usage : bench_arbre_b [nombre_maximal_de_cles]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "table.h"
+#include "outils.h"
+#include "tests/aleatoire.h"
+#include "bench/chronometre.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * Mélange les clés (mélange de Fisher-Yates), pour que l'ordre des accès ne
+ * soit corrélé ni à l'ordre des clés ni à l'ordre des allocations.
+ */
+static void melanger( intptr_t* cles, long nb_cles, uint64_t* graine ){
+	long i;
+	for( i=nb_cles-1; i>0; i-- ){
+		long j = aleatoire( graine ) % ( i + 1 );
+		intptr_t c = cles[i];
+		cles[i] = cles[j];
+		cles[j] = c;
+	}
+}
+
+/*
+ * Mesure les quatre opérations sur la table vide 'table', et renvoie une 
+ * somme de contrôle.
+ */
+long mesurer( Table* table, intptr_t* cles, long nb_cles, const char* nom ){
+	long i;
+	long somme = 0;
+	uint64_t graine = 88172645463325252ull;
+	double debut, ajout, recherche, parcours, suppression;
+	Table_iterateur it;
+
+	melanger( cles, nb_cles, &graine );
+	debut = maintenant();
+	for( i=0; i<nb_cles; i++ ){
+		add_table( table, cles[i], i );
+	}
+	ajout = maintenant() - debut;
+
+	melanger( cles, nb_cles, &graine );
+	debut = maintenant();
+	for( i=0; i<nb_cles; i++ ){
+		it = trouver_table( table, cles[i] );
+		somme += get_valeur( it );
+	}
+	recherche = maintenant() - debut;
+
+	debut = maintenant();
+	for(
+		it = premier_iterateur_table( table );
+		! iterateur_est_vide( it );
+		it = iterateur_suivant_table( it )
+	){
+		somme += get_cle( it );
+	}
+	parcours = maintenant() - debut;
+
+	melanger( cles, nb_cles, &graine );
+	debut = maintenant();
+	for( i=0; i<nb_cles; i++ ){
+		delete_table( table, cles[i] );
+	}
+	suppression = maintenant() - debut;
+	somme += taille_table( table );
+
+	printf(
+		"%-8s %9ld cles : ajout %7.1f  recherche %7.1f  parcours %6.1f"
+		"  suppression %7.1f ns\n", 
+		nom, nb_cles, ajout / nb_cles, recherche / nb_cles, 
+		parcours / nb_cles, suppression / nb_cles
+	);
+	liberer_table( table );
+	return somme;
+}
+
+int main( int argc, char* argv[] ){
+	long nb_max = argc > 1 ? atol( argv[1] ) : 1000000;
+	long nb_cles;
+	long somme = 0;
+
+	for( nb_cles = 10000; nb_cles <= nb_max; nb_cles *= 10 ){
+		intptr_t* cles = xmalloc( nb_cles * sizeof(intptr_t) );
+		long i;
+		for( i=0; i<nb_cles; i++ ) cles[i] = i;
+		somme += mesurer( 
+			creer_table( NULL, NULL, NULL ), cles, nb_cles, "avl" 
+		);
+		somme += mesurer( 
+			creer_table_arbre_b( NULL, NULL, NULL ), cles, nb_cles, "arbre_b" 
+		);
+		xfree( cles );
+	}
+	// Empêche le compilateur de supprimer les boucles mesurées.
+	if( somme == 42 ) printf( "%ld\n", somme );
+	return 0;
+}
@@ -0,0 +1,116 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Compare la reconnaissance de mots par un automate non déterministe et par
+ * sa version compilée (voir automate_compile.h), en nanosecondes par lettre 
+ * lue. L'automate a 'nb_etats' états et 'nb_transitions' transitions 
+ * aléatoires sur 26 lettres ; chaque mot part d'un seul état initial.
+ *
+ * Usage : bench_automate_compile [nb_etats] [nb_transitions] [nb_mots]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "automate.h"
+#include "automate_compile.h"
+#include "outils.h"
+#include "tests/aleatoire.h"
+#include "bench/chronometre.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define LONGUEUR_MOT 64
+
+int main( int argc, char* argv[] ){
+	int nb_etats = argc > 1 ? atoi( argv[1] ) : 100000;
+	int nb_transitions = argc > 2 ? atoi( argv[2] ) : 1000000;
+	int nb_mots = argc > 3 ? atoi( argv[3] ) : 2000;
+	uint64_t graine = 88172645463325252ull;
+	int i, j;
+	double debut;
+
+	Automate* automate = creer_automate();
+	for( i=0; i<nb_transitions; i++ ){
+		ajouter_transition(
+			automate, aleatoire( &graine ) % nb_etats, 
+			'a' + aleatoire( &graine ) % 26, aleatoire( &graine ) % nb_etats
+		);
+	}
+	for( i=0; i<nb_etats; i += 2 ){
+		ajouter_etat_final( automate, i );
+	}
+	ajouter_etat_initial( automate, 0 );
+
+	debut = maintenant();
+	Automate_compile* compile = compiler_automate( automate );
+	printf( "compiler_automate : %.1f ms\n", ( maintenant() - debut ) / 1e6 );
+
+	// Des mots lisibles depuis l'état initial, pour que la lecture ne 
+	// s'arrête pas dès les premières lettres.
+	char (*mots)[LONGUEUR_MOT + 1] = xmalloc( nb_mots * sizeof(*mots) );
+	for( i=0; i<nb_mots; i++ ){
+		int etat = 0;
+		for( j=0; j<LONGUEUR_MOT; j++ ){
+			int numero = numero_de_l_etat( compile, etat );
+			int lettre, essais;
+			for( essais=0; essais<26; essais++ ){
+				lettre = aleatoire( &graine ) % 26;
+				size_t ligne = (size_t) lettre * compile->nb_etats + numero;
+				if( compile->debuts[ligne] < compile->debuts[ligne+1] ){
+					etat = compile->etats[ compile->fins[ compile->debuts[ligne] ] ];
+					break;
+				}
+			}
+			mots[i][j] = 'a' + lettre;
+		}
+		mots[i][LONGUEUR_MOT] = '\0';
+	}
+
+	long reconnus = 0;
+	debut = maintenant();
+	for( i=0; i<nb_mots; i++ ){
+		reconnus += le_mot_est_reconnu( automate, mots[i] );
+	}
+	printf(
+		"le_mot_est_reconnu          : %8.1f ns/lettre\n",
+		( maintenant() - debut ) / ( (double) nb_mots * LONGUEUR_MOT )
+	);
+
+	debut = maintenant();
+	for( i=0; i<nb_mots; i++ ){
+		reconnus -= le_mot_est_reconnu_compile( compile, mots[i] );
+	}
+	printf(
+		"le_mot_est_reconnu_compile  : %8.1f ns/lettre\n",
+		( maintenant() - debut ) / ( (double) nb_mots * LONGUEUR_MOT )
+	);
+
+	xfree( mots );
+	liberer_automate_compile( compile );
+	liberer_automate( automate );
+	if( reconnus != 0 ){
+		fprintf( stderr, "Les deux automates ne reconnaissent pas les mêmes mots.\n" );
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,109 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Compare la reconnaissance d'un texte par un automate déterministe complet,
+ * par sa version compilée et par sa table dense (voir automate_compile.h),
+ * en nanosecondes par octet lu. L'automate a 'nb_etats' états et 26 
+ * lettres, qui ne forment que 8 classes : la lettre 'a' + l se comporte 
+ * comme la lettre 'a' + l % 8.
+ *
+ * Usage : bench_automate_dense [nb_etats] [longueur_texte]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "automate.h"
+#include "automate_compile.h"
+#include "outils.h"
+#include "tests/aleatoire.h"
+#include "bench/chronometre.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+int main( int argc, char* argv[] ){
+	int nb_etats = argc > 1 ? atoi( argv[1] ) : 1000;
+	int longueur = argc > 2 ? atoi( argv[2] ) : 1000000;
+	uint64_t graine = 88172645463325252ull;
+	int i, l;
+	double debut;
+
+	Automate* automate = creer_automate();
+	for( i=0; i<nb_etats; i++ ){
+		int fins[8];
+		for( l=0; l<8; l++ ){
+			fins[l] = aleatoire( &graine ) % nb_etats;
+		}
+		for( l=0; l<26; l++ ){
+			ajouter_transition( automate, i, 'a' + l, fins[ l % 8 ] );
+		}
+		if( aleatoire( &graine ) % 2 ) ajouter_etat_final( automate, i );
+	}
+	ajouter_etat_initial( automate, 0 );
+
+	char* texte = xmalloc( longueur + 1 );
+	for( i=0; i<longueur; i++ ){
+		texte[i] = 'a' + aleatoire( &graine ) % 26;
+	}
+	texte[longueur] = '\0';
+
+	debut = maintenant();
+	Automate_compile* compile = compiler_automate( automate );
+	printf( "compiler_automate       : %8.1f ms\n", ( maintenant() - debut ) / 1e6 );
+	debut = maintenant();
+	Automate_dense* dense = compiler_automate_dense( automate );
+	printf( 
+		"compiler_automate_dense : %8.1f ms (%d classes, %zu octets)\n", 
+		( maintenant() - debut ) / 1e6, dense->nb_classes,
+		(size_t) dense->nb_etats * dense->nb_classes * sizeof(uint32_t)
+	);
+
+	int reconnus = 0;
+	debut = maintenant();
+	reconnus += le_mot_est_reconnu( automate, texte );
+	printf(
+		"le_mot_est_reconnu         : %8.2f ns/octet\n",
+		( maintenant() - debut ) / longueur
+	);
+	debut = maintenant();
+	reconnus += le_mot_est_reconnu_compile( compile, texte );
+	printf(
+		"le_mot_est_reconnu_compile : %8.2f ns/octet\n",
+		( maintenant() - debut ) / longueur
+	);
+	debut = maintenant();
+	reconnus += le_mot_est_reconnu_dense( dense, texte );
+	printf(
+		"le_mot_est_reconnu_dense   : %8.2f ns/octet\n",
+		( maintenant() - debut ) / longueur
+	);
+
+	xfree( texte );
+	liberer_automate_dense( dense );
+	liberer_automate_compile( compile );
+	liberer_automate( automate );
+	if( reconnus % 3 != 0 ){
+		fprintf( stderr, "Les trois automates ne reconnaissent pas le texte.\n" );
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,121 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Pour chaque version des opérations sur les tableaux de bits (scalaire, 
+ * SSE4, AVX2) que le processeur sait exécuter, mesure :
+ *   - le débit de bitset_ajouter() et de bitset_popcount(), en Go/s, sur 
+ *     des tableaux de 'nombre_de_mots' mots ;
+ *   - le temps de le_mot_est_reconnu() sur un grand automate non 
+ *     déterministe, dont chaque état mène à une centaine d'états voisins.
+ *
+ * Usage : bench_bitset [nombre_de_mots] [nombre_d_etats]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "automate.h"
+#include "bitset.h"
+#include "outils.h"
+#include "tests/aleatoire.h"
+#include "bench/chronometre.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static const char* nom_des_noyaux( Bitset_noyaux noyaux ){
+	switch( noyaux ){
+		case BITSET_NOYAUX_SCALAIRES : return "scalaires";
+		case BITSET_NOYAUX_SSE4 : return "SSE4";
+		case BITSET_NOYAUX_AVX2 : return "AVX2";
+		default : return "?";
+	}
+}
+
+int main( int argc, char* argv[] ){
+	size_t nb_mots = argc > 1 ? strtoul( argv[1], NULL, 10 ) : 1 << 14;
+	int nb_etats = argc > 2 ? atoi( argv[2] ) : 4096;
+	uint64_t graine = 88172645463325252ULL;
+	size_t i;
+
+	uint64_t* a = xmalloc( nb_mots * sizeof(uint64_t) );
+	uint64_t* b = xmalloc( nb_mots * sizeof(uint64_t) );
+	for( i=0; i<nb_mots; i++ ){
+		a[i] = aleatoire( &graine ) & aleatoire( &graine );
+		b[i] = aleatoire( &graine );
+	}
+
+	Automate* automate = creer_automate();
+	int e, k;
+	for( e=0; e<nb_etats; e++ ){
+		for( k=0; k<100; k++ ){
+			int fin = ( e + aleatoire( &graine ) % 1024 ) % nb_etats;
+			ajouter_transition( automate, e, 'a' + ( k & 1 ), fin );
+		}
+	}
+	ajouter_etat_initial( automate, 0 );
+	ajouter_etat_final( automate, nb_etats - 1 );
+	char mot[201];
+	for( i=0; i<200; i++ ){
+		mot[i] = 'a' + ( aleatoire( &graine ) & 1 );
+	}
+	mot[200] = '\0';
+
+	Bitset_noyaux noyaux;
+	for( 
+		noyaux = BITSET_NOYAUX_SCALAIRES; noyaux <= BITSET_NOYAUX_AVX2; 
+		noyaux++ 
+	){
+		if( ! bitset_choisir_noyaux( noyaux ) ){
+			continue;
+		}
+		size_t nb_tours = ( (size_t) 1 << 28 ) / ( nb_mots + 1 );
+		size_t total = 0;
+		double debut = maintenant();
+		for( i=0; i<nb_tours; i++ ){
+			total += bitset_ajouter( b, a, nb_mots );
+			b[ i % nb_mots ] = 0;
+		}
+		double duree_ajouter = maintenant() - debut;
+		debut = maintenant();
+		for( i=0; i<nb_tours; i++ ){
+			total += bitset_popcount( a, nb_mots );
+		}
+		double duree_popcount = maintenant() - debut;
+		double octets = (double) nb_tours * nb_mots * sizeof(uint64_t);
+
+		debut = maintenant();
+		int reconnu = le_mot_est_reconnu( automate, mot );
+		double duree_reconnu = maintenant() - debut;
+
+		printf( 
+			"%-10s ajouter : %6.2f Go/s   popcount : %6.2f Go/s   "
+			"le_mot_est_reconnu : %8.2f ms (%d, %zu)\n",
+			nom_des_noyaux( noyaux ),
+			2 * octets / duree_ajouter, octets / duree_popcount,
+			duree_reconnu / 1e6, reconnu, total & 1
+		);
+	}
+
+	liberer_automate( automate );
+	xfree( a );
+	xfree( b );
+	return 0;
+}
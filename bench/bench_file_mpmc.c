@@ -0,0 +1,161 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Mesure le débit d'une File_mpmc et d'une File_bloquante, en millions 
+ * d'éléments transmis par seconde, avec de 1 à N producteurs et autant de 
+ * consommateurs. Chaque producteur ajoute le même nombre d'éléments.
+ *
+ * Par défaut, N est le nombre de processeurs disponibles (au moins 2). Sur 
+ * une machine qui a moins de processeurs que de threads, les threads qui 
+ * attendent cèdent le processeur (sched_yield) : les mesures restent 
+ * possibles mais ne disent rien du passage à l'échelle.
+ *
+ * Usage : bench_file_mpmc [nombre_max_de_threads] [elements_par_producteur]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "file_mpmc.h"
+#include "outils.h"
+#include "bench/chronometre.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define CAPACITE 1024
+
+typedef struct {
+	File_mpmc* file;
+	File_bloquante* bloquante;
+	long nb_elements;
+	atomic_long* restants;
+	long somme;
+} Travailleur;
+
+void* produire( void* data ){
+	Travailleur* t = (Travailleur*) data;
+	long i;
+	for( i=1; i<=t->nb_elements; i++ ){
+		if( t->bloquante ){
+			ajouter_file_bloquante( t->bloquante, i );
+		}else{
+			while( ! ajouter_file_mpmc( t->file, i ) ){
+				sched_yield();
+			}
+		}
+	}
+	return NULL;
+}
+
+void* consommer( void* data ){
+	Travailleur* t = (Travailleur*) data;
+	intptr_t element;
+	t->somme = 0;
+	if( t->bloquante ){
+		while( retirer_file_bloquante( t->bloquante, &element ) ){
+			t->somme += element;
+		}
+		return NULL;
+	}
+	while( atomic_load_explicit( t->restants, memory_order_relaxed ) > 0 ){
+		if( retirer_file_mpmc( t->file, &element ) ){
+			atomic_fetch_sub_explicit( t->restants, 1, memory_order_relaxed );
+			t->somme += element;
+		}else{
+			sched_yield();
+		}
+	}
+	return NULL;
+}
+
+/*
+ * Fait passer nb_threads * nb_elements éléments par la file et renvoie le
+ * débit mesuré, ou -1 si des éléments ont été perdus.
+ */
+double mesurer( int nb_threads, long nb_elements, int bloquante ){
+	int i;
+	pthread_t* threads = xmalloc( 2 * nb_threads * sizeof(pthread_t) );
+	Travailleur* t = xmalloc( 2 * nb_threads * sizeof(Travailleur) );
+	File_mpmc* file = bloquante ? NULL : creer_file_mpmc( CAPACITE );
+	File_bloquante* fb = bloquante ? creer_file_bloquante( CAPACITE ) : NULL;
+	atomic_long restants;
+	atomic_init( &restants, nb_threads * nb_elements );
+
+	double debut = maintenant();
+	for( i=0; i<2*nb_threads; i++ ){
+		t[i].file = file;
+		t[i].bloquante = fb;
+		t[i].nb_elements = nb_elements;
+		t[i].restants = &restants;
+		pthread_create( 
+			&threads[i], NULL, i < nb_threads ? produire : consommer, &t[i] 
+		);
+	}
+	for( i=0; i<nb_threads; i++ ){
+		pthread_join( threads[i], NULL );
+	}
+	if( fb ){
+		fermer_file_bloquante( fb );
+	}
+	long somme = 0;
+	for( i=nb_threads; i<2*nb_threads; i++ ){
+		pthread_join( threads[i], NULL );
+		somme += t[i].somme;
+	}
+	double duree = maintenant() - debut;
+
+	liberer_file_mpmc( file );
+	liberer_file_bloquante( fb );
+	xfree( t );
+	xfree( threads );
+	if( somme != nb_threads * ( nb_elements * ( nb_elements + 1 ) / 2 ) ){
+		return -1;
+	}
+	return nb_threads * nb_elements / duree * 1e3;
+}
+
+int main( int argc, char* argv[] ){
+	long nb_processeurs = sysconf( _SC_NPROCESSORS_ONLN );
+	int max_threads = argc > 1 ? atoi( argv[1] ) : 
+		( nb_processeurs > 2 ? nb_processeurs : 2 );
+	long nb_elements = argc > 2 ? atol( argv[2] ) : 1000000;
+	int n;
+
+	printf( "%ld processeur(s)\n", nb_processeurs );
+	for( n=1; n<=max_threads; n++ ){
+		double debit = mesurer( n, nb_elements, 0 );
+		double debit_bloquante = mesurer( n, nb_elements, 1 );
+		if( debit < 0 || debit_bloquante < 0 ){
+			fprintf( stderr, "Des éléments ont été perdus.\n" );
+			return 1;
+		}
+		printf( 
+			"%2d producteur(s), %2d consommateur(s) : "
+			"File_mpmc %7.2f M/s, File_bloquante %7.2f M/s\n",
+			n, n, debit, debit_bloquante
+		);
+	}
+	return 0;
+}
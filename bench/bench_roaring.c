@@ -0,0 +1,126 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*
+ * Compare, pour deux ensembles de 'nb' entiers épars (des identifiants 
+ * d'états produits, de la forme ( i << 24 ) | j), la représentation 
+ * compressée (ENSEMBLE_COMPRESSE) à un arbre AVL (ENSEMBLE_ARBRE) :
+ *   - la mémoire allouée par ensemble, en octets par élément, si la 
+ *     bibliothèque compte ses allocations (make STATISTIQUES=1) ;
+ *   - le temps de l'union, de l'intersection et de ensembles_se_coupent().
+ *
+ * Usage : bench_roaring [nb]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ensemble.h"
+#include "outils.h"
+#include "tests/aleatoire.h"
+#include "bench/chronometre.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// Un comparateur explicite suffit à imposer un arbre.
+static int comparer_entiers( const intptr_t a, const intptr_t b ){
+	return ( a > b ) - ( a < b );
+}
+
+/*
+ * Remplit 'elements' de 'nb' entiers triés : pour chaque i, une suite de 
+ * j en grande partie contiguë, avec des trous.
+ */
+static void remplir( intptr_t* elements, size_t nb, uint64_t* graine ){
+	size_t k = 0;
+	intptr_t i = 0, j = 0;
+	while( k < nb ){
+		j += 1 + ( aleatoire( graine ) % 4 == 0 ) * ( aleatoire( graine ) % 64 );
+		if( j >= 1 << 18 ){
+			i++;
+			j = aleatoire( graine ) % 16;
+		}
+		elements[k++] = ( i << 24 ) | j;
+	}
+}
+
+static void mesurer(
+	const char* nom,
+	int (*comparer)( const intptr_t, const intptr_t ),
+	const intptr_t* elements_a, const intptr_t* elements_b, size_t nb
+){
+#ifdef OUTILS_STATISTIQUES
+	size_t avant = statistiques_memoire().octets_vivants;
+#endif
+	Ensemble* a = creer_ensemble_depuis_tableau(
+		comparer, NULL, NULL, elements_a, nb
+	);
+#ifdef OUTILS_STATISTIQUES
+	size_t memoire = statistiques_memoire().octets_vivants - avant;
+#endif
+	Ensemble* b = creer_ensemble_depuis_tableau(
+		comparer, NULL, NULL, elements_b, nb
+	);
+
+	double debut = maintenant();
+	Ensemble* u = creer_union_ensemble( a, b );
+	double t_union = maintenant() - debut;
+
+	debut = maintenant();
+	Ensemble* inter = creer_intersection_ensemble( a, b );
+	double t_inter = maintenant() - debut;
+
+	debut = maintenant();
+	int se_coupent = ensembles_se_coupent( a, b );
+	double t_coupe = maintenant() - debut;
+
+	printf( "%-10s ", nom );
+#ifdef OUTILS_STATISTIQUES
+	printf( "%8.2f o/élt   ", (double) memoire / nb );
+#endif
+	printf(
+		"union %8.2f ms (%u)   intersection %8.2f ms (%u)"
+		"   se_coupent %8.3f ms (%d)\n",
+		t_union / 1e6, taille_ensemble( u ),
+		t_inter / 1e6, taille_ensemble( inter ), t_coupe / 1e6, se_coupent
+	);
+
+	liberer_ensemble( inter );
+	liberer_ensemble( u );
+	liberer_ensemble( b );
+	liberer_ensemble( a );
+}
+
+int main( int argc, char* argv[] ){
+	size_t nb = argc > 1 ? strtoul( argv[1], NULL, 10 ) : 1000000;
+	uint64_t graine = 88172645463325252ULL;
+
+	intptr_t* a = xmalloc( nb * sizeof(intptr_t) );
+	intptr_t* b = xmalloc( nb * sizeof(intptr_t) );
+	remplir( a, nb, &graine );
+	remplir( b, nb, &graine );
+
+	printf( "%zu éléments par ensemble\n", nb );
+	mesurer( "compressé", NULL, a, b, nb );
+	mesurer( "arbre", comparer_entiers, a, b, nb );
+
+	xfree( a );
+	xfree( b );
+	return 0;
+}
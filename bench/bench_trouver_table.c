@@ -0,0 +1,171 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Mesure le temps moyen d'une recherche dans une table, en nanosecondes :
+ *   - dans une table dont les clés sont des entiers ;
+ *   - dans une table dont les clés sont des couples alloués, comme la table
+ *     des transitions d'un automate ;
+ *   - pour ces deux tables, codées par un arbre puis par une table de 
+ *     hachage ;
+ *   - à travers est_une_transition_de_l_automate(), qui passe par voisins().
+ *
+ * Usage : bench_trouver_table [nombre_de_cles] [nombre_de_recherches]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "automate.h"
+#include "table.h"
+#include "outils.h"
+#include "bench/chronometre.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+typedef struct {
+	int x;
+	int y;
+} Couple;
+
+int comparer_couple( const Couple* a, const Couple* b ){
+	if( a->x != b->x ) return a->x < b->x ? -1 : 1;
+	if( a->y != b->y ) return a->y < b->y ? -1 : 1;
+	return 0;
+}
+
+Couple* copier_couple( const Couple* c ){
+	Couple* res = xmalloc( sizeof(Couple) );
+	*res = *c;
+	return res;
+}
+
+void supprimer_couple( Couple* c ){
+	xfree( c );
+}
+
+size_t hacher_couple( const Couple* c ){
+	return (size_t) c->x * 31 + c->y;
+}
+
+long mesurer_entiers(
+	Table* entiers, int nb_cles, int nb_recherches, const char* nom
+){
+	int i;
+	long trouves = 0;
+	for( i=0; i<nb_cles; i++ ){
+		add_table( entiers, i, i );
+	}
+	double debut = maintenant();
+	for( i=0; i<nb_recherches; i++ ){
+		trouves += ! iterateur_est_vide(
+			trouver_table( entiers, (int) ( ( i * 7919L ) % nb_cles ) )
+		);
+	}
+	printf(
+		"%-36s: %8.1f ns/recherche\n", nom,
+		( maintenant() - debut ) / nb_recherches
+	);
+	liberer_table( entiers );
+	return trouves;
+}
+
+long mesurer_couples(
+	Table* couples, int nb_cles, int nb_recherches, const char* nom
+){
+	int i;
+	long trouves = 0;
+	Couple c;
+	for( i=0; i<nb_cles; i++ ){
+		c.x = i / 26;
+		c.y = i % 26;
+		add_table( couples, (intptr_t) &c, i );
+	}
+	double debut = maintenant();
+	for( i=0; i<nb_recherches; i++ ){
+		int k = (int) ( ( i * 7919L ) % nb_cles );
+		c.x = k / 26;
+		c.y = k % 26;
+		trouves += ! iterateur_est_vide( trouver_table( couples, (intptr_t) &c ) );
+	}
+	printf(
+		"%-36s: %8.1f ns/recherche\n", nom,
+		( maintenant() - debut ) / nb_recherches
+	);
+	liberer_table( couples );
+	return trouves;
+}
+
+int main( int argc, char* argv[] ){
+	int nb_cles = argc > 1 ? atoi( argv[1] ) : 100000;
+	int nb_recherches = argc > 2 ? atoi( argv[2] ) : 1000000;
+	int i;
+	long trouves = 0;
+	double debut;
+
+	trouves += mesurer_entiers(
+		creer_table( NULL, NULL, NULL ), nb_cles, nb_recherches,
+		"trouver_table (cles entieres)"
+	);
+	trouves += mesurer_entiers(
+		creer_table_de_hachage( NULL, NULL, NULL, NULL ), 
+		nb_cles, nb_recherches, "trouver_table (entieres, hachage)"
+	);
+	trouves += mesurer_couples(
+		creer_table(
+			(int (*)( const intptr_t, const intptr_t )) comparer_couple,
+			(intptr_t (*)( const intptr_t )) copier_couple,
+			(void (*)( intptr_t )) supprimer_couple
+		),
+		nb_cles, nb_recherches, "trouver_table (cles copiees)"
+	);
+	trouves += mesurer_couples(
+		creer_table_de_hachage(
+			(int (*)( const intptr_t, const intptr_t )) comparer_couple,
+			(intptr_t (*)( const intptr_t )) copier_couple,
+			(void (*)( intptr_t )) supprimer_couple,
+			(size_t (*)( const intptr_t )) hacher_couple
+		),
+		nb_cles, nb_recherches, "trouver_table (copiees, hachage)"
+	);
+
+	Automate* automate = creer_automate();
+	for( i=0; i<nb_cles; i++ ){
+		ajouter_transition( automate, i / 26, 'a' + i % 26, i / 26 + 1 );
+	}
+	debut = maintenant();
+	for( i=0; i<nb_recherches; i++ ){
+		int k = (int) ( ( i * 7919L ) % nb_cles );
+		trouves += est_une_transition_de_l_automate(
+			automate, k / 26, 'a' + k % 26, k / 26 + 1
+		);
+	}
+	printf(
+		"%-36s: %8.1f ns/recherche\n", "est_une_transition_de_l_automate",
+		( maintenant() - debut ) / nb_recherches
+	);
+	liberer_automate( automate );
+
+	if( trouves != 5L * nb_recherches ){
+		fprintf( stderr, "Des recherches ont échoué.\n" );
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,40 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Chronomètre partagé par les mesures de performance.
+ *
+ * clock_gettime() n'est déclarée que si _POSIX_C_SOURCE est défini avant 
+ * le premier en-tête système : chaque bench_*.c le définit en tête.
+ */
+
+#ifndef __CHRONOMETRE_H__
+#define __CHRONOMETRE_H__
+
+#include <time.h>
+
+/* Renvoie le temps écoulé depuis une origine arbitraire, en nanosecondes. */
+static inline double maintenant( void ){
+	struct timespec t;
+	clock_gettime( CLOCK_MONOTONIC, &t );
+	return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+#endif
@@ -0,0 +1,671 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bitset.h"
+
+#include <stdatomic.h>
+
+#if defined( __x86_64__ ) && defined( __GNUC__ )
+#define BITSET_X86_64
+#include <immintrin.h>
+#endif
+
+/*
+ * Les opérations sur des tableaux entiers de mots (union, intersection, 
+ * comptage, ...) existent en trois versions : scalaire, SSE4 et AVX2. La 
+ * meilleure version que le processeur sait exécuter est choisie au premier
+ * appel ; bitset_choisir_noyaux() permet d'en imposer une autre.
+ */
+typedef struct {
+	void (*union_)( uint64_t*, const uint64_t*, const uint64_t*, size_t );
+	void (*intersection)( uint64_t*, const uint64_t*, const uint64_t*, size_t );
+	void (*difference)( uint64_t*, const uint64_t*, const uint64_t*, size_t );
+	size_t (*ajouter)( uint64_t*, const uint64_t*, size_t );
+	size_t (*retirer)( uint64_t*, const uint64_t*, size_t );
+	size_t (*popcount)( const uint64_t*, size_t );
+	int (*est_inclus)( const uint64_t*, const uint64_t*, size_t );
+	int (*egaux)( const uint64_t*, const uint64_t*, size_t );
+	int (*se_coupent)( const uint64_t*, const uint64_t*, size_t );
+	int (*est_nul)( const uint64_t*, size_t );
+} Noyaux_bitset;
+
+/*
+ * Versions scalaires.
+ */
+
+static void union_scalaire(
+	uint64_t* dest, const uint64_t* a, const uint64_t* b, size_t nb_mots
+){
+	size_t i;
+	for( i=0; i<nb_mots; i++ ){
+		dest[i] = a[i] | b[i];
+	}
+}
+
+static void intersection_scalaire(
+	uint64_t* dest, const uint64_t* a, const uint64_t* b, size_t nb_mots
+){
+	size_t i;
+	for( i=0; i<nb_mots; i++ ){
+		dest[i] = a[i] & b[i];
+	}
+}
+
+static void difference_scalaire(
+	uint64_t* dest, const uint64_t* a, const uint64_t* b, size_t nb_mots
+){
+	size_t i;
+	for( i=0; i<nb_mots; i++ ){
+		dest[i] = a[i] & ~b[i];
+	}
+}
+
+static size_t ajouter_scalaire(
+	uint64_t* dest, const uint64_t* source, size_t nb_mots
+){
+	size_t res = 0;
+	size_t i;
+	for( i=0; i<nb_mots; i++ ){
+		res += __builtin_popcountll( source[i] & ~dest[i] );
+		dest[i] |= source[i];
+	}
+	return res;
+}
+
+static size_t retirer_scalaire(
+	uint64_t* dest, const uint64_t* source, size_t nb_mots
+){
+	size_t res = 0;
+	size_t i;
+	for( i=0; i<nb_mots; i++ ){
+		res += __builtin_popcountll( source[i] & dest[i] );
+		dest[i] &= ~source[i];
+	}
+	return res;
+}
+
+static size_t popcount_scalaire( const uint64_t* mots, size_t nb_mots ){
+	size_t res = 0;
+	size_t i;
+	for( i=0; i<nb_mots; i++ ){
+		res += __builtin_popcountll( mots[i] );
+	}
+	return res;
+}
+
+static int est_inclus_scalaire(
+	const uint64_t* a, const uint64_t* b, size_t nb_mots
+){
+	size_t i;
+	for( i=0; i<nb_mots; i++ ){
+		if( a[i] & ~b[i] ) return 0;
+	}
+	return 1;
+}
+
+static int egaux_scalaire(
+	const uint64_t* a, const uint64_t* b, size_t nb_mots
+){
+	size_t i;
+	for( i=0; i<nb_mots; i++ ){
+		if( a[i] != b[i] ) return 0;
+	}
+	return 1;
+}
+
+static int se_coupent_scalaire(
+	const uint64_t* a, const uint64_t* b, size_t nb_mots
+){
+	size_t i;
+	for( i=0; i<nb_mots; i++ ){
+		if( a[i] & b[i] ) return 1;
+	}
+	return 0;
+}
+
+static int est_nul_scalaire( const uint64_t* mots, size_t nb_mots ){
+	size_t i;
+	for( i=0; i<nb_mots; i++ ){
+		if( mots[i] ) return 0;
+	}
+	return 1;
+}
+
+static const Noyaux_bitset noyaux_scalaires = {
+	union_scalaire, intersection_scalaire, difference_scalaire,
+	ajouter_scalaire, retirer_scalaire, popcount_scalaire,
+	est_inclus_scalaire, egaux_scalaire, se_coupent_scalaire, est_nul_scalaire
+};
+
+#ifdef BITSET_X86_64
+
+/*
+ * Versions SSE4 : des registres de 128 bits, ptest (SSE4.1) pour les tests
+ * et l'instruction popcnt pour les comptages.
+ */
+
+#define BITSET_SSE4 \
+	__attribute__(( target( "sse4.2,popcnt" ) ))
+
+BITSET_SSE4
+static void union_sse4(
+	uint64_t* dest, const uint64_t* a, const uint64_t* b, size_t nb_mots
+){
+	size_t i;
+	for( i=0; i+2<=nb_mots; i+=2 ){
+		__m128i x = _mm_loadu_si128( (const __m128i*) ( a + i ) );
+		__m128i y = _mm_loadu_si128( (const __m128i*) ( b + i ) );
+		_mm_storeu_si128( (__m128i*) ( dest + i ), _mm_or_si128( x, y ) );
+	}
+	union_scalaire( dest + i, a + i, b + i, nb_mots - i );
+}
+
+BITSET_SSE4
+static void intersection_sse4(
+	uint64_t* dest, const uint64_t* a, const uint64_t* b, size_t nb_mots
+){
+	size_t i;
+	for( i=0; i+2<=nb_mots; i+=2 ){
+		__m128i x = _mm_loadu_si128( (const __m128i*) ( a + i ) );
+		__m128i y = _mm_loadu_si128( (const __m128i*) ( b + i ) );
+		_mm_storeu_si128( (__m128i*) ( dest + i ), _mm_and_si128( x, y ) );
+	}
+	intersection_scalaire( dest + i, a + i, b + i, nb_mots - i );
+}
+
+BITSET_SSE4
+static void difference_sse4(
+	uint64_t* dest, const uint64_t* a, const uint64_t* b, size_t nb_mots
+){
+	size_t i;
+	for( i=0; i+2<=nb_mots; i+=2 ){
+		__m128i x = _mm_loadu_si128( (const __m128i*) ( a + i ) );
+		__m128i y = _mm_loadu_si128( (const __m128i*) ( b + i ) );
+		_mm_storeu_si128( (__m128i*) ( dest + i ), _mm_andnot_si128( y, x ) );
+	}
+	difference_scalaire( dest + i, a + i, b + i, nb_mots - i );
+}
+
+BITSET_SSE4
+static size_t ajouter_sse4(
+	uint64_t* dest, const uint64_t* source, size_t nb_mots
+){
+	size_t res = 0;
+	size_t i;
+	for( i=0; i<nb_mots; i++ ){
+		res += _mm_popcnt_u64( source[i] & ~dest[i] );
+		dest[i] |= source[i];
+	}
+	return res;
+}
+
+BITSET_SSE4
+static size_t retirer_sse4(
+	uint64_t* dest, const uint64_t* source, size_t nb_mots
+){
+	size_t res = 0;
+	size_t i;
+	for( i=0; i<nb_mots; i++ ){
+		res += _mm_popcnt_u64( source[i] & dest[i] );
+		dest[i] &= ~source[i];
+	}
+	return res;
+}
+
+BITSET_SSE4
+static size_t popcount_sse4( const uint64_t* mots, size_t nb_mots ){
+	// Quatre sommes indépendantes, pour que les popcnt s'enchaînent sans 
+	// s'attendre.
+	size_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+	size_t i;
+	for( i=0; i+4<=nb_mots; i+=4 ){
+		s0 += _mm_popcnt_u64( mots[i] );
+		s1 += _mm_popcnt_u64( mots[i+1] );
+		s2 += _mm_popcnt_u64( mots[i+2] );
+		s3 += _mm_popcnt_u64( mots[i+3] );
+	}
+	for( ; i<nb_mots; i++ ){
+		s0 += _mm_popcnt_u64( mots[i] );
+	}
+	return s0 + s1 + s2 + s3;
+}
+
+BITSET_SSE4
+static int est_inclus_sse4(
+	const uint64_t* a, const uint64_t* b, size_t nb_mots
+){
+	size_t i;
+	for( i=0; i+2<=nb_mots; i+=2 ){
+		__m128i x = _mm_loadu_si128( (const __m128i*) ( a + i ) );
+		__m128i y = _mm_loadu_si128( (const __m128i*) ( b + i ) );
+		if( ! _mm_testc_si128( y, x ) ) return 0;
+	}
+	return est_inclus_scalaire( a + i, b + i, nb_mots - i );
+}
+
+BITSET_SSE4
+static int egaux_sse4(
+	const uint64_t* a, const uint64_t* b, size_t nb_mots
+){
+	size_t i;
+	for( i=0; i+2<=nb_mots; i+=2 ){
+		__m128i x = _mm_loadu_si128( (const __m128i*) ( a + i ) );
+		__m128i y = _mm_loadu_si128( (const __m128i*) ( b + i ) );
+		__m128i d = _mm_xor_si128( x, y );
+		if( ! _mm_testz_si128( d, d ) ) return 0;
+	}
+	return egaux_scalaire( a + i, b + i, nb_mots - i );
+}
+
+BITSET_SSE4
+static int se_coupent_sse4(
+	const uint64_t* a, const uint64_t* b, size_t nb_mots
+){
+	size_t i;
+	for( i=0; i+2<=nb_mots; i+=2 ){
+		__m128i x = _mm_loadu_si128( (const __m128i*) ( a + i ) );
+		__m128i y = _mm_loadu_si128( (const __m128i*) ( b + i ) );
+		if( ! _mm_testz_si128( x, y ) ) return 1;
+	}
+	return se_coupent_scalaire( a + i, b + i, nb_mots - i );
+}
+
+BITSET_SSE4
+static int est_nul_sse4( const uint64_t* mots, size_t nb_mots ){
+	size_t i;
+	for( i=0; i+2<=nb_mots; i+=2 ){
+		__m128i x = _mm_loadu_si128( (const __m128i*) ( mots + i ) );
+		if( ! _mm_testz_si128( x, x ) ) return 0;
+	}
+	return est_nul_scalaire( mots + i, nb_mots - i );
+}
+
+static const Noyaux_bitset noyaux_sse4 = {
+	union_sse4, intersection_sse4, difference_sse4,
+	ajouter_sse4, retirer_sse4, popcount_sse4,
+	est_inclus_sse4, egaux_sse4, se_coupent_sse4, est_nul_sse4
+};
+
+/*
+ * Versions AVX2 : des registres de 256 bits. Les comptages se font dans 
+ * les registres, octet par octet, en cherchant le nombre de bits de chaque 
+ * quartet dans une table de 16 valeurs (vpshufb), puis en sommant les 
+ * octets par groupes de 8 (vpsadbw).
+ */
+
+#define BITSET_AVX2 \
+	__attribute__(( target( "avx2,popcnt" ) ))
+
+BITSET_AVX2 __attribute__(( always_inline ))
+static inline __m256i popcount_octets_avx2( __m256i x ){
+	const __m256i table = _mm256_setr_epi8(
+		0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+		0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4
+	);
+	const __m256i quartet = _mm256_set1_epi8( 0x0f );
+	__m256i bas = _mm256_and_si256( x, quartet );
+	__m256i haut = _mm256_and_si256( _mm256_srli_epi16( x, 4 ), quartet );
+	return _mm256_add_epi8(
+		_mm256_shuffle_epi8( table, bas ), _mm256_shuffle_epi8( table, haut )
+	);
+}
+
+BITSET_AVX2 __attribute__(( always_inline ))
+static inline __m256i accumuler_popcount_avx2( __m256i somme, __m256i x ){
+	return _mm256_add_epi64(
+		somme, 
+		_mm256_sad_epu8( popcount_octets_avx2( x ), _mm256_setzero_si256() )
+	);
+}
+
+BITSET_AVX2 __attribute__(( always_inline ))
+static inline size_t somme_avx2( __m256i somme ){
+	return (size_t) _mm256_extract_epi64( somme, 0 ) +
+		(size_t) _mm256_extract_epi64( somme, 1 ) +
+		(size_t) _mm256_extract_epi64( somme, 2 ) +
+		(size_t) _mm256_extract_epi64( somme, 3 );
+}
+
+BITSET_AVX2
+static void union_avx2(
+	uint64_t* dest, const uint64_t* a, const uint64_t* b, size_t nb_mots
+){
+	size_t i;
+	for( i=0; i+4<=nb_mots; i+=4 ){
+		__m256i x = _mm256_loadu_si256( (const __m256i*) ( a + i ) );
+		__m256i y = _mm256_loadu_si256( (const __m256i*) ( b + i ) );
+		_mm256_storeu_si256( (__m256i*) ( dest + i ), _mm256_or_si256( x, y ) );
+	}
+	union_scalaire( dest + i, a + i, b + i, nb_mots - i );
+}
+
+BITSET_AVX2
+static void intersection_avx2(
+	uint64_t* dest, const uint64_t* a, const uint64_t* b, size_t nb_mots
+){
+	size_t i;
+	for( i=0; i+4<=nb_mots; i+=4 ){
+		__m256i x = _mm256_loadu_si256( (const __m256i*) ( a + i ) );
+		__m256i y = _mm256_loadu_si256( (const __m256i*) ( b + i ) );
+		_mm256_storeu_si256( (__m256i*) ( dest + i ), _mm256_and_si256( x, y ) );
+	}
+	intersection_scalaire( dest + i, a + i, b + i, nb_mots - i );
+}
+
+BITSET_AVX2
+static void difference_avx2(
+	uint64_t* dest, const uint64_t* a, const uint64_t* b, size_t nb_mots
+){
+	size_t i;
+	for( i=0; i+4<=nb_mots; i+=4 ){
+		__m256i x = _mm256_loadu_si256( (const __m256i*) ( a + i ) );
+		__m256i y = _mm256_loadu_si256( (const __m256i*) ( b + i ) );
+		_mm256_storeu_si256( 
+			(__m256i*) ( dest + i ), _mm256_andnot_si256( y, x ) 
+		);
+	}
+	difference_scalaire( dest + i, a + i, b + i, nb_mots - i );
+}
+
+BITSET_AVX2
+static size_t ajouter_avx2(
+	uint64_t* dest, const uint64_t* source, size_t nb_mots
+){
+	__m256i somme = _mm256_setzero_si256();
+	size_t i;
+	for( i=0; i+4<=nb_mots; i+=4 ){
+		__m256i d = _mm256_loadu_si256( (const __m256i*) ( dest + i ) );
+		__m256i s = _mm256_loadu_si256( (const __m256i*) ( source + i ) );
+		somme = accumuler_popcount_avx2( somme, _mm256_andnot_si256( d, s ) );
+		_mm256_storeu_si256( (__m256i*) ( dest + i ), _mm256_or_si256( d, s ) );
+	}
+	return somme_avx2( somme ) + 
+		ajouter_sse4( dest + i, source + i, nb_mots - i );
+}
+
+BITSET_AVX2
+static size_t retirer_avx2(
+	uint64_t* dest, const uint64_t* source, size_t nb_mots
+){
+	__m256i somme = _mm256_setzero_si256();
+	size_t i;
+	for( i=0; i+4<=nb_mots; i+=4 ){
+		__m256i d = _mm256_loadu_si256( (const __m256i*) ( dest + i ) );
+		__m256i s = _mm256_loadu_si256( (const __m256i*) ( source + i ) );
+		somme = accumuler_popcount_avx2( somme, _mm256_and_si256( d, s ) );
+		_mm256_storeu_si256( 
+			(__m256i*) ( dest + i ), _mm256_andnot_si256( s, d ) 
+		);
+	}
+	return somme_avx2( somme ) + 
+		retirer_sse4( dest + i, source + i, nb_mots - i );
+}
+
+BITSET_AVX2
+static size_t popcount_avx2( const uint64_t* mots, size_t nb_mots ){
+	__m256i somme = _mm256_setzero_si256();
+	size_t i;
+	for( i=0; i+4<=nb_mots; i+=4 ){
+		somme = accumuler_popcount_avx2(
+			somme, _mm256_loadu_si256( (const __m256i*) ( mots + i ) )
+		);
+	}
+	return somme_avx2( somme ) + popcount_sse4( mots + i, nb_mots - i );
+}
+
+BITSET_AVX2
+static int est_inclus_avx2(
+	const uint64_t* a, const uint64_t* b, size_t nb_mots
+){
+	size_t i;
+	for( i=0; i+4<=nb_mots; i+=4 ){
+		__m256i x = _mm256_loadu_si256( (const __m256i*) ( a + i ) );
+		__m256i y = _mm256_loadu_si256( (const __m256i*) ( b + i ) );
+		if( ! _mm256_testc_si256( y, x ) ) return 0;
+	}
+	return est_inclus_scalaire( a + i, b + i, nb_mots - i );
+}
+
+BITSET_AVX2
+static int egaux_avx2(
+	const uint64_t* a, const uint64_t* b, size_t nb_mots
+){
+	size_t i;
+	for( i=0; i+4<=nb_mots; i+=4 ){
+		__m256i x = _mm256_loadu_si256( (const __m256i*) ( a + i ) );
+		__m256i y = _mm256_loadu_si256( (const __m256i*) ( b + i ) );
+		__m256i d = _mm256_xor_si256( x, y );
+		if( ! _mm256_testz_si256( d, d ) ) return 0;
+	}
+	return egaux_scalaire( a + i, b + i, nb_mots - i );
+}
+
+BITSET_AVX2
+static int se_coupent_avx2(
+	const uint64_t* a, const uint64_t* b, size_t nb_mots
+){
+	size_t i;
+	for( i=0; i+4<=nb_mots; i+=4 ){
+		__m256i x = _mm256_loadu_si256( (const __m256i*) ( a + i ) );
+		__m256i y = _mm256_loadu_si256( (const __m256i*) ( b + i ) );
+		if( ! _mm256_testz_si256( x, y ) ) return 1;
+	}
+	return se_coupent_scalaire( a + i, b + i, nb_mots - i );
+}
+
+BITSET_AVX2
+static int est_nul_avx2( const uint64_t* mots, size_t nb_mots ){
+	size_t i;
+	for( i=0; i+4<=nb_mots; i+=4 ){
+		__m256i x = _mm256_loadu_si256( (const __m256i*) ( mots + i ) );
+		if( ! _mm256_testz_si256( x, x ) ) return 0;
+	}
+	return est_nul_scalaire( mots + i, nb_mots - i );
+}
+
+static const Noyaux_bitset noyaux_avx2 = {
+	union_avx2, intersection_avx2, difference_avx2,
+	ajouter_avx2, retirer_avx2, popcount_avx2,
+	est_inclus_avx2, egaux_avx2, se_coupent_avx2, est_nul_avx2
+};
+
+#endif
+
+static const Noyaux_bitset* table_des_noyaux( Bitset_noyaux noyaux ){
+	switch( noyaux ){
+		case BITSET_NOYAUX_SCALAIRES :
+			return &noyaux_scalaires;
+#ifdef BITSET_X86_64
+		case BITSET_NOYAUX_SSE4 :
+			__builtin_cpu_init();
+			if( 
+				__builtin_cpu_supports( "sse4.2" ) && 
+				__builtin_cpu_supports( "popcnt" ) 
+			){
+				return &noyaux_sse4;
+			}
+			return NULL;
+		case BITSET_NOYAUX_AVX2 :
+			__builtin_cpu_init();
+			if( 
+				__builtin_cpu_supports( "avx2" ) && 
+				__builtin_cpu_supports( "popcnt" ) 
+			){
+				return &noyaux_avx2;
+			}
+			return NULL;
+#endif
+		default :
+			return NULL;
+	}
+}
+
+static _Atomic( Bitset_noyaux ) noyaux_choisis = BITSET_NOYAUX_AUCUN;
+static _Atomic( const Noyaux_bitset* ) noyaux_courants = NULL;
+
+static const Noyaux_bitset* noyaux( void ){
+	const Noyaux_bitset* res = atomic_load_explicit( 
+		&noyaux_courants, memory_order_acquire 
+	);
+	if( ! res ){
+		Bitset_noyaux n = BITSET_NOYAUX_AVX2;
+		while( ! ( res = table_des_noyaux( n ) ) ){
+			n--;
+		}
+		atomic_store( &noyaux_choisis, n );
+		atomic_store_explicit( &noyaux_courants, res, memory_order_release );
+	}
+	return res;
+}
+
+Bitset_noyaux bitset_noyaux( void ){
+	noyaux();
+	return atomic_load( &noyaux_choisis );
+}
+
+int bitset_choisir_noyaux( Bitset_noyaux choix ){
+	const Noyaux_bitset* res = table_des_noyaux( choix );
+	if( ! res ){
+		return 0;
+	}
+	atomic_store( &noyaux_choisis, choix );
+	atomic_store_explicit( &noyaux_courants, res, memory_order_release );
+	return 1;
+}
+
+void bitset_union(
+	uint64_t* dest, const uint64_t* a, const uint64_t* b, size_t nb_mots
+){
+	noyaux()->union_( dest, a, b, nb_mots );
+}
+
+void bitset_intersection(
+	uint64_t* dest, const uint64_t* a, const uint64_t* b, size_t nb_mots
+){
+	noyaux()->intersection( dest, a, b, nb_mots );
+}
+
+void bitset_difference(
+	uint64_t* dest, const uint64_t* a, const uint64_t* b, size_t nb_mots
+){
+	noyaux()->difference( dest, a, b, nb_mots );
+}
+
+size_t bitset_ajouter( uint64_t* dest, const uint64_t* source, size_t nb_mots ){
+	return noyaux()->ajouter( dest, source, nb_mots );
+}
+
+size_t bitset_retirer( uint64_t* dest, const uint64_t* source, size_t nb_mots ){
+	return noyaux()->retirer( dest, source, nb_mots );
+}
+
+size_t bitset_popcount( const uint64_t* mots, size_t nb_mots ){
+	return noyaux()->popcount( mots, nb_mots );
+}
+
+int bitset_est_inclus( const uint64_t* a, const uint64_t* b, size_t nb_mots ){
+	return noyaux()->est_inclus( a, b, nb_mots );
+}
+
+int bitset_egaux( const uint64_t* a, const uint64_t* b, size_t nb_mots ){
+	return noyaux()->egaux( a, b, nb_mots );
+}
+
+int bitset_se_coupent( const uint64_t* a, const uint64_t* b, size_t nb_mots ){
+	return noyaux()->se_coupent( a, b, nb_mots );
+}
+
+int bitset_est_nul( const uint64_t* mots, size_t nb_mots ){
+	return noyaux()->est_nul( mots, nb_mots );
+}
+
+intptr_t bitset_suivant(
+	const uint64_t* mots, size_t nb_mots, intptr_t position
+){
+	if( position < 0 ) position = 0;
+	size_t i = BITSET_MOT( position );
+	if( i >= nb_mots ) return -1;
+	uint64_t mot = mots[i] & ( ~ (uint64_t) 0 << ( position & 63 ) );
+	while( ! mot ){
+		i++;
+		if( i >= nb_mots ) return -1;
+		mot = mots[i];
+	}
+	return i * BITSET_BITS_PAR_MOT + __builtin_ctzll( mot );
+}
+
+intptr_t bitset_precedent(
+	const uint64_t* mots, size_t nb_mots, intptr_t position
+){
+	if( position < 0 || nb_mots == 0 ) return -1;
+	size_t i = BITSET_MOT( position );
+	uint64_t mot;
+	if( i >= nb_mots ){
+		i = nb_mots - 1;
+		mot = mots[i];
+	}else{
+		mot = mots[i] & ( ~ (uint64_t) 0 >> ( 63 - ( position & 63 ) ) );
+	}
+	while( ! mot ){
+		if( i == 0 ) return -1;
+		i--;
+		mot = mots[i];
+	}
+	return i * BITSET_BITS_PAR_MOT + 63 - __builtin_clzll( mot );
+}
+
+size_t bitset_rang( const uint64_t* mots, size_t nb_mots, intptr_t position ){
+	if( position <= 0 ) return 0;
+	size_t i = BITSET_MOT( position );
+	if( i >= nb_mots ) return bitset_popcount( mots, nb_mots );
+	size_t res = bitset_popcount( mots, i );
+	if( position & 63 ){
+		res += __builtin_popcountll( 
+			mots[i] & ( ~ (uint64_t) 0 >> ( 64 - ( position & 63 ) ) )
+		);
+	}
+	return res;
+}
+
+// Nombre de mots comptés d'un coup par bitset_ieme() avant de descendre au
+// niveau des mots.
+#define BITSET_MOTS_PAR_BLOC 64
+
+intptr_t bitset_ieme( const uint64_t* mots, size_t nb_mots, size_t rang ){
+	size_t i = 0;
+	while( i + BITSET_MOTS_PAR_BLOC <= nb_mots ){
+		size_t nb = bitset_popcount( mots + i, BITSET_MOTS_PAR_BLOC );
+		if( nb > rang ) break;
+		rang -= nb;
+		i += BITSET_MOTS_PAR_BLOC;
+	}
+	for( ; i<nb_mots; i++ ){
+		size_t nb = __builtin_popcountll( mots[i] );
+		if( nb > rang ){
+			uint64_t mot = mots[i];
+			while( rang-- ){
+				mot &= mot - 1;
+			}
+			return i * BITSET_BITS_PAR_MOT + __builtin_ctzll( mot );
+		}
+		rang -= nb;
+	}
+	return -1;
+}
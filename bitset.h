@@ -0,0 +1,186 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file bitset.h */
+
+#ifndef __BITSET_H__
+#define __BITSET_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Nombre de bits contenus dans un mot d'un tableau de bits.
+ */
+#define BITSET_BITS_PAR_MOT 64
+
+/**
+ * @brief
+ * Renvoie l'indice du mot qui contient le bit 'position'.
+ *
+ * La division est arrondie vers moins l'infini, ce qui permet d'utiliser des
+ * positions négatives.
+ */
+#define BITSET_MOT( position ) ( ( position ) >> 6 )
+
+/**
+ * @brief
+ * Renvoie le masque du bit 'position' dans son mot.
+ */
+#define BITSET_MASQUE( position ) ( ( (uint64_t) 1 ) << ( ( position ) & 63 ) )
+
+/**
+ * @brief
+ * Calcule dest[i] = a[i] | b[i] pour tous les i de 0 à nb_mots - 1.
+ *
+ * Le tableau dest peut être égal à a ou à b.
+ */
+void bitset_union(
+	uint64_t* dest, const uint64_t* a, const uint64_t* b, size_t nb_mots
+);
+
+/**
+ * @brief
+ * Calcule dest[i] = a[i] & b[i] pour tous les i de 0 à nb_mots - 1.
+ *
+ * Le tableau dest peut être égal à a ou à b.
+ */
+void bitset_intersection(
+	uint64_t* dest, const uint64_t* a, const uint64_t* b, size_t nb_mots
+);
+
+/**
+ * @brief
+ * Calcule dest[i] = a[i] & ~b[i] pour tous les i de 0 à nb_mots - 1.
+ *
+ * Le tableau dest peut être égal à a ou à b.
+ */
+void bitset_difference(
+	uint64_t* dest, const uint64_t* a, const uint64_t* b, size_t nb_mots
+);
+
+/**
+ * @brief
+ * Calcule dest[i] = dest[i] | source[i] pour tous les i de 0 à nb_mots - 1,
+ * et renvoie le nombre de bits passés à 1.
+ */
+size_t bitset_ajouter( uint64_t* dest, const uint64_t* source, size_t nb_mots );
+
+/**
+ * @brief
+ * Calcule dest[i] = dest[i] & ~source[i] pour tous les i de 0 à 
+ * nb_mots - 1, et renvoie le nombre de bits passés à 0.
+ */
+size_t bitset_retirer( uint64_t* dest, const uint64_t* source, size_t nb_mots );
+
+/**
+ * @brief
+ * Renvoie le nombre de bits à 1 dans le tableau.
+ */
+size_t bitset_popcount( const uint64_t* mots, size_t nb_mots );
+
+/**
+ * @brief
+ * Renvoie 1 si tous les bits à 1 de a sont à 1 dans b, 0 sinon.
+ */
+int bitset_est_inclus( const uint64_t* a, const uint64_t* b, size_t nb_mots );
+
+/**
+ * @brief
+ * Renvoie 1 si les deux tableaux sont égaux, 0 sinon.
+ */
+int bitset_egaux( const uint64_t* a, const uint64_t* b, size_t nb_mots );
+
+/**
+ * @brief
+ * Renvoie 1 si un même bit est à 1 dans a et dans b, 0 sinon.
+ */
+int bitset_se_coupent( const uint64_t* a, const uint64_t* b, size_t nb_mots );
+
+/**
+ * @brief
+ * Renvoie 1 si tous les bits du tableau sont à 0, 0 sinon.
+ */
+int bitset_est_nul( const uint64_t* mots, size_t nb_mots );
+
+/**
+ * @brief
+ * Les versions des opérations sur des tableaux entiers de mots (union, 
+ * intersection, difference, ajouter, retirer, popcount, est_inclus, egaux,
+ * se_coupent et est_nul).
+ *
+ * Par défaut, on utilise la meilleure version que le processeur sait 
+ * exécuter.
+ */
+typedef enum {
+	BITSET_NOYAUX_AUCUN = -1,
+	BITSET_NOYAUX_SCALAIRES = 0,
+	BITSET_NOYAUX_SSE4 = 1,
+	BITSET_NOYAUX_AVX2 = 2
+} Bitset_noyaux;
+
+/**
+ * @brief
+ * Renvoie la version des opérations utilisée.
+ */
+Bitset_noyaux bitset_noyaux( void );
+
+/**
+ * @brief
+ * Impose une version des opérations (pour les tests et les mesures).
+ * Renvoie 0, sans rien changer, si le processeur ne sait pas l'exécuter.
+ */
+int bitset_choisir_noyaux( Bitset_noyaux noyaux );
+
+/**
+ * @brief
+ * Renvoie la position du premier bit à 1 dont la position est supérieure ou
+ * égale à 'position'.
+ * Renvoie -1 s'il n'existe pas de tel bit.
+ */
+intptr_t bitset_suivant(
+	const uint64_t* mots, size_t nb_mots, intptr_t position
+);
+
+/**
+ * @brief
+ * Renvoie la position du dernier bit à 1 dont la position est inférieure ou
+ * égale à 'position'.
+ * Renvoie -1 s'il n'existe pas de tel bit.
+ */
+intptr_t bitset_precedent(
+	const uint64_t* mots, size_t nb_mots, intptr_t position
+);
+
+/**
+ * @brief
+ * Renvoie le nombre de bits à 1 dont la position est strictement inférieure
+ * à 'position'.
+ */
+size_t bitset_rang( const uint64_t* mots, size_t nb_mots, intptr_t position );
+
+/**
+ * @brief
+ * Renvoie la position du bit à 1 de rang 'rang', c'est-à-dire précédé de 
+ * 'rang' bits à 1, ou -1 si le tableau a au plus 'rang' bits à 1.
+ */
+intptr_t bitset_ieme( const uint64_t* mots, size_t nb_mots, size_t rang );
+
+#endif
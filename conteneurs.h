@@ -0,0 +1,289 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __CONTENEURS_H__
+#define __CONTENEURS_H__
+
+#include "outils.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Conteneurs spécialisés à la compilation.
+ *
+ * Ensemble et Table rangent des intptr_t et passent par des pointeurs de 
+ * fonctions pour comparer, copier et hacher leurs éléments. Les macros 
+ * DEFINIR_... définissent au contraire un type et ses fonctions pour un 
+ * type d'éléments donné : les éléments sont rangés tels quels (4 octets pour
+ * un int32_t) et les comparaisons et le hachage, passés sous forme de 
+ * macros, sont développés sur place par le compilateur.
+ *
+ * Toutes les fonctions sont 'static inline' : une macro peut être 
+ * instanciée dans un fichier d'en-tête comme dans un fichier source. Chaque
+ * macro prend le nom du type à définir et le suffixe des noms de ses 
+ * fonctions. Par exemple,
+ *     DEFINIR_VECTEUR( Vecteur_etats, vecteur_etats, int32_t )
+ * définit le type Vecteur_etats et les fonctions 
+ * initialiser_vecteur_etats(), ajouter_vecteur_etats(), etc.
+ *
+ * Aucun de ces conteneurs n'est responsable de la mémoire de ses éléments.
+ */
+
+/*
+ * Comparaisons et hachage d'entiers, à passer aux macros.
+ */
+#define CONTENEURS_EGAUX( a, b ) ( ( a ) == ( b ) )
+#define CONTENEURS_HACHER_ENTIER( x ) conteneurs_melanger( (uint64_t) ( x ) )
+
+/*
+ * Mélange les bits d'un entier (finaliseur de MurmurHash3, comme pour les 
+ * tables de hachage de table.c).
+ */
+static inline uint32_t conteneurs_melanger( uint64_t h ){
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+	return (uint32_t) h;
+}
+
+/*
+ * Renvoie une capacité au moins égale à 'minimum', en doublant 'capacite' 
+ * (qui vaut 'initiale' si elle est nulle).
+ */
+static inline size_t conteneurs_agrandir(
+	size_t capacite, size_t minimum, size_t initiale
+){
+	if( capacite == 0 ) capacite = initiale;
+	while( capacite < minimum ) capacite *= 2;
+	return capacite;
+}
+
+/*
+ * Un tableau de T qui s'agrandit en doublant sa capacité. Ajouter un 
+ * élément à la fin se fait en temps constant amorti.
+ *
+ * Fonctions : initialiser, liberer, reserver, vider, ajouter, taille.
+ */
+#define DEFINIR_VECTEUR( Type, nom, T ) \
+	\
+typedef struct { \
+	T* elements; \
+	size_t taille; \
+	size_t capacite; \
+} Type; \
+	\
+static inline void initialiser_##nom( Type* v ){ \
+	v->elements = NULL; \
+	v->taille = 0; \
+	v->capacite = 0; \
+} \
+	\
+static inline void liberer_##nom( Type* v ){ \
+	xfree( v->elements ); \
+	initialiser_##nom( v ); \
+} \
+	\
+/* Garantit la place pour 'capacite' éléments. */ \
+static inline void reserver_##nom( Type* v, size_t capacite ){ \
+	if( capacite <= v->capacite ) return; \
+	capacite = conteneurs_agrandir( v->capacite, capacite, 8 ); \
+	T* elements = xmalloc( capacite * sizeof(T) ); \
+	if( v->taille ){ \
+		memcpy( elements, v->elements, v->taille * sizeof(T) ); \
+	} \
+	xfree( v->elements ); \
+	v->elements = elements; \
+	v->capacite = capacite; \
+} \
+	\
+static inline void vider_##nom( Type* v ){ \
+	v->taille = 0; \
+} \
+	\
+static inline void ajouter_##nom( Type* v, T element ){ \
+	if( v->taille == v->capacite ){ \
+		reserver_##nom( v, v->taille + 1 ); \
+	} \
+	v->elements[ v->taille++ ] = element; \
+} \
+	\
+static inline size_t taille_##nom( const Type* v ){ \
+	return v->taille; \
+}
+
+/*
+ * Une table de hachage à adressage ouvert, gérée par la méthode 
+ * "Robin Hood" comme les tables de hachage de table.c, qui associe une 
+ * valeur de type Tvaleur à chaque clé de type Tcle. HACHER( cle ) renvoie un
+ * haché de 32 bits (CONTENEURS_HACHER_ENTIER pour des entiers) et 
+ * EGALES( a, b ) compare deux clés.
+ *
+ * Les cases sont parcourues de 0 à 'capacite' - 1 ; une case est occupée si
+ * son champ 'distance' n'est pas nul (voir suivante()).
+ *
+ * Fonctions : initialiser, liberer, vider, taille, trouver (renvoie 
+ * l'adresse de la valeur associée à la clé, ou NULL), obtenir (renvoie 
+ * l'adresse de la valeur associée à la clé, après avoir ajouté la clé avec 
+ * une valeur nulle si elle n'y était pas), ajouter (associe la valeur à la
+ * clé), retirer (renvoie 1 si la clé y était) et suivante (indice de la 
+ * première case occupée à partir d'une case donnée).
+ *
+ * La structure porte le nom du type : un fichier d'en-tête peut déclarer 
+ * un pointeur 'struct Type*' sans instancier la macro.
+ */
+#define DEFINIR_TABLE_DE_HACHAGE( Type, nom, Tcle, Tvaleur, HACHER, EGALES ) \
+	\
+typedef struct { \
+	Tcle cle; \
+	Tvaleur valeur; \
+	uint32_t hache; \
+	uint32_t distance; \
+} Type##_case; \
+	\
+typedef struct Type { \
+	Type##_case* cases; \
+	size_t capacite; \
+	size_t nb_elements; \
+} Type; \
+	\
+static inline void initialiser_##nom( Type* t ){ \
+	t->cases = NULL; \
+	t->capacite = 0; \
+	t->nb_elements = 0; \
+} \
+	\
+static inline void liberer_##nom( Type* t ){ \
+	xfree( t->cases ); \
+	initialiser_##nom( t ); \
+} \
+	\
+static inline void vider_##nom( Type* t ){ \
+	if( t->capacite ){ \
+		memset( t->cases, 0, t->capacite * sizeof(Type##_case) ); \
+	} \
+	t->nb_elements = 0; \
+} \
+	\
+static inline size_t taille_##nom( const Type* t ){ \
+	return t->nb_elements; \
+} \
+	\
+static inline Tvaleur* trouver_##nom( const Type* t, Tcle cle ){ \
+	if( t->nb_elements == 0 ) return NULL; \
+	size_t masque = t->capacite - 1; \
+	uint32_t hache = HACHER( cle ); \
+	size_t i = hache & masque; \
+	uint32_t distance = 1; \
+	while( t->cases[i].distance >= distance ){ \
+		if( t->cases[i].hache == hache && EGALES( t->cases[i].cle, cle ) ){ \
+			return &t->cases[i].valeur; \
+		} \
+		i = ( i + 1 ) & masque; \
+		distance++; \
+	} \
+	return NULL; \
+} \
+	\
+/* Place une case dont la clé n'est pas dans la table, qui doit avoir une */ \
+/* case libre. Renvoie l'indice où elle a été placée. */ \
+static inline size_t placer_##nom( Type* t, Type##_case c ){ \
+	size_t masque = t->capacite - 1; \
+	size_t i = c.hache & masque; \
+	size_t res = t->capacite; \
+	c.distance = 1; \
+	while( t->cases[i].distance ){ \
+		if( t->cases[i].distance < c.distance ){ \
+			Type##_case tmp = t->cases[i]; \
+			t->cases[i] = c; \
+			c = tmp; \
+			if( res == t->capacite ) res = i; \
+		} \
+		i = ( i + 1 ) & masque; \
+		c.distance++; \
+	} \
+	t->cases[i] = c; \
+	return res == t->capacite ? i : res; \
+} \
+	\
+static inline void redimensionner_##nom( Type* t, size_t capacite ){ \
+	Type##_case* anciennes = t->cases; \
+	size_t ancienne_capacite = t->capacite; \
+	t->cases = xmalloc( capacite * sizeof(Type##_case) ); \
+	memset( t->cases, 0, capacite * sizeof(Type##_case) ); \
+	t->capacite = capacite; \
+	size_t i; \
+	for( i=0; i<ancienne_capacite; i++ ){ \
+		if( anciennes[i].distance ){ \
+			placer_##nom( t, anciennes[i] ); \
+		} \
+	} \
+	xfree( anciennes ); \
+} \
+	\
+static inline Tvaleur* obtenir_##nom( Type* t, Tcle cle ){ \
+	Tvaleur* valeur = trouver_##nom( t, cle ); \
+	if( valeur ) return valeur; \
+	/* La table est agrandie au-delà de 7/8 de cases occupées. */ \
+	if( 8 * ( t->nb_elements + 1 ) > 7 * t->capacite ){ \
+		redimensionner_##nom( t, t->capacite ? 2 * t->capacite : 16 ); \
+	} \
+	Type##_case c; \
+	memset( &c, 0, sizeof(c) ); \
+	c.cle = cle; \
+	c.hache = HACHER( cle ); \
+	t->nb_elements++; \
+	return &t->cases[ placer_##nom( t, c ) ].valeur; \
+} \
+	\
+static inline void ajouter_##nom( Type* t, Tcle cle, Tvaleur valeur ){ \
+	*obtenir_##nom( t, cle ) = valeur; \
+} \
+	\
+static inline int retirer_##nom( Type* t, Tcle cle ){ \
+	Tvaleur* valeur = trouver_##nom( t, cle ); \
+	if( ! valeur ) return 0; \
+	size_t masque = t->capacite - 1; \
+	size_t i = (Type##_case*) \
+		( (char*) valeur - offsetof( Type##_case, valeur ) ) - t->cases; \
+	size_t j = ( i + 1 ) & masque; \
+	/* Les cases suivantes qui ne sont pas à leur place idéale reculent. */ \
+	while( t->cases[j].distance > 1 ){ \
+		t->cases[i] = t->cases[j]; \
+		t->cases[i].distance--; \
+		i = j; \
+		j = ( j + 1 ) & masque; \
+	} \
+	t->cases[i].distance = 0; \
+	t->nb_elements--; \
+	return 1; \
+} \
+	\
+static inline size_t suivante_##nom( const Type* t, size_t i ){ \
+	while( i < t->capacite && ! t->cases[i].distance ){ \
+		i++; \
+	} \
+	return i; \
+}
+
+#endif
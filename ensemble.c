@@ -27,6 +27,23 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+/*
+ * Un ensemble d'entiers reste codé par un tableau de bits tant que le nombre
+ * de mots du tableau ne dépasse pas ENSEMBLE_BITSET_MOTS_MIN ou
+ * ENSEMBLE_BITSET_MOTS_PAR_ELEMENT fois le nombre d'éléments.
+ * Au-delà, l'ensemble est converti en arbre.
+ */
+#define ENSEMBLE_BITSET_MOTS_MIN 16
+#define ENSEMBLE_BITSET_MOTS_PAR_ELEMENT 8
+
+/*
+ * Nombre maximal d'éléments d'un ensemble codé par un tableau trié. Au-delà,
+ * l'ensemble est converti en tableau de bits ou en arbre.
+ */
+#define ENSEMBLE_TAILLE_MAX_TABLEAU 16
 
 
 int* allouer_element( int val ){
@@ -39,37 +56,273 @@ void supprimer_element( int* element ){
 	xfree( element );
 }
 
-void next_iterators( Table_iterateur * it1, Table_iterateur * it2 ){
-	*it1 = iterateur_suivant_table(*it1);
-	*it2 = iterateur_suivant_table(*it2);
+void next_iterators( Ensemble_iterateur * it1, Ensemble_iterateur * it2 ){
+	*it1 = iterateur_suivant_ensemble(*it1);
+	*it2 = iterateur_suivant_ensemble(*it2);
+}
+
+static int comparer_elements(
+	const Ensemble* ens, intptr_t elem1, intptr_t elem2
+){
+	if( ens->comparer_element ){
+		return ens->comparer_element( elem1, elem2 );
+	}
+	if( elem1 < elem2 ) return -1;
+	if( elem1 > elem2 ) return 1;
+	return 0;
 }
 
 int comparer_ensemble( const Ensemble* ens1, const Ensemble*  ens2 ){
-	Table_iterateur it1, it2;
+	Ensemble_iterateur it1, it2;
 	
-	it1 = premier_iterateur_table( ens1->table );
-	it2 = premier_iterateur_table( ens2->table );
+	it1 = premier_iterateur_ensemble( ens1 );
+	it2 = premier_iterateur_ensemble( ens2 );
 	for( 
 		;
-		( ! iterateur_est_vide(it1) ) && ( ! iterateur_est_vide(it2) );
+		( ! iterateur_ensemble_est_vide(it1) ) &&
+		( ! iterateur_ensemble_est_vide(it2) );
 		next_iterators( &it1, &it2 )
 	){
-		int cmp;
-		if( ens1->comparer_element ){
-			cmp = ens1->comparer_element( get_cle( it1 ), get_cle( it2 ) );
-		}else{
-			cmp = get_cle( it1 ) -  get_cle( it2 );
-		}
+		int cmp = comparer_elements( ens1, get_element( it1 ), get_element( it2 ) );
 	 	if( cmp > 0 ) return 1;
 	 	if( cmp < 0 ) return -1;
 	}
-	if( iterateur_est_vide(it1) && iterateur_est_vide(it2) )
+	if( iterateur_ensemble_est_vide(it1) && iterateur_ensemble_est_vide(it2) )
 		return 0;
-	if( iterateur_est_vide(it1) ) 
+	if( iterateur_ensemble_est_vide(it1) ) 
+		return -1;
+	return 1;
+}
+
+/*
+ * Renvoie vrai si l'ensemble contient des entiers, c'est-à-dire s'il a été
+ * créé sans fonction de comparaison, de copie et de suppression.
+ */
+static int est_un_ensemble_d_entiers( const Ensemble* ens ){
+	return ! ens->comparer_element && ! ens->copier_element && 
+		! ens->supprimer_element;
+}
+
+static intptr_t* elements_tableau( Ensemble* ens ){
+	return ens->elements ? ens->elements : ens->elements_inline;
+}
+
+static const intptr_t* elements_tableau_const( const Ensemble* ens ){
+	return ens->elements ? ens->elements : ens->elements_inline;
+}
+
+static void initialiser_tableau( Ensemble* ens ){
+	ens->representation = ENSEMBLE_TABLEAU;
+	ens->taille = 0;
+	ens->elements = NULL;
+	ens->capacite = ENSEMBLE_CAPACITE_INLINE;
+}
+
+/*
+ * Recherche dichotomique d'un élément dans un ensemble codé par un tableau.
+ * Renvoie vrai si l'élément est trouvé. Dans tous les cas, 'indice' contient
+ * la position à laquelle se trouve (ou devrait se trouver) l'élément.
+ */
+static int chercher_dans_tableau(
+	const Ensemble* ens, intptr_t element, int* indice
+){
+	const intptr_t* elements = elements_tableau_const( ens );
+	int debut = 0;
+	int fin = ens->taille;
+	while( debut < fin ){
+		int milieu = ( debut + fin ) / 2;
+		int cmp = comparer_elements( ens, elements[milieu], element );
+		if( cmp == 0 ){
+			*indice = milieu;
+			return 1;
+		}
+		if( cmp < 0 ){
+			debut = milieu + 1;
+		}else{
+			fin = milieu;
+		}
+	}
+	*indice = debut;
+	return 0;
+}
+
+static void liberer_tableau( Ensemble* ens ){
+	if( ens->supprimer_element ){
+		intptr_t* elements = elements_tableau( ens );
+		unsigned int i;
+		for( i=0; i<ens->taille; i++ ){
+			if( elements[i] ){
+				ens->supprimer_element( elements[i] );
+			}
+		}
+	}
+	xfree( ens->elements );
+}
+
+static int bitset_densite_acceptable( size_t nb_mots, size_t taille ){
+	return nb_mots <= ENSEMBLE_BITSET_MOTS_MIN ||
+		nb_mots <= ENSEMBLE_BITSET_MOTS_PAR_ELEMENT * taille;
+}
+
+static intptr_t element_du_bit( const Ensemble* ens, intptr_t position ){
+	return ens->premier_mot * BITSET_BITS_PAR_MOT + position;
+}
+
+/*
+ * Renvoie la position du bit codant 'element', ou -1 si l'élément est en 
+ * dehors du tableau de bits.
+ */
+static intptr_t bit_de_l_element( const Ensemble* ens, intptr_t element ){
+	intptr_t mot = BITSET_MOT( element ) - ens->premier_mot;
+	if( ens->nb_mots == 0 || mot < 0 || mot >= (intptr_t) ens->nb_mots ){
 		return -1;
+	}
+	return mot * BITSET_BITS_PAR_MOT + ( element & 63 );
+}
+
+static void initialiser_bitset( Ensemble* ens ){
+	ens->representation = ENSEMBLE_BITSET;
+	ens->table = NULL;
+	ens->mots = NULL;
+	ens->nb_mots = 0;
+	ens->premier_mot = 0;
+	ens->taille = 0;
+}
+
+/*
+ * Agrandit le tableau de bits pour qu'il couvre les mots d'indices 
+ * 'mot_min' à 'mot_max'.
+ * Renvoie 0, sans rien modifier, si le tableau obtenu serait trop creux pour
+ * un ensemble de 'taille' éléments.
+ */
+static int etendre_bitset(
+	Ensemble* ens, intptr_t mot_min, intptr_t mot_max, size_t taille
+){
+	intptr_t premier = mot_min;
+	intptr_t dernier = mot_max;
+	if( ens->nb_mots ){
+		intptr_t ancien_dernier = ens->premier_mot + ens->nb_mots - 1;
+		if( mot_min >= ens->premier_mot && mot_max <= ancien_dernier ){
+			return 1;
+		}
+		if( ens->premier_mot < premier ) premier = ens->premier_mot;
+		if( ancien_dernier > dernier ) dernier = ancien_dernier;
+	}
+	size_t nb_mots = dernier - premier + 1;
+	if( ! bitset_densite_acceptable( nb_mots, taille ) ){
+		return 0;
+	}
+	// On double la taille du tableau, si possible, pour que les ajouts 
+	// successifs d'éléments croissants (ou décroissants) restent amortis.
+	if(
+		nb_mots < 2 * ens->nb_mots && 
+		bitset_densite_acceptable( 2 * ens->nb_mots, taille )
+	){
+		size_t marge = 2 * ens->nb_mots - nb_mots;
+		if( premier < ens->premier_mot ){
+			premier -= marge;
+		}else{
+			dernier += marge;
+		}
+		nb_mots = 2 * ens->nb_mots;
+	}
+	uint64_t* mots = xmalloc( nb_mots * sizeof(uint64_t) );
+	memset( mots, 0, nb_mots * sizeof(uint64_t) );
+	if( ens->nb_mots ){
+		memcpy(
+			mots + ( ens->premier_mot - premier ), ens->mots, 
+			ens->nb_mots * sizeof(uint64_t)
+		);
+		xfree( ens->mots );
+	}
+	ens->mots = mots;
+	ens->nb_mots = nb_mots;
+	ens->premier_mot = premier;
 	return 1;
 }
 
+/*
+ * Transforme un ensemble d'entiers codé par un tableau de bits en un 
+ * ensemble compressé.
+ */
+static void convertir_bitset_en_compresse( Ensemble* ens ){
+	Roaring roaring;
+	roaring_initialiser( &roaring );
+	roaring_ajouter_mots( &roaring, ens->mots, ens->nb_mots, ens->premier_mot );
+	xfree( ens->mots );
+	ens->roaring = roaring;
+	ens->representation = ENSEMBLE_COMPRESSE;
+}
+
+/*
+ * Convertit un ensemble plein codé par un tableau trié en un tableau de bits
+ * (pour les ensembles d'entiers assez denses), en un ensemble compressé 
+ * (pour les autres ensembles d'entiers) ou en un arbre.
+ */
+static void convertir_tableau( Ensemble* ens ){
+	unsigned int taille = ens->taille;
+	unsigned int i;
+	intptr_t copie_inline[ENSEMBLE_CAPACITE_INLINE];
+	intptr_t* elements = ens->elements;
+	if( ! elements ){
+		// Les éléments tiennent dans 'elements_inline' : taille est au plus
+		// ENSEMBLE_CAPACITE_INLINE.
+		memcpy( copie_inline, ens->elements_inline, sizeof(copie_inline) );
+		elements = copie_inline;
+	}
+	intptr_t mot_min = BITSET_MOT( elements[0] );
+	intptr_t mot_max = BITSET_MOT( elements[taille-1] );
+	if(
+		est_un_ensemble_d_entiers( ens ) &&
+		bitset_densite_acceptable( mot_max - mot_min + 1, taille )
+	){
+		initialiser_bitset( ens );
+		etendre_bitset( ens, mot_min, mot_max, taille );
+		for( i=0; i<taille; i++ ){
+			intptr_t pos = bit_de_l_element( ens, elements[i] );
+			ens->mots[ BITSET_MOT( pos ) ] |= BITSET_MASQUE( pos );
+		}
+		ens->taille = taille;
+	}else if( est_un_ensemble_d_entiers( ens ) ){
+		ens->representation = ENSEMBLE_COMPRESSE;
+		roaring_initialiser( &ens->roaring );
+		roaring_remplir( &ens->roaring, elements, taille );
+	}else{
+		ens->representation = ENSEMBLE_ARBRE;
+		ens->table = creer_table(
+			ens->comparer_element, ens->copier_element, ens->supprimer_element
+		);
+		// La table fait sa propre copie des éléments.
+		remplir_table_triee( ens->table, elements, NULL, taille );
+		if( ens->supprimer_element ){
+			for( i=0; i<taille; i++ ){
+				if( elements[i] ){
+					ens->supprimer_element( elements[i] );
+				}
+			}
+		}
+	}
+	if( elements != copie_inline ){
+		xfree( elements );
+	}
+}
+
+/*
+ * Recherche le premier et le dernier mot non nul d'un tableau de bits.
+ * Renvoie 0 si le tableau ne contient aucun bit à 1.
+ */
+static int mots_utiles_bitset(
+	const Ensemble* ens, intptr_t* mot_min, intptr_t* mot_max
+){
+	intptr_t premier = bitset_suivant( ens->mots, ens->nb_mots, 0 );
+	if( premier < 0 ) return 0;
+	intptr_t dernier = bitset_precedent(
+		ens->mots, ens->nb_mots, ens->nb_mots * BITSET_BITS_PAR_MOT - 1
+	);
+	*mot_min = ens->premier_mot + BITSET_MOT( premier );
+	*mot_max = ens->premier_mot + BITSET_MOT( dernier );
+	return 1;
+}
 
 Ensemble * creer_ensemble(
 	int (*comparer_element)( const intptr_t elem1, const intptr_t elem2 ),
@@ -77,23 +330,96 @@ Ensemble * creer_ensemble(
 	void (*supprimer_element)(intptr_t elem )
 ){
 	Ensemble * result = (Ensemble*) xmalloc( sizeof(Ensemble) );
-	result->table = creer_table(
-		comparer_element, copier_element, supprimer_element
-	);
 	result->comparer_element = comparer_element;
 	result->copier_element = copier_element;
 	result->supprimer_element = supprimer_element;
+	initialiser_tableau( result );
 	return result;
 }
 
+/*
+ * Libère le contenu de l'ensemble.
+ */
+static void liberer_contenu( Ensemble * ens ){
+	switch( ens->representation ){
+		case ENSEMBLE_TABLEAU :
+			liberer_tableau( ens );
+			break;
+		case ENSEMBLE_BITSET :
+			xfree( ens->mots );
+			break;
+		case ENSEMBLE_ARBRE :
+			liberer_table( ens->table );
+			break;
+		case ENSEMBLE_COMPRESSE :
+			roaring_liberer( &ens->roaring );
+			break;
+	}
+}
+
 void liberer_ensemble( Ensemble * ens ){
 	if(ens){
-		liberer_table( ens->table );
+		liberer_contenu( ens );
 		xfree( ens );
 	}
 }
 
+static void ajouter_element_tableau( Ensemble * ens, const intptr_t element ){
+	int indice;
+	if( chercher_dans_tableau( ens, element, &indice ) ){
+		return;
+	}
+	if( ens->taille == ENSEMBLE_TAILLE_MAX_TABLEAU ){
+		convertir_tableau( ens );
+		ajouter_element( ens, element );
+		return;
+	}
+	if( ens->taille == ens->capacite ){
+		unsigned int capacite = 2 * ens->capacite;
+		if( capacite > ENSEMBLE_TAILLE_MAX_TABLEAU ){
+			capacite = ENSEMBLE_TAILLE_MAX_TABLEAU;
+		}
+		intptr_t* elements = xmalloc( capacite * sizeof(intptr_t) );
+		memcpy( elements, elements_tableau( ens ), ens->taille * sizeof(intptr_t) );
+		xfree( ens->elements );
+		ens->elements = elements;
+		ens->capacite = capacite;
+	}
+	intptr_t* elements = elements_tableau( ens );
+	memmove(
+		elements + indice + 1, elements + indice, 
+		( ens->taille - indice ) * sizeof(intptr_t)
+	);
+	if( ens->copier_element && element ){
+		elements[indice] = ens->copier_element( element );
+	}else{
+		elements[indice] = element;
+	}
+	ens->taille++;
+}
+
 void ajouter_element( Ensemble * ensemble, const intptr_t element ){
+	if( ensemble->representation == ENSEMBLE_TABLEAU ){
+		ajouter_element_tableau( ensemble, element );
+		return;
+	}
+	if( ensemble->representation == ENSEMBLE_BITSET ){
+		intptr_t mot = BITSET_MOT( element );
+		if( etendre_bitset( ensemble, mot, mot, ensemble->taille + 1 ) ){
+			intptr_t pos = bit_de_l_element( ensemble, element );
+			uint64_t* m = &( ensemble->mots[ BITSET_MOT( pos ) ] );
+			if( ! ( *m & BITSET_MASQUE( pos ) ) ){
+				*m |= BITSET_MASQUE( pos );
+				ensemble->taille++;
+			}
+			return;
+		}
+		convertir_bitset_en_compresse( ensemble );
+	}
+	if( ensemble->representation == ENSEMBLE_COMPRESSE ){
+		ensemble->taille += roaring_ajouter( &ensemble->roaring, element );
+		return;
+	}
 	add_table( ensemble->table, element, (intptr_t) NULL );
 }
 
@@ -102,7 +428,93 @@ void action_ajouter_element( const intptr_t element, void* ens ){
 	ajouter_element( (Ensemble*) ens, element );
 }
 
+/*
+ * Ajoute, mot par mot, les éléments de ens2 à ens1. Les deux ensembles sont
+ * codés par des tableaux de bits.
+ * Renvoie 0, sans rien modifier, si le tableau de ens1 deviendrait trop creux.
+ */
+static int ajouter_elements_bitset( Ensemble * ens1, const Ensemble * ens2 ){
+	intptr_t mot_min, mot_max;
+	if( ! mots_utiles_bitset( ens2, &mot_min, &mot_max ) ){
+		return 1;
+	}
+	if( ! etendre_bitset( ens1, mot_min, mot_max, ens1->taille + ens2->taille ) ){
+		return 0;
+	}
+	size_t nb_mots = mot_max - mot_min + 1;
+	uint64_t* dest = ens1->mots + ( mot_min - ens1->premier_mot );
+	const uint64_t* source = ens2->mots + ( mot_min - ens2->premier_mot );
+	ens1->taille += bitset_ajouter( dest, source, nb_mots );
+	return 1;
+}
+
+/*
+ * Renvoie vrai si l'ensemble est codé par un tableau de bits ou par un 
+ * ensemble compressé : il peut alors être combiné à un ensemble compressé
+ * conteneur par conteneur.
+ */
+static int est_compressible( const Ensemble* ens ){
+	return ens->representation == ENSEMBLE_BITSET || 
+		ens->representation == ENSEMBLE_COMPRESSE;
+}
+
+/*
+ * Renvoie l'ensemble compressé qui code 'ens', ou 'tampon' initialisé avec
+ * les éléments de 'ens' s'il est codé par un tableau de bits (il faudra le 
+ * libérer).
+ */
+static const Roaring* en_roaring( const Ensemble* ens, Roaring* tampon ){
+	if( ens->representation == ENSEMBLE_COMPRESSE ){
+		return &ens->roaring;
+	}
+	roaring_initialiser( tampon );
+	roaring_ajouter_mots( tampon, ens->mots, ens->nb_mots, ens->premier_mot );
+	return tampon;
+}
+
+static void liberer_en_roaring( const Roaring* roaring, Roaring* tampon ){
+	if( roaring == tampon ){
+		roaring_liberer( tampon );
+	}
+}
+
+static void copier_contenu( Ensemble* res, const Ensemble* ensemble );
+
 void ajouter_elements( Ensemble * ens1, const Ensemble * ens2 ){
+	if( 
+		ens1->taille == 0 && est_un_ensemble_d_entiers( ens1 ) && 
+		est_compressible( ens2 ) 
+	){
+		// ens1 est vide : il prend une copie du contenu de ens2, mot par mot
+		// ou conteneur par conteneur.
+		liberer_contenu( ens1 );
+		initialiser_tableau( ens1 );
+		copier_contenu( ens1, ens2 );
+		return;
+	}
+	if(
+		ens1->representation == ENSEMBLE_BITSET &&
+		ens2->representation == ENSEMBLE_BITSET &&
+		ajouter_elements_bitset( ens1, ens2 )
+	){
+		return;
+	}
+	if( est_compressible( ens1 ) && est_compressible( ens2 ) ){
+		// Le tableau de bits de ens1 deviendrait trop creux, ou ens2 est 
+		// compressé : le résultat est compressé.
+		if( ens1->representation == ENSEMBLE_BITSET ){
+			convertir_bitset_en_compresse( ens1 );
+		}
+		if( ens2->representation == ENSEMBLE_BITSET ){
+			roaring_ajouter_mots( 
+				&ens1->roaring, ens2->mots, ens2->nb_mots, ens2->premier_mot 
+			);
+		}else{
+			roaring_union( &ens1->roaring, &ens2->roaring );
+		}
+		ens1->taille = ens1->roaring.cardinal;
+		return;
+	}
 	pour_tout_element( ens2, action_ajouter_element, ens1 );
 }
 
@@ -121,6 +533,36 @@ void transferer_elements(
 }
 
 void retirer_element( Ensemble * ensemble, const intptr_t element ){
+	if( ensemble->representation == ENSEMBLE_TABLEAU ){
+		int indice;
+		if( chercher_dans_tableau( ensemble, element, &indice ) ){
+			intptr_t* elements = elements_tableau( ensemble );
+			if( ensemble->supprimer_element && elements[indice] ){
+				ensemble->supprimer_element( elements[indice] );
+			}
+			memmove(
+				elements + indice, elements + indice + 1, 
+				( ensemble->taille - indice - 1 ) * sizeof(intptr_t)
+			);
+			ensemble->taille--;
+		}
+		return;
+	}
+	if( ensemble->representation == ENSEMBLE_BITSET ){
+		intptr_t pos = bit_de_l_element( ensemble, element );
+		if( pos >= 0 ){
+			uint64_t* m = &( ensemble->mots[ BITSET_MOT( pos ) ] );
+			if( *m & BITSET_MASQUE( pos ) ){
+				*m &= ~ BITSET_MASQUE( pos );
+				ensemble->taille--;
+			}
+		}
+		return;
+	}
+	if( ensemble->representation == ENSEMBLE_COMPRESSE ){
+		ensemble->taille -= roaring_retirer( &ensemble->roaring, element );
+		return;
+	}
 	delete_table( ensemble->table, element );
 }
 
@@ -129,26 +571,279 @@ void action_retirer_elements( const intptr_t element, void* ens ){
 }
 
 void retirer_elements( Ensemble * ens1, const Ensemble * ens2 ){
+	if(
+		ens1->representation == ENSEMBLE_BITSET &&
+		ens2->representation == ENSEMBLE_BITSET
+	){
+		intptr_t debut = ens1->premier_mot;
+		intptr_t fin = ens1->premier_mot + ens1->nb_mots;
+		if( ens2->premier_mot > debut ) debut = ens2->premier_mot;
+		if( ens2->premier_mot + (intptr_t) ens2->nb_mots < fin ){
+			fin = ens2->premier_mot + ens2->nb_mots;
+		}
+		if( debut < fin ){
+			uint64_t* dest = ens1->mots + ( debut - ens1->premier_mot );
+			const uint64_t* source = ens2->mots + ( debut - ens2->premier_mot );
+			ens1->taille -= bitset_retirer( dest, source, fin - debut );
+		}
+		return;
+	}
+	if( 
+		ens1->representation == ENSEMBLE_COMPRESSE && est_compressible( ens2 ) 
+	){
+		Roaring tampon;
+		const Roaring* roaring = en_roaring( ens2, &tampon );
+		roaring_difference( &ens1->roaring, roaring );
+		liberer_en_roaring( roaring, &tampon );
+		ens1->taille = ens1->roaring.cardinal;
+		return;
+	}
 	pour_tout_element( ens2, action_retirer_elements, ens1 );
 }
 
 void vider_ensemble( Ensemble * ensemble ){
-	vider_table( ensemble->table );
+	liberer_contenu( ensemble );
+	initialiser_tableau( ensemble );
 }
 
 int est_dans_l_ensemble( const Ensemble * ensemble, intptr_t element ){
-	Table_iterateur it = trouver_table( ensemble->table, element );
-	return ! avl_t_is_null( &it ); 
+	if( ensemble->representation == ENSEMBLE_TABLEAU ){
+		int indice;
+		return chercher_dans_tableau( ensemble, element, &indice );
+	}
+	if( ensemble->representation == ENSEMBLE_BITSET ){
+		intptr_t pos = bit_de_l_element( ensemble, element );
+		return pos >= 0 && 
+			( ensemble->mots[ BITSET_MOT( pos ) ] & BITSET_MASQUE( pos ) );
+	}
+	if( ensemble->representation == ENSEMBLE_COMPRESSE ){
+		return roaring_contient( &ensemble->roaring, element );
+	}
+	return chercher_table( ensemble->table, element, NULL );
+}
+
+unsigned int taille_ensemble( const Ensemble* ensemble ){
+	if( ensemble->representation == ENSEMBLE_ARBRE ){
+		return taille_table( ensemble->table );
+	}
+	return ensemble->taille;
 }
 
-void action_taille_ensemble( const intptr_t element, void* taille ){
-	(*(int*) taille)+=1;
+intptr_t min_ensemble( const Ensemble* ensemble ){
+	assert( ! ensemble_est_vide( ensemble ) );
+	return get_element( premier_iterateur_ensemble( ensemble ) );
 }
 
-unsigned int taille_ensemble( const Ensemble* ensemble ){
-	int taille = 0;
-	pour_tout_element( ensemble, action_taille_ensemble, &taille );
-	return taille;
+intptr_t max_ensemble( const Ensemble* ensemble ){
+	assert( ! ensemble_est_vide( ensemble ) );
+	return get_element( dernier_iterateur_ensemble( ensemble ) );
+}
+
+unsigned int rang_dans_l_ensemble(
+	const Ensemble* ensemble, const intptr_t element
+){
+	int indice;
+	intptr_t position;
+	switch( ensemble->representation ){
+		case ENSEMBLE_TABLEAU :
+			chercher_dans_tableau( ensemble, element, &indice );
+			return indice;
+		case ENSEMBLE_BITSET :
+			position = element - ensemble->premier_mot * BITSET_BITS_PAR_MOT;
+			return bitset_rang( ensemble->mots, ensemble->nb_mots, position );
+		case ENSEMBLE_COMPRESSE :
+			return roaring_rang( &ensemble->roaring, element );
+		default :
+			return rang_table( ensemble->table, element );
+	}
+}
+
+unsigned int nombre_d_elements_entre(
+	const Ensemble* ensemble, const intptr_t min, const intptr_t max
+){
+	if( comparer_elements( ensemble, min, max ) > 0 ) return 0;
+	return rang_dans_l_ensemble( ensemble, max ) + 
+		est_dans_l_ensemble( ensemble, max ) - 
+		rang_dans_l_ensemble( ensemble, min );
+}
+
+int ensemble_est_vide( const Ensemble* ensemble ){
+	return taille_ensemble( ensemble ) == 0;
+}
+
+typedef struct {
+	size_t (*hacher_element)( const intptr_t elem );
+	uint64_t hache;
+} data_hacher_ensemble_t;
+
+static void action_hacher_ensemble( const intptr_t element, void* data ){
+	data_hacher_ensemble_t* d = (data_hacher_ensemble_t*) data;
+	uint64_t h = d->hacher_element ? 
+		(uint64_t) d->hacher_element( element ) : (uint64_t) element;
+	// Les éléments arrivent dans l'ordre croissant : le hachage dépend de 
+	// leur position et non de la représentation de l'ensemble.
+	h *= 0x9e3779b97f4a7c15ULL;
+	d->hache = ( ( d->hache << 5 ) | ( d->hache >> 59 ) ) ^ ( h ^ ( h >> 29 ) );
+}
+
+size_t hacher_ensemble(
+	const Ensemble* ensemble, size_t (*hacher_element)( const intptr_t elem )
+){
+	data_hacher_ensemble_t data;
+	data.hacher_element = hacher_element;
+	data.hache = taille_ensemble( ensemble );
+	pour_tout_element( ensemble, action_hacher_ensemble, &data );
+	return (size_t) data.hache;
+}
+
+/*
+ * Renvoie le nombre d'éléments communs à deux ensembles codés par des 
+ * tableaux de bits ou compressés.
+ */
+static size_t cardinal_intersection_compresse( 
+	const Ensemble* ens1, const Ensemble* ens2 
+){
+	Roaring tampon1, tampon2;
+	const Roaring* roaring1 = en_roaring( ens1, &tampon1 );
+	const Roaring* roaring2 = en_roaring( ens2, &tampon2 );
+	size_t res = roaring_cardinal_intersection( roaring1, roaring2 );
+	liberer_en_roaring( roaring1, &tampon1 );
+	liberer_en_roaring( roaring2, &tampon2 );
+	return res;
+}
+
+/*
+ * Renvoie 1 si deux ensembles codés par des tableaux de bits ou compressés 
+ * ont un élément commun.
+ */
+static int se_coupent_compresse( const Ensemble* ens1, const Ensemble* ens2 ){
+	Roaring tampon1, tampon2;
+	const Roaring* roaring1 = en_roaring( ens1, &tampon1 );
+	const Roaring* roaring2 = en_roaring( ens2, &tampon2 );
+	int res = roaring_se_coupent( roaring1, roaring2 );
+	liberer_en_roaring( roaring1, &tampon1 );
+	liberer_en_roaring( roaring2, &tampon2 );
+	return res;
+}
+
+/*
+ * Renvoie 1 si ens1 est inclus dans ens2, les deux ensembles étant codés 
+ * par des tableaux de bits : les mots de ens1 en dehors du tableau de ens2
+ * doivent être nuls, les autres inclus dans ceux de ens2.
+ */
+static int est_inclus_bitset( const Ensemble* ens1, const Ensemble* ens2 ){
+	intptr_t debut = ens1->premier_mot;
+	intptr_t fin = ens1->premier_mot + ens1->nb_mots;
+	if( ens2->premier_mot > debut ) debut = ens2->premier_mot;
+	if( ens2->premier_mot + (intptr_t) ens2->nb_mots < fin ){
+		fin = ens2->premier_mot + ens2->nb_mots;
+	}
+	if( debut >= fin ){
+		return bitset_est_nul( ens1->mots, ens1->nb_mots );
+	}
+	return 
+		bitset_est_nul( ens1->mots, debut - ens1->premier_mot ) &&
+		bitset_est_nul(
+			ens1->mots + ( fin - ens1->premier_mot ),
+			ens1->premier_mot + ens1->nb_mots - fin
+		) &&
+		bitset_est_inclus(
+			ens1->mots + ( debut - ens1->premier_mot ),
+			ens2->mots + ( debut - ens2->premier_mot ),
+			fin - debut
+		);
+}
+
+int ensembles_egaux( const Ensemble* ens1, const Ensemble* ens2 ){
+	if( ens1 == ens2 ) return 1;
+	if( taille_ensemble( ens1 ) != taille_ensemble( ens2 ) ) return 0;
+	if( 
+		ens1->representation == ENSEMBLE_BITSET &&
+		ens2->representation == ENSEMBLE_BITSET
+	){
+		if(
+			ens1->premier_mot == ens2->premier_mot &&
+			ens1->nb_mots == ens2->nb_mots
+		){
+			return bitset_egaux( ens1->mots, ens2->mots, ens1->nb_mots );
+		}
+		// À taille égale, l'inclusion suffit.
+		return est_inclus_bitset( ens1, ens2 );
+	}
+	if( 
+		ens1->representation == ENSEMBLE_COMPRESSE &&
+		ens2->representation == ENSEMBLE_COMPRESSE
+	){
+		return roaring_egaux( &ens1->roaring, &ens2->roaring );
+	}
+	if( est_compressible( ens1 ) && est_compressible( ens2 ) ){
+		return cardinal_intersection_compresse( ens1, ens2 ) == ens1->taille;
+	}
+	return comparer_ensemble( ens1, ens2 ) == 0;
+}
+
+int est_inclus_dans_ensemble( const Ensemble* ens1, const Ensemble* ens2 ){
+	if( ens1 == ens2 ) return 1;
+	if( taille_ensemble( ens1 ) > taille_ensemble( ens2 ) ) return 0;
+	if( 
+		ens1->representation == ENSEMBLE_BITSET &&
+		ens2->representation == ENSEMBLE_BITSET
+	){
+		return est_inclus_bitset( ens1, ens2 );
+	}
+	if( est_compressible( ens1 ) && est_compressible( ens2 ) ){
+		return cardinal_intersection_compresse( ens1, ens2 ) == ens1->taille;
+	}
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( ens1 );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		if( ! est_dans_l_ensemble( ens2, get_element( it ) ) ){
+			return 0;
+		}
+	}
+	return 1;
+}
+
+int ensembles_se_coupent( const Ensemble* ens1, const Ensemble* ens2 ){
+	if( 
+		ens1->representation == ENSEMBLE_BITSET &&
+		ens2->representation == ENSEMBLE_BITSET
+	){
+		intptr_t debut = ens1->premier_mot;
+		intptr_t fin = ens1->premier_mot + ens1->nb_mots;
+		if( ens2->premier_mot > debut ) debut = ens2->premier_mot;
+		if( ens2->premier_mot + (intptr_t) ens2->nb_mots < fin ){
+			fin = ens2->premier_mot + ens2->nb_mots;
+		}
+		return debut < fin && bitset_se_coupent(
+			ens1->mots + ( debut - ens1->premier_mot ),
+			ens2->mots + ( debut - ens2->premier_mot ),
+			fin - debut
+		);
+	}
+	if( est_compressible( ens1 ) && est_compressible( ens2 ) ){
+		return se_coupent_compresse( ens1, ens2 );
+	}
+	// On parcourt le plus petit ensemble et on cherche dans l'autre.
+	if( taille_ensemble( ens1 ) > taille_ensemble( ens2 ) ){
+		const Ensemble* tmp = ens1;
+		ens1 = ens2;
+		ens2 = tmp;
+	}
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( ens1 );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		if( est_dans_l_ensemble( ens2, get_element( it ) ) ){
+			return 1;
+		}
+	}
+	return 0;
 }
 
 typedef struct {
@@ -193,6 +888,36 @@ void pour_tout_element(
 	void (* action )( const intptr_t element, void* data ),
 	void* data
 ){
+	if( ensemble->representation == ENSEMBLE_TABLEAU ){
+		const intptr_t* elements = elements_tableau_const( ensemble );
+		unsigned int i;
+		for( i=0; i<ensemble->taille; i++ ){
+			action( elements[i], data );
+		}
+		return;
+	}
+	if( ensemble->representation == ENSEMBLE_BITSET ){
+		intptr_t pos;
+		for(
+			pos = bitset_suivant( ensemble->mots, ensemble->nb_mots, 0 );
+			pos >= 0;
+			pos = bitset_suivant( ensemble->mots, ensemble->nb_mots, pos + 1 )
+		){
+			action( element_du_bit( ensemble, pos ), data );
+		}
+		return;
+	}
+	if( ensemble->representation == ENSEMBLE_COMPRESSE ){
+		intptr_t pos;
+		for(
+			pos = roaring_suivant( &ensemble->roaring, -1 );
+			pos >= 0;
+			pos = roaring_suivant( &ensemble->roaring, pos )
+		){
+			action( roaring_element( &ensemble->roaring, pos ), data );
+		}
+		return;
+	}
 	data_pour_tout_element_t data1;
 	data1.action = action;
 	data1.data = data;
@@ -202,72 +927,454 @@ void pour_tout_element(
 }
 
 void swap_ensemble( Ensemble* ens1, Ensemble* ens2 ){
-	void* tmp = ens1->table;
-	ens1->table = ens2->table;
-	ens2->table = tmp;
+	Ensemble tmp = *ens1;
+	*ens1 = *ens2;
+	*ens2 = tmp;
 }
 void deplacer_ensemble( Ensemble* ens1, Ensemble* ens2 ){
 	swap_ensemble( ens1, ens2 );
 	liberer_ensemble( ens2 );
 }
 
+/*
+ * Remplit 'res', codé par un tableau vide, avec une copie du contenu de 
+ * 'ensemble'. Les deux ensembles ont les mêmes fonctions.
+ */
+static void copier_contenu( Ensemble* res, const Ensemble* ensemble ){
+	if( ensemble->representation == ENSEMBLE_TABLEAU ){
+		const intptr_t* elements = elements_tableau_const( ensemble );
+		unsigned int i;
+		if( ensemble->elements ){
+			res->elements = xmalloc( ensemble->capacite * sizeof(intptr_t) );
+			res->capacite = ensemble->capacite;
+		}
+		intptr_t* copie = elements_tableau( res );
+		for( i=0; i<ensemble->taille; i++ ){
+			if( ensemble->copier_element && elements[i] ){
+				copie[i] = ensemble->copier_element( elements[i] );
+			}else{
+				copie[i] = elements[i];
+			}
+		}
+		res->taille = ensemble->taille;
+		return;
+	}
+	if( ensemble->representation == ENSEMBLE_BITSET ){
+		initialiser_bitset( res );
+		if( ensemble->nb_mots ){
+			res->mots = xmalloc( ensemble->nb_mots * sizeof(uint64_t) );
+			memcpy(
+				res->mots, ensemble->mots, 
+				ensemble->nb_mots * sizeof(uint64_t)
+			);
+		}
+		res->nb_mots = ensemble->nb_mots;
+		res->premier_mot = ensemble->premier_mot;
+		res->taille = ensemble->taille;
+		return;
+	}
+	if( ensemble->representation == ENSEMBLE_COMPRESSE ){
+		res->representation = ENSEMBLE_COMPRESSE;
+		roaring_copier( &res->roaring, &ensemble->roaring );
+		res->taille = ensemble->taille;
+		return;
+	}
+	// La table fait sa propre copie des éléments.
+	res->representation = ENSEMBLE_ARBRE;
+	res->table = copier_table( ensemble->table, NULL );
+}
+
 Ensemble* copier_ensemble( const Ensemble* ensemble ){
+	Ensemble* res = (Ensemble*) xmalloc( sizeof(Ensemble) );
+	*res = *ensemble;
+	initialiser_tableau( res );
+	copier_contenu( res, ensemble );
+	return res;
+}
+
+/*
+ * Remplit l'ensemble vide 'res', qui vient d'être créé, avec une copie des 
+ * 'taille' éléments du tableau 'elements'. Ces éléments doivent être deux à 
+ * deux distincts et triés dans l'ordre croissant.
+ *
+ * L'ensemble obtenu a la même représentation que si ses éléments avaient été
+ * ajoutés un par un, mais il est construit en temps linéaire.
+ */
+static void remplir_ensemble_trie(
+	Ensemble* res, const intptr_t* elements, unsigned int taille
+){
+	unsigned int i;
+	if( taille <= ENSEMBLE_TAILLE_MAX_TABLEAU ){
+		if( taille > ENSEMBLE_CAPACITE_INLINE ){
+			res->elements = xmalloc( taille * sizeof(intptr_t) );
+			res->capacite = taille;
+		}
+		intptr_t* copie = elements_tableau( res );
+		for( i=0; i<taille; i++ ){
+			if( res->copier_element && elements[i] ){
+				copie[i] = res->copier_element( elements[i] );
+			}else{
+				copie[i] = elements[i];
+			}
+		}
+		res->taille = taille;
+		return;
+	}
+	intptr_t mot_min = BITSET_MOT( elements[0] );
+	intptr_t mot_max = BITSET_MOT( elements[taille-1] );
+	if(
+		est_un_ensemble_d_entiers( res ) &&
+		bitset_densite_acceptable( mot_max - mot_min + 1, taille )
+	){
+		initialiser_bitset( res );
+		etendre_bitset( res, mot_min, mot_max, taille );
+		for( i=0; i<taille; i++ ){
+			intptr_t pos = bit_de_l_element( res, elements[i] );
+			res->mots[ BITSET_MOT( pos ) ] |= BITSET_MASQUE( pos );
+		}
+		res->taille = taille;
+		return;
+	}
+	if( est_un_ensemble_d_entiers( res ) ){
+		res->representation = ENSEMBLE_COMPRESSE;
+		roaring_initialiser( &res->roaring );
+		roaring_remplir( &res->roaring, elements, taille );
+		res->taille = taille;
+		return;
+	}
+	res->representation = ENSEMBLE_ARBRE;
+	res->table = creer_table(
+		res->comparer_element, res->copier_element, res->supprimer_element
+	);
+	remplir_table_triee( res->table, elements, NULL, taille );
+}
+
+static int comparer_elements_du_tableau( 
+	const void* a, const void* b, void* ens
+){
+	return comparer_elements(
+		(const Ensemble*) ens, *(const intptr_t*) a, *(const intptr_t*) b
+	);
+}
+
+Ensemble * creer_ensemble_depuis_tableau(
+	int (*comparer_element)( const intptr_t elem1, const intptr_t elem2 ),
+	intptr_t (*copier_element)( const intptr_t elem ),
+	void (*supprimer_element)(intptr_t elem ),
+	const intptr_t* elements, unsigned int nb
+){
 	Ensemble* res = creer_ensemble(
-		ensemble->comparer_element, ensemble->copier_element,
-		ensemble->supprimer_element
+		comparer_element, copier_element, supprimer_element
 	);
-	ajouter_elements( res, ensemble  );
+	intptr_t* tries = xmalloc( ( nb + 1 ) * sizeof(intptr_t) );
+	memcpy( tries, elements, nb * sizeof(intptr_t) );
+	trier_tableau(
+		tries, nb, sizeof(intptr_t), comparer_elements_du_tableau, res 
+	);
+	// On ne garde qu'un exemplaire de chaque élément.
+	unsigned int i, taille = 0;
+	for( i=0; i<nb; i++ ){
+		if( 
+			taille == 0 || 
+			comparer_elements( res, tries[taille-1], tries[i] ) != 0 
+		){
+			tries[taille++] = tries[i];
+		}
+	}
+	remplir_ensemble_trie( res, tries, taille );
+	xfree( tries );
 	return res;
 }
 
-Ensemble * creer_union_ensemble( const Ensemble* ens1, const Ensemble* ens2 ){
-	Ensemble * res = copier_ensemble( ens1 );
-	ajouter_elements( res, ens2 );
+/*
+ * Parties de ens1 et ens2 que fusionner_ensembles() doit garder.
+ */
+#define FUSION_SEULEMENT_DANS_1 1
+#define FUSION_SEULEMENT_DANS_2 2
+#define FUSION_DANS_LES_DEUX 4
+
+typedef struct {
+	intptr_t* elements;
+	unsigned int taille;
+} data_elements_tries_t;
+
+static void action_elements_tries( const intptr_t element, void* data ){
+	data_elements_tries_t* d = (data_elements_tries_t*) data;
+	d->elements[ d->taille++ ] = element;
+}
+
+unsigned int ensemble_vers_tableau( const Ensemble* ensemble, intptr_t* tableau ){
+	data_elements_tries_t data;
+	data.elements = tableau;
+	data.taille = 0;
+	pour_tout_element( ensemble, action_elements_tries, &data );
+	return data.taille;
+}
+
+/*
+ * Renvoie un tableau, alloué, contenant les éléments de l'ensemble dans 
+ * l'ordre croissant. Les éléments ne sont pas copiés.
+ */
+static intptr_t* elements_tries( const Ensemble* ens ){
+	intptr_t* res = xmalloc( ( taille_ensemble( ens ) + 1 ) * sizeof(intptr_t) );
+	ensemble_vers_tableau( ens, res );
+	return res;
+}
+
+/*
+ * Fusionne les éléments de ens1 et de ens2, pris dans l'ordre croissant, et
+ * renvoie l'ensemble des éléments qui appartiennent aux parties désignées par 
+ * 'garder' (combinaison des constantes FUSION_*).
+ *
+ * Chaque ensemble n'est parcouru qu'une fois et le résultat est construit à 
+ * partir du tableau trié des éléments gardés : le tout se fait en temps
+ * linéaire.
+ */
+static Ensemble* fusionner_ensembles(
+	const Ensemble* ens1, const Ensemble* ens2, int garder
+){
+	unsigned int taille1 = taille_ensemble( ens1 );
+	unsigned int taille2 = taille_ensemble( ens2 );
+	intptr_t* elements1 = elements_tries( ens1 );
+	intptr_t* elements2 = elements_tries( ens2 );
+	intptr_t* elements = xmalloc( ( taille1 + taille2 + 1 ) * sizeof(intptr_t) );
+	unsigned int i = 0, j = 0, taille = 0;
+	while( i < taille1 && j < taille2 ){
+		int cmp = comparer_elements( ens1, elements1[i], elements2[j] );
+		if( cmp < 0 ){
+			if( garder & FUSION_SEULEMENT_DANS_1 ) elements[taille++] = elements1[i];
+			i++;
+		}else if( cmp > 0 ){
+			if( garder & FUSION_SEULEMENT_DANS_2 ) elements[taille++] = elements2[j];
+			j++;
+		}else{
+			if( garder & FUSION_DANS_LES_DEUX ) elements[taille++] = elements1[i];
+			i++;
+			j++;
+		}
+	}
+	if( garder & FUSION_SEULEMENT_DANS_1 ){
+		while( i < taille1 ) elements[taille++] = elements1[i++];
+	}
+	if( garder & FUSION_SEULEMENT_DANS_2 ){
+		while( j < taille2 ) elements[taille++] = elements2[j++];
+	}
+	Ensemble* res = creer_ensemble(
+		ens1->comparer_element, ens1->copier_element, ens1->supprimer_element
+	);
+	remplir_ensemble_trie( res, elements, taille );
+	xfree( elements );
+	xfree( elements1 );
+	xfree( elements2 );
 	return res;
 }
 
+Ensemble * creer_union_ensemble( const Ensemble* ens1, const Ensemble* ens2 ){
+	if( est_compressible( ens1 ) && est_compressible( ens2 ) ){
+		Ensemble * res = copier_ensemble( ens1 );
+		ajouter_elements( res, ens2 );
+		return res;
+	}
+	return fusionner_ensembles(
+		ens1, ens2, 
+		FUSION_SEULEMENT_DANS_1 | FUSION_SEULEMENT_DANS_2 | FUSION_DANS_LES_DEUX
+	);
+}
+
 Ensemble * creer_difference_ensemble(
 	const Ensemble* ens1, const Ensemble* ens2
 ){
-	Ensemble * res = copier_ensemble( ens1 );
-	retirer_elements( res, ens2 );
+	if( est_compressible( ens1 ) && est_compressible( ens2 ) ){
+		Ensemble * res = copier_ensemble( ens1 );
+		retirer_elements( res, ens2 );
+		return res;
+	}
+	return fusionner_ensembles( ens1, ens2, FUSION_SEULEMENT_DANS_1 );
+}
+
+/*
+ * Calcule, mot par mot, l'intersection de deux ensembles codés par des
+ * tableaux de bits.
+ */
+static Ensemble * creer_intersection_bitset(
+	const Ensemble* ens1, const Ensemble* ens2
+){
+	Ensemble * res = creer_ensemble( NULL, NULL, NULL );
+	initialiser_bitset( res );
+	intptr_t debut = ens1->premier_mot;
+	intptr_t fin = ens1->premier_mot + ens1->nb_mots;
+	if( ens2->premier_mot > debut ) debut = ens2->premier_mot;
+	if( ens2->premier_mot + (intptr_t) ens2->nb_mots < fin ){
+		fin = ens2->premier_mot + ens2->nb_mots;
+	}
+	if( debut < fin ){
+		size_t nb_mots = fin - debut;
+		res->mots = xmalloc( nb_mots * sizeof(uint64_t) );
+		bitset_intersection(
+			res->mots, 
+			ens1->mots + ( debut - ens1->premier_mot ),
+			ens2->mots + ( debut - ens2->premier_mot ),
+			nb_mots
+		);
+		res->nb_mots = nb_mots;
+		res->premier_mot = debut;
+		res->taille = bitset_popcount( res->mots, nb_mots );
+	}
 	return res;
 }
 
 Ensemble * creer_intersection_ensemble(
 	const Ensemble* ens1, const Ensemble* ens2
 ){
-	Ensemble *tmp, *res;
-	tmp = creer_difference_ensemble( ens1, ens2 );
-	res = creer_difference_ensemble( ens1, tmp );
-	liberer_ensemble( tmp );
-	return res;
+	if(
+		ens1->representation == ENSEMBLE_BITSET &&
+		ens2->representation == ENSEMBLE_BITSET
+	){
+		return creer_intersection_bitset( ens1, ens2 );
+	}
+	if( est_compressible( ens1 ) && est_compressible( ens2 ) ){
+		Ensemble * res = creer_ensemble( NULL, NULL, NULL );
+		Roaring tampon1, tampon2;
+		const Roaring* roaring1 = en_roaring( ens1, &tampon1 );
+		const Roaring* roaring2 = en_roaring( ens2, &tampon2 );
+		res->representation = ENSEMBLE_COMPRESSE;
+		roaring_intersection( &res->roaring, roaring1, roaring2 );
+		res->taille = res->roaring.cardinal;
+		liberer_en_roaring( roaring1, &tampon1 );
+		liberer_en_roaring( roaring2, &tampon2 );
+		return res;
+	}
+	return fusionner_ensembles( ens1, ens2, FUSION_DANS_LES_DEUX );
 }
 
 Ensemble_iterateur trouver_ensemble(
 	const Ensemble* ensemble, const intptr_t element
 ){
-	return trouver_table( ensemble->table, element );
+	Ensemble_iterateur it;
+	it.ensemble = ensemble;
+	if( ensemble->representation == ENSEMBLE_TABLEAU ){
+		int indice;
+		it.position = -1;
+		if( chercher_dans_tableau( ensemble, element, &indice ) ){
+			it.position = indice;
+		}
+	}else if( ensemble->representation == ENSEMBLE_BITSET ){
+		it.position = -1;
+		if( est_dans_l_ensemble( ensemble, element ) ){
+			it.position = bit_de_l_element( ensemble, element );
+		}
+	}else if( ensemble->representation == ENSEMBLE_COMPRESSE ){
+		it.position = roaring_position( &ensemble->roaring, element );
+	}else{
+		it.arbre = trouver_table( ensemble->table, element );
+	}
+	return it;
 }
 
 Ensemble_iterateur premier_iterateur_ensemble( const Ensemble* ensemble ){
-	return premier_iterateur_table( ensemble->table );
+	Ensemble_iterateur it;
+	it.ensemble = ensemble;
+	if( ensemble->representation == ENSEMBLE_TABLEAU ){
+		it.position = ensemble->taille ? 0 : -1;
+	}else if( ensemble->representation == ENSEMBLE_BITSET ){
+		it.position = bitset_suivant( ensemble->mots, ensemble->nb_mots, 0 );
+	}else if( ensemble->representation == ENSEMBLE_COMPRESSE ){
+		it.position = roaring_suivant( &ensemble->roaring, -1 );
+	}else{
+		it.arbre = premier_iterateur_table( ensemble->table );
+	}
+	return it;
+}
+
+Ensemble_iterateur dernier_iterateur_ensemble( const Ensemble* ensemble ){
+	// Le précédent de l'itérateur vide est le dernier élément.
+	return iterateur_precedent_ensemble( 
+		ieme_iterateur_ensemble( ensemble, taille_ensemble( ensemble ) ) 
+	);
+}
+
+Ensemble_iterateur ieme_iterateur_ensemble(
+	const Ensemble* ensemble, unsigned int rang
+){
+	Ensemble_iterateur it;
+	it.ensemble = ensemble;
+	if( ensemble->representation == ENSEMBLE_ARBRE ){
+		it.arbre = ieme_iterateur_table( ensemble->table, rang );
+	}else if( rang >= ensemble->taille ){
+		it.position = -1;
+	}else if( ensemble->representation == ENSEMBLE_TABLEAU ){
+		it.position = rang;
+	}else if( ensemble->representation == ENSEMBLE_BITSET ){
+		it.position = bitset_ieme( ensemble->mots, ensemble->nb_mots, rang );
+	}else{
+		it.position = roaring_ieme( &ensemble->roaring, rang );
+	}
+	return it;
 }
 
 Ensemble_iterateur iterateur_suivant_ensemble(
-	const Ensemble_iterateur iterateur
+	Ensemble_iterateur iterateur
 ){
-	return iterateur_suivant_table( iterateur );
+	const Ensemble* ens = iterateur.ensemble;
+	if( ens->representation == ENSEMBLE_TABLEAU ){
+		iterateur.position++;
+		if( iterateur.position >= ens->taille ){
+			iterateur.position = -1;
+		}
+	}else if( ens->representation == ENSEMBLE_BITSET ){
+		// Comme pour les arbres, le suivant de l'itérateur vide est le
+		// premier élément.
+		iterateur.position = bitset_suivant(
+			ens->mots, ens->nb_mots, iterateur.position + 1
+		);
+	}else if( ens->representation == ENSEMBLE_COMPRESSE ){
+		iterateur.position = roaring_suivant( &ens->roaring, iterateur.position );
+	}else{
+		iterateur.arbre = iterateur_suivant_table( iterateur.arbre );
+	}
+	return iterateur;
 }
 
 Ensemble_iterateur iterateur_precedent_ensemble( Ensemble_iterateur iterateur ){
-	return iterateur_precedent_table( iterateur );
+	const Ensemble* ens = iterateur.ensemble;
+	if( ens->representation == ENSEMBLE_TABLEAU ){
+		if( iterateur.position < 0 ){
+			iterateur.position = ens->taille;
+		}
+		iterateur.position--;
+	}else if( ens->representation == ENSEMBLE_BITSET ){
+		// Le précédent de l'itérateur vide est le dernier élément.
+		intptr_t position = iterateur.position - 1;
+		if( iterateur.position < 0 ){
+			position = ens->nb_mots * BITSET_BITS_PAR_MOT - 1;
+		}
+		iterateur.position = bitset_precedent(
+			ens->mots, ens->nb_mots, position
+		);
+	}else if( ens->representation == ENSEMBLE_COMPRESSE ){
+		iterateur.position = roaring_precedent( &ens->roaring, iterateur.position );
+	}else{
+		iterateur.arbre = iterateur_precedent_table( iterateur.arbre );
+	}
+	return iterateur;
 }
 
 int iterateur_ensemble_est_vide( Ensemble_iterateur iterateur ){
-	return iterateur_est_vide( iterateur );
+	if( iterateur.ensemble->representation != ENSEMBLE_ARBRE ){
+		return iterateur.position < 0;
+	}
+	return iterateur_est_vide( iterateur.arbre );
 }
 
 intptr_t get_element( Ensemble_iterateur it ){
-	return get_cle( it );
+	if( it.ensemble->representation == ENSEMBLE_TABLEAU ){
+		return elements_tableau_const( it.ensemble )[ it.position ];
+	}
+	if( it.ensemble->representation == ENSEMBLE_BITSET ){
+		return element_du_bit( it.ensemble, it.position );
+	}
+	if( it.ensemble->representation == ENSEMBLE_COMPRESSE ){
+		return roaring_element( &it.ensemble->roaring, it.position );
+	}
+	return get_cle( it.arbre );
 }
@@ -25,13 +25,62 @@
 #include <stdint.h>
 
 #include "avl.h"
+#include "bitset.h"
+#include "roaring.h"
 #include "table.h"
 
+/*
+ * Nombre d'éléments qu'un ensemble codé par un tableau peut contenir sans
+ * allouer de mémoire en dehors de la structure Ensemble.
+ */
+#define ENSEMBLE_CAPACITE_INLINE 4
+
+/*
+ * Définit les différentes représentations possibles d'un ensemble.
+ *
+ *   - ENSEMBLE_TABLEAU : les éléments sont rangés, triés, dans un tableau.
+ *     Les ENSEMBLE_CAPACITE_INLINE premiers éléments sont stockés dans la 
+ *     structure elle-même. C'est la représentation de tous les ensembles à
+ *     leur création ; elle est abandonnée quand l'ensemble grossit.
+ *   - ENSEMBLE_ARBRE : les éléments sont rangés dans un arbre AVL (une Table).
+ *   - ENSEMBLE_BITSET : les éléments sont des entiers codés par un tableau
+ *     de bits. Le bit i du mot j code l'entier 
+ *     ( premier_mot + j ) * BITSET_BITS_PAR_MOT + i.
+ *   - ENSEMBLE_COMPRESSE : les éléments sont des entiers épars, codés par 
+ *     un ensemble compressé (voir roaring.h).
+ */
+typedef enum {
+	ENSEMBLE_TABLEAU,
+	ENSEMBLE_ARBRE,
+	ENSEMBLE_BITSET,
+	ENSEMBLE_COMPRESSE
+} Ensemble_representation;
+
 /*
  * Définit le type d'un ensemble.
  */
 struct Ensemble {
-	Table* table;
+	Ensemble_representation representation;
+	unsigned int taille;
+	union {
+		// ENSEMBLE_ARBRE
+		Table* table;
+		// ENSEMBLE_COMPRESSE
+		Roaring roaring;
+		// ENSEMBLE_BITSET
+		struct {
+			uint64_t* mots;
+			size_t nb_mots;
+			intptr_t premier_mot;
+		};
+		// ENSEMBLE_TABLEAU ('elements' est NULL tant que les éléments 
+		// tiennent dans 'elements_inline')
+		struct {
+			intptr_t* elements;
+			unsigned int capacite;
+			intptr_t elements_inline[ENSEMBLE_CAPACITE_INLINE];
+		};
+	};
 	int (*comparer_element)( const intptr_t elem1, const intptr_t elem2 );
 	intptr_t (*copier_element)( const intptr_t elem );
 	void (*supprimer_element)(intptr_t elem );
@@ -41,8 +90,23 @@ typedef struct Ensemble Ensemble;
 
 /*
  * Définit le type d'un itérateur sur les éléments d'un ensemble.
+ *
+ * Pour la représentation ENSEMBLE_BITSET, 'position' est la position du bit
+ * courant dans le tableau de bits, pour la représentation 
+ * ENSEMBLE_COMPRESSE, c'est une position au sens de roaring_suivant(), et 
+ * pour la représentation ENSEMBLE_TABLEAU, c'est l'indice de l'élément 
+ * courant (-1 pour l'itérateur vide). Pour la représentation 
+ * ENSEMBLE_ARBRE, c'est le champ 'arbre' qui est utilisé. Les deux champs 
+ * partagent la même mémoire : un itérateur fait quatre mots, l'ensemble et
+ * un Table_iterateur de trois mots (32 octets sur une machine 64 bits).
  */
-typedef struct avl_traverser Ensemble_iterateur;
+typedef struct {
+	const Ensemble* ensemble;
+	union {
+		intptr_t position;
+		Table_iterateur arbre;
+	};
+} Ensemble_iterateur;
 
 /*
  * Renvoie un nouvel ensemble vide.
@@ -57,6 +121,12 @@ typedef struct avl_traverser Ensemble_iterateur;
  *   - void supprimer_element( intptr_t elem ),
  * qui permettent de comparer, supprimer et copier des éléments de l'ensemble.
  *
+ * Tant qu'il est petit, l'ensemble est codé par un tableau trié.
+ * Si les trois fonctions sont NULL, l'ensemble contient des entiers. Quand il
+ * grossit, il est alors codé par un tableau de bits (ENSEMBLE_BITSET) tant
+ * que ses éléments restent assez proches les uns des autres, et par un 
+ * ensemble compressé (ENSEMBLE_COMPRESSE) sinon. Les autres ensembles sont
+ * codés par un arbre.
  */
 Ensemble * creer_ensemble(
   int (*comparer_element)( const intptr_t elem1, const intptr_t elem2 ),
@@ -64,6 +134,32 @@ Ensemble * creer_ensemble(
   void (*supprimer_element)( intptr_t elem )
   );
 
+/*
+ * Renvoie un nouvel ensemble qui contient une copie des 'nb' éléments du 
+ * tableau 'elements'. Les fonctions de l'ensemble sont celles de 
+ * creer_ensemble().
+ *
+ * Le tableau n'a pas besoin d'être trié et peut contenir plusieurs fois le 
+ * même élément. S'il est déjà trié, l'ensemble est construit en temps 
+ * linéaire, sans insérer les éléments un par un ; sinon, une copie du 
+ * tableau est d'abord triée.
+ */
+Ensemble * creer_ensemble_depuis_tableau(
+  int (*comparer_element)( const intptr_t elem1, const intptr_t elem2 ),
+  intptr_t (*copier_element)( const intptr_t elem ),
+  void (*supprimer_element)( intptr_t elem ),
+  const intptr_t* elements, unsigned int nb
+  );
+
+/*
+ * Écrit les éléments de l'ensemble, dans l'ordre croissant, dans le tableau
+ * 'tableau', qui doit pouvoir contenir taille_ensemble( ensemble ) éléments.
+ * Renvoie le nombre d'éléments écrits.
+ *
+ * Les éléments ne sont pas copiés : ils restent la propriété de l'ensemble.
+ */
+unsigned int ensemble_vers_tableau( const Ensemble* ensemble, intptr_t* tableau );
+
 /*
  * Libère la mémoire d'un ensemble.
  * La mémoire de tous les éléments de l'ensemble est aussi libérée.
@@ -124,10 +220,50 @@ void vider_ensemble( Ensemble * ensemble );
 int est_dans_l_ensemble( const Ensemble * ensemble, const intptr_t element );
 
 /*
- * Renvoie le nombre d'éléments qui se trouvent dans l'ensemble.
+ * Renvoie le nombre d'éléments qui se trouvent dans l'ensemble, en temps 
+ * constant.
  */
 unsigned int taille_ensemble( const Ensemble* ensemble );
 
+/*
+ * Renvoie 1 si l'ensemble ne contient aucun élément, et 0 sinon.
+ */
+int ensemble_est_vide( const Ensemble* ensemble );
+
+/*
+ * Renvoie le plus petit (resp. le plus grand) élément de l'ensemble, qui ne
+ * doit pas être vide, sans passer en revue les autres éléments : pour un 
+ * arbre, il suffit de descendre à gauche (resp. à droite) depuis la racine.
+ * Un tableau de bits, en revanche, est lu mot à mot depuis son début (resp.
+ * sa fin) jusqu'au premier mot non nul, et un ensemble compressé de même
+ * dans son premier (resp. dernier) bloc : le temps est alors linéaire en
+ * le nombre de mots vides traversés.
+ */
+intptr_t min_ensemble( const Ensemble* ensemble );
+intptr_t max_ensemble( const Ensemble* ensemble );
+
+/*
+ * Renvoie le nombre d'éléments de l'ensemble strictement plus petits que 
+ * 'element', qui n'a pas besoin d'être dans l'ensemble. Un élément de 
+ * l'ensemble a donc pour rang sa position dans l'ordre croissant, à partir 
+ * de 0.
+ *
+ * Le rang se calcule en temps logarithmique pour un tableau et pour un 
+ * arbre, dont chaque noeud connaît la taille de son sous-arbre. Pour un 
+ * tableau de bits, on compte les bits à 1 qui précèdent l'élément.
+ */
+unsigned int rang_dans_l_ensemble(
+  const Ensemble* ensemble, const intptr_t element
+  );
+
+/*
+ * Renvoie le nombre d'éléments de l'ensemble compris entre 'min' et 'max', 
+ * bornes incluses, à partir de deux rangs.
+ */
+unsigned int nombre_d_elements_entre(
+  const Ensemble* ensemble, const intptr_t min, const intptr_t max
+  );
+
 /*
  * Compare deux ensembles entre eux.
  *
@@ -141,7 +277,39 @@ unsigned int taille_ensemble( const Ensemble* ensemble );
 int comparer_ensemble( const Ensemble* ens1, const Ensemble*  ens2 );
 
 /*
- * Renvoie une copie de l'ensemble passé en paramètre
+ * Renvoie 1 si les deux ensembles contiennent les mêmes éléments, et 0 sinon.
+ *
+ * Les tailles sont comparées d'abord, en temps constant : les éléments ne 
+ * sont parcourus que si les deux ensembles ont la même taille.
+ */
+int ensembles_egaux( const Ensemble* ens1, const Ensemble* ens2 );
+
+/*
+ * Renvoie 1 si tous les éléments de ens1 sont dans ens2, et 0 sinon.
+ */
+int est_inclus_dans_ensemble( const Ensemble* ens1, const Ensemble* ens2 );
+
+/*
+ * Renvoie 1 si les deux ensembles ont au moins un élément en commun, et 0 
+ * sinon. Contrairement à creer_intersection_ensemble(), rien n'est alloué.
+ */
+int ensembles_se_coupent( const Ensemble* ens1, const Ensemble* ens2 );
+
+/*
+ * Renvoie une valeur de hachage de l'ensemble, calculée à partir de sa 
+ * taille et de ses éléments pris dans l'ordre croissant. Deux ensembles 
+ * égaux ont la même valeur de hachage, quelle que soit leur représentation.
+ *
+ * 'hacher_element' doit renvoyer la même valeur pour deux éléments égaux.
+ * Il peut être NULL pour un ensemble d'entiers : les éléments sont alors 
+ * utilisés tels quels.
+ */
+size_t hacher_ensemble(
+  const Ensemble* ensemble, size_t (*hacher_element)( const intptr_t elem )
+  );
+
+/*
+ * Renvoie une copie de l'ensemble passé en paramètre, en temps linéaire.
  */
 Ensemble* copier_ensemble( const Ensemble* ensemble );
 
@@ -210,6 +378,21 @@ Ensemble_iterateur trouver_ensemble(
  */
 Ensemble_iterateur premier_iterateur_ensemble( const Ensemble* ensemble );
 
+/*
+ * Renvoie un itérateur positionné sur le dernier élement de l'ensemble.
+ */
+Ensemble_iterateur dernier_iterateur_ensemble( const Ensemble* ensemble );
+
+/*
+ * Renvoie un itérateur positionné sur l'élément de rang 'rang' (voir 
+ * rang_dans_l_ensemble()), ou l'itérateur vide si l'ensemble a au plus 
+ * 'rang' éléments. Pour un arbre, l'élément est trouvé en temps 
+ * logarithmique.
+ */
+Ensemble_iterateur ieme_iterateur_ensemble(
+  const Ensemble* ensemble, unsigned int rang
+  );
+
 /*
  * Renvoie l'iterateur suivant.
  *
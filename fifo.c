@@ -22,62 +22,178 @@
 #include "outils.h"
 #include "fifo.h"
 
-typedef struct List List;
+#include <assert.h>
+#include <string.h>
 
-struct List {
-	List * next;
-	intptr_t element;
-};
+/*
+ * Capacité du tableau de la file lors du premier ajout.
+ */
+#define FIFO_CAPACITE_MIN 16
 
+/*
+ * Les 'taille' éléments de la file occupent les cases debut, debut+1, ...
+ * du tableau, modulo 'capacite', qui est une puissance de 2.
+ */
 struct Fifo {
-	List * list;
+	intptr_t* elements;
+	size_t capacite;
+	size_t debut;
+	size_t taille;
 };
 
-List* allouer_list( List * next, intptr_t element ){
-	List* res = (List*) xmalloc( sizeof(List) );
-	res->next = next;
-	res->element = element;
-	return res;
+static size_t case_fifo( const Fifo* fifo, size_t i ){
+	return ( fifo->debut + i ) & ( fifo->capacite - 1 );
 }
 
-void liberer_list( List * list ){
-	xfree( list );
+/*
+ * Remplace le tableau de la file par un tableau de 'capacite' cases, où
+ * les éléments sont rangés à partir de la case 0.
+ */
+static void redimensionner_fifo( Fifo* fifo, size_t capacite ){
+	intptr_t* elements = xmalloc( capacite * sizeof(intptr_t) );
+	if( fifo->taille ){
+		size_t avant_la_fin = fifo->capacite - fifo->debut;
+		if( avant_la_fin >= fifo->taille ){
+			memcpy( 
+				elements, fifo->elements + fifo->debut, 
+				fifo->taille * sizeof(intptr_t) 
+			);
+		}else{
+			memcpy( 
+				elements, fifo->elements + fifo->debut, 
+				avant_la_fin * sizeof(intptr_t) 
+			);
+			memcpy( 
+				elements + avant_la_fin, fifo->elements, 
+				( fifo->taille - avant_la_fin ) * sizeof(intptr_t) 
+			);
+		}
+	}
+	xfree( fifo->elements );
+	fifo->elements = elements;
+	fifo->capacite = capacite;
+	fifo->debut = 0;
+}
+
+void reserver_fifo( Fifo* fifo, size_t nb ){
+	if( nb <= fifo->capacite ){
+		return;
+	}
+	size_t capacite = fifo->capacite ? fifo->capacite : FIFO_CAPACITE_MIN;
+	while( capacite < nb ){
+		capacite *= 2;
+	}
+	redimensionner_fifo( fifo, capacite );
 }
 
 void ajouter_fifo( Fifo* fifo, intptr_t element ){
-	fifo->list = allouer_list( fifo->list, element );
+	if( fifo->taille == fifo->capacite ){
+		reserver_fifo( fifo, fifo->taille + 1 );
+	}
+	fifo->elements[ case_fifo( fifo, fifo->taille ) ] = element;
+	fifo->taille++;
+}
+
+void ajouter_debut_fifo( Fifo* fifo, intptr_t element ){
+	if( fifo->taille == fifo->capacite ){
+		reserver_fifo( fifo, fifo->taille + 1 );
+	}
+	fifo->debut = ( fifo->debut - 1 ) & ( fifo->capacite - 1 );
+	fifo->elements[ fifo->debut ] = element;
+	fifo->taille++;
 }
 
 intptr_t retirer_fifo( Fifo* fifo ){
-	intptr_t res = fifo->list->element;
-	List* tmp = fifo->list;
-	fifo->list = fifo->list->next;
-	liberer_list( tmp );
+	assert( fifo->taille );
+	intptr_t res = fifo->elements[ fifo->debut ];
+	fifo->debut = case_fifo( fifo, 1 );
+	fifo->taille--;
 	return res;
 }
 
+intptr_t retirer_fin_fifo( Fifo* fifo ){
+	assert( fifo->taille );
+	fifo->taille--;
+	return fifo->elements[ case_fifo( fifo, fifo->taille ) ];
+}
+
 intptr_t obtenir_fifo( Fifo* fifo ){
-	return fifo->list->element;
+	assert( fifo->taille );
+	return fifo->elements[ fifo->debut ];
+}
+
+intptr_t obtenir_fin_fifo( Fifo* fifo ){
+	assert( fifo->taille );
+	return fifo->elements[ case_fifo( fifo, fifo->taille - 1 ) ];
+}
+
+void ajouter_tableau_fifo( Fifo* fifo, const intptr_t* elements, size_t nb ){
+	if( ! nb ){
+		return;
+	}
+	reserver_fifo( fifo, fifo->taille + nb );
+	// Les éléments sont copiés en au plus deux morceaux : jusqu'à la fin du
+	// tableau, puis depuis son début.
+	size_t fin = case_fifo( fifo, fifo->taille );
+	size_t premier_morceau = fifo->capacite - fin;
+	if( premier_morceau > nb ){
+		premier_morceau = nb;
+	}
+	memcpy( fifo->elements + fin, elements, premier_morceau * sizeof(intptr_t) );
+	memcpy( 
+		fifo->elements, elements + premier_morceau, 
+		( nb - premier_morceau ) * sizeof(intptr_t) 
+	);
+	fifo->taille += nb;
+}
+
+size_t retirer_tableau_fifo( Fifo* fifo, intptr_t* elements, size_t nb ){
+	if( nb > fifo->taille ){
+		nb = fifo->taille;
+	}
+	if( ! nb ){
+		return 0;
+	}
+	size_t premier_morceau = fifo->capacite - fifo->debut;
+	if( premier_morceau > nb ){
+		premier_morceau = nb;
+	}
+	memcpy( 
+		elements, fifo->elements + fifo->debut, 
+		premier_morceau * sizeof(intptr_t) 
+	);
+	memcpy( 
+		elements + premier_morceau, fifo->elements, 
+		( nb - premier_morceau ) * sizeof(intptr_t) 
+	);
+	fifo->debut = case_fifo( fifo, nb );
+	fifo->taille -= nb;
+	return nb;
 }
 
 int est_vide( Fifo* fifo ){
-	return fifo->list == NULL;
+	return fifo->taille == 0;
+}
+
+size_t taille_fifo( const Fifo* fifo ){
+	return fifo->taille;
 }
 
 Fifo* creer_fifo(){
 	Fifo* res = xmalloc( sizeof(Fifo) );
-	res->list = NULL;
+	res->elements = NULL;
+	res->capacite = 0;
+	res->debut = 0;
+	res->taille = 0;
 	return res;
 }
 
-void vider_list( List * list ){
-	if( list ){
-		vider_list( list->next );
-		xfree( list );
-	}
+void vider_fifo( Fifo* fifo ){
+	fifo->debut = 0;
+	fifo->taille = 0;
 }
 
 void liberer_fifo( Fifo* file ){
-	vider_list( file->list );
+	xfree( file->elements );
 	xfree( file );
 }
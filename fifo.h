@@ -22,13 +22,20 @@
 #ifndef __FIFO_H__
 #define __FIFO_H__
 
+#include <stddef.h>
 #include <stdint.h>
 
 /*
  * Définit le type d'une file first-in first-out contenant des entiers ou 
- * des pointerus vers des stucture plus complexes.
+ * des pointeurs vers des structures plus complexes.
  * La file n'est pas responsable de la mémoire des éléments qui y sont 
  * entreposés.
+ *
+ * Les éléments sont rangés dans un tableau circulaire qui double de taille
+ * quand il est plein : ajouter ou retirer un élément, à l'une ou l'autre
+ * des extrémités de la file, se fait en temps constant amorti, sans 
+ * allocation dans le cas courant. La file peut aussi servir de pile ou de 
+ * file à double entrée.
  */
 typedef struct Fifo Fifo;
 
@@ -39,29 +46,75 @@ Fifo* creer_fifo();
 
 /*
  * Supprimme la mémoire associée à la file.
- * La mamoir associée aux élément de la file ne sont pas supprimé.
+ * La mémoire associée aux éléments de la file n'est pas supprimée.
  */
 void liberer_fifo( Fifo* fifo );
 
+/*
+ * Retire tous les éléments de la file, en temps constant. La mémoire du 
+ * tableau est gardée pour les ajouts suivants.
+ */
+void vider_fifo( Fifo* fifo );
+
 /*
  * Renvoie vrai si la file ne contient pas d'élement.
  */
 int est_vide( Fifo* fifo );
 
 /*
- * Ajoute un élément au dessus de la pile.
+ * Renvoie le nombre d'éléments de la file.
+ */
+size_t taille_fifo( const Fifo* fifo );
+
+/*
+ * Garantit que la file peut contenir 'nb' éléments sans allouer de mémoire.
+ */
+void reserver_fifo( Fifo* fifo, size_t nb );
+
+/*
+ * Ajoute un élément à la fin de la file.
  */
 void ajouter_fifo( Fifo* fifo, intptr_t element );
 
 /*
- * Retire un élément du dessus de la pile et le renvoie.
+ * Retire l'élément du début de la file et le renvoie.
+ * La file ne doit pas être vide.
  */
 intptr_t retirer_fifo( Fifo* fifo );
 
 /*
- * Renvoie l'élement qui se trouve au dessus de la pile. L'élément n'est pas
- * retiré de la pile.
+ * Renvoie l'élement qui se trouve au début de la file. L'élément n'est pas
+ * retiré de la file.
  */
 intptr_t obtenir_fifo( Fifo* fifo );
 
+/*
+ * Ajoute un élément au début de la file : c'est lui que renverra le 
+ * prochain appel à retirer_fifo().
+ */
+void ajouter_debut_fifo( Fifo* fifo, intptr_t element );
+
+/*
+ * Retire l'élément de la fin de la file (le dernier ajouté par 
+ * ajouter_fifo()) et le renvoie. La file ne doit pas être vide.
+ */
+intptr_t retirer_fin_fifo( Fifo* fifo );
+
+/*
+ * Renvoie l'élement qui se trouve à la fin de la file, sans le retirer.
+ */
+intptr_t obtenir_fin_fifo( Fifo* fifo );
+
+/*
+ * Ajoute, dans l'ordre, les 'nb' éléments du tableau 'elements' à la fin de
+ * la file. La mémoire est allouée au plus une fois.
+ */
+void ajouter_tableau_fifo( Fifo* fifo, const intptr_t* elements, size_t nb );
+
+/*
+ * Retire au plus 'nb' éléments du début de la file et les écrit, dans 
+ * l'ordre, dans le tableau 'elements'. Renvoie le nombre d'éléments retirés.
+ */
+size_t retirer_tableau_fifo( Fifo* fifo, intptr_t* elements, size_t nb );
+
 #endif
@@ -0,0 +1,255 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "file_mpmc.h"
+#include "outils.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+
+/*
+ * Taille supposée d'une ligne de cache. Les positions d'écriture et de 
+ * lecture, modifiées par des threads différents, sont placées sur des 
+ * lignes distinctes.
+ */
+#define FILE_MPMC_LIGNE_DE_CACHE 64
+
+/*
+ * Une case peut être écrite par l'ajout de position p quand sa séquence 
+ * vaut p, et lue par le retrait de position p quand elle vaut p + 1. Après
+ * la lecture, la séquence passe à p + capacite : la case attend l'ajout du 
+ * tour suivant.
+ */
+typedef struct {
+	atomic_size_t sequence;
+	intptr_t element;
+} Case_mpmc;
+
+struct File_mpmc {
+	Case_mpmc* cases;
+	size_t masque;
+	char separation1[FILE_MPMC_LIGNE_DE_CACHE];
+	atomic_size_t fin;
+	char separation2[FILE_MPMC_LIGNE_DE_CACHE];
+	atomic_size_t debut;
+	char separation3[FILE_MPMC_LIGNE_DE_CACHE];
+};
+
+File_mpmc* creer_file_mpmc( size_t capacite ){
+	size_t c = 2;
+	while( c < capacite ){
+		c *= 2;
+	}
+	File_mpmc* file = xmalloc( sizeof(File_mpmc) );
+	file->cases = xmalloc( c * sizeof(Case_mpmc) );
+	file->masque = c - 1;
+	size_t i;
+	for( i=0; i<c; i++ ){
+		atomic_init( &file->cases[i].sequence, i );
+	}
+	atomic_init( &file->fin, 0 );
+	atomic_init( &file->debut, 0 );
+	return file;
+}
+
+void liberer_file_mpmc( File_mpmc* file ){
+	if( ! file ) return;
+	xfree( file->cases );
+	xfree( file );
+}
+
+size_t capacite_file_mpmc( const File_mpmc* file ){
+	return file->masque + 1;
+}
+
+int ajouter_file_mpmc( File_mpmc* file, intptr_t element ){
+	Case_mpmc* c;
+	size_t position = atomic_load_explicit( &file->fin, memory_order_relaxed );
+	for(;;){
+		c = &file->cases[ position & file->masque ];
+		size_t sequence = 
+			atomic_load_explicit( &c->sequence, memory_order_acquire );
+		intptr_t difference = (intptr_t) sequence - (intptr_t) position;
+		if( difference == 0 ){
+			// La case est libre : on essaie de la réserver.
+			if(
+				atomic_compare_exchange_weak_explicit(
+					&file->fin, &position, position + 1,
+					memory_order_relaxed, memory_order_relaxed
+				)
+			){
+				break;
+			}
+		}else if( difference < 0 ){
+			// La case n'a pas encore été lue au tour précédent.
+			return 0;
+		}else{
+			// Un autre producteur a pris la case.
+			position = atomic_load_explicit( &file->fin, memory_order_relaxed );
+		}
+	}
+	c->element = element;
+	atomic_store_explicit( &c->sequence, position + 1, memory_order_release );
+	return 1;
+}
+
+int retirer_file_mpmc( File_mpmc* file, intptr_t* element ){
+	Case_mpmc* c;
+	size_t position = atomic_load_explicit( &file->debut, memory_order_relaxed );
+	for(;;){
+		c = &file->cases[ position & file->masque ];
+		size_t sequence = 
+			atomic_load_explicit( &c->sequence, memory_order_acquire );
+		intptr_t difference = (intptr_t) sequence - (intptr_t) ( position + 1 );
+		if( difference == 0 ){
+			if(
+				atomic_compare_exchange_weak_explicit(
+					&file->debut, &position, position + 1,
+					memory_order_relaxed, memory_order_relaxed
+				)
+			){
+				break;
+			}
+		}else if( difference < 0 ){
+			// La case n'a pas encore été écrite : la file est vide.
+			return 0;
+		}else{
+			position = atomic_load_explicit( &file->debut, memory_order_relaxed );
+		}
+	}
+	*element = c->element;
+	atomic_store_explicit( 
+		&c->sequence, position + file->masque + 1, memory_order_release 
+	);
+	return 1;
+}
+
+/*
+ * Les compteurs de threads en attente permettent aux opérations qui 
+ * réussissent de ne prendre le verrou que s'il y a quelqu'un à réveiller.
+ */
+struct File_bloquante {
+	File_mpmc* file;
+	pthread_mutex_t verrou;
+	pthread_cond_t non_vide;
+	pthread_cond_t non_pleine;
+	atomic_int consommateurs_en_attente;
+	atomic_int producteurs_en_attente;
+	atomic_int fermee;
+};
+
+File_bloquante* creer_file_bloquante( size_t capacite ){
+	File_bloquante* file = xmalloc( sizeof(File_bloquante) );
+	file->file = creer_file_mpmc( capacite );
+	pthread_mutex_init( &file->verrou, NULL );
+	pthread_cond_init( &file->non_vide, NULL );
+	pthread_cond_init( &file->non_pleine, NULL );
+	atomic_init( &file->consommateurs_en_attente, 0 );
+	atomic_init( &file->producteurs_en_attente, 0 );
+	atomic_init( &file->fermee, 0 );
+	return file;
+}
+
+void liberer_file_bloquante( File_bloquante* file ){
+	if( ! file ) return;
+	pthread_cond_destroy( &file->non_pleine );
+	pthread_cond_destroy( &file->non_vide );
+	pthread_mutex_destroy( &file->verrou );
+	liberer_file_mpmc( file->file );
+	xfree( file );
+}
+
+/*
+ * Réveille les threads qui attendent sur 'condition', s'il y en a.
+ *
+ * La barrière garantit que, si l'on ne voit aucun thread en attente, tout 
+ * thread qui se met ensuite en attente verra l'opération qui vient de 
+ * réussir quand il réessaiera la sienne, sous le verrou, avant de 
+ * s'endormir.
+ */
+static void reveiller( 
+	File_bloquante* file, atomic_int* en_attente, pthread_cond_t* condition 
+){
+	atomic_thread_fence( memory_order_seq_cst );
+	if( atomic_load( en_attente ) ){
+		pthread_mutex_lock( &file->verrou );
+		pthread_cond_broadcast( condition );
+		pthread_mutex_unlock( &file->verrou );
+	}
+}
+
+int ajouter_file_bloquante( File_bloquante* file, intptr_t element ){
+	if( atomic_load( &file->fermee ) ){
+		return 0;
+	}
+	if( ! ajouter_file_mpmc( file->file, element ) ){
+		int ajoute = 0;
+		pthread_mutex_lock( &file->verrou );
+		atomic_fetch_add( &file->producteurs_en_attente, 1 );
+		// Voir reveiller().
+		atomic_thread_fence( memory_order_seq_cst );
+		while( 
+			! atomic_load( &file->fermee ) && 
+			! ( ajoute = ajouter_file_mpmc( file->file, element ) )
+		){
+			pthread_cond_wait( &file->non_pleine, &file->verrou );
+		}
+		atomic_fetch_sub( &file->producteurs_en_attente, 1 );
+		pthread_mutex_unlock( &file->verrou );
+		if( ! ajoute ){
+			return 0;
+		}
+	}
+	reveiller( file, &file->consommateurs_en_attente, &file->non_vide );
+	return 1;
+}
+
+int retirer_file_bloquante( File_bloquante* file, intptr_t* element ){
+	if( ! retirer_file_mpmc( file->file, element ) ){
+		int retire = 0;
+		pthread_mutex_lock( &file->verrou );
+		atomic_fetch_add( &file->consommateurs_en_attente, 1 );
+		// Voir reveiller().
+		atomic_thread_fence( memory_order_seq_cst );
+		while( ! ( retire = retirer_file_mpmc( file->file, element ) ) ){
+			if( atomic_load( &file->fermee ) ){
+				break;
+			}
+			pthread_cond_wait( &file->non_vide, &file->verrou );
+		}
+		atomic_fetch_sub( &file->consommateurs_en_attente, 1 );
+		pthread_mutex_unlock( &file->verrou );
+		if( ! retire ){
+			return 0;
+		}
+	}
+	reveiller( file, &file->producteurs_en_attente, &file->non_pleine );
+	return 1;
+}
+
+void fermer_file_bloquante( File_bloquante* file ){
+	pthread_mutex_lock( &file->verrou );
+	atomic_store( &file->fermee, 1 );
+	pthread_cond_broadcast( &file->non_vide );
+	pthread_cond_broadcast( &file->non_pleine );
+	pthread_mutex_unlock( &file->verrou );
+}
@@ -0,0 +1,118 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __FILE_MPMC_H__
+#define __FILE_MPMC_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Définit le type d'une file first-in first-out de capacité bornée, 
+ * utilisable par plusieurs threads à la fois, aussi bien pour ajouter 
+ * (producteurs) que pour retirer (consommateurs) des éléments.
+ *
+ * Comme pour une Fifo (voir fifo.h), les éléments sont des entiers ou des 
+ * pointeurs, et la file n'est pas responsable de leur mémoire.
+ *
+ * La file n'utilise aucun verrou : chaque case du tableau circulaire porte 
+ * un numéro de séquence qui indique si elle est prête à être écrite ou lue,
+ * et les positions d'écriture et de lecture sont réservées par 
+ * compare-and-swap. Un thread interrompu au milieu d'une opération ne 
+ * bloque que la case qu'il a réservée.
+ */
+typedef struct File_mpmc File_mpmc;
+
+/*
+ * Crée une file vide pouvant contenir au moins 'capacite' éléments. La 
+ * capacité réelle est la puissance de 2 suivante (au moins 2).
+ */
+File_mpmc* creer_file_mpmc( size_t capacite );
+
+/*
+ * Libère la mémoire de la file. Aucun thread ne doit plus l'utiliser.
+ */
+void liberer_file_mpmc( File_mpmc* file );
+
+/*
+ * Renvoie le nombre maximal d'éléments de la file.
+ */
+size_t capacite_file_mpmc( const File_mpmc* file );
+
+/*
+ * Ajoute un élément à la fin de la file et renvoie 1, ou renvoie 0, sans 
+ * attendre, si la file est pleine.
+ */
+int ajouter_file_mpmc( File_mpmc* file, intptr_t element );
+
+/*
+ * Retire l'élément du début de la file, l'écrit dans '*element' et renvoie 
+ * 1, ou renvoie 0, sans attendre, si la file est vide.
+ */
+int retirer_file_mpmc( File_mpmc* file, intptr_t* element );
+
+/*
+ * Définit le type d'une file bornée, utilisable par plusieurs threads, dont
+ * les opérations attendent, au lieu d'échouer, que la file ne soit plus 
+ * pleine ou plus vide.
+ *
+ * Tant qu'elles n'ont pas à attendre, les opérations passent par une 
+ * File_mpmc, sans verrou. Un thread qui doit attendre s'endort sur une 
+ * variable de condition, et n'est réveillé que lorsque son opération peut 
+ * réussir ou que la file est fermée : des threads sans travail ne 
+ * consomment pas de temps de calcul.
+ */
+typedef struct File_bloquante File_bloquante;
+
+/*
+ * Crée une file bloquante vide pouvant contenir au moins 'capacite' 
+ * éléments.
+ */
+File_bloquante* creer_file_bloquante( size_t capacite );
+
+/*
+ * Libère la mémoire de la file. Aucun thread ne doit plus l'utiliser.
+ */
+void liberer_file_bloquante( File_bloquante* file );
+
+/*
+ * Ajoute un élément à la fin de la file, en attendant qu'une place se 
+ * libère si la file est pleine. Renvoie 1, ou 0 si la file a été fermée : 
+ * l'élément n'est alors pas ajouté.
+ */
+int ajouter_file_bloquante( File_bloquante* file, intptr_t element );
+
+/*
+ * Retire l'élément du début de la file et l'écrit dans '*element', en 
+ * attendant qu'un élément arrive si la file est vide. Renvoie 1, ou 0 si 
+ * la file est fermée et vide.
+ */
+int retirer_file_bloquante( File_bloquante* file, intptr_t* element );
+
+/*
+ * Ferme la file : les ajouts suivants échouent et les threads qui attendent
+ * sont réveillés. Les éléments encore dans la file peuvent être retirés ; 
+ * une fois la file vide, retirer_file_bloquante() renvoie 0. C'est ainsi
+ * que l'on signale aux consommateurs qu'il n'y aura plus de travail.
+ */
+void fermer_file_bloquante( File_bloquante* file );
+
+#endif
@@ -19,9 +19,20 @@
  */
 
 
+#define _DEFAULT_SOURCE
+
 #include "outils.h"
 
+#include <assert.h>
+#include <pthread.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 int test( int result, int ligne ){
 	if( ! result ){
@@ -31,7 +42,288 @@ int test( int result, int ligne ){
 	return 0;
 }
 
+/*
+ * L'allocateur installé par changer_allocateur(), commun à tous les 
+ * threads, et l'arène du thread courant.
+ */
+static _Atomic( Allocateur* ) allocateur_courant = NULL;
+static _Thread_local Arene* arene_courante = NULL;
+
+/*
+ * En-tête des blocs, quand il en faut un : sa taille, pour 'liberer', et,
+ * avec OUTILS_STATISTIQUES, son étiquette, pour que xfree() puisse mettre à 
+ * jour les compteurs. L'en-tête garde l'alignement de malloc().
+ */
+typedef struct {
+	size_t taille;
+#ifdef OUTILS_STATISTIQUES
+	size_t site;
+#endif
+} En_tete;
+
+#define OUTILS_ALIGNER( n ) \
+	( ( (n) + alignof(max_align_t) - 1 ) / alignof(max_align_t) \
+	  * alignof(max_align_t) )
+#define OUTILS_TAILLE_EN_TETE OUTILS_ALIGNER( sizeof(En_tete) )
+
+#ifdef OUTILS_STATISTIQUES
+
+/*
+ * Nombre maximal d'étiquettes distinctes (une puissance de 2). Les 
+ * allocations des étiquettes suivantes sont comptées ensemble, sous 
+ * l'étiquette "(autres)".
+ */
+#define OUTILS_NB_ETIQUETTES 1024
+#define OUTILS_AUTRES OUTILS_NB_ETIQUETTES
+
+/*
+ * Les étiquettes forment une table de hachage à adressage ouvert, indexée 
+ * par leur adresse, où l'on ne fait qu'ajouter des étiquettes : elle se 
+ * remplit sans verrou, par compare-and-swap.
+ */
+static _Atomic( const char* ) etiquettes[OUTILS_NB_ETIQUETTES];
+
+/*
+ * Pour que les compteurs ne coûtent pas une instruction atomique chacun à 
+ * chaque allocation, chaque thread a ses propres compteurs, qu'il est seul 
+ * à modifier ; les statistiques en font la somme. Seuls le nombre d'octets 
+ * vivants de tout le programme et son pic sont partagés.
+ *
+ * 'octets_vivants' est la différence, modulo SIZE_MAX+1, entre les octets 
+ * alloués et libérés par le thread : elle est « négative » quand le thread 
+ * libère des blocs alloués par un autre. 'pic_octets_vivants' est le plus 
+ * grand 'octets_vivants' atteint depuis la dernière remise à zéro.
+ */
+typedef struct {
+	atomic_size_t nb_allocations;
+	atomic_size_t nb_liberations;
+	atomic_size_t octets_alloues;
+	atomic_size_t octets_vivants;
+	atomic_size_t pic_octets_vivants;
+} Compteurs_memoire;
+
+/*
+ * Les compteurs d'un thread sont créés à sa première allocation et ne sont 
+ * jamais libérés : ce qu'il a alloué reste compté après sa fin.
+ */
+typedef struct Compteurs_thread {
+	Compteurs_memoire sites[OUTILS_NB_ETIQUETTES + 1];
+	size_t epoque;
+	struct Compteurs_thread* suivant;
+} Compteurs_thread;
+
+static _Atomic( Compteurs_thread* ) compteurs_threads = NULL;
+static _Thread_local Compteurs_thread* compteurs_thread = NULL;
+
+static atomic_size_t octets_vivants_total;
+static atomic_size_t pic_octets_vivants_total;
+
+/*
+ * reinitialiser_statistiques_memoire() ne touche pas aux compteurs des 
+ * threads : elle relève leurs sommes, que l'on retranche ensuite, et change
+ * d'époque. Un thread dont l'époque est dépassée fait repartir ses pics de 
+ * ses octets vivants à sa prochaine allocation.
+ */
+static atomic_size_t epoque_courante;
+static atomic_size_t base_nb_allocations[OUTILS_NB_ETIQUETTES + 1];
+static atomic_size_t base_nb_liberations[OUTILS_NB_ETIQUETTES + 1];
+static atomic_size_t base_octets_alloues[OUTILS_NB_ETIQUETTES + 1];
+
+static _Thread_local const char* etiquette_courante = NULL;
+
+/*
+ * Étiquette des dalles des arènes (voir plus bas) : les blocs découpés dans
+ * une arène ne sont pas comptés un par un.
+ */
+static const char etiquette_arenes[] = "(arenes)";
+
+static size_t site_de( const char* etiquette ){
+	size_t h = (size_t) ( ( (uint64_t) (uintptr_t) etiquette ) * 0x9e3779b97f4a7c15ULL >> 40 );
+	size_t i;
+	for( i=0; i<OUTILS_NB_ETIQUETTES; i++ ){
+		size_t site = ( h + i ) & ( OUTILS_NB_ETIQUETTES - 1 );
+		const char* e = atomic_load_explicit( 
+			&etiquettes[site], memory_order_acquire 
+		);
+		if( e == etiquette ){
+			return site;
+		}
+		if( ! e ){
+			if(
+				atomic_compare_exchange_strong( &etiquettes[site], &e, etiquette ) ||
+				e == etiquette
+			){
+				return site;
+			}
+		}
+	}
+	return OUTILS_AUTRES;
+}
+
+/*
+ * Les compteurs d'un thread ne sont modifiés que par lui : une lecture 
+ * suivie d'une écriture suffit, sans instruction atomique.
+ */
+static inline void ajouter_compteur( atomic_size_t* compteur, size_t n ){
+	atomic_store_explicit( 
+		compteur, 
+		atomic_load_explicit( compteur, memory_order_relaxed ) + n, 
+		memory_order_relaxed 
+	);
+}
+
+static inline size_t plus_grand( size_t a, size_t b ){
+	return (ptrdiff_t) a > (ptrdiff_t) b ? a : b;
+}
+
+static void changer_d_epoque( Compteurs_thread* compteurs, size_t epoque ){
+	size_t i;
+	for( i=0; i<=OUTILS_NB_ETIQUETTES; i++ ){
+		Compteurs_memoire* c = &compteurs->sites[i];
+		atomic_store_explicit( 
+			&c->pic_octets_vivants, 
+			plus_grand( atomic_load_explicit( &c->octets_vivants, memory_order_relaxed ), 0 ),
+			memory_order_relaxed
+		);
+	}
+	compteurs->epoque = epoque;
+}
+
+static Compteurs_thread* creer_compteurs_thread( void ){
+	Compteurs_thread* res = calloc( 1, sizeof(Compteurs_thread) );
+	if( ! res ){
+		ERREUR( "Espace insuffisant" );
+	}
+	res->epoque = atomic_load( &epoque_courante );
+	res->suivant = atomic_load( &compteurs_threads );
+	while( 
+		! atomic_compare_exchange_weak( &compteurs_threads, &res->suivant, res ) 
+	);
+	return res;
+}
+
+static void compter_allocation( size_t site, size_t n ){
+	Compteurs_thread* compteurs = compteurs_thread;
+	if( ! compteurs ){
+		compteurs = compteurs_thread = creer_compteurs_thread();
+	}
+	size_t epoque = atomic_load_explicit( &epoque_courante, memory_order_relaxed );
+	if( compteurs->epoque != epoque ){
+		changer_d_epoque( compteurs, epoque );
+	}
+	Compteurs_memoire* c = &compteurs->sites[site];
+	ajouter_compteur( &c->nb_allocations, 1 );
+	ajouter_compteur( &c->octets_alloues, n );
+	size_t vivants = atomic_load_explicit( &c->octets_vivants, memory_order_relaxed ) + n;
+	atomic_store_explicit( &c->octets_vivants, vivants, memory_order_relaxed );
+	if( 
+		(ptrdiff_t) vivants > 
+		(ptrdiff_t) atomic_load_explicit( &c->pic_octets_vivants, memory_order_relaxed )
+	){
+		atomic_store_explicit( &c->pic_octets_vivants, vivants, memory_order_relaxed );
+	}
+
+	vivants = atomic_fetch_add_explicit( 
+		&octets_vivants_total, n, memory_order_relaxed 
+	) + n;
+	size_t pic = atomic_load_explicit( &pic_octets_vivants_total, memory_order_relaxed );
+	while( 
+		pic < vivants && 
+		! atomic_compare_exchange_weak_explicit( 
+			&pic_octets_vivants_total, &pic, vivants, 
+			memory_order_relaxed, memory_order_relaxed 
+		)
+	);
+}
+
+static void compter_liberation( size_t site, size_t n ){
+	Compteurs_thread* compteurs = compteurs_thread;
+	if( ! compteurs ){
+		compteurs = compteurs_thread = creer_compteurs_thread();
+	}
+	Compteurs_memoire* c = &compteurs->sites[site];
+	ajouter_compteur( &c->nb_liberations, 1 );
+	ajouter_compteur( &c->octets_vivants, -n );
+	atomic_fetch_sub_explicit( &octets_vivants_total, n, memory_order_relaxed );
+}
+
+#endif
+
+static void* allouer_dans_l_arene( Arene* arene, size_t n );
+
+/*
+ * Demande un bloc à l'allocateur installé, ou à malloc(), et y écrit 
+ * l'en-tête.
+ */
+static char* allouer_avec_en_tete( Allocateur* allocateur, size_t n ){
+	size_t taille = OUTILS_TAILLE_EN_TETE + n;
+	char* bloc = allocateur ? 
+		allocateur->allouer( allocateur, taille ) : malloc( taille );
+	if( ! bloc ){
+		ERREUR( "Espace insuffisant" );
+	}
+	( (En_tete*) bloc )->taille = n;
+	return bloc;
+}
+
+static void liberer_avec_en_tete( Allocateur* allocateur, char* bloc ){
+	if( allocateur ){
+		allocateur->liberer( 
+			allocateur, bloc, OUTILS_TAILLE_EN_TETE + ( (En_tete*) bloc )->taille 
+		);
+	}else{
+		free( bloc );
+	}
+}
+
+#ifdef OUTILS_STATISTIQUES
+
+void* xmalloc_site( size_t n, const char* site ){
+	if( arene_courante ){
+		return allouer_dans_l_arene( arene_courante, n );
+	}
+	char* bloc = allouer_avec_en_tete( 
+		atomic_load_explicit( &allocateur_courant, memory_order_relaxed ), n 
+	);
+	En_tete* en_tete = (En_tete*) bloc;
+	en_tete->site = site_de( etiquette_courante ? etiquette_courante : site );
+	compter_allocation( en_tete->site, n );
+	return bloc + OUTILS_TAILLE_EN_TETE;
+}
+
+void* (xmalloc)( size_t n ){
+	return xmalloc_site( n, "(inconnu)" );
+}
+
+void xfree( void* ptr ){
+	if( ! ptr || est_dans_une_arene( ptr ) ){
+		// Un bloc d'une arène est rendu avec son arène.
+		return;
+	}
+	char* bloc = (char*) ptr - OUTILS_TAILLE_EN_TETE;
+	En_tete* en_tete = (En_tete*) bloc;
+	compter_liberation( en_tete->site, en_tete->taille );
+	liberer_avec_en_tete( 
+		atomic_load_explicit( &allocateur_courant, memory_order_relaxed ), bloc 
+	);
+}
+
+#else
+
+/*
+ * Sans statistiques, seuls les blocs demandés à un allocateur installé ont
+ * un en-tête : comme un bloc est rendu à l'allocateur installé au moment de
+ * xfree(), il en a un si et seulement si un allocateur est installé.
+ */
 void* xmalloc( size_t n ){
+	if( arene_courante ){
+		return allouer_dans_l_arene( arene_courante, n );
+	}
+	Allocateur* allocateur = 
+		atomic_load_explicit( &allocateur_courant, memory_order_relaxed );
+	if( allocateur ){
+		return allouer_avec_en_tete( allocateur, n ) + OUTILS_TAILLE_EN_TETE;
+	}
 	void* result = malloc( n );
 	if( ! result ){
 		ERREUR( "Espace insuffisant" );
@@ -40,5 +332,492 @@ void* xmalloc( size_t n ){
 }
 
 void xfree( void* ptr ){
-	free(ptr);
+	if( ! ptr || est_dans_une_arene( ptr ) ){
+		// Un bloc d'une arène est rendu avec son arène.
+		return;
+	}
+	Allocateur* allocateur = 
+		atomic_load_explicit( &allocateur_courant, memory_order_relaxed );
+	if( allocateur ){
+		liberer_avec_en_tete( allocateur, (char*) ptr - OUTILS_TAILLE_EN_TETE );
+	}else{
+		free( ptr );
+	}
+}
+
+#endif
+
+Allocateur* changer_allocateur( Allocateur* allocateur ){
+	return atomic_exchange( &allocateur_courant, allocateur );
+}
+
+/*
+ * Une arène découpe ses blocs, les uns après les autres, dans des dalles 
+ * chaînées ; chaque dalle est au moins deux fois plus grande que la 
+ * précédente.
+ *
+ * Toutes les dalles sont prises dans une seule région d'adresses, réservée 
+ * auprès du système à la première dalle : un bloc vient d'une arène si et 
+ * seulement si son adresse est dans la région. Les blocs des arènes et ceux
+ * de malloc() n'ont ainsi pas besoin d'en-tête pour être distingués. La 
+ * réservation ne coûte pas de mémoire : les pages d'une dalle ne sont 
+ * rendues accessibles qu'à sa création.
+ *
+ * Les dalles des arènes libérées sont gardées par le thread, jusqu'à 
+ * OUTILS_OCTETS_DALLES_LIBRES octets, pour les arènes suivantes : quand on
+ * crée et détruit beaucoup de petites arènes, la mémoire n'est ni rendue 
+ * au système ni redemandée à chaque fois. Les autres dalles sont rendues à
+ * la région, dont les pages sont rendues au système, et réutilisées par 
+ * tous les threads. Les dalles gardées par un thread sont rendues quand il
+ * se termine (voir garder_dalle()).
+ */
+typedef struct Dalle_arene {
+	struct Dalle_arene* precedente;
+	size_t taille;
+} Dalle_arene;
+
+#define OUTILS_TAILLE_DALLE_ARENE OUTILS_ALIGNER( sizeof(Dalle_arene) )
+#define OUTILS_TAILLE_PREMIERE_DALLE 4096
+#define OUTILS_OCTETS_DALLES_LIBRES ( 1024 * 1024 )
+#define OUTILS_TAILLE_REGION_ARENES \
+	( (size_t) 1 << ( sizeof(void*) >= 8 ? 36 : 28 ) )
+
+static _Atomic( char* ) region_arenes = NULL;
+static atomic_size_t octets_region_utilises;
+
+static pthread_mutex_t verrou_dalles_rendues = PTHREAD_MUTEX_INITIALIZER;
+static Dalle_arene* dalles_rendues = NULL;
+
+static _Thread_local Dalle_arene* dalles_libres = NULL;
+static _Thread_local size_t octets_dalles_libres = 0;
+
+static pthread_once_t cle_dalles_creee = PTHREAD_ONCE_INIT;
+static pthread_key_t cle_dalles;
+
+struct Arene {
+	Dalle_arene* dalles;
+	char* courant;
+	size_t restants;
+	size_t taille_derniere_dalle;
+};
+
+static size_t taille_page( void ){
+	static size_t taille = 0;
+	if( ! taille ){
+		taille = (size_t) sysconf( _SC_PAGESIZE );
+	}
+	return taille;
+}
+
+static char* region( void ){
+	char* res = atomic_load_explicit( &region_arenes, memory_order_acquire );
+	if( res ){
+		return res;
+	}
+	void* reservee = mmap( 
+		NULL, OUTILS_TAILLE_REGION_ARENES, PROT_NONE, 
+		MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 
+	);
+	if( reservee == MAP_FAILED ){
+		ERREUR( "Espace insuffisant" );
+	}
+	if( 
+		! atomic_compare_exchange_strong( 
+			&region_arenes, &res, (char*) reservee 
+		) 
+	){
+		// Un autre thread a réservé la région en même temps.
+		munmap( reservee, OUTILS_TAILLE_REGION_ARENES );
+		return res;
+	}
+	return reservee;
+}
+
+#ifdef OUTILS_STATISTIQUES
+// Les dalles sont comptées comme des blocs de l'étiquette "(arenes)".
+static void compter_dalle( Dalle_arene* dalle, int prise ){
+	size_t octets = OUTILS_TAILLE_DALLE_ARENE + dalle->taille;
+	if( prise ){
+		compter_allocation( site_de( etiquette_arenes ), octets );
+	}else{
+		compter_liberation( site_de( etiquette_arenes ), octets );
+	}
+}
+#else
+#define compter_dalle( dalle, prise )
+#endif
+
+/*
+ * Découpe dans la région une nouvelle dalle d'au moins 'taille_dalle' 
+ * octets utiles.
+ */
+static Dalle_arene* creer_dalle( size_t taille_dalle ){
+	size_t page = taille_page();
+	size_t octets = 
+		( OUTILS_TAILLE_DALLE_ARENE + taille_dalle + page - 1 ) / page * page;
+	char* debut_region = region();
+	size_t debut = atomic_fetch_add( &octets_region_utilises, octets );
+	if( 
+		debut > OUTILS_TAILLE_REGION_ARENES || 
+		octets > OUTILS_TAILLE_REGION_ARENES - debut ||
+		mprotect( debut_region + debut, octets, PROT_READ | PROT_WRITE )
+	){
+		ERREUR( "Espace insuffisant" );
+	}
+	Dalle_arene* dalle = (Dalle_arene*) ( debut_region + debut );
+	dalle->taille = octets - OUTILS_TAILLE_DALLE_ARENE;
+	return dalle;
+}
+
+/*
+ * Rend une dalle à la région. Ses pages, sauf la première qui garde son 
+ * en-tête, sont rendues au système : elles seront remises à zéro.
+ */
+static void rendre_dalle( Dalle_arene* dalle ){
+	size_t page = taille_page();
+	size_t octets = OUTILS_TAILLE_DALLE_ARENE + dalle->taille;
+	if( octets > page ){
+		madvise( (char*) dalle + page, octets - page, MADV_DONTNEED );
+	}
+	pthread_mutex_lock( &verrou_dalles_rendues );
+	dalle->precedente = dalles_rendues;
+	dalles_rendues = dalle;
+	pthread_mutex_unlock( &verrou_dalles_rendues );
+}
+
+/*
+ * Retire de la liste 'liste' la première dalle d'au moins 'taille_dalle' 
+ * octets utiles, ou renvoie NULL.
+ */
+static Dalle_arene* retirer_dalle( Dalle_arene** liste, size_t taille_dalle ){
+	Dalle_arene** libre;
+	for( libre = liste; *libre; libre = &(*libre)->precedente ){
+		if( (*libre)->taille >= taille_dalle ){
+			Dalle_arene* dalle = *libre;
+			*libre = dalle->precedente;
+			return dalle;
+		}
+	}
+	return NULL;
+}
+
+static Dalle_arene* prendre_dalle( size_t taille_dalle ){
+	Dalle_arene* dalle = retirer_dalle( &dalles_libres, taille_dalle );
+	if( dalle ){
+		octets_dalles_libres -= dalle->taille;
+	}else{
+		pthread_mutex_lock( &verrou_dalles_rendues );
+		dalle = retirer_dalle( &dalles_rendues, taille_dalle );
+		pthread_mutex_unlock( &verrou_dalles_rendues );
+		if( ! dalle ){
+			dalle = creer_dalle( taille_dalle );
+		}
+	}
+	compter_dalle( dalle, 1 );
+	return dalle;
+}
+
+Arene* creer_arene( void ){
+	// Une arène est toujours allouée hors de toute arène.
+	Arene* precedente = arene_courante;
+	arene_courante = NULL;
+	Arene* arene = xmalloc( sizeof(Arene) );
+	arene_courante = precedente;
+	arene->dalles = NULL;
+	arene->courant = NULL;
+	arene->restants = 0;
+	arene->taille_derniere_dalle = 0;
+	return arene;
+}
+
+static void rendre_dalles_du_thread( void* inutilise ){
+	(void) inutilise;
+	rendre_dalles_libres();
+}
+
+static void creer_cle_dalles( void ){
+	if( pthread_key_create( &cle_dalles, rendre_dalles_du_thread ) ){
+		ERREUR( "Impossible de créer la clé des dalles libres" );
+	}
+}
+
+/*
+ * Garde la dalle pour les prochaines arènes du thread. La première fois, 
+ * le thread enregistre rendre_dalles_du_thread(), que pthread appelle quand
+ * il se termine : un thread de travail ne garde pas sa mémoire au-delà de 
+ * sa vie. Le thread principal, lui, garde ses dalles jusqu'à la fin du 
+ * processus.
+ */
+static void garder_dalle( Dalle_arene* dalle ){
+	if( ! dalles_libres ){
+		pthread_once( &cle_dalles_creee, creer_cle_dalles );
+		// Une valeur non nulle, pour que le destructeur soit appelé.
+		pthread_setspecific( cle_dalles, &cle_dalles );
+	}
+	dalle->precedente = dalles_libres;
+	dalles_libres = dalle;
+	octets_dalles_libres += dalle->taille;
+}
+
+void liberer_arene( Arene* arene ){
+	if( ! arene ){
+		return;
+	}
+	assert( arene != arene_courante );
+	while( arene->dalles ){
+		Dalle_arene* dalle = arene->dalles;
+		arene->dalles = dalle->precedente;
+		compter_dalle( dalle, 0 );
+		if( octets_dalles_libres + dalle->taille <= OUTILS_OCTETS_DALLES_LIBRES ){
+			garder_dalle( dalle );
+		}else{
+			rendre_dalle( dalle );
+		}
+	}
+	xfree( arene );
+}
+
+static void* allouer_dans_l_arene( Arene* arene, size_t n ){
+	size_t taille = OUTILS_ALIGNER( n );
+	if( taille > arene->restants ){
+		size_t taille_dalle = arene->taille_derniere_dalle ? 
+			2 * arene->taille_derniere_dalle : OUTILS_TAILLE_PREMIERE_DALLE;
+		if( taille_dalle < taille ){
+			taille_dalle = taille;
+		}
+		Dalle_arene* dalle = prendre_dalle( taille_dalle );
+		dalle->precedente = arene->dalles;
+		arene->dalles = dalle;
+		arene->courant = (char*) dalle + OUTILS_TAILLE_DALLE_ARENE;
+		arene->restants = dalle->taille;
+		arene->taille_derniere_dalle = dalle->taille;
+	}
+	char* bloc = arene->courant;
+	arene->courant += taille;
+	arene->restants -= taille;
+	return bloc;
+}
+
+void rendre_dalles_libres( void ){
+	while( dalles_libres ){
+		Dalle_arene* dalle = dalles_libres;
+		dalles_libres = dalle->precedente;
+		rendre_dalle( dalle );
+	}
+	octets_dalles_libres = 0;
+}
+
+Arene* utiliser_arene( Arene* arene ){
+	Arene* ancienne = arene_courante;
+	arene_courante = arene;
+	return ancienne;
+}
+
+int est_dans_une_arene( const void* ptr ){
+	char* debut = atomic_load_explicit( &region_arenes, memory_order_relaxed );
+	return debut && 
+		(uintptr_t) ptr - (uintptr_t) debut < OUTILS_TAILLE_REGION_ARENES;
+}
+
+int arene_est_utilisee( void ){
+	return arene_courante != NULL;
+}
+
+#ifdef OUTILS_STATISTIQUES
+
+const char* etiqueter_allocations( const char* etiquette ){
+	const char* ancienne = etiquette_courante;
+	etiquette_courante = etiquette;
+	return ancienne;
+}
+
+/*
+ * Somme les compteurs des threads pour l'étiquette 'site'.
+ */
+static Statistiques_memoire lire_site( size_t site ){
+	Statistiques_memoire res;
+	res.etiquette = site == OUTILS_AUTRES ? 
+		"(autres)" : atomic_load( &etiquettes[site] );
+	res.nb_allocations = - atomic_load( &base_nb_allocations[site] );
+	res.nb_liberations = - atomic_load( &base_nb_liberations[site] );
+	res.octets_alloues = - atomic_load( &base_octets_alloues[site] );
+	res.octets_vivants = 0;
+	res.pic_octets_vivants = 0;
+	size_t epoque = atomic_load( &epoque_courante );
+	Compteurs_thread* compteurs;
+	for( 
+		compteurs = atomic_load( &compteurs_threads ); compteurs; 
+		compteurs = compteurs->suivant 
+	){
+		Compteurs_memoire* c = &compteurs->sites[site];
+		size_t vivants = atomic_load_explicit( &c->octets_vivants, memory_order_relaxed );
+		res.nb_allocations += atomic_load_explicit( &c->nb_allocations, memory_order_relaxed );
+		res.nb_liberations += atomic_load_explicit( &c->nb_liberations, memory_order_relaxed );
+		res.octets_alloues += atomic_load_explicit( &c->octets_alloues, memory_order_relaxed );
+		res.octets_vivants += vivants;
+		// Le pic d'une étiquette est le plus grand pic atteint par un thread :
+		// il est exact tant qu'un seul thread alloue pour cette étiquette.
+		res.pic_octets_vivants = plus_grand( 
+			res.pic_octets_vivants,
+			compteurs->epoque == epoque ? 
+				atomic_load_explicit( &c->pic_octets_vivants, memory_order_relaxed ) :
+				vivants
+		);
+	}
+	return res;
+}
+
+static int site_utilise( size_t site ){
+	return site == OUTILS_AUTRES ? 
+		lire_site( site ).nb_allocations || lire_site( site ).octets_vivants :
+		atomic_load( &etiquettes[site] ) != NULL;
+}
+
+Statistiques_memoire statistiques_memoire( void ){
+	Statistiques_memoire total;
+	total.etiquette = NULL;
+	total.nb_allocations = 0;
+	total.nb_liberations = 0;
+	total.octets_alloues = 0;
+	size_t site;
+	for( site=0; site<=OUTILS_NB_ETIQUETTES; site++ ){
+		if( site_utilise( site ) ){
+			Statistiques_memoire stats = lire_site( site );
+			total.nb_allocations += stats.nb_allocations;
+			total.nb_liberations += stats.nb_liberations;
+			total.octets_alloues += stats.octets_alloues;
+		}
+	}
+	total.octets_vivants = atomic_load( &octets_vivants_total );
+	total.pic_octets_vivants = atomic_load( &pic_octets_vivants_total );
+	return total;
+}
+
+size_t statistiques_memoire_par_etiquette( 
+	Statistiques_memoire* stats, size_t nb_max 
+){
+	size_t nb = 0;
+	size_t site;
+	for( site=0; site<=OUTILS_NB_ETIQUETTES; site++ ){
+		if( site_utilise( site ) ){
+			if( nb < nb_max ){
+				stats[nb] = lire_site( site );
+			}
+			nb++;
+		}
+	}
+	return nb;
+}
+
+void reinitialiser_statistiques_memoire( void ){
+	size_t site;
+	for( site=0; site<=OUTILS_NB_ETIQUETTES; site++ ){
+		atomic_store( &base_nb_allocations[site], 0 );
+		atomic_store( &base_nb_liberations[site], 0 );
+		atomic_store( &base_octets_alloues[site], 0 );
+		Statistiques_memoire stats = lire_site( site );
+		atomic_store( &base_nb_allocations[site], stats.nb_allocations );
+		atomic_store( &base_nb_liberations[site], stats.nb_liberations );
+		atomic_store( &base_octets_alloues[site], stats.octets_alloues );
+	}
+	atomic_fetch_add( &epoque_courante, 1 );
+	atomic_store( 
+		&pic_octets_vivants_total, atomic_load( &octets_vivants_total ) 
+	);
+}
+
+static int comparer_pics( const void* a, const void* b ){
+	const Statistiques_memoire* sa = (const Statistiques_memoire*) a;
+	const Statistiques_memoire* sb = (const Statistiques_memoire*) b;
+	if( sa->pic_octets_vivants != sb->pic_octets_vivants ){
+		return sa->pic_octets_vivants > sb->pic_octets_vivants ? -1 : 1;
+	}
+	return strcmp( sa->etiquette, sb->etiquette );
+}
+
+void afficher_statistiques_memoire( FILE* flux ){
+	// Les statistiques sont relevées avant d'allouer le tableau qui sert à 
+	// les trier, qui est pris à malloc() pour ne pas être compté.
+	Statistiques_memoire total = statistiques_memoire();
+	Statistiques_memoire* stats = 
+		malloc( ( OUTILS_NB_ETIQUETTES + 1 ) * sizeof(Statistiques_memoire) );
+	if( ! stats ){
+		ERREUR( "Espace insuffisant" );
+	}
+	size_t nb = statistiques_memoire_par_etiquette( 
+		stats, OUTILS_NB_ETIQUETTES + 1 
+	);
+	qsort( stats, nb, sizeof(Statistiques_memoire), comparer_pics );
+	fprintf( 
+		flux, 
+		"Memoire : %zu allocations, %zu liberations, %zu octets alloues, "
+		"%zu octets vivants, pic de %zu octets\n",
+		total.nb_allocations, total.nb_liberations, total.octets_alloues,
+		total.octets_vivants, total.pic_octets_vivants
+	);
+	fprintf( 
+		flux, "  %-32s %12s %12s %14s %12s %12s\n", "etiquette", 
+		"allocations", "liberations", "alloues", "vivants", "pic"
+	);
+	size_t i;
+	for( i=0; i<nb; i++ ){
+		fprintf( 
+			flux, "  %-32s %12zu %12zu %14zu %12zu %12zu\n", stats[i].etiquette,
+			stats[i].nb_allocations, stats[i].nb_liberations, 
+			stats[i].octets_alloues, stats[i].octets_vivants, 
+			stats[i].pic_octets_vivants
+		);
+	}
+	free( stats );
+}
+
+#endif
+
+void trier_tableau(
+	void* base, size_t nb, size_t taille, 
+	int (*comparer)( const void* a, const void* b, void* data ), void* data
+){
+	char* t = (char*) base;
+	size_t i;
+	for( i=1; i<nb; i++ ){
+		if( comparer( t + (i-1)*taille, t + i*taille, data ) > 0 ) break;
+	}
+	if( i >= nb ){
+		return;
+	}
+	// Tri fusion ascendant : des séquences triées de longueur 'largeur' sont 
+	// fusionnées deux à deux, alternativement de 'source' vers 'dest'.
+	char* tampon = xmalloc( nb * taille );
+	char* source = t;
+	char* dest = tampon;
+	size_t largeur;
+	for( largeur = 1; largeur < nb; largeur *= 2 ){
+		size_t debut;
+		for( debut = 0; debut < nb; debut += 2 * largeur ){
+			size_t milieu = debut + largeur < nb ? debut + largeur : nb;
+			size_t fin = debut + 2 * largeur < nb ? debut + 2 * largeur : nb;
+			size_t a = debut, b = milieu, k = debut;
+			while( a < milieu && b < fin ){
+				// En cas d'égalité, l'élément de gauche passe en premier.
+				if( comparer( source + b*taille, source + a*taille, data ) < 0 ){
+					memcpy( dest + k*taille, source + b*taille, taille );
+					b++;
+				}else{
+					memcpy( dest + k*taille, source + a*taille, taille );
+					a++;
+				}
+				k++;
+			}
+			memcpy( dest + k*taille, source + a*taille, ( milieu - a ) * taille );
+			k += milieu - a;
+			memcpy( dest + k*taille, source + b*taille, ( fin - b ) * taille );
+		}
+		char* tmp = source;
+		source = dest;
+		dest = tmp;
+	}
+	if( source != t ){
+		memcpy( t, source, nb * taille );
+	}
+	xfree( tampon );
 }
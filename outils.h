@@ -29,9 +29,171 @@
 #define DEBUGO(x) do { fprintf(stdout,"DEBUG : %s - ligne : %d, fichier : %s\n", (x), __LINE__, __FILE__ ); } while(0)
 #define ERREUR(x) do { fprintf(stderr,"ERREUR : %s - ligne : %d, fichier : %s\n", (x), __LINE__, __FILE__ ); exit(EXIT_FAILURE); } while(0)
 
+/*
+ * Toute la mémoire de la bibliothèque est allouée par xmalloc() et rendue 
+ * par xfree(). xmalloc() arrête le programme si la mémoire manque. Par 
+ * défaut, xmalloc() et xfree() ne font qu'appeler malloc() et free().
+ *
+ * Si la bibliothèque est compilée avec OUTILS_STATISTIQUES (make 
+ * STATISTIQUES=1), chaque allocation est en plus comptée et attribuée à une
+ * étiquette : par défaut, l'endroit du code ("fichier.c:ligne") qui appelle 
+ * xmalloc(), ou bien l'étiquette posée par etiqueter_allocations(). Voir 
+ * statistiques_memoire(). Chaque bloc porte alors un en-tête de 16 octets, 
+ * et chaque allocation met à jour des compteurs partagés : l'option ne sert
+ * qu'à mesurer. La bibliothèque et les programmes qui l'utilisent doivent 
+ * être compilés avec la même option.
+ */
 void* xmalloc( size_t n );
 void xfree( void* ptr );
 
+/*
+ * Définit un allocateur. xmalloc() et xfree() passent par l'allocateur 
+ * installé par changer_allocateur(), ou par malloc() et free() si aucun ne 
+ * l'est. Les blocs demandés à un allocateur portent un en-tête qui donne 
+ * leur taille à 'liberer'.
+ *
+ * 'allouer' doit renvoyer un bloc de 'n' octets, aligné comme malloc(), ou 
+ * NULL si la mémoire manque. 'liberer' reçoit un bloc renvoyé par 'allouer'
+ * et sa taille 'n'. Le premier champ permet de retrouver, par un 
+ * transtypage, la structure qui contient l'allocateur et son état (un 
+ * cache par thread, une arène, ...).
+ */
+typedef struct Allocateur {
+	void* (*allouer)( struct Allocateur* allocateur, size_t n );
+	void (*liberer)( struct Allocateur* allocateur, void* bloc, size_t n );
+} Allocateur;
+
+/*
+ * Installe un allocateur (NULL pour revenir à malloc() et free()) et 
+ * renvoie celui qui était installé.
+ *
+ * L'allocateur est commun à tous les threads du programme : un bloc alloué
+ * par un thread peut être libéré par un autre. Un bloc est toujours rendu à
+ * l'allocateur installé au moment de xfree() : on ne change donc 
+ * d'allocateur que lorsqu'aucun bloc alloué par l'ancien n'est encore 
+ * utilisé, et qu'aucun autre thread n'alloue, typiquement au début du 
+ * programme. Un allocateur propre à chaque thread (un cache par thread, par
+ * exemple) se construit derrière cette interface.
+ */
+Allocateur* changer_allocateur( Allocateur* allocateur );
+
+/*
+ * Une arène : une zone de mémoire où les blocs sont découpés les uns après 
+ * les autres, et rendus tous ensemble par liberer_arene(). Les arènes 
+ * prennent leur mémoire directement au système, et non à l'allocateur.
+ *
+ * Tant qu'une arène est utilisée par un thread (voir utiliser_arene()), 
+ * xmalloc() y découpe les blocs de ce thread, et xfree() ignore les blocs 
+ * qui viennent d'une arène. La mémoire d'un bloc libéré n'est donc pas 
+ * réutilisée avant la libération de l'arène : une arène convient à des 
+ * données qui ont toutes la même durée de vie.
+ */
+typedef struct Arene Arene;
+
+Arene* creer_arene( void );
+
+/*
+ * Détruit l'arène, qui ne doit plus être utilisée : tous ses blocs 
+ * deviennent invalides. Le thread garde une partie de sa mémoire (au plus 
+ * 1 Mo) pour les arènes qu'il créera ensuite ; rendre_dalles_libres() la 
+ * rend à l'allocateur. Elle est aussi rendue automatiquement quand le 
+ * thread se termine.
+ */
+void liberer_arene( Arene* arene );
+
+void rendre_dalles_libres( void );
+
+/*
+ * Fait allouer les blocs suivants du thread courant dans l'arène 'arene' 
+ * (NULL pour revenir à l'allocateur) et renvoie l'arène utilisée 
+ * jusque-là :
+ *
+ *   Arene* avant = utiliser_arene( arene );
+ *   ...
+ *   utiliser_arene( avant );
+ */
+Arene* utiliser_arene( Arene* arene );
+
+/*
+ * Renvoie 1 si le bloc 'ptr', renvoyé par xmalloc(), vient d'une arène. Le
+ * test ne compare que des adresses.
+ */
+int est_dans_une_arene( const void* ptr );
+
+/*
+ * Renvoie 1 si le thread courant alloue dans une arène.
+ */
+int arene_est_utilisee( void );
+
+#ifdef OUTILS_STATISTIQUES
+
+/*
+ * Alloue 'n' octets en attribuant l'allocation à l'étiquette 'site' (ou à
+ * l'étiquette posée par etiqueter_allocations() si elle existe). La macro 
+ * xmalloc() l'appelle avec l'endroit de l'appel.
+ */
+void* xmalloc_site( size_t n, const char* site );
+
+#define OUTILS_CHAINE_( x ) #x
+#define OUTILS_CHAINE( x ) OUTILS_CHAINE_( x )
+#define xmalloc( n ) xmalloc_site( (n), __FILE__ ":" OUTILS_CHAINE( __LINE__ ) )
+
+/*
+ * Attribue les allocations suivantes du thread courant à l'étiquette 
+ * 'etiquette' au lieu de l'endroit où xmalloc() est appelé, et renvoie 
+ * l'étiquette précédente. NULL revient à l'attribution par endroit d'appel.
+ *
+ * Les étiquettes sont identifiées par leur adresse : on utilise des chaînes
+ * constantes. Pour mesurer une opération :
+ *
+ *   const char* avant = etiqueter_allocations( "copier_automate" );
+ *   Automate* copie = copier_automate( automate );
+ *   etiqueter_allocations( avant );
+ */
+const char* etiqueter_allocations( const char* etiquette );
+
+/*
+ * Statistiques sur la mémoire allouée par xmalloc(), pour une étiquette ou
+ * pour l'ensemble du programme (etiquette vaut alors NULL). Les tailles 
+ * sont celles demandées à xmalloc().
+ */
+typedef struct {
+	const char* etiquette;
+	size_t nb_allocations;
+	size_t nb_liberations;
+	size_t octets_alloues;
+	size_t octets_vivants;
+	size_t pic_octets_vivants;
+} Statistiques_memoire;
+
+/*
+ * Renvoie les statistiques de tout le programme.
+ */
+Statistiques_memoire statistiques_memoire( void );
+
+/*
+ * Écrit dans 'stats' les statistiques d'au plus 'nb_max' étiquettes, et 
+ * renvoie le nombre d'étiquettes connues.
+ */
+size_t statistiques_memoire_par_etiquette( 
+	Statistiques_memoire* stats, size_t nb_max 
+);
+
+/*
+ * Remet à zéro les nombres d'allocations, de libérations et d'octets 
+ * alloués. Les pics repartent de la mémoire encore vivante : on peut ainsi
+ * mesurer le pic d'une opération.
+ */
+void reinitialiser_statistiques_memoire( void );
+
+/*
+ * Affiche les statistiques de tout le programme, puis celles des étiquettes,
+ * par pic de mémoire décroissant.
+ */
+void afficher_statistiques_memoire( FILE* flux );
+
+#endif
+
 #define TEST(y,x) do { x &= (y); if(!(y)){ fprintf(stdout, "\033[31mEchec du test %s() -- ligne : %d, fichier : %s\033[0m\n", __FUNCTION__, __LINE__, __FILE__ ); } } while(0)
 #define TEST1(x) test( x, __LINE__)
 
@@ -40,5 +202,17 @@ void xfree( void* ptr );
 
 int test( int result, int ligne );
 
+/*
+ * Trie, de manière stable, le tableau 'base' de 'nb' éléments de 'taille' 
+ * octets, dans l'ordre croissant donné par 'comparer'. Le paramètre 'data' 
+ * est passé tel quel à chaque appel de 'comparer'.
+ *
+ * Renvoie immédiatement, en temps linéaire, si le tableau est déjà trié.
+ */
+void trier_tableau(
+	void* base, size_t nb, size_t taille, 
+	int (*comparer)( const void* a, const void* b, void* data ), void* data
+);
+
 #endif
 
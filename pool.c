@@ -0,0 +1,124 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pool.h"
+#include "outils.h"
+
+#include <assert.h>
+
+/*
+ * Une dalle contient d'abord POOL_BLOCS_MIN blocs, puis deux fois plus que la
+ * précédente, jusqu'à POOL_BLOCS_MAX blocs.
+ */
+#define POOL_BLOCS_MIN 8
+#define POOL_BLOCS_MAX 1024
+
+struct Dalle {
+	Dalle* suivante;
+	// Les blocs suivent l'en-tête, alignés comme un pointeur.
+	void* blocs[];
+};
+
+static void* allouer_bloc_avl( struct libavl_allocator* allocateur, size_t n ){
+	Pool* pool = (Pool*) allocateur;
+	assert( n <= pool->taille_bloc );
+	return allouer_bloc( pool );
+}
+
+static void liberer_bloc_avl( struct libavl_allocator* allocateur, void* bloc ){
+	liberer_bloc( (Pool*) allocateur, bloc );
+}
+
+void initialiser_pool( Pool* pool, size_t taille_bloc ){
+	// Un bloc libre doit pouvoir contenir le pointeur vers le bloc libre 
+	// suivant, et tous les blocs restent alignés comme des pointeurs.
+	if( taille_bloc < sizeof(void*) ){
+		taille_bloc = sizeof(void*);
+	}
+	taille_bloc = ( taille_bloc + sizeof(void*) - 1 ) & ~( sizeof(void*) - 1 );
+
+	pool->allocateur.libavl_malloc = allouer_bloc_avl;
+	pool->allocateur.libavl_free = liberer_bloc_avl;
+	pool->taille_bloc = taille_bloc;
+	pool->blocs_par_dalle = POOL_BLOCS_MIN;
+	pool->libres = NULL;
+	pool->courant = NULL;
+	pool->restants = 0;
+	pool->dalles = NULL;
+}
+
+void vider_pool( Pool* pool ){
+	Dalle* dalle = pool->dalles;
+	while( dalle ){
+		Dalle* suivante = dalle->suivante;
+		xfree( dalle );
+		dalle = suivante;
+	}
+	initialiser_pool( pool, pool->taille_bloc );
+}
+
+Pool* creer_pool( size_t taille_bloc ){
+	Pool* res = xmalloc( sizeof(Pool) );
+	initialiser_pool( res, taille_bloc );
+	return res;
+}
+
+void liberer_pool( Pool* pool ){
+	vider_pool( pool );
+	xfree( pool );
+}
+
+static void ajouter_dalle( Pool* pool, size_t nb_blocs ){
+	Dalle* dalle = xmalloc( sizeof(Dalle) + nb_blocs * pool->taille_bloc );
+	dalle->suivante = pool->dalles;
+	pool->dalles = dalle;
+	pool->courant = (char*) dalle->blocs;
+	pool->restants = nb_blocs;
+}
+
+void reserver_pool( Pool* pool, size_t nb_blocs ){
+	if( pool->restants < nb_blocs ){
+		// Les blocs restants de la dalle courante sont abandonnés.
+		ajouter_dalle( pool, nb_blocs );
+	}
+}
+
+void* allouer_bloc( Pool* pool ){
+	if( pool->libres ){
+		void* res = pool->libres;
+		pool->libres = *(void**) res;
+		return res;
+	}
+	if( pool->restants == 0 ){
+		ajouter_dalle( pool, pool->blocs_par_dalle );
+		if( pool->blocs_par_dalle < POOL_BLOCS_MAX ){
+			pool->blocs_par_dalle *= 2;
+		}
+	}
+	void* res = pool->courant;
+	pool->courant += pool->taille_bloc;
+	pool->restants--;
+	return res;
+}
+
+void liberer_bloc( Pool* pool, void* bloc ){
+	*(void**) bloc = pool->libres;
+	pool->libres = bloc;
+}
@@ -0,0 +1,96 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file pool.h */
+
+#ifndef __POOL_H__
+#define __POOL_H__
+
+#include <stddef.h>
+#include "avl.h"
+
+typedef struct Dalle Dalle;
+
+/**
+ * @brief Définit le type d'un pool de blocs mémoire de taille fixe.
+ *
+ * Les blocs sont découpés dans de grandes zones mémoire, les dalles. 
+ * Un bloc rendu au pool est réutilisé par l'allocation suivante, mais la 
+ * mémoire des dalles n'est rendue au système que par vider_pool() ou 
+ * liberer_pool(), en une seule fois.
+ *
+ * Le champ 'allocateur' permet d'utiliser le pool comme allocateur des 
+ * noeuds d'un arbre AVL (voir avl.h).
+ */
+typedef struct Pool {
+	struct libavl_allocator allocateur;
+	size_t taille_bloc;
+	size_t blocs_par_dalle;
+	void* libres;
+	char* courant;
+	size_t restants;
+	Dalle* dalles;
+} Pool;
+
+/**
+ * @brief Initialise un pool vide, dont la mémoire est fournie par 
+ * l'utilisateur, qui distribue des blocs de 'taille_bloc' octets.
+ *
+ * Aucune mémoire n'est allouée avant la première demande de bloc.
+ */
+void initialiser_pool( Pool* pool, size_t taille_bloc );
+
+/**
+ * @brief Rend au système toute la mémoire du pool.
+ *
+ * Tous les blocs distribués par le pool deviennent invalides.
+ * Le pool peut être réutilisé ensuite.
+ */
+void vider_pool( Pool* pool );
+
+/**
+ * @brief Crée un nouveau pool de blocs de 'taille_bloc' octets.
+ */
+Pool* creer_pool( size_t taille_bloc );
+
+/**
+ * @brief Détruit un pool créé par creer_pool() et toute sa mémoire.
+ */
+void liberer_pool( Pool* pool );
+
+/**
+ * @brief Renvoie un bloc du pool.
+ */
+void* allouer_bloc( Pool* pool );
+
+/**
+ * @brief Garantit que les 'nb_blocs' prochains blocs distribués par le pool 
+ * (hors blocs libérés et réutilisés) sont contigus, dans une même dalle.
+ *
+ * Une seule dalle est allouée, si nécessaire, pour tous ces blocs.
+ */
+void reserver_pool( Pool* pool, size_t nb_blocs );
+
+/**
+ * @brief Rend un bloc au pool pour qu'il soit réutilisé.
+ */
+void liberer_bloc( Pool* pool, void* bloc );
+
+#endif
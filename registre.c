@@ -0,0 +1,191 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "registre.h"
+#include "outils.h"
+#include "pool.h"
+#include "table.h"
+
+#include <assert.h>
+#include <string.h>
+
+#define REGISTRE_CAPACITE_MIN 16
+
+/*
+ * Un ensemble du registre, avec sa taille et sa valeur de hachage. Les 
+ * entrées sont allouées dans un pool : leur adresse ne change pas, et sert 
+ * de clé dans la table de hachage du registre.
+ */
+typedef struct {
+	Ensemble* ensemble;
+	size_t hache;
+	unsigned int taille;
+	int id;
+} Entree_registre;
+
+struct Registre {
+	size_t (*hacher_element)( const intptr_t elem );
+	// Associe chaque entrée à son identifiant.
+	Table* index;
+	Pool entrees;
+	// 'par_id[i]' est l'entrée d'identifiant i.
+	Entree_registre** par_id;
+	int nb_ensembles;
+	int capacite;
+};
+
+static size_t hacher_entree( const Entree_registre* entree ){
+	return entree->hache;
+}
+
+/*
+ * La table ne compare deux clés que si leurs valeurs de hachage sont égales.
+ * La taille, connue, élimine ensuite la plupart des collisions sans parcourir
+ * les éléments.
+ */
+static int comparer_entrees( 
+	const Entree_registre* a, const Entree_registre* b 
+){
+	if( a->hache != b->hache || a->taille != b->taille ){
+		return 1;
+	}
+	return ! ensembles_egaux( a->ensemble, b->ensemble );
+}
+
+Registre* creer_registre( size_t (*hacher_element)( const intptr_t elem ) ){
+	Registre* res = xmalloc( sizeof(Registre) );
+	res->hacher_element = hacher_element;
+	res->index = creer_table_de_hachage(
+		( int(*)(const intptr_t, const intptr_t) ) comparer_entrees, NULL, NULL,
+		( size_t(*)(const intptr_t) ) hacher_entree
+	);
+	initialiser_pool( &res->entrees, sizeof(Entree_registre) );
+	res->par_id = NULL;
+	res->nb_ensembles = 0;
+	res->capacite = 0;
+	return res;
+}
+
+void liberer_registre( Registre* registre ){
+	if( ! registre ) return;
+	int i;
+	for( i=0; i<registre->nb_ensembles; i++ ){
+		liberer_ensemble( registre->par_id[i]->ensemble );
+	}
+	liberer_table( registre->index );
+	vider_pool( &registre->entrees );
+	xfree( registre->par_id );
+	xfree( registre );
+}
+
+static void initialiser_entree_de_recherche( 
+	const Registre* registre, Entree_registre* entree, const Ensemble* ensemble
+){
+	entree->ensemble = (Ensemble*) ensemble;
+	entree->hache = hacher_ensemble( ensemble, registre->hacher_element );
+	entree->taille = taille_ensemble( ensemble );
+	entree->id = -1;
+}
+
+static int chercher_entree( 
+	const Registre* registre, const Entree_registre* entree 
+){
+	intptr_t id;
+	if( chercher_table( registre->index, (intptr_t) entree, &id ) ){
+		return (int) id;
+	}
+	return -1;
+}
+
+/*
+ * Ajoute au registre l'ensemble décrit par 'recherche', qui n'y est pas 
+ * encore. Le registre devient responsable de 'ensemble'.
+ */
+static int ajouter_entree(
+	Registre* registre, const Entree_registre* recherche, Ensemble* ensemble
+){
+	if( registre->nb_ensembles == registre->capacite ){
+		int capacite = registre->capacite ? 
+			2 * registre->capacite : REGISTRE_CAPACITE_MIN;
+		Entree_registre** par_id = xmalloc( capacite * sizeof(Entree_registre*) );
+		if( registre->nb_ensembles ){
+			memcpy( 
+				par_id, registre->par_id, 
+				registre->nb_ensembles * sizeof(Entree_registre*) 
+			);
+		}
+		xfree( registre->par_id );
+		registre->par_id = par_id;
+		registre->capacite = capacite;
+	}
+	Entree_registre* entree = allouer_bloc( &registre->entrees );
+	*entree = *recherche;
+	entree->ensemble = ensemble;
+	entree->id = registre->nb_ensembles++;
+	registre->par_id[ entree->id ] = entree;
+	add_table( registre->index, (intptr_t) entree, entree->id );
+	return entree->id;
+}
+
+int interner_ensemble( Registre* registre, const Ensemble* ensemble ){
+	Entree_registre recherche;
+	initialiser_entree_de_recherche( registre, &recherche, ensemble );
+	int id = chercher_entree( registre, &recherche );
+	if( id >= 0 ){
+		return id;
+	}
+	return ajouter_entree( registre, &recherche, copier_ensemble( ensemble ) );
+}
+
+int interner_ensemble_et_libere( Registre* registre, Ensemble* ensemble ){
+	Entree_registre recherche;
+	initialiser_entree_de_recherche( registre, &recherche, ensemble );
+	int id = chercher_entree( registre, &recherche );
+	if( id >= 0 ){
+		liberer_ensemble( ensemble );
+		return id;
+	}
+	return ajouter_entree( registre, &recherche, ensemble );
+}
+
+int chercher_registre( const Registre* registre, const Ensemble* ensemble ){
+	Entree_registre recherche;
+	initialiser_entree_de_recherche( registre, &recherche, ensemble );
+	return chercher_entree( registre, &recherche );
+}
+
+const Ensemble* get_ensemble_registre( const Registre* registre, int id ){
+	assert( id >= 0 && id < registre->nb_ensembles );
+	return registre->par_id[ id ]->ensemble;
+}
+
+unsigned int get_taille_registre( const Registre* registre, int id ){
+	assert( id >= 0 && id < registre->nb_ensembles );
+	return registre->par_id[ id ]->taille;
+}
+
+size_t get_hache_registre( const Registre* registre, int id ){
+	assert( id >= 0 && id < registre->nb_ensembles );
+	return registre->par_id[ id ]->hache;
+}
+
+int nombre_ensembles_registre( const Registre* registre ){
+	return registre->nb_ensembles;
+}
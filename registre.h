@@ -0,0 +1,109 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file registre.h */
+
+#ifndef __REGISTRE_H__
+#define __REGISTRE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ensemble.h"
+
+/**
+ * @brief Définit le type d'un registre d'ensembles.
+ *
+ * Un registre associe à chaque ensemble distinct qu'on lui présente un 
+ * identifiant canonique : deux ensembles égaux reçoivent le même 
+ * identifiant. Les identifiants sont attribués dans l'ordre, à partir de 0,
+ * sans trou.
+ *
+ * Le registre garde sa propre copie de chaque ensemble, avec sa taille et 
+ * sa valeur de hachage calculées une fois pour toutes. Chercher un ensemble 
+ * dans le registre se fait en temps constant en moyenne, plus le temps de 
+ * hacher l'ensemble cherché ; comparer deux ensembles du registre revient à 
+ * comparer leurs identifiants.
+ *
+ * Tous les ensembles présentés à un même registre doivent avoir la même 
+ * fonction de comparaison des éléments.
+ */
+typedef struct Registre Registre;
+
+/**
+ * @brief Crée un registre vide.
+ *
+ * 'hacher_element' doit renvoyer la même valeur pour deux éléments égaux. 
+ * Il peut être NULL si les ensembles contiennent des entiers.
+ */
+Registre* creer_registre( size_t (*hacher_element)( const intptr_t elem ) );
+
+/**
+ * @brief Libère le registre et toutes les copies d'ensembles qu'il contient.
+ */
+void liberer_registre( Registre* registre );
+
+/**
+ * @brief Renvoie l'identifiant de l'ensemble.
+ *
+ * Si aucun ensemble égal n'est encore dans le registre, une copie de 
+ * l'ensemble y est ajoutée et reçoit l'identifiant nombre_ensembles_registre()
+ * (pris avant l'appel). L'ensemble passé en paramètre reste à la charge de 
+ * l'utilisateur.
+ */
+int interner_ensemble( Registre* registre, const Ensemble* ensemble );
+
+/**
+ * @brief Comme interner_ensemble(), mais le registre devient responsable 
+ * de l'ensemble : il est gardé tel quel s'il est nouveau, et libéré sinon.
+ */
+int interner_ensemble_et_libere( Registre* registre, Ensemble* ensemble );
+
+/**
+ * @brief Renvoie l'identifiant de l'ensemble, ou -1 si aucun ensemble égal
+ * n'est dans le registre.
+ */
+int chercher_registre( const Registre* registre, const Ensemble* ensemble );
+
+/**
+ * @brief Renvoie l'ensemble canonique associé à un identifiant.
+ *
+ * L'ensemble appartient au registre et ne doit pas être modifié.
+ */
+const Ensemble* get_ensemble_registre( const Registre* registre, int id );
+
+/**
+ * @brief Renvoie, en temps constant, la taille de l'ensemble d'identifiant 
+ * 'id'.
+ */
+unsigned int get_taille_registre( const Registre* registre, int id );
+
+/**
+ * @brief Renvoie, en temps constant, la valeur de hachage de l'ensemble 
+ * d'identifiant 'id', calculée par hacher_ensemble().
+ */
+size_t get_hache_registre( const Registre* registre, int id );
+
+/**
+ * @brief Renvoie le nombre d'ensembles distincts du registre.
+ */
+int nombre_ensembles_registre( const Registre* registre );
+
+#endif
@@ -0,0 +1,1107 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "roaring.h"
+#include "bitset.h"
+#include "outils.h"
+
+#include <string.h>
+
+/*
+ * Un élément est rangé dans le conteneur de clé ROARING_CLE( element ), qui
+ * ne garde que ses 16 bits de poids faible, ROARING_BAS( element ).
+ */
+#define ROARING_CLE( element ) ( ( element ) >> 16 )
+#define ROARING_BAS( element ) ( (uint16_t) ( ( element ) & 0xffff ) )
+
+#define ROARING_CAPACITE_MIN 4
+
+/*
+ * Une position code l'indice du conteneur et, dans le conteneur, l'indice 
+ * de la valeur (ROARING_TABLEAU) ou la valeur elle-même (ROARING_BITMAP et
+ * ROARING_PLAGES).
+ */
+#define ROARING_POSITION( indice, p ) ( ( (intptr_t) ( indice ) << 16 ) | ( p ) )
+#define ROARING_INDICE( position ) ( (size_t) ( ( position ) >> 16 ) )
+#define ROARING_P( position ) ( (int32_t) ( ( position ) & 0xffff ) )
+
+/*
+ * Fonctions sur les conteneurs.
+ */
+
+static size_t octets_conteneur( const Roaring_conteneur* c ){
+	switch( c->type ){
+		case ROARING_TABLEAU :
+			return c->capacite * sizeof(uint16_t);
+		case ROARING_BITMAP :
+			return ROARING_MOTS_PAR_BITMAP * sizeof(uint64_t);
+		default :
+			return c->capacite * sizeof(Roaring_plage);
+	}
+}
+
+static void initialiser_conteneur( Roaring_conteneur* c, intptr_t cle ){
+	c->cle = cle;
+	c->type = ROARING_TABLEAU;
+	c->cardinal = 0;
+	c->nb_plages = 0;
+	c->capacite = 0;
+	c->valeurs = NULL;
+}
+
+static void liberer_conteneur( Roaring_conteneur* c ){
+	xfree( c->valeurs );
+}
+
+static void copier_conteneur(
+	Roaring_conteneur* dest, const Roaring_conteneur* source
+){
+	*dest = *source;
+	if( source->type == ROARING_TABLEAU ) dest->capacite = source->cardinal;
+	if( source->type == ROARING_PLAGES ) dest->capacite = source->nb_plages;
+	size_t octets = octets_conteneur( dest );
+	dest->valeurs = xmalloc( octets );
+	memcpy( dest->valeurs, source->valeurs, octets );
+}
+
+static uint32_t fin_de_plage( const Roaring_plage* plage ){
+	return (uint32_t) plage->debut + plage->longueur;
+}
+
+/*
+ * Met à 1 (ou à 0) les bits de 'debut' à 'fin', inclus.
+ */
+static void changer_intervalle( 
+	uint64_t* mots, uint32_t debut, uint32_t fin, int valeur 
+){
+	uint32_t premier = debut >> 6;
+	uint32_t dernier = fin >> 6;
+	uint64_t masque_debut = ~ (uint64_t) 0 << ( debut & 63 );
+	uint64_t masque_fin = ~ (uint64_t) 0 >> ( 63 - ( fin & 63 ) );
+	uint32_t i;
+	if( premier == dernier ){
+		masque_debut &= masque_fin;
+	}
+	if( valeur ){
+		mots[premier] |= masque_debut;
+		if( premier == dernier ) return;
+		for( i=premier+1; i<dernier; i++ ) mots[i] = ~ (uint64_t) 0;
+		mots[dernier] |= masque_fin;
+	}else{
+		mots[premier] &= ~masque_debut;
+		if( premier == dernier ) return;
+		for( i=premier+1; i<dernier; i++ ) mots[i] = 0;
+		mots[dernier] &= ~masque_fin;
+	}
+}
+
+/*
+ * Écrit les éléments du conteneur dans le tableau de bits 'mots', qui doit 
+ * être nul.
+ */
+static void remplir_mots( const Roaring_conteneur* c, uint64_t* mots ){
+	uint32_t i;
+	switch( c->type ){
+		case ROARING_TABLEAU :
+			for( i=0; i<c->cardinal; i++ ){
+				mots[ BITSET_MOT( c->valeurs[i] ) ] |= BITSET_MASQUE( c->valeurs[i] );
+			}
+			break;
+		case ROARING_BITMAP :
+			memcpy( mots, c->mots, ROARING_MOTS_PAR_BITMAP * sizeof(uint64_t) );
+			break;
+		case ROARING_PLAGES :
+			for( i=0; i<c->nb_plages; i++ ){
+				changer_intervalle( 
+					mots, c->plages[i].debut, fin_de_plage( &c->plages[i] ), 1 
+				);
+			}
+			break;
+	}
+}
+
+static void convertir_en_bitmap( Roaring_conteneur* c ){
+	if( c->type == ROARING_BITMAP ) return;
+	uint64_t* mots = xmalloc( ROARING_MOTS_PAR_BITMAP * sizeof(uint64_t) );
+	memset( mots, 0, ROARING_MOTS_PAR_BITMAP * sizeof(uint64_t) );
+	remplir_mots( c, mots );
+	xfree( c->valeurs );
+	c->mots = mots;
+	c->type = ROARING_BITMAP;
+	c->nb_plages = 0;
+	c->capacite = 0;
+}
+
+/*
+ * Le conteneur doit avoir au plus ROARING_TAILLE_MAX_TABLEAU éléments.
+ */
+static void convertir_en_tableau( Roaring_conteneur* c ){
+	if( c->type == ROARING_TABLEAU ) return;
+	uint16_t* valeurs = xmalloc( c->cardinal * sizeof(uint16_t) );
+	uint32_t n = 0;
+	uint32_t i;
+	if( c->type == ROARING_BITMAP ){
+		for( i=0; i<ROARING_MOTS_PAR_BITMAP; i++ ){
+			uint64_t mot = c->mots[i];
+			while( mot ){
+				valeurs[n++] = i * BITSET_BITS_PAR_MOT + __builtin_ctzll( mot );
+				mot &= mot - 1;
+			}
+		}
+	}else{
+		for( i=0; i<c->nb_plages; i++ ){
+			uint32_t v;
+			for( v=c->plages[i].debut; v<=fin_de_plage( &c->plages[i] ); v++ ){
+				valeurs[n++] = v;
+			}
+		}
+	}
+	xfree( c->valeurs );
+	c->valeurs = valeurs;
+	c->type = ROARING_TABLEAU;
+	c->nb_plages = 0;
+	c->capacite = c->cardinal;
+}
+
+static uint32_t nombre_de_plages( const Roaring_conteneur* c ){
+	uint32_t res = 0;
+	uint32_t i;
+	switch( c->type ){
+		case ROARING_TABLEAU :
+			for( i=0; i<c->cardinal; i++ ){
+				if( i == 0 || c->valeurs[i] != c->valeurs[i-1] + 1 ) res++;
+			}
+			return res;
+		case ROARING_BITMAP : {
+			// Une plage commence à chaque bit à 1 précédé d'un bit à 0.
+			uint64_t retenue = 0;
+			for( i=0; i<ROARING_MOTS_PAR_BITMAP; i++ ){
+				uint64_t mot = c->mots[i];
+				res += __builtin_popcountll( mot & ~( ( mot << 1 ) | retenue ) );
+				retenue = mot >> 63;
+			}
+			return res;
+		}
+		default :
+			return c->nb_plages;
+	}
+}
+
+/*
+ * Renvoie la position du premier bit à 0 à partir de 'position', ou 2^16.
+ */
+static uint32_t zero_suivant( const uint64_t* mots, uint32_t position ){
+	uint32_t i = BITSET_MOT( position );
+	uint64_t mot = ~mots[i] & ( ~ (uint64_t) 0 << ( position & 63 ) );
+	while( ! mot ){
+		i++;
+		if( i == ROARING_MOTS_PAR_BITMAP ) return 1 << 16;
+		mot = ~mots[i];
+	}
+	return i * BITSET_BITS_PAR_MOT + __builtin_ctzll( mot );
+}
+
+static void convertir_en_plages( Roaring_conteneur* c ){
+	if( c->type == ROARING_PLAGES ) return;
+	uint32_t nb_plages = nombre_de_plages( c );
+	Roaring_plage* plages = xmalloc( nb_plages * sizeof(Roaring_plage) );
+	uint32_t n = 0;
+	if( c->type == ROARING_TABLEAU ){
+		uint32_t i;
+		for( i=0; i<c->cardinal; i++ ){
+			if( n && c->valeurs[i] == fin_de_plage( &plages[n-1] ) + 1 ){
+				plages[n-1].longueur++;
+			}else{
+				plages[n].debut = c->valeurs[i];
+				plages[n].longueur = 0;
+				n++;
+			}
+		}
+	}else{
+		intptr_t debut;
+		for(
+			debut = bitset_suivant( c->mots, ROARING_MOTS_PAR_BITMAP, 0 );
+			debut >= 0;
+		){
+			uint32_t fin = zero_suivant( c->mots, debut );
+			plages[n].debut = debut;
+			plages[n].longueur = fin - 1 - debut;
+			n++;
+			debut = bitset_suivant( c->mots, ROARING_MOTS_PAR_BITMAP, fin );
+		}
+	}
+	xfree( c->valeurs );
+	c->plages = plages;
+	c->type = ROARING_PLAGES;
+	c->nb_plages = nb_plages;
+	c->capacite = nb_plages;
+}
+
+/*
+ * Donne au conteneur la représentation la plus compacte. On n'appelle 
+ * cette fonction qu'après les opérations qui traitent tout un conteneur :
+ * compter les plages coûte autant que l'opération.
+ */
+static void optimiser_conteneur( Roaring_conteneur* c ){
+	size_t plages = nombre_de_plages( c ) * sizeof(Roaring_plage);
+	size_t tableau = c->cardinal <= ROARING_TAILLE_MAX_TABLEAU ? 
+		c->cardinal * sizeof(uint16_t) : SIZE_MAX;
+	size_t bitmap = ROARING_MOTS_PAR_BITMAP * sizeof(uint64_t);
+	if( plages < tableau && plages < bitmap ){
+		convertir_en_plages( c );
+	}else if( tableau <= bitmap ){
+		convertir_en_tableau( c );
+	}else{
+		convertir_en_bitmap( c );
+	}
+}
+
+/*
+ * Les plages ne sont pas modifiées élément par élément : le conteneur est 
+ * d'abord converti en tableau ou en tableau de bits.
+ */
+static void developper( Roaring_conteneur* c ){
+	if( c->cardinal <= ROARING_TAILLE_MAX_TABLEAU ){
+		convertir_en_tableau( c );
+	}else{
+		convertir_en_bitmap( c );
+	}
+}
+
+/*
+ * Recherche dichotomique de 'v' dans 'valeurs'. Dans tous les cas, 'indice'
+ * contient la position à laquelle se trouve (ou devrait se trouver) 'v'.
+ */
+static int chercher_valeur(
+	const uint16_t* valeurs, uint32_t n, uint16_t v, uint32_t* indice
+){
+	uint32_t debut = 0;
+	uint32_t fin = n;
+	while( debut < fin ){
+		uint32_t milieu = ( debut + fin ) / 2;
+		if( valeurs[milieu] < v ){
+			debut = milieu + 1;
+		}else{
+			fin = milieu;
+		}
+	}
+	*indice = debut;
+	return debut < n && valeurs[debut] == v;
+}
+
+/*
+ * Renvoie le nombre de plages qui commencent avant 'v' (ou en 'v').
+ */
+static uint32_t plages_avant( const Roaring_conteneur* c, uint32_t v ){
+	uint32_t debut = 0;
+	uint32_t fin = c->nb_plages;
+	while( debut < fin ){
+		uint32_t milieu = ( debut + fin ) / 2;
+		if( c->plages[milieu].debut <= v ){
+			debut = milieu + 1;
+		}else{
+			fin = milieu;
+		}
+	}
+	return debut;
+}
+
+static int conteneur_contient( const Roaring_conteneur* c, uint16_t v ){
+	uint32_t indice;
+	switch( c->type ){
+		case ROARING_TABLEAU :
+			return chercher_valeur( c->valeurs, c->cardinal, v, &indice );
+		case ROARING_BITMAP :
+			return ( c->mots[ BITSET_MOT( v ) ] & BITSET_MASQUE( v ) ) != 0;
+		default :
+			indice = plages_avant( c, v );
+			return indice && v <= fin_de_plage( &c->plages[indice-1] );
+	}
+}
+
+static int conteneur_ajouter( Roaring_conteneur* c, uint16_t v ){
+	if( c->type == ROARING_PLAGES ){
+		if( conteneur_contient( c, v ) ) return 0;
+		developper( c );
+	}
+	if( c->type == ROARING_TABLEAU ){
+		uint32_t indice;
+		if( chercher_valeur( c->valeurs, c->cardinal, v, &indice ) ){
+			return 0;
+		}
+		if( c->cardinal < ROARING_TAILLE_MAX_TABLEAU ){
+			if( c->cardinal == c->capacite ){
+				uint32_t capacite = 2 * c->capacite;
+				if( capacite < ROARING_CAPACITE_MIN ) capacite = ROARING_CAPACITE_MIN;
+				if( capacite > ROARING_TAILLE_MAX_TABLEAU ){
+					capacite = ROARING_TAILLE_MAX_TABLEAU;
+				}
+				uint16_t* valeurs = xmalloc( capacite * sizeof(uint16_t) );
+				if( c->cardinal ){
+					memcpy( valeurs, c->valeurs, c->cardinal * sizeof(uint16_t) );
+				}
+				xfree( c->valeurs );
+				c->valeurs = valeurs;
+				c->capacite = capacite;
+			}
+			memmove(
+				c->valeurs + indice + 1, c->valeurs + indice,
+				( c->cardinal - indice ) * sizeof(uint16_t)
+			);
+			c->valeurs[indice] = v;
+			c->cardinal++;
+			return 1;
+		}
+		convertir_en_bitmap( c );
+	}
+	uint64_t* mot = &c->mots[ BITSET_MOT( v ) ];
+	if( *mot & BITSET_MASQUE( v ) ) return 0;
+	*mot |= BITSET_MASQUE( v );
+	c->cardinal++;
+	return 1;
+}
+
+static int conteneur_retirer( Roaring_conteneur* c, uint16_t v ){
+	if( c->type == ROARING_PLAGES ){
+		if( ! conteneur_contient( c, v ) ) return 0;
+		developper( c );
+	}
+	if( c->type == ROARING_TABLEAU ){
+		uint32_t indice;
+		if( ! chercher_valeur( c->valeurs, c->cardinal, v, &indice ) ){
+			return 0;
+		}
+		memmove(
+			c->valeurs + indice, c->valeurs + indice + 1,
+			( c->cardinal - indice - 1 ) * sizeof(uint16_t)
+		);
+		c->cardinal--;
+		return 1;
+	}
+	uint64_t* mot = &c->mots[ BITSET_MOT( v ) ];
+	if( ! ( *mot & BITSET_MASQUE( v ) ) ) return 0;
+	*mot &= ~BITSET_MASQUE( v );
+	c->cardinal--;
+	// On attend que le tableau soit à moitié plein pour y revenir : des 
+	// ajouts et des retraits alternés autour de la limite ne convertissent
+	// pas le conteneur à chaque fois.
+	if( c->cardinal <= ROARING_TAILLE_MAX_TABLEAU / 2 ){
+		convertir_en_tableau( c );
+	}
+	return 1;
+}
+
+static void conteneur_union(
+	Roaring_conteneur* dest, const Roaring_conteneur* source
+){
+	uint32_t i;
+	if( 
+		dest->type == ROARING_TABLEAU && source->type == ROARING_TABLEAU &&
+		dest->cardinal + source->cardinal <= ROARING_TAILLE_MAX_TABLEAU
+	){
+		uint32_t capacite = dest->cardinal + source->cardinal;
+		uint16_t* valeurs = xmalloc( capacite * sizeof(uint16_t) );
+		uint32_t j = 0, n = 0;
+		i = 0;
+		while( i < dest->cardinal && j < source->cardinal ){
+			uint16_t a = dest->valeurs[i];
+			uint16_t b = source->valeurs[j];
+			valeurs[n++] = a < b ? a : b;
+			if( a <= b ) i++;
+			if( b <= a ) j++;
+		}
+		while( i < dest->cardinal ) valeurs[n++] = dest->valeurs[i++];
+		while( j < source->cardinal ) valeurs[n++] = source->valeurs[j++];
+		xfree( dest->valeurs );
+		dest->valeurs = valeurs;
+		dest->capacite = capacite;
+		dest->cardinal = n;
+		return;
+	}
+	convertir_en_bitmap( dest );
+	switch( source->type ){
+		case ROARING_TABLEAU :
+			for( i=0; i<source->cardinal; i++ ){
+				uint16_t v = source->valeurs[i];
+				uint64_t* mot = &dest->mots[ BITSET_MOT( v ) ];
+				dest->cardinal += ! ( *mot & BITSET_MASQUE( v ) );
+				*mot |= BITSET_MASQUE( v );
+			}
+			break;
+		case ROARING_BITMAP :
+			dest->cardinal += bitset_ajouter( 
+				dest->mots, source->mots, ROARING_MOTS_PAR_BITMAP 
+			);
+			break;
+		case ROARING_PLAGES :
+			for( i=0; i<source->nb_plages; i++ ){
+				changer_intervalle(
+					dest->mots, source->plages[i].debut, 
+					fin_de_plage( &source->plages[i] ), 1
+				);
+			}
+			dest->cardinal = bitset_popcount( dest->mots, ROARING_MOTS_PAR_BITMAP );
+			break;
+	}
+	optimiser_conteneur( dest );
+}
+
+static void conteneur_difference(
+	Roaring_conteneur* dest, const Roaring_conteneur* source
+){
+	uint32_t i;
+	if( dest->type == ROARING_PLAGES ){
+		developper( dest );
+	}
+	if( dest->type == ROARING_TABLEAU ){
+		uint32_t n = 0;
+		for( i=0; i<dest->cardinal; i++ ){
+			if( ! conteneur_contient( source, dest->valeurs[i] ) ){
+				dest->valeurs[n++] = dest->valeurs[i];
+			}
+		}
+		dest->cardinal = n;
+		return;
+	}
+	switch( source->type ){
+		case ROARING_TABLEAU :
+			for( i=0; i<source->cardinal; i++ ){
+				uint16_t v = source->valeurs[i];
+				uint64_t* mot = &dest->mots[ BITSET_MOT( v ) ];
+				dest->cardinal -= ( *mot & BITSET_MASQUE( v ) ) != 0;
+				*mot &= ~BITSET_MASQUE( v );
+			}
+			break;
+		case ROARING_BITMAP :
+			dest->cardinal -= bitset_retirer( 
+				dest->mots, source->mots, ROARING_MOTS_PAR_BITMAP 
+			);
+			break;
+		case ROARING_PLAGES :
+			for( i=0; i<source->nb_plages; i++ ){
+				changer_intervalle(
+					dest->mots, source->plages[i].debut, 
+					fin_de_plage( &source->plages[i] ), 0
+				);
+			}
+			dest->cardinal = bitset_popcount( dest->mots, ROARING_MOTS_PAR_BITMAP );
+			break;
+	}
+	if( dest->cardinal ){
+		optimiser_conteneur( dest );
+	}
+}
+
+/*
+ * Renvoie le tableau de bits du conteneur : le sien, ou 'tampon' rempli 
+ * avec ses éléments.
+ */
+static const uint64_t* mots_du_conteneur(
+	const Roaring_conteneur* c, uint64_t* tampon
+){
+	if( c->type == ROARING_BITMAP ){
+		return c->mots;
+	}
+	memset( tampon, 0, ROARING_MOTS_PAR_BITMAP * sizeof(uint64_t) );
+	remplir_mots( c, tampon );
+	return tampon;
+}
+
+/*
+ * Calcule l'intersection de deux conteneurs de même clé. Si 'res' n'est 
+ * pas NULL et que l'intersection n'est pas vide, 'res' reçoit un nouveau 
+ * conteneur. Renvoie le nombre d'éléments de l'intersection.
+ */
+static uint32_t conteneur_intersection(
+	Roaring_conteneur* res, 
+	const Roaring_conteneur* a, const Roaring_conteneur* b
+){
+	uint32_t n = 0;
+	uint32_t i;
+	if( a->type == ROARING_TABLEAU || b->type == ROARING_TABLEAU ){
+		// On parcourt le tableau (le plus petit, s'il y en a deux).
+		if( 
+			b->type == ROARING_TABLEAU && 
+			( a->type != ROARING_TABLEAU || b->cardinal < a->cardinal )
+		){
+			const Roaring_conteneur* tmp = a;
+			a = b;
+			b = tmp;
+		}
+		uint16_t* valeurs = res ? xmalloc( a->cardinal * sizeof(uint16_t) ) : NULL;
+		if( b->type == ROARING_TABLEAU ){
+			uint32_t j = 0;
+			i = 0;
+			while( i < a->cardinal && j < b->cardinal ){
+				if( a->valeurs[i] < b->valeurs[j] ){
+					i++;
+				}else if( a->valeurs[i] > b->valeurs[j] ){
+					j++;
+				}else{
+					if( valeurs ) valeurs[n] = a->valeurs[i];
+					n++;
+					i++;
+					j++;
+				}
+			}
+		}else{
+			for( i=0; i<a->cardinal; i++ ){
+				if( conteneur_contient( b, a->valeurs[i] ) ){
+					if( valeurs ) valeurs[n] = a->valeurs[i];
+					n++;
+				}
+			}
+		}
+		if( res && n ){
+			initialiser_conteneur( res, a->cle );
+			res->valeurs = valeurs;
+			res->capacite = a->cardinal;
+			res->cardinal = n;
+		}else{
+			xfree( valeurs );
+		}
+		return n;
+	}
+	uint64_t tampon_a[ROARING_MOTS_PAR_BITMAP];
+	uint64_t tampon_b[ROARING_MOTS_PAR_BITMAP];
+	const uint64_t* mots_a = mots_du_conteneur( a, tampon_a );
+	const uint64_t* mots_b = mots_du_conteneur( b, tampon_b );
+	bitset_intersection( tampon_a, mots_a, mots_b, ROARING_MOTS_PAR_BITMAP );
+	n = bitset_popcount( tampon_a, ROARING_MOTS_PAR_BITMAP );
+	if( res && n ){
+		initialiser_conteneur( res, a->cle );
+		res->type = ROARING_BITMAP;
+		res->mots = xmalloc( ROARING_MOTS_PAR_BITMAP * sizeof(uint64_t) );
+		memcpy( res->mots, tampon_a, ROARING_MOTS_PAR_BITMAP * sizeof(uint64_t) );
+		res->cardinal = n;
+		optimiser_conteneur( res );
+	}
+	return n;
+}
+
+/*
+ * Fonctions sur la liste des conteneurs.
+ */
+
+/*
+ * Renvoie l'indice du premier conteneur dont la clé est supérieure ou égale
+ * à 'cle'.
+ */
+static size_t chercher_conteneur( const Roaring* r, intptr_t cle ){
+	size_t debut = 0;
+	size_t fin = r->nb_conteneurs;
+	while( debut < fin ){
+		size_t milieu = ( debut + fin ) / 2;
+		if( r->conteneurs[milieu].cle < cle ){
+			debut = milieu + 1;
+		}else{
+			fin = milieu;
+		}
+	}
+	return debut;
+}
+
+static const Roaring_conteneur* trouver_conteneur( 
+	const Roaring* r, intptr_t cle 
+){
+	size_t indice = chercher_conteneur( r, cle );
+	if( indice < r->nb_conteneurs && r->conteneurs[indice].cle == cle ){
+		return &r->conteneurs[indice];
+	}
+	return NULL;
+}
+
+static void reserver_conteneurs( Roaring* r, size_t nb ){
+	if( nb <= r->capacite ) return;
+	size_t capacite = 2 * r->capacite;
+	if( capacite < nb ) capacite = nb;
+	if( capacite < ROARING_CAPACITE_MIN ) capacite = ROARING_CAPACITE_MIN;
+	Roaring_conteneur* conteneurs = xmalloc( capacite * sizeof(Roaring_conteneur) );
+	if( r->nb_conteneurs ){
+		memcpy( 
+			conteneurs, r->conteneurs, 
+			r->nb_conteneurs * sizeof(Roaring_conteneur) 
+		);
+	}
+	xfree( r->conteneurs );
+	r->conteneurs = conteneurs;
+	r->capacite = capacite;
+}
+
+/*
+ * Renvoie le conteneur de clé 'cle', créé vide s'il n'existait pas.
+ */
+static Roaring_conteneur* obtenir_conteneur( Roaring* r, intptr_t cle ){
+	size_t indice = chercher_conteneur( r, cle );
+	if( indice < r->nb_conteneurs && r->conteneurs[indice].cle == cle ){
+		return &r->conteneurs[indice];
+	}
+	reserver_conteneurs( r, r->nb_conteneurs + 1 );
+	memmove(
+		r->conteneurs + indice + 1, r->conteneurs + indice,
+		( r->nb_conteneurs - indice ) * sizeof(Roaring_conteneur)
+	);
+	r->nb_conteneurs++;
+	initialiser_conteneur( &r->conteneurs[indice], cle );
+	return &r->conteneurs[indice];
+}
+
+static void retirer_conteneur( Roaring* r, size_t indice ){
+	liberer_conteneur( &r->conteneurs[indice] );
+	memmove(
+		r->conteneurs + indice, r->conteneurs + indice + 1,
+		( r->nb_conteneurs - indice - 1 ) * sizeof(Roaring_conteneur)
+	);
+	r->nb_conteneurs--;
+}
+
+void roaring_initialiser( Roaring* r ){
+	r->conteneurs = NULL;
+	r->nb_conteneurs = 0;
+	r->capacite = 0;
+	r->cardinal = 0;
+}
+
+void roaring_liberer( Roaring* r ){
+	size_t i;
+	for( i=0; i<r->nb_conteneurs; i++ ){
+		liberer_conteneur( &r->conteneurs[i] );
+	}
+	xfree( r->conteneurs );
+}
+
+void roaring_copier( Roaring* dest, const Roaring* source ){
+	roaring_initialiser( dest );
+	reserver_conteneurs( dest, source->nb_conteneurs );
+	size_t i;
+	for( i=0; i<source->nb_conteneurs; i++ ){
+		copier_conteneur( &dest->conteneurs[i], &source->conteneurs[i] );
+	}
+	dest->nb_conteneurs = source->nb_conteneurs;
+	dest->cardinal = source->cardinal;
+}
+
+int roaring_ajouter( Roaring* r, intptr_t element ){
+	Roaring_conteneur* c = obtenir_conteneur( r, ROARING_CLE( element ) );
+	int res = conteneur_ajouter( c, ROARING_BAS( element ) );
+	r->cardinal += res;
+	return res;
+}
+
+int roaring_retirer( Roaring* r, intptr_t element ){
+	size_t indice = chercher_conteneur( r, ROARING_CLE( element ) );
+	if( 
+		indice == r->nb_conteneurs || 
+		r->conteneurs[indice].cle != ROARING_CLE( element ) 
+	){
+		return 0;
+	}
+	Roaring_conteneur* c = &r->conteneurs[indice];
+	int res = conteneur_retirer( c, ROARING_BAS( element ) );
+	r->cardinal -= res;
+	if( ! c->cardinal ){
+		retirer_conteneur( r, indice );
+	}
+	return res;
+}
+
+int roaring_contient( const Roaring* r, intptr_t element ){
+	const Roaring_conteneur* c = trouver_conteneur( r, ROARING_CLE( element ) );
+	return c && conteneur_contient( c, ROARING_BAS( element ) );
+}
+
+void roaring_remplir( Roaring* r, const intptr_t* elements, size_t nb ){
+	size_t i = 0;
+	while( i < nb ){
+		intptr_t cle = ROARING_CLE( elements[i] );
+		size_t fin = i;
+		while( fin < nb && ROARING_CLE( elements[fin] ) == cle ) fin++;
+		reserver_conteneurs( r, r->nb_conteneurs + 1 );
+		Roaring_conteneur* c = &r->conteneurs[ r->nb_conteneurs++ ];
+		initialiser_conteneur( c, cle );
+		c->cardinal = fin - i;
+		if( c->cardinal <= ROARING_TAILLE_MAX_TABLEAU ){
+			c->valeurs = xmalloc( c->cardinal * sizeof(uint16_t) );
+			c->capacite = c->cardinal;
+			size_t j;
+			for( j=i; j<fin; j++ ){
+				c->valeurs[j-i] = ROARING_BAS( elements[j] );
+			}
+		}else{
+			c->type = ROARING_BITMAP;
+			c->mots = xmalloc( ROARING_MOTS_PAR_BITMAP * sizeof(uint64_t) );
+			memset( c->mots, 0, ROARING_MOTS_PAR_BITMAP * sizeof(uint64_t) );
+			for( ; i<fin; i++ ){
+				uint16_t v = ROARING_BAS( elements[i] );
+				c->mots[ BITSET_MOT( v ) ] |= BITSET_MASQUE( v );
+			}
+		}
+		optimiser_conteneur( c );
+		r->cardinal += c->cardinal;
+		i = fin;
+	}
+}
+
+void roaring_ajouter_mots(
+	Roaring* r, const uint64_t* mots, size_t nb_mots, intptr_t premier_mot
+){
+	size_t j = 0;
+	while( j < nb_mots ){
+		// Les mots de 'mots' qui vont dans le même conteneur.
+		intptr_t mot = premier_mot + j;
+		size_t decalage = mot & ( ROARING_MOTS_PAR_BITMAP - 1 );
+		size_t n = ROARING_MOTS_PAR_BITMAP - decalage;
+		if( n > nb_mots - j ) n = nb_mots - j;
+		if( ! bitset_est_nul( mots + j, n ) ){
+			Roaring_conteneur* c = obtenir_conteneur( r, mot >> 10 );
+			convertir_en_bitmap( c );
+			size_t ajoutes = bitset_ajouter( c->mots + decalage, mots + j, n );
+			c->cardinal += ajoutes;
+			r->cardinal += ajoutes;
+			optimiser_conteneur( c );
+		}
+		j += n;
+	}
+}
+
+void roaring_union( Roaring* dest, const Roaring* source ){
+	if( dest == source || ! source->nb_conteneurs ) return;
+	size_t capacite = dest->nb_conteneurs + source->nb_conteneurs;
+	Roaring_conteneur* conteneurs = xmalloc( capacite * sizeof(Roaring_conteneur) );
+	size_t i = 0, j = 0, n = 0;
+	dest->cardinal = 0;
+	while( i < dest->nb_conteneurs || j < source->nb_conteneurs ){
+		Roaring_conteneur* c = &conteneurs[n++];
+		if( 
+			j == source->nb_conteneurs || ( 
+				i < dest->nb_conteneurs &&
+				dest->conteneurs[i].cle < source->conteneurs[j].cle 
+			)
+		){
+			*c = dest->conteneurs[i++];
+		}else if( 
+			i == dest->nb_conteneurs || 
+			source->conteneurs[j].cle < dest->conteneurs[i].cle
+		){
+			copier_conteneur( c, &source->conteneurs[j++] );
+		}else{
+			*c = dest->conteneurs[i++];
+			conteneur_union( c, &source->conteneurs[j++] );
+		}
+		dest->cardinal += c->cardinal;
+	}
+	xfree( dest->conteneurs );
+	dest->conteneurs = conteneurs;
+	dest->nb_conteneurs = n;
+	dest->capacite = capacite;
+}
+
+void roaring_difference( Roaring* dest, const Roaring* source ){
+	if( dest == source ){
+		roaring_liberer( dest );
+		roaring_initialiser( dest );
+		return;
+	}
+	size_t i, j = 0, n = 0;
+	dest->cardinal = 0;
+	for( i=0; i<dest->nb_conteneurs; i++ ){
+		Roaring_conteneur* c = &dest->conteneurs[i];
+		while( j < source->nb_conteneurs && source->conteneurs[j].cle < c->cle ){
+			j++;
+		}
+		if( j < source->nb_conteneurs && source->conteneurs[j].cle == c->cle ){
+			conteneur_difference( c, &source->conteneurs[j] );
+		}
+		if( c->cardinal ){
+			dest->conteneurs[n++] = *c;
+			dest->cardinal += c->cardinal;
+		}else{
+			liberer_conteneur( c );
+		}
+	}
+	dest->nb_conteneurs = n;
+}
+
+void roaring_intersection( Roaring* res, const Roaring* a, const Roaring* b ){
+	roaring_initialiser( res );
+	size_t i = 0, j = 0;
+	while( i < a->nb_conteneurs && j < b->nb_conteneurs ){
+		if( a->conteneurs[i].cle < b->conteneurs[j].cle ){
+			i++;
+		}else if( a->conteneurs[i].cle > b->conteneurs[j].cle ){
+			j++;
+		}else{
+			Roaring_conteneur c;
+			if( conteneur_intersection( &c, &a->conteneurs[i], &b->conteneurs[j] ) ){
+				reserver_conteneurs( res, res->nb_conteneurs + 1 );
+				res->conteneurs[ res->nb_conteneurs++ ] = c;
+				res->cardinal += c.cardinal;
+			}
+			i++;
+			j++;
+		}
+	}
+}
+
+size_t roaring_cardinal_intersection( const Roaring* a, const Roaring* b ){
+	size_t res = 0;
+	size_t i = 0, j = 0;
+	while( i < a->nb_conteneurs && j < b->nb_conteneurs ){
+		if( a->conteneurs[i].cle < b->conteneurs[j].cle ){
+			i++;
+		}else if( a->conteneurs[i].cle > b->conteneurs[j].cle ){
+			j++;
+		}else{
+			res += conteneur_intersection( 
+				NULL, &a->conteneurs[i], &b->conteneurs[j] 
+			);
+			i++;
+			j++;
+		}
+	}
+	return res;
+}
+
+int roaring_se_coupent( const Roaring* a, const Roaring* b ){
+	size_t i = 0, j = 0;
+	while( i < a->nb_conteneurs && j < b->nb_conteneurs ){
+		if( a->conteneurs[i].cle < b->conteneurs[j].cle ){
+			i++;
+		}else if( a->conteneurs[i].cle > b->conteneurs[j].cle ){
+			j++;
+		}else{
+			if( 
+				conteneur_intersection( 
+					NULL, &a->conteneurs[i], &b->conteneurs[j] 
+				) 
+			){
+				return 1;
+			}
+			i++;
+			j++;
+		}
+	}
+	return 0;
+}
+
+int roaring_egaux( const Roaring* a, const Roaring* b ){
+	if( a->cardinal != b->cardinal || a->nb_conteneurs != b->nb_conteneurs ){
+		return 0;
+	}
+	size_t i;
+	for( i=0; i<a->nb_conteneurs; i++ ){
+		const Roaring_conteneur* ca = &a->conteneurs[i];
+		const Roaring_conteneur* cb = &b->conteneurs[i];
+		if( 
+			ca->cle != cb->cle || ca->cardinal != cb->cardinal ||
+			conteneur_intersection( NULL, ca, cb ) != ca->cardinal
+		){
+			return 0;
+		}
+	}
+	return 1;
+}
+
+size_t roaring_memoire( const Roaring* r ){
+	size_t res = r->capacite * sizeof(Roaring_conteneur);
+	size_t i;
+	for( i=0; i<r->nb_conteneurs; i++ ){
+		res += octets_conteneur( &r->conteneurs[i] );
+	}
+	return res;
+}
+
+/*
+ * Parcours.
+ */
+
+static int32_t premier_dans( const Roaring_conteneur* c ){
+	switch( c->type ){
+		case ROARING_TABLEAU :
+			return 0;
+		case ROARING_BITMAP :
+			return bitset_suivant( c->mots, ROARING_MOTS_PAR_BITMAP, 0 );
+		default :
+			return c->plages[0].debut;
+	}
+}
+
+static int32_t dernier_dans( const Roaring_conteneur* c ){
+	switch( c->type ){
+		case ROARING_TABLEAU :
+			return c->cardinal - 1;
+		case ROARING_BITMAP :
+			return bitset_precedent( 
+				c->mots, ROARING_MOTS_PAR_BITMAP, ( 1 << 16 ) - 1 
+			);
+		default :
+			return fin_de_plage( &c->plages[ c->nb_plages - 1 ] );
+	}
+}
+
+static int32_t suivant_dans( const Roaring_conteneur* c, int32_t p ){
+	uint32_t k;
+	switch( c->type ){
+		case ROARING_TABLEAU :
+			return p + 1 < (int32_t) c->cardinal ? p + 1 : -1;
+		case ROARING_BITMAP :
+			return bitset_suivant( c->mots, ROARING_MOTS_PAR_BITMAP, p + 1 );
+		default :
+			if( p + 1 >= ( 1 << 16 ) ) return -1;
+			k = plages_avant( c, p + 1 );
+			if( k && p + 1 <= (int32_t) fin_de_plage( &c->plages[k-1] ) ){
+				return p + 1;
+			}
+			return k < c->nb_plages ? c->plages[k].debut : -1;
+	}
+}
+
+static int32_t precedent_dans( const Roaring_conteneur* c, int32_t p ){
+	uint32_t k;
+	switch( c->type ){
+		case ROARING_TABLEAU :
+			return p - 1;
+		case ROARING_BITMAP :
+			if( p == 0 ) return -1;
+			return bitset_precedent( c->mots, ROARING_MOTS_PAR_BITMAP, p - 1 );
+		default :
+			if( p == 0 ) return -1;
+			k = plages_avant( c, p - 1 );
+			if( ! k ) return -1;
+			if( p - 1 <= (int32_t) fin_de_plage( &c->plages[k-1] ) ){
+				return p - 1;
+			}
+			return fin_de_plage( &c->plages[k-1] );
+	}
+}
+
+/*
+ * Renvoie le nombre de valeurs du conteneur strictement plus petites que 'v'.
+ */
+static uint32_t rang_dans( const Roaring_conteneur* c, uint32_t v ){
+	uint32_t res = 0, k;
+	switch( c->type ){
+		case ROARING_TABLEAU :
+			chercher_valeur( c->valeurs, c->cardinal, v, &res );
+			return res;
+		case ROARING_BITMAP :
+			return bitset_rang( c->mots, ROARING_MOTS_PAR_BITMAP, v );
+		default :
+			for( k=0; k<c->nb_plages && c->plages[k].debut < v; k++ ){
+				uint32_t fin = fin_de_plage( &c->plages[k] );
+				res += ( fin < v ? fin + 1 : v ) - c->plages[k].debut;
+			}
+			return res;
+	}
+}
+
+/*
+ * Renvoie la position, dans le conteneur, de la valeur de rang 'rang', qui
+ * doit être inférieur au cardinal du conteneur.
+ */
+static int32_t ieme_dans( const Roaring_conteneur* c, uint32_t rang ){
+	uint32_t k;
+	switch( c->type ){
+		case ROARING_TABLEAU :
+			return rang;
+		case ROARING_BITMAP :
+			return bitset_ieme( c->mots, ROARING_MOTS_PAR_BITMAP, rang );
+		default :
+			for( k=0; rang > c->plages[k].longueur; k++ ){
+				rang -= c->plages[k].longueur + 1;
+			}
+			return c->plages[k].debut + rang;
+	}
+}
+
+intptr_t roaring_suivant( const Roaring* r, intptr_t position ){
+	size_t indice = 0;
+	if( position >= 0 ){
+		indice = ROARING_INDICE( position );
+		int32_t p = suivant_dans( &r->conteneurs[indice], ROARING_P( position ) );
+		if( p >= 0 ) return ROARING_POSITION( indice, p );
+		indice++;
+	}
+	if( indice < r->nb_conteneurs ){
+		return ROARING_POSITION( indice, premier_dans( &r->conteneurs[indice] ) );
+	}
+	return -1;
+}
+
+intptr_t roaring_precedent( const Roaring* r, intptr_t position ){
+	size_t indice = r->nb_conteneurs;
+	if( position >= 0 ){
+		indice = ROARING_INDICE( position );
+		int32_t p = precedent_dans( &r->conteneurs[indice], ROARING_P( position ) );
+		if( p >= 0 ) return ROARING_POSITION( indice, p );
+	}
+	if( indice == 0 ) return -1;
+	indice--;
+	return ROARING_POSITION( indice, dernier_dans( &r->conteneurs[indice] ) );
+}
+
+intptr_t roaring_element( const Roaring* r, intptr_t position ){
+	const Roaring_conteneur* c = &r->conteneurs[ ROARING_INDICE( position ) ];
+	int32_t p = ROARING_P( position );
+	intptr_t bas = c->type == ROARING_TABLEAU ? c->valeurs[p] : p;
+	return c->cle * ( (intptr_t) 1 << 16 ) + bas;
+}
+
+size_t roaring_rang( const Roaring* r, intptr_t element ){
+	size_t res = 0;
+	size_t i, indice = chercher_conteneur( r, ROARING_CLE( element ) );
+	for( i=0; i<indice; i++ ){
+		res += r->conteneurs[i].cardinal;
+	}
+	if( 
+		indice < r->nb_conteneurs && 
+		r->conteneurs[indice].cle == ROARING_CLE( element ) 
+	){
+		res += rang_dans( &r->conteneurs[indice], ROARING_BAS( element ) );
+	}
+	return res;
+}
+
+intptr_t roaring_ieme( const Roaring* r, size_t rang ){
+	size_t i;
+	if( rang >= r->cardinal ) return -1;
+	for( i=0; rang >= r->conteneurs[i].cardinal; i++ ){
+		rang -= r->conteneurs[i].cardinal;
+	}
+	return ROARING_POSITION( i, ieme_dans( &r->conteneurs[i], rang ) );
+}
+
+intptr_t roaring_position( const Roaring* r, intptr_t element ){
+	size_t indice = chercher_conteneur( r, ROARING_CLE( element ) );
+	if( 
+		indice == r->nb_conteneurs || 
+		r->conteneurs[indice].cle != ROARING_CLE( element ) 
+	){
+		return -1;
+	}
+	const Roaring_conteneur* c = &r->conteneurs[indice];
+	uint16_t v = ROARING_BAS( element );
+	if( c->type == ROARING_TABLEAU ){
+		uint32_t p;
+		if( ! chercher_valeur( c->valeurs, c->cardinal, v, &p ) ) return -1;
+		return ROARING_POSITION( indice, p );
+	}
+	return conteneur_contient( c, v ) ? ROARING_POSITION( indice, v ) : -1;
+}
@@ -0,0 +1,245 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux.
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file roaring.h */
+
+#ifndef __ROARING_H__
+#define __ROARING_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief
+ * Nombre maximal d'éléments d'un conteneur codé par un tableau trié. Au-delà,
+ * un tableau de bits (8 Ko) prend moins de place.
+ */
+#define ROARING_TAILLE_MAX_TABLEAU 4096
+
+/**
+ * @brief
+ * Nombre de mots du tableau de bits d'un conteneur : 2^16 bits.
+ */
+#define ROARING_MOTS_PAR_BITMAP 1024
+
+/**
+ * @brief
+ * Les représentations possibles d'un conteneur.
+ *
+ *   - ROARING_TABLEAU : les 16 bits de poids faible des éléments, triés.
+ *   - ROARING_BITMAP : un tableau de 2^16 bits.
+ *   - ROARING_PLAGES : une suite triée d'intervalles disjoints et non 
+ *     contigus.
+ */
+typedef enum {
+	ROARING_TABLEAU,
+	ROARING_BITMAP,
+	ROARING_PLAGES
+} Roaring_type;
+
+/**
+ * @brief
+ * L'intervalle [debut, debut + longueur] (longueur vaut donc le nombre 
+ * d'éléments moins 1).
+ */
+typedef struct {
+	uint16_t debut;
+	uint16_t longueur;
+} Roaring_plage;
+
+/**
+ * @brief
+ * Les éléments dont les bits de poids fort ( element >> 16 ) valent 'cle'.
+ * Un conteneur n'est jamais vide.
+ */
+typedef struct {
+	intptr_t cle;
+	Roaring_type type;
+	// Nombre d'éléments (de 1 à 2^16).
+	uint32_t cardinal;
+	// Nombre de plages (ROARING_PLAGES), et place allouée, en valeurs ou en 
+	// plages (ROARING_TABLEAU et ROARING_PLAGES).
+	uint32_t nb_plages;
+	uint32_t capacite;
+	union {
+		uint16_t* valeurs;
+		uint64_t* mots;
+		Roaring_plage* plages;
+	};
+} Roaring_conteneur;
+
+/**
+ * @brief
+ * Un ensemble compressé d'entiers, à la manière des « Roaring bitmaps » : 
+ * les éléments sont répartis dans des conteneurs selon leurs bits de poids
+ * fort, et chaque conteneur choisit la représentation la plus compacte pour
+ * ses 16 bits de poids faible.
+ *
+ * Les conteneurs sont rangés par clé croissante.
+ */
+typedef struct {
+	Roaring_conteneur* conteneurs;
+	size_t nb_conteneurs;
+	size_t capacite;
+	size_t cardinal;
+} Roaring;
+
+/**
+ * @brief
+ * Initialise un ensemble vide.
+ */
+void roaring_initialiser( Roaring* r );
+
+/**
+ * @brief
+ * Libère la mémoire utilisée par l'ensemble, qui doit ensuite être 
+ * initialisé à nouveau pour être utilisé.
+ */
+void roaring_liberer( Roaring* r );
+
+/**
+ * @brief
+ * Initialise 'dest' avec une copie de 'source'.
+ */
+void roaring_copier( Roaring* dest, const Roaring* source );
+
+/**
+ * @brief
+ * Ajoute un élément. Renvoie 1 si l'élément n'y était pas, 0 sinon.
+ */
+int roaring_ajouter( Roaring* r, intptr_t element );
+
+/**
+ * @brief
+ * Retire un élément. Renvoie 1 si l'élément y était, 0 sinon.
+ */
+int roaring_retirer( Roaring* r, intptr_t element );
+
+/**
+ * @brief
+ * Renvoie 1 si l'élément est dans l'ensemble, 0 sinon.
+ */
+int roaring_contient( const Roaring* r, intptr_t element );
+
+/**
+ * @brief
+ * Ajoute à l'ensemble vide 'r' les 'nb' éléments du tableau, qui doivent 
+ * être deux à deux distincts et triés dans l'ordre croissant.
+ */
+void roaring_remplir( Roaring* r, const intptr_t* elements, size_t nb );
+
+/**
+ * @brief
+ * Ajoute les éléments codés par un tableau de bits, dont le bit i du mot j
+ * code l'entier ( premier_mot + j ) * 64 + i (voir bitset.h).
+ */
+void roaring_ajouter_mots(
+	Roaring* r, const uint64_t* mots, size_t nb_mots, intptr_t premier_mot
+);
+
+/**
+ * @brief
+ * Ajoute à 'dest' les éléments de 'source'.
+ */
+void roaring_union( Roaring* dest, const Roaring* source );
+
+/**
+ * @brief
+ * Retire de 'dest' les éléments de 'source'.
+ */
+void roaring_difference( Roaring* dest, const Roaring* source );
+
+/**
+ * @brief
+ * Initialise 'res' avec l'intersection de 'a' et 'b'.
+ */
+void roaring_intersection( Roaring* res, const Roaring* a, const Roaring* b );
+
+/**
+ * @brief
+ * Renvoie le nombre d'éléments communs à 'a' et 'b', sans construire leur 
+ * intersection.
+ */
+size_t roaring_cardinal_intersection( const Roaring* a, const Roaring* b );
+
+/**
+ * @brief
+ * Renvoie 1 si 'a' et 'b' ont au moins un élément commun, 0 sinon. Le 
+ * parcours s'arrête au premier conteneur dont l'intersection n'est pas vide.
+ */
+int roaring_se_coupent( const Roaring* a, const Roaring* b );
+
+/**
+ * @brief
+ * Renvoie 1 si les deux ensembles ont les mêmes éléments, 0 sinon.
+ */
+int roaring_egaux( const Roaring* a, const Roaring* b );
+
+/**
+ * @brief
+ * Renvoie le nombre d'octets alloués par l'ensemble.
+ */
+size_t roaring_memoire( const Roaring* r );
+
+/**
+ * @brief
+ * Les positions permettent de parcourir l'ensemble dans l'ordre croissant 
+ * ou décroissant. Une position vaut -1 quand elle ne désigne aucun élément.
+ *
+ * Renvoie la position de l'élément qui suit 'position', ou du premier 
+ * élément si 'position' vaut -1.
+ */
+intptr_t roaring_suivant( const Roaring* r, intptr_t position );
+
+/**
+ * @brief
+ * Renvoie la position de l'élément qui précède 'position', ou du dernier 
+ * élément si 'position' vaut -1.
+ */
+intptr_t roaring_precedent( const Roaring* r, intptr_t position );
+
+/**
+ * @brief
+ * Renvoie l'élément à la position 'position'.
+ */
+intptr_t roaring_element( const Roaring* r, intptr_t position );
+
+/**
+ * @brief
+ * Renvoie la position de l'élément, ou -1 s'il n'est pas dans l'ensemble.
+ */
+intptr_t roaring_position( const Roaring* r, intptr_t element );
+
+/**
+ * @brief
+ * Renvoie le nombre d'éléments de l'ensemble strictement plus petits que 
+ * 'element', qui n'a pas besoin d'être dans l'ensemble. Les cardinaux des 
+ * conteneurs étant connus, seul le conteneur de l'élément est parcouru.
+ */
+size_t roaring_rang( const Roaring* r, intptr_t element );
+
+/**
+ * @brief
+ * Renvoie la position de l'élément de rang 'rang' (précédé de 'rang' 
+ * éléments), ou -1 si l'ensemble a au plus 'rang' éléments.
+ */
+intptr_t roaring_ieme( const Roaring* r, size_t rang );
+
+#endif
@@ -22,96 +22,347 @@
 #include "outils.h"
 #include "fifo.h"
 #include "avl.h"
+#include "pool.h"
+#include "arbre_b.h"
 
 #include <assert.h>
 
 #include <search.h>
 #include <stdlib.h>
+#include <string.h>
 
+/*
+ * Une association ne contient que la clé et la valeur. Les fonctions de
+ * comparaison, de copie et de suppression des clés sont stockées une seule
+ * fois, dans la table, et l'arbre les retrouve grâce à son paramètre
+ * (avl_param), qui pointe sur la table.
+ */
 typedef struct Table_association {
-	void (*supprimer_cle)(intptr_t cle);
-	intptr_t (*copier_cle)(const intptr_t cle);
-	int (*comparer_cle)(const intptr_t cle1, const intptr_t cle2);
 	intptr_t cle;
 	intptr_t valeur;
 } Table_association ;
 
+/*
+ * Case d'une table de hachage. 
+ *
+ * Le champ 'distance' vaut 0 si la case est libre et, sinon, 1 + le nombre de
+ * cases qui séparent la case de la case idéale de la clé (celle donnée par son
+ * haché). Le haché est conservé pour ne pas le recalculer lors des 
+ * agrandissements et pour n'appeler la fonction de comparaison que sur les 
+ * clés qui ont le même haché.
+ */
+typedef struct Case_hachage {
+	intptr_t cle;
+	intptr_t valeur;
+	uint32_t hache;
+	uint32_t distance;
+} Case_hachage;
+
+/*
+ * Capacité initiale d'une table de hachage. La capacité est toujours une 
+ * puissance de 2.
+ */
+#define TABLE_CAPACITE_INITIALE 16
+
+/*
+ * La table de hachage est agrandie dès que plus de 
+ * TABLE_CHARGE_MAX_NUMERATEUR / TABLE_CHARGE_MAX_DENOMINATEUR de ses cases 
+ * sont occupées.
+ */
+#define TABLE_CHARGE_MAX_NUMERATEUR 7
+#define TABLE_CHARGE_MAX_DENOMINATEUR 8
+
+/*
+ * Une table est codée soit par un arbre AVL (TABLE_ARBRE), soit par une table 
+ * de hachage à adressage ouvert (TABLE_HACHAGE), gérée par la méthode 
+ * "Robin Hood" : lors d'une insertion, une clé prend la place de toute clé 
+ * plus proche qu'elle de sa case idéale, ce qui garde les chaînes de 
+ * recherche courtes.
+ *
+ * Une table peut aussi être codée par un B+-arbre (TABLE_ARBRE_B), qui 
+ * range lui-même les clés et les valeurs dans ses feuilles.
+ *
+ * Les noeuds de l'arbre et les associations d'une table sont alloués dans 
+ * deux pools propres à la table. Ainsi, vider_table() et liberer_table()
+ * rendent toute la mémoire de la table en quelques appels à xfree().
+ */
 struct Table {
+	Table_type type;
 	int (*comparer_cle)( const intptr_t cle1, const intptr_t cle2 );
 	intptr_t (*copier_cle)( const intptr_t cle );
 	void (*supprimer_cle)(intptr_t cle);
-	struct avl_table * root;
+	size_t (*hacher_cle)( const intptr_t cle );
+	union {
+		struct {
+			struct avl_table root;
+			Pool noeuds;
+			Pool associations;
+		};
+		struct {
+			Case_hachage* cases;
+			size_t capacite;
+			size_t nb_elements;
+		};
+		Arbre_b arbre_b;
+	};
 };
 
 
-intptr_t get_cle( Table_iterateur it ){
-	const Table_association * asso = ( const Table_association * ) avl_t_cur( &it );
-	return (const intptr_t) asso->cle;
-}
-
-intptr_t get_valeur( Table_iterateur it ){
-	Table_association * asso = ( Table_association * ) avl_t_cur( &it );
-	return asso->valeur;
-}
+/*
+ * Fonctions propres aux tables codées par des arbres.
+ */
 
 Table_association * creer_table_association(
-	const Table* table, const intptr_t cle, intptr_t valeur
+	Table* table, const intptr_t cle, intptr_t valeur
 ){
-	Table_association * res = xmalloc(
-		sizeof( Table_association )
-	);
+	Table_association * res = allouer_bloc( &table->associations );
 	if( table->copier_cle && cle ){
 		res->cle = table->copier_cle( cle );
 	}else{
 		res->cle = cle;
 	}
 	res->valeur = valeur;
-	res->supprimer_cle = table->supprimer_cle;
-	res->copier_cle = table->copier_cle;
-	res->comparer_cle = table->comparer_cle;
 	return res;
 }
 
-Table_association * copier_table_association( Table_association * asso ){
-	Table_association * res = xmalloc(
-		sizeof( Table_association )
+int compare_table_association( const void * pa1, const void * pb1, void* param ){
+	const Table_association * pa = (const Table_association *) pa1;
+	const Table_association * pb = (const Table_association *) pb1;
+	const Table * table = (const Table *) param;
+	return table->comparer_cle( pa->cle, pb->cle );
+}
+
+/*
+ * Comparaison utilisée lorsque la table n'a pas de fonction de comparaison :
+ * les clés sont alors comparées comme des entiers, sans appel indirect.
+ */
+static int compare_table_association_entiere(
+	const void * pa1, const void * pb1, void* param
+){
+	intptr_t a = ( (const Table_association *) pa1 )->cle;
+	intptr_t b = ( (const Table_association *) pb1 )->cle;
+	return ( a > b ) - ( a < b );
+}
+
+/*
+ * (Ré)initialise l'arbre de la table, avec la fonction de comparaison qui
+ * correspond aux clés de la table.
+ */
+static void initialiser_arbre( Table* table ){
+	avl_init(
+		&table->root, 
+		table->comparer_cle ? 
+			compare_table_association : compare_table_association_entiere,
+		table, &table->noeuds.allocateur
 	);
-	*res = *asso;
-	if( asso->copier_cle && asso->cle ){
-		res->cle = asso->copier_cle( asso->cle );
+}
+
+void supprimer_table_association( Table* table, Table_association * asso ){
+	if( table->supprimer_cle && asso->cle ){
+		table->supprimer_cle( asso->cle );
 	}
-	return res;
+	liberer_bloc( &table->associations, asso );
 }
 
-int compare_table_association( const void * pa1, const void * pb1, void* param ){
-	Table_association * pa = (Table_association *) pa1;
-	Table_association * pb = (Table_association *) pb1;
-	if( pa->comparer_cle ){
-		int r = pa->comparer_cle( pa->cle, pb->cle );
-		return r;
-	}else{
-		if( pa->cle < pb->cle )
-			return -1;
-		if( pa->cle > pb->cle )
-			return 1;
-		return 0;
+/*
+ * Initialise une association temporaire, sur la pile, qui sert de modèle
+ * pour chercher la clé 'cle' dans l'arbre. La clé n'est pas copiée : la
+ * fonction de comparaison travaille directement sur la clé de l'appelant.
+ */
+static void initialiser_association_de_recherche(
+	Table_association* asso, const intptr_t cle
+){
+	asso->cle = cle;
+	asso->valeur = (intptr_t) NULL;
+}
+
+/*
+ * Fonctions propres aux tables de hachage.
+ */
+
+/*
+ * Mélange les bits d'un haché (finaliseur de MurmurHash3), pour que les 
+ * fonctions de hachage simples, comme l'identité sur les entiers, répartissent
+ * bien les clés dans les cases.
+ */
+static uint32_t melanger_hache( uint64_t h ){
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+	return (uint32_t) h;
+}
+
+static uint32_t hacher( const Table* table, const intptr_t cle ){
+	if( table->hacher_cle ){
+		return melanger_hache( table->hacher_cle( cle ) );
 	}
+	return melanger_hache( (uint64_t) cle );
 }
 
+static int cles_egales( const Table* table, const intptr_t a, const intptr_t b ){
+	if( table->comparer_cle ){
+		return table->comparer_cle( a, b ) == 0;
+	}
+	return a == b;
+}
 
-void supprimer_table_association2( void* asso_tmp, void* data ){
-	Table_association * asso = (Table_association*) asso_tmp;
-	if( asso->supprimer_cle && asso->cle ){
-		asso->supprimer_cle( asso->cle );
+/*
+ * Renvoie l'indice de la case qui contient la clé, ou table->capacite si la
+ * clé n'est pas dans la table.
+ */
+static size_t chercher_case( const Table* table, const intptr_t cle ){
+	if( table->nb_elements == 0 ){
+		return table->capacite;
+	}
+	size_t masque = table->capacite - 1;
+	uint32_t hache = hacher( table, cle );
+	size_t i = hache & masque;
+	uint32_t distance = 1;
+	while( table->cases[i].distance >= distance ){
+		if(
+			table->cases[i].hache == hache && 
+			cles_egales( table, table->cases[i].cle, cle )
+		){
+			return i;
+		}
+		i = ( i + 1 ) & masque;
+		distance++;
+	}
+	return table->capacite;
+}
+
+/*
+ * Place une case, dont la clé n'est pas encore dans la table, en déplaçant
+ * les cases plus proches de leur case idéale. La table doit avoir une case
+ * libre.
+ */
+static void placer_case( Table* table, Case_hachage c ){
+	size_t masque = table->capacite - 1;
+	size_t i = c.hache & masque;
+	c.distance = 1;
+	while( table->cases[i].distance ){
+		if( table->cases[i].distance < c.distance ){
+			Case_hachage tmp = table->cases[i];
+			table->cases[i] = c;
+			c = tmp;
+		}
+		i = ( i + 1 ) & masque;
+		c.distance++;
+	}
+	table->cases[i] = c;
+}
+
+static void redimensionner_hachage( Table* table, size_t capacite ){
+	Case_hachage* anciennes = table->cases;
+	size_t ancienne_capacite = table->capacite;
+	table->cases = xmalloc( capacite * sizeof(Case_hachage) );
+	memset( table->cases, 0, capacite * sizeof(Case_hachage) );
+	table->capacite = capacite;
+	size_t i;
+	for( i=0; i<ancienne_capacite; i++ ){
+		if( anciennes[i].distance ){
+			placer_case( table, anciennes[i] );
+		}
+	}
+	xfree( anciennes );
+}
+
+/*
+ * Retire la case d'indice i, puis décale vers l'arrière les cases qui la
+ * suivent et qui ne sont pas dans leur case idéale.
+ */
+static void retirer_case( Table* table, size_t i ){
+	size_t masque = table->capacite - 1;
+	size_t j = ( i + 1 ) & masque;
+	while( table->cases[j].distance > 1 ){
+		table->cases[i] = table->cases[j];
+		table->cases[i].distance--;
+		i = j;
+		j = ( j + 1 ) & masque;
+	}
+	table->cases[i].distance = 0;
+	table->nb_elements--;
+}
+
+/*
+ * Renvoie l'indice de la première case occupée à partir de la case i, ou
+ * table->capacite s'il n'y en a pas.
+ */
+static size_t case_occupee_suivante( const Table* table, size_t i ){
+	while( i < table->capacite && ! table->cases[i].distance ){
+		i++;
+	}
+	return i;
+}
+
+/*
+ * Renvoie l'indice de la dernière case occupée avant la case i (non comprise),
+ * ou table->capacite s'il n'y en a pas.
+ */
+static size_t case_occupee_precedente( const Table* table, size_t i ){
+	while( i > 0 ){
+		i--;
+		if( table->cases[i].distance ){
+			return i;
+		}
+	}
+	return table->capacite;
+}
+
+/*
+ * Fonctions communes.
+ */
+
+intptr_t get_cle( Table_iterateur it ){
+	if( it.table->type == TABLE_HACHAGE ){
+		return it.table->cases[ it.position ].cle;
 	}
-	xfree(asso);
+	if( it.table->type == TABLE_ARBRE_B ){
+		return it.place.feuille->cles[ it.place.indice ];
+	}
+	const Table_association * asso = ( const Table_association * ) it.noeud->avl_data;
+	return (const intptr_t) asso->cle;
 }
 
-void supprimer_table_association( Table_association * asso ){
-	if( asso->supprimer_cle && asso->cle ){
-		asso->supprimer_cle( asso->cle );
+intptr_t get_valeur( Table_iterateur it ){
+	if( it.table->type == TABLE_HACHAGE ){
+		return it.table->cases[ it.position ].valeur;
+	}
+	if( it.table->type == TABLE_ARBRE_B ){
+		return it.place.feuille->valeurs[ it.place.indice ];
+	}
+	Table_association * asso = ( Table_association * ) it.noeud->avl_data;
+	return asso->valeur;
+}
+
+/*
+ * Supprime les clés de toutes les associations de la table. La mémoire des
+ * associations et des noeuds, elle, est rendue en bloc par vider_pool().
+ */
+static void supprimer_cles( Table* table ){
+	if( ! table->supprimer_cle ){
+		return;
+	}
+	if( table->type == TABLE_HACHAGE ){
+		size_t i;
+		for( i=0; i<table->capacite; i++ ){
+			if( table->cases[i].distance && table->cases[i].cle ){
+				table->supprimer_cle( table->cases[i].cle );
+			}
+		}
+		return;
+	}
+	struct avl_traverser traverser;
+	void * item;
+	avl_t_init( &traverser, &table->root );
+	while( (item = avl_t_next( &traverser )) ){
+		Table_association* asso = (Table_association *) item;
+		if( asso->cle ){
+			table->supprimer_cle( asso->cle );
+		}
 	}
-	xfree(asso);
 }
 
 Table* creer_table(
@@ -120,60 +371,378 @@ Table* creer_table(
 	void (*supprimer_cle)(intptr_t cle)
 ){
 	Table* res = xmalloc( sizeof(Table) );
-	res->root = avl_create ( compare_table_association, NULL, NULL );
+	res->type = TABLE_ARBRE;
+	initialiser_pool( &res->noeuds, sizeof(struct avl_node) );
+	initialiser_pool( &res->associations, sizeof(Table_association) );
+
+	res->supprimer_cle = supprimer_cle;
+	res->comparer_cle = comparer_cle;
+	res->copier_cle = copier_cle;
+	res->hacher_cle = NULL;
+	initialiser_arbre( res );
+	return res;
+}
+
+Table* creer_table_arbre_b(
+	int (*comparer_cle)( const intptr_t cle1, const intptr_t cle2 ),
+	intptr_t (*copier_cle)( const intptr_t cle ),
+	void (*supprimer_cle)(intptr_t cle)
+){
+	Table* res = xmalloc( sizeof(Table) );
+	res->type = TABLE_ARBRE_B;
+	res->supprimer_cle = supprimer_cle;
+	res->comparer_cle = comparer_cle;
+	res->copier_cle = copier_cle;
+	res->hacher_cle = NULL;
+	initialiser_arbre_b( &res->arbre_b, comparer_cle, copier_cle, supprimer_cle );
+	return res;
+}
 
+Table* creer_table_de_hachage(
+	int (*comparer_cle)( const intptr_t cle1, const intptr_t cle2 ),
+	intptr_t (*copier_cle)( const intptr_t cle ),
+	void (*supprimer_cle)(intptr_t cle),
+	size_t (*hacher_cle)( const intptr_t cle )
+){
+	if( comparer_cle && ! hacher_cle ){
+		ERREUR( "Une table de hachage dont les clés ne sont pas des entiers "
+			"doit avoir une fonction de hachage" );
+	}
+	Table* res = xmalloc( sizeof(Table) );
+	res->type = TABLE_HACHAGE;
 	res->supprimer_cle = supprimer_cle;
 	res->comparer_cle = comparer_cle;
 	res->copier_cle = copier_cle;
+	res->hacher_cle = hacher_cle;
+	res->cases = NULL;
+	res->capacite = 0;
+	res->nb_elements = 0;
+	return res;
+}
+
+typedef struct {
+	Table* copie;
+	intptr_t (*copier_valeur)( const intptr_t valeur );
+} data_copier_table_t;
+
+static intptr_t copier_valeur_table(
+	const data_copier_table_t* d, const intptr_t valeur
+){
+	return d->copier_valeur ? d->copier_valeur( valeur ) : valeur;
+}
+
+/*
+ * Fonction de copie passée à avl_copy_into() : l'association copiée est 
+ * allouée dans le pool de la table copie.
+ */
+static void* copier_association( void* item, void* param ){
+	const Table_association* asso = (const Table_association*) item;
+	const data_copier_table_t* d = (const data_copier_table_t*) param;
+	return creer_table_association(
+		d->copie, asso->cle, copier_valeur_table( d, asso->valeur )
+	);
+}
+
+Table* copier_table(
+	const Table* table, intptr_t (*copier_valeur)( const intptr_t valeur )
+){
+	Table* res;
+	data_copier_table_t data;
+	data.copier_valeur = copier_valeur;
+	if( table->type == TABLE_HACHAGE ){
+		res = creer_table_de_hachage(
+			table->comparer_cle, table->copier_cle, table->supprimer_cle,
+			table->hacher_cle
+		);
+		data.copie = res;
+		if( ! table->capacite ){
+			return res;
+		}
+		res->cases = xmalloc( table->capacite * sizeof(Case_hachage) );
+		memcpy( res->cases, table->cases, table->capacite * sizeof(Case_hachage) );
+		res->capacite = table->capacite;
+		res->nb_elements = table->nb_elements;
+		size_t i;
+		for( i=0; i<res->capacite; i++ ){
+			Case_hachage* c = &res->cases[i];
+			if( ! c->distance ){
+				continue;
+			}
+			if( res->copier_cle && c->cle ){
+				c->cle = res->copier_cle( c->cle );
+			}
+			c->valeur = copier_valeur_table( &data, c->valeur );
+		}
+		return res;
+	}
+	if( table->type == TABLE_ARBRE_B ){
+		res = creer_table_arbre_b(
+			table->comparer_cle, table->copier_cle, table->supprimer_cle
+		);
+		copier_arbre_b( &res->arbre_b, &table->arbre_b, copier_valeur );
+		return res;
+	}
+	res = creer_table( table->comparer_cle, table->copier_cle, table->supprimer_cle );
+	data.copie = res;
+	// La copie reproduit la forme de l'arbre, sans aucune comparaison.
+	avl_copy_into( &res->root, &table->root, copier_association, NULL, &data );
 	return res;
 }
 
+void remplir_table_triee(
+	Table* table, const intptr_t* cles, const intptr_t* valeurs, size_t nb
+){
+	assert( table_est_vide( table ) );
+	size_t i;
+	if( table->type == TABLE_HACHAGE ){
+		for( i=0; i<nb; i++ ){
+			add_table( table, cles[i], valeurs ? valeurs[i] : (intptr_t) NULL );
+		}
+		return;
+	}
+	if( table->type == TABLE_ARBRE_B ){
+		construire_arbre_b( &table->arbre_b, cles, valeurs, nb );
+		return;
+	}
+	if( nb == 0 ){
+		return;
+	}
+	// Les noeuds et les associations sont pris dans une seule dalle de chacun
+	// des pools.
+	reserver_pool( &table->noeuds, nb );
+	reserver_pool( &table->associations, nb );
+	void** associations = xmalloc( nb * sizeof(void*) );
+	for( i=0; i<nb; i++ ){
+		associations[i] = creer_table_association(
+			table, cles[i], valeurs ? valeurs[i] : (intptr_t) NULL
+		);
+	}
+	// Les clés étant triées, l'arbre est construit directement, sans 
+	// comparaison ni rééquilibrage.
+	if( ! avl_build( &table->root, associations, nb ) ){
+		ERREUR( "Espace insuffisant" );
+	}
+	xfree( associations );
+}
+
+static int comparer_associations_du_tableau(
+	const void* a, const void* b, void* table
+){
+	const Table* t = (const Table*) table;
+	intptr_t cle1 = ( (const Table_association*) a )->cle;
+	intptr_t cle2 = ( (const Table_association*) b )->cle;
+	if( t->comparer_cle ){
+		return t->comparer_cle( cle1, cle2 );
+	}
+	return ( cle1 > cle2 ) - ( cle1 < cle2 );
+}
+
+Table* creer_table_depuis_tableau(
+	int (*comparer_cle)( const intptr_t cle1, const intptr_t cle2 ),
+	intptr_t (*copier_cle)( const intptr_t cle ),
+	void (*supprimer_cle)(intptr_t cle),
+	const intptr_t* cles, const intptr_t* valeurs, size_t nb
+){
+	Table* res = creer_table( comparer_cle, copier_cle, supprimer_cle );
+	Table_association* paires = xmalloc( ( nb + 1 ) * sizeof(Table_association) );
+	size_t i;
+	for( i=0; i<nb; i++ ){
+		paires[i].cle = cles[i];
+		paires[i].valeur = valeurs ? valeurs[i] : (intptr_t) NULL;
+	}
+	// Le tri est stable : parmi des clés égales, la dernière du tableau est
+	// la dernière de sa série, et c'est elle qui est gardée, comme si les 
+	// associations avaient été ajoutées une à une par add_table().
+	trier_tableau( 
+		paires, nb, sizeof(Table_association), 
+		comparer_associations_du_tableau, res 
+	);
+	intptr_t* cles_triees = xmalloc( ( nb + 1 ) * sizeof(intptr_t) );
+	intptr_t* valeurs_triees = xmalloc( ( nb + 1 ) * sizeof(intptr_t) );
+	size_t taille = 0;
+	for( i=0; i<nb; i++ ){
+		if(
+			i + 1 < nb &&
+			comparer_associations_du_tableau( &paires[i], &paires[i+1], res ) == 0
+		){
+			continue;
+		}
+		cles_triees[taille] = paires[i].cle;
+		valeurs_triees[taille] = paires[i].valeur;
+		taille++;
+	}
+	remplir_table_triee( res, cles_triees, valeurs_triees, taille );
+	xfree( paires );
+	xfree( cles_triees );
+	xfree( valeurs_triees );
+	return res;
+}
+
+Table_type get_type_table( const Table* table ){
+	return table->type;
+}
+
 void liberer_table( Table* table ){
 	assert( table );
-	avl_destroy ( table->root, supprimer_table_association2 );
+	if( table->type == TABLE_ARBRE_B ){
+		vider_arbre_b( &table->arbre_b );
+		xfree( table );
+		return;
+	}
+	supprimer_cles( table );
+	if( table->type == TABLE_HACHAGE ){
+		xfree( table->cases );
+	}else{
+		vider_pool( &table->noeuds );
+		vider_pool( &table->associations );
+	}
 	xfree( table );
 }
 
+static void add_table_hachage( Table* table, const intptr_t cle, intptr_t valeur ){
+	size_t i = chercher_case( table, cle );
+	if( i != table->capacite ){
+		table->cases[i].valeur = valeur;
+		return;
+	}
+	if(
+		TABLE_CHARGE_MAX_DENOMINATEUR * ( table->nb_elements + 1 ) > 
+		TABLE_CHARGE_MAX_NUMERATEUR * table->capacite
+	){
+		redimensionner_hachage( 
+			table, 
+			table->capacite ? 2 * table->capacite : TABLE_CAPACITE_INITIALE
+		);
+	}
+	Case_hachage c;
+	if( table->copier_cle && cle ){
+		c.cle = table->copier_cle( cle );
+	}else{
+		c.cle = cle;
+	}
+	c.valeur = valeur;
+	c.hache = hacher( table, cle );
+	placer_case( table, c );
+	table->nb_elements++;
+}
+
 void add_table( Table* table, const intptr_t cle, intptr_t valeur ) {
-	Table_association* asso = creer_table_association(table, cle, valeur);
-	void* val = avl_probe ( table->root, (void*) asso );
+	if( table->type == TABLE_HACHAGE ){
+		add_table_hachage( table, cle, valeur );
+		return;
+	}
+	if( table->type == TABLE_ARBRE_B ){
+		ajouter_arbre_b( &table->arbre_b, cle, valeur );
+		return;
+	}
+	Table_association asso;
+	initialiser_association_de_recherche( &asso, cle );
+	void** val = avl_probe ( &table->root, &asso );
 	if( val == NULL ){
 		ERREUR( "Espace insuffisant" );
 	}
-	Table_association* asso_tree = *( Table_association** ) val; 
-	if( asso_tree != asso  ){
-		supprimer_table_association( asso );
-		asso_tree->valeur = valeur;
+	if( *val == &asso ){
+		// La clé est nouvelle : l'association temporaire est remplacée, dans
+		// l'arbre, par une association qui possède sa propre copie de la clé.
+		*val = creer_table_association( table, cle, valeur );
+	}else{
+		( (Table_association*) *val )->valeur = valeur;
 	}
 }
 
 intptr_t delete_table( Table* table, intptr_t cle ){
-	intptr_t valeur = (intptr_t) NULL;
-	Table_association* asso_tree = NULL;
-	Table_association* asso = creer_table_association(
-		table, cle, (intptr_t) NULL
-	);
-	void* val = avl_find( table->root, (void*) asso );
-	if( val ){
-		asso_tree = ( Table_association* ) val; 
-		valeur = asso_tree->valeur;
+	if( table->type == TABLE_HACHAGE ){
+		size_t i = chercher_case( table, cle );
+		if( i == table->capacite ){
+			return (intptr_t) NULL;
+		}
+		intptr_t valeur = table->cases[i].valeur;
+		if( table->supprimer_cle && table->cases[i].cle ){
+			table->supprimer_cle( table->cases[i].cle );
+		}
+		retirer_case( table, i );
+		return valeur;
+	}
+	if( table->type == TABLE_ARBRE_B ){
+		intptr_t valeur = (intptr_t) NULL;
+		retirer_arbre_b( &table->arbre_b, cle, &valeur );
+		return valeur;
 	}
-	avl_delete( table->root, (void*) asso );
-	if(asso_tree){
-		supprimer_table_association( asso_tree );
+	Table_association asso;
+	initialiser_association_de_recherche( &asso, cle );
+	Table_association* asso_tree = avl_delete( &table->root, &asso );
+	if( ! asso_tree ){
+		return (intptr_t) NULL;
 	}
-	supprimer_table_association( asso );
+	intptr_t valeur = asso_tree->valeur;
+	supprimer_table_association( table, asso_tree );
 	return valeur;
 }
 
+int chercher_table( const Table* table, const intptr_t cle, intptr_t* valeur ){
+	if( table->type == TABLE_HACHAGE ){
+		size_t i = chercher_case( table, cle );
+		if( i == table->capacite ){
+			return 0;
+		}
+		if( valeur ){
+			*valeur = table->cases[i].valeur;
+		}
+		return 1;
+	}
+	if( table->type == TABLE_ARBRE_B ){
+		Arbre_b_position place = trouver_arbre_b( &table->arbre_b, cle );
+		if( ! place.feuille ){
+			return 0;
+		}
+		if( valeur ){
+			*valeur = place.feuille->valeurs[ place.indice ];
+		}
+		return 1;
+	}
+	Table_association asso;
+	initialiser_association_de_recherche( &asso, cle );
+	Table_association* asso_tree = avl_find( &table->root, &asso );
+	if( ! asso_tree ){
+		return 0;
+	}
+	if( valeur ){
+		*valeur = asso_tree->valeur;
+	}
+	return 1;
+}
+
 void pour_toute_cle_valeur_table(
 	const Table* table,
 	void (* action)( const intptr_t cle, intptr_t valeur, void* data  ),
 	void* data
 ){
+	if( table->type == TABLE_HACHAGE ){
+		size_t i;
+		for( i=0; i<table->capacite; i++ ){
+			if( table->cases[i].distance ){
+				action( table->cases[i].cle, table->cases[i].valeur, data );
+			}
+		}
+		return;
+	}
+	if( table->type == TABLE_ARBRE_B ){
+		// Les feuilles sont lues dans l'ordre, sans remonter dans l'arbre.
+		const Arbre_b_feuille* feuille;
+		unsigned int i;
+		for(
+			feuille = table->arbre_b.premiere; feuille; 
+			feuille = feuille->suivante
+		){
+			for( i=0; i<feuille->nb; i++ ){
+				action( feuille->cles[i], feuille->valeurs[i], data );
+			}
+		}
+		return;
+	}
 	struct avl_traverser traverser;
 	void * item;
-	avl_t_init( &traverser, table->root );
+	avl_t_init( &traverser, (struct avl_table*) &table->root );
 	while( (item = avl_t_next( &traverser )) ){
 		Table_association* asso = (Table_association *) item;
 		action( asso->cle, asso->valeur, data );
@@ -199,8 +768,21 @@ void pour_toute_valeur_table(
 }
 
 void vider_table( Table* table ){
-	avl_destroy ( table->root, supprimer_table_association2 );
-	table->root = avl_create ( compare_table_association, NULL, NULL );
+	if( table->type == TABLE_ARBRE_B ){
+		vider_arbre_b( &table->arbre_b );
+		return;
+	}
+	supprimer_cles( table );
+	if( table->type == TABLE_HACHAGE ){
+		xfree( table->cases );
+		table->cases = NULL;
+		table->capacite = 0;
+		table->nb_elements = 0;
+		return;
+	}
+	vider_pool( &table->noeuds );
+	vider_pool( &table->associations );
+	initialiser_arbre( table );
 }
 
 typedef struct {
@@ -238,19 +820,82 @@ void print_table(
 	printf( " }%s", texte_de_fin );
 }
 
+/*
+ * Reconstruit le parcours de l'arbre correspondant à l'itérateur. Le parcours
+ * ne contient que l'arbre et le noeud courant : les noeuds connaissant leur
+ * parent, il n'y a pas de pile à reconstituer.
+ */
+static struct avl_traverser traverser_de_l_iterateur( Table_iterateur it ){
+	struct avl_traverser traverser = {
+		(struct avl_table*) &it.table->root, it.noeud
+	};
+	return traverser;
+}
+
 Table_iterateur trouver_table( const Table* table, intptr_t cle ){
 	Table_iterateur it;
-	Table_association* asso = creer_table_association(
-		table, cle, (intptr_t) NULL
-	);
-	avl_t_find( &it, table->root, (void*) asso );
-	supprimer_table_association( asso );
+	it.table = table;
+	if( table->type == TABLE_HACHAGE ){
+		it.position = chercher_case( table, cle );
+		return it;
+	}
+	if( table->type == TABLE_ARBRE_B ){
+		it.place = trouver_arbre_b( &table->arbre_b, cle );
+		return it;
+	}
+	Table_association asso;
+	initialiser_association_de_recherche( &asso, cle );
+	struct avl_traverser traverser;
+	avl_t_find( &traverser, (struct avl_table*) &table->root, &asso );
+	it.noeud = traverser.avl_node;
 	return it;
 }
 
+Table_iterateur ieme_iterateur_table( const Table* table, size_t rang ){
+	Table_iterateur it;
+	it.table = table;
+	if( table->type == TABLE_HACHAGE ){
+		it.position = case_occupee_suivante( table, 0 );
+		while( rang > 0 && it.position < table->capacite ){
+			it.position = case_occupee_suivante( table, it.position + 1 );
+			rang--;
+		}
+		return it;
+	}
+	if( table->type == TABLE_ARBRE_B ){
+		it.place = ieme_position_arbre_b( &table->arbre_b, rang );
+		return it;
+	}
+	struct avl_traverser traverser;
+	avl_t_select( &traverser, (struct avl_table*) &table->root, rang );
+	it.noeud = traverser.avl_node;
+	return it;
+}
+
+size_t rang_table( const Table* table, const intptr_t cle ){
+	assert( table->type != TABLE_HACHAGE );
+	if( table->type == TABLE_ARBRE_B ){
+		return rang_arbre_b( &table->arbre_b, cle );
+	}
+	Table_association asso;
+	initialiser_association_de_recherche( &asso, cle );
+	return avl_rank( &table->root, &asso );
+}
+
 Table_iterateur premier_iterateur_table( const Table* table ){
 	Table_iterateur it;
-	avl_t_first( &it, table->root );
+	it.table = table;
+	if( table->type == TABLE_HACHAGE ){
+		it.position = case_occupee_suivante( table, 0 );
+		return it;
+	}
+	if( table->type == TABLE_ARBRE_B ){
+		it.place = premiere_position_arbre_b( &table->arbre_b );
+		return it;
+	}
+	struct avl_traverser traverser;
+	avl_t_first( &traverser, (struct avl_table*) &table->root );
+	it.noeud = traverser.avl_node;
 	return it;
 }
 
@@ -258,33 +903,82 @@ Table_iterateur dernier_iterateur_table(
 	const Table_iterateur * iterator, Table* table 
 ){
 	Table_iterateur it;
-	avl_t_last( &it, table->root );
+	it.table = table;
+	if( table->type == TABLE_HACHAGE ){
+		it.position = case_occupee_precedente( table, table->capacite );
+		return it;
+	}
+	if( table->type == TABLE_ARBRE_B ){
+		it.place = derniere_position_arbre_b( &table->arbre_b );
+		return it;
+	}
+	struct avl_traverser traverser;
+	avl_t_last( &traverser, &table->root );
+	it.noeud = traverser.avl_node;
 	return it;
 }
 
 int iterateur_est_vide( Table_iterateur iterator ){
-	return avl_t_is_null( &iterator );	
+	if( iterator.table->type == TABLE_HACHAGE ){
+		return iterator.position == iterator.table->capacite;
+	}
+	if( iterator.table->type == TABLE_ARBRE_B ){
+		return iterator.place.feuille == NULL;
+	}
+	return iterator.noeud == NULL;
 }
 
 Table_iterateur iterateur_suivant_table( Table_iterateur iterateur ){
-	avl_t_next( &iterateur );
+	if( iterateur.table->type == TABLE_HACHAGE ){
+		// Comme pour les arbres, le suivant de l'itérateur vide est le premier
+		// itérateur.
+		size_t debut = 
+			( iterateur.position == iterateur.table->capacite ) ? 
+			0 : iterateur.position + 1;
+		iterateur.position = case_occupee_suivante( iterateur.table, debut );
+		return iterateur;
+	}
+	if( iterateur.table->type == TABLE_ARBRE_B ){
+		iterateur.place = position_suivante_arbre_b( 
+			&iterateur.table->arbre_b, iterateur.place 
+		);
+		return iterateur;
+	}
+	struct avl_traverser traverser = traverser_de_l_iterateur( iterateur );
+	avl_t_next( &traverser );
+	iterateur.noeud = traverser.avl_node;
 	return iterateur;
 }
 
 Table_iterateur iterateur_precedent_table( Table_iterateur iterateur ){
-	avl_t_prev( &iterateur );
+	if( iterateur.table->type == TABLE_HACHAGE ){
+		iterateur.position = case_occupee_precedente(
+			iterateur.table, iterateur.position
+		);
+		return iterateur;
+	}
+	if( iterateur.table->type == TABLE_ARBRE_B ){
+		iterateur.place = position_precedente_arbre_b( 
+			&iterateur.table->arbre_b, iterateur.place 
+		);
+		return iterateur;
+	}
+	struct avl_traverser traverser = traverser_de_l_iterateur( iterateur );
+	avl_t_prev( &traverser );
+	iterateur.noeud = traverser.avl_node;
 	return iterateur;
 }
 
-int taille_table( Table* t ){
-	int res = 0;
-	Table_iterateur it1;
-	for(
-		it1 = premier_iterateur_table( t );
-		! iterateur_est_vide( it1 );
-		it1 = iterateur_suivant_table( it1 )
-	){
-		res += 1;
+int taille_table( const Table* t ){
+	if( t->type == TABLE_HACHAGE ){
+		return t->nb_elements;
 	}
-	return res;
-};
+	if( t->type == TABLE_ARBRE_B ){
+		return t->arbre_b.nb_elements;
+	}
+	return avl_count( &t->root );
+}
+
+int table_est_vide( const Table* t ){
+	return taille_table( t ) == 0;
+}
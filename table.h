@@ -23,8 +23,10 @@
 #ifndef __TABLE_H__
 #define __TABLE_H__
 
+#include <stddef.h>
 #include <stdint.h>
 #include "avl.h"
+#include "arbre_b.h"
 
 /**
  * @brief Définit le type d'une table.
@@ -36,10 +38,41 @@
  */
 typedef struct Table Table;
 
+/**
+ * @brief Définit la manière dont une table est codée.
+ *
+ * TABLE_ARBRE : la table est un arbre AVL. Les associations sont parcourues
+ * dans l'ordre croissant des clés.
+ *
+ * TABLE_HACHAGE : la table est une table de hachage à adressage ouvert. 
+ * Les recherches sont plus rapides, mais les associations sont parcourues 
+ * dans un ordre quelconque.
+ *
+ * TABLE_ARBRE_B : la table est un B+-arbre (voir arbre_b.h). Comme pour 
+ * TABLE_ARBRE, les associations sont parcourues dans l'ordre croissant des 
+ * clés, mais chaque noeud contient plusieurs clés, rangées côte à côte : une 
+ * recherche visite beaucoup moins de lignes de cache, et un parcours dans 
+ * l'ordre lit les feuilles les unes après les autres.
+ */
+typedef enum { TABLE_ARBRE, TABLE_HACHAGE, TABLE_ARBRE_B } Table_type;
+
 /**
  * @brief Définit le type d'un itérateur sur les éléments d'une table.
+ *
+ * Les champs de l'itérateur ne doivent pas être utilisés directement.
+ * L'itérateur tient en trois mots et se copie donc à très faible coût : les
+ * noeuds de l'arbre AVL connaissant leur parent, et les feuilles du B+-arbre
+ * étant chaînées, la position courante suffit pour passer au suivant ou au 
+ * précédent.
  */
-typedef struct avl_traverser Table_iterateur;
+typedef struct {
+	const Table* table;
+	union {
+		size_t position;          // TABLE_HACHAGE : indice de la case.
+		struct avl_node* noeud;   // TABLE_ARBRE : noeud courant, ou NULL.
+		Arbre_b_position place;   // TABLE_ARBRE_B : feuille et indice.
+	};
+} Table_iterateur;
 
 /**
  * @brief Renvoie une nouvelle table.
@@ -149,6 +182,108 @@ Table* creer_table(
 	void (*supprimer_cle)(intptr_t cle)
 );
 
+/**
+ * @brief Renvoie une nouvelle table codée par une table de hachage.
+ *
+ * Les paramètres 'comparer_cle', 'copier_cle' et 'supprimer_cle' ont le même
+ * rôle que pour creer_table(), mais la fonction de comparaison ne sert qu'à
+ * tester l'égalité de deux clés. 
+ * La fonction 'hacher_cle' doit renvoyer la même valeur pour deux clés égales.
+ * Si les clés sont des entiers, tous les paramètres peuvent être mis à NULL.
+ *
+ * Une table de hachage offre les mêmes fonctions qu'une table codée par un
+ * arbre, mais ses itérateurs parcourent les associations dans un ordre 
+ * quelconque. Il faut donc utiliser creer_table() dès que l'ordre des clés
+ * est nécessaire.
+ */
+Table* creer_table_de_hachage(
+	int (*comparer_cle)( const intptr_t cle1, const intptr_t cle2),
+	intptr_t (*copier_cle)( const intptr_t cle ),
+	void (*supprimer_cle)(intptr_t cle),
+	size_t (*hacher_cle)( const intptr_t cle )
+);
+
+/**
+ * @brief Renvoie une nouvelle table codée par un B+-arbre.
+ *
+ * Les paramètres ont le même rôle que pour creer_table(), et la table offre
+ * les mêmes fonctions, avec les mêmes complexités, qu'une table codée par un
+ * arbre AVL. Les clés des noeuds internes du B+-arbre sont des copies de 
+ * clés, faites par 'copier_cle'.
+ *
+ * Les associations étant rangées dans des tableaux, les recherches et les 
+ * parcours touchent bien moins de lignes de cache qu'avec un arbre AVL. En
+ * contrepartie, un ajout ou une suppression invalide les itérateurs de la
+ * table.
+ */
+Table* creer_table_arbre_b(
+	int (*comparer_cle)( const intptr_t cle1, const intptr_t cle2),
+	intptr_t (*copier_cle)( const intptr_t cle ),
+	void (*supprimer_cle)(intptr_t cle)
+);
+
+/**
+ * @brief
+ * Renvoie une copie de la table, codée de la même manière et avec les mêmes
+ * fonctions de comparaison, de copie, de suppression et de hachage des clés.
+ *
+ * Les clés sont copiées par la fonction de copie des clés de la table.
+ * Si 'copier_valeur' n'est pas NULL, chaque valeur de la copie est le 
+ * résultat de 'copier_valeur' sur la valeur correspondante ; sinon, les 
+ * valeurs sont recopiées telles quelles.
+ *
+ * La copie se fait en temps linéaire : la structure de la table (arbre ou 
+ * cases de la table de hachage) est dupliquée directement, sans réinsérer les
+ * associations une à une.
+ */
+Table* copier_table(
+	const Table* table, intptr_t (*copier_valeur)( const intptr_t valeur )
+);
+
+/**
+ * @brief
+ * Remplit une table vide avec les 'nb' associations cles[i] --> valeurs[i].
+ * Si 'valeurs' vaut NULL, toutes les valeurs sont NULL.
+ *
+ * Les clés doivent être deux à deux distinctes et triées dans l'ordre 
+ * croissant, pour la fonction de comparaison des clés de la table. 
+ * Elles sont copiées, comme par add_table().
+ *
+ * Pour une table codée par un arbre (AVL ou B+-arbre), l'arbre est construit
+ * directement, parfaitement équilibré, en temps linéaire.
+ */
+void remplir_table_triee(
+	Table* table, const intptr_t* cles, const intptr_t* valeurs, size_t nb
+);
+
+/**
+ * @brief
+ * Renvoie une nouvelle table, codée par un arbre, qui contient les 'nb' 
+ * associations cles[i] --> valeurs[i]. Si 'valeurs' vaut NULL, toutes les 
+ * valeurs sont NULL.
+ *
+ * Les fonctions 'comparer_cle', 'copier_cle' et 'supprimer_cle' sont celles 
+ * de creer_table(). Les clés n'ont pas besoin d'être triées. Si une clé 
+ * apparaît plusieurs fois, c'est la dernière valeur qui lui est associée, 
+ * comme avec des appels successifs à add_table().
+ *
+ * L'arbre est construit directement, parfaitement équilibré, avec tous ses 
+ * noeuds dans un même bloc mémoire. Si les clés sont déjà triées, la 
+ * construction se fait en temps linéaire.
+ */
+Table* creer_table_depuis_tableau(
+	int (*comparer_cle)( const intptr_t cle1, const intptr_t cle2),
+	intptr_t (*copier_cle)( const intptr_t cle ),
+	void (*supprimer_cle)(intptr_t cle),
+	const intptr_t* cles, const intptr_t* valeurs, size_t nb
+);
+
+/**
+ * @brief
+ * Renvoie la manière dont la table est codée.
+ */
+Table_type get_type_table( const Table* table );
+
 /**
  * @brief
  * Cette fonction détruit une table. La mémoire qui a été allouée par la table 
@@ -248,6 +383,21 @@ void pour_toute_cle_valeur_table(
 	void* data
 );
 
+/**
+ * @brief
+ * Cherche l'association dont la clé est identique (pour la fonction de 
+ * comparaison de clé de la table) à la clé passée en paramètre.
+ *
+ * Renvoie 1 si la clé est dans la table, et 0 sinon. Si la clé est trouvée 
+ * et que 'valeur' n'est pas NULL, la valeur associée à la clé est écrite dans
+ * '*valeur'.
+ *
+ * Contrairement à trouver_table(), cette fonction ne construit pas 
+ * d'itérateur. Ni la recherche, ni trouver_table() n'allouent de mémoire : la
+ * clé passée en paramètre est comparée directement aux clés de la table.
+ */
+int chercher_table( const Table* table, const intptr_t cle, intptr_t* valeur );
+
 /**
  * @brief
  * Renvoie un itérateur positionné sur l'association dont la clé est identique 
@@ -256,6 +406,27 @@ void pour_toute_cle_valeur_table(
  */
 Table_iterateur trouver_table( const Table* table, const intptr_t cle );
 
+/**
+ * @brief
+ * Renvoie un itérateur positionné sur l'association de rang 'rang', 
+ * c'est-à-dire précédée de 'rang' associations, ou l'itérateur vide si la 
+ * table a au plus 'rang' associations.
+ * Pour une table codée par un arbre (AVL ou B+-arbre), l'association est 
+ * trouvée en temps logarithmique, grâce à la taille des sous-arbres 
+ * conservée dans chaque noeud. Pour une table de hachage, le rang est 
+ * celui de l'ordre (quelconque) du parcours, et la recherche se fait en 
+ * temps linéaire.
+ */
+Table_iterateur ieme_iterateur_table( const Table* table, size_t rang );
+
+/**
+ * @brief
+ * Renvoie le nombre de clés de la table strictement plus petites que 'cle',
+ * qui n'a pas besoin d'être dans la table, en temps logarithmique.
+ * La table doit être codée par un arbre (AVL ou B+-arbre).
+ */
+size_t rang_table( const Table* table, const intptr_t cle );
+
 /**
  * @brief
  * Renvoie un itérateur positionné sur la première association de la table.
@@ -318,8 +489,14 @@ intptr_t get_valeur( Table_iterateur it );
 
 /**
  * @brief
- * Renvoie la taille de la table.
+ * Renvoie la taille de la table, en temps constant.
+ */
+int taille_table( const Table* t );
+
+/**
+ * @brief
+ * Renvoie 1 si la table ne contient aucune association, et 0 sinon.
  */
-int taille_table( Table* t );
+int table_est_vide( const Table* t );
 
 #endif
@@ -0,0 +1,23 @@
+tests/test_arbre_b: tests/test_arbre_b.o libautomate.a
+tests/test_automate_accessible: tests/test_automate_accessible.o libautomate.a
+tests/test_automate_compact: tests/test_automate_compact.o libautomate.a
+tests/test_automate_compile: tests/test_automate_compile.o libautomate.a
+tests/test_automate_du_melange: tests/test_automate_du_melange.o libautomate.a
+tests/test_automate_vide: tests/test_automate_vide.o libautomate.a
+tests/test_bitset: tests/test_bitset.o libautomate.a
+tests/test_conteneurs: tests/test_conteneurs.o libautomate.a
+tests/test_copier_automate: tests/test_copier_automate.o libautomate.a
+tests/test_creer_automate: tests/test_creer_automate.o libautomate.a
+tests/test_delta_delta_star: tests/test_delta_delta_star.o libautomate.a
+tests/test_ensemble: tests/test_ensemble.o libautomate.a
+tests/test_fifo: tests/test_fifo.o libautomate.a
+tests/test_file_mpmc: tests/test_file_mpmc.o libautomate.a
+tests/test_get_max_etat: tests/test_get_max_etat.o libautomate.a
+tests/test_miroir: tests/test_miroir.o libautomate.a
+tests/test_outils: tests/test_outils.o libautomate.a
+tests/test_pool: tests/test_pool.o libautomate.a
+tests/test_registre: tests/test_registre.o libautomate.a
+tests/test_roaring: tests/test_roaring.o libautomate.a
+tests/test_table: tests/test_table.o libautomate.a
+tests/test_translater_etat: tests/test_translater_etat.o libautomate.a
+
@@ -0,0 +1,39 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Générateur pseudo-aléatoire partagé par les tests et les mesures de 
+ * performance : un xorshift 64 bits, reproductible d'une machine à l'autre.
+ * La graine ne doit pas être nulle.
+ */
+
+#ifndef __ALEATOIRE_H__
+#define __ALEATOIRE_H__
+
+#include <stdint.h>
+
+static inline uint64_t aleatoire( uint64_t* graine ){
+	*graine ^= *graine << 13;
+	*graine ^= *graine >> 7;
+	*graine ^= *graine << 17;
+	return *graine;
+}
+
+#endif
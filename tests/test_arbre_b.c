@@ -0,0 +1,279 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "arbre_b.h"
+#include "outils.h"
+#include "tests/aleatoire.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// Les clés testées sont dans [ -DECALAGE, TAILLE - DECALAGE [.
+#define TAILLE 4000
+#define DECALAGE 1000
+
+// Clés allouées, pour vérifier que l'arbre copie et supprime ses clés.
+static int comparer_cle( const intptr_t a, const intptr_t b ){
+	return *(const int*) a - *(const int*) b;
+}
+
+static intptr_t copier_cle( const intptr_t cle ){
+	int* res = xmalloc( sizeof(int) );
+	*res = *(const int*) cle;
+	return (intptr_t) res;
+}
+
+static void supprimer_cle( intptr_t cle ){
+	xfree( (int*) cle );
+}
+
+static int valeur_de_cle( const Arbre_b* arbre, intptr_t cle ){
+	return arbre->comparer ? *(const int*) cle : (int) cle;
+}
+
+/*
+ * Vérifie récursivement les invariants du sous-arbre : clés dans
+ * [ *min, *max [, noeuds au moins à moitié pleins (sauf la racine) et
+ * tailles des fils exactes. Renvoie la taille du sous-arbre, ou -1.
+ */
+static long verifier_sous_arbre(
+	const Arbre_b* arbre, const void* sous_arbre, unsigned int hauteur,
+	const int* min, const int* max, int est_racine
+){
+	unsigned int i;
+	if( hauteur == 0 ){
+		const Arbre_b_feuille* feuille = sous_arbre;
+		if( feuille->nb > ARBRE_B_ORDRE ) return -1;
+		if( ! est_racine && feuille->nb < ARBRE_B_ORDRE/2 ) return -1;
+		for( i=0; i<feuille->nb; i++ ){
+			int c = valeur_de_cle( arbre, feuille->cles[i] );
+			if( i > 0 && valeur_de_cle( arbre, feuille->cles[i-1] ) >= c )
+				return -1;
+			if( ( min && c < *min ) || ( max && c >= *max ) ) return -1;
+		}
+		return feuille->nb;
+	}
+	const Arbre_b_noeud* noeud = sous_arbre;
+	if( noeud->nb > ARBRE_B_ORDRE - 1 || noeud->nb == 0 ) return -1;
+	if( ! est_racine && noeud->nb < ARBRE_B_ORDRE/2 - 1 ) return -1;
+	long total = 0;
+	for( i=0; i<=noeud->nb; i++ ){
+		int bas, haut;
+		if( i > 0 ) bas = valeur_de_cle( arbre, noeud->cles[i-1] );
+		if( i < noeud->nb ) haut = valeur_de_cle( arbre, noeud->cles[i] );
+		long taille = verifier_sous_arbre(
+			arbre, noeud->fils[i], hauteur - 1,
+			i > 0 ? &bas : min, i < noeud->nb ? &haut : max, 0
+		);
+		if( taille < 0 || (size_t) taille != noeud->tailles[i] ) return -1;
+		total += taille;
+	}
+	return total;
+}
+
+/*
+ * Vérifie que l'arbre contient exactement les clés c telles que
+ * ref[ c + DECALAGE ] est non nul, associées à la valeur 2 * c, et que
+ * le chaînage des feuilles, les positions, les rangs et les tailles sont
+ * cohérents.
+ */
+static int est_conforme( const Arbre_b* arbre, const char* ref ){
+	size_t nb = 0, i;
+	int c;
+	for( i=0; i<TAILLE; i++ ) nb += ref[i] != 0;
+	if( arbre->nb_elements != nb ) return 0;
+	if( nb == 0 ){
+		return arbre->racine == NULL
+			&& premiere_position_arbre_b( arbre ).feuille == NULL
+			&& derniere_position_arbre_b( arbre ).feuille == NULL;
+	}
+	if(
+		verifier_sous_arbre( arbre, arbre->racine, arbre->hauteur, NULL, NULL, 1 )
+		!= (long) nb
+	) return 0;
+
+	// Parcours croissant, avec rang et sélection.
+	Arbre_b_position pos = premiere_position_arbre_b( arbre );
+	size_t rang = 0;
+	for( c = -DECALAGE; c < TAILLE - DECALAGE; c++ ){
+		if( ! ref[ c + DECALAGE ] ) continue;
+		if( pos.feuille == NULL ) return 0;
+		intptr_t cle = pos.feuille->cles[ pos.indice ];
+		if( valeur_de_cle( arbre, cle ) != c ) return 0;
+		if( pos.feuille->valeurs[ pos.indice ] != 2 * c ) return 0;
+		if( rang_arbre_b( arbre, cle ) != rang ) return 0;
+		Arbre_b_position ieme = ieme_position_arbre_b( arbre, rang );
+		if( ieme.feuille != pos.feuille || ieme.indice != pos.indice ) return 0;
+		pos = position_suivante_arbre_b( arbre, pos );
+		rang++;
+	}
+	if( pos.feuille != NULL ) return 0;
+	if( ieme_position_arbre_b( arbre, nb ).feuille != NULL ) return 0;
+
+	// Parcours décroissant.
+	pos = derniere_position_arbre_b( arbre );
+	for( c = TAILLE - DECALAGE - 1; c >= -DECALAGE; c-- ){
+		if( ! ref[ c + DECALAGE ] ) continue;
+		if( pos.feuille == NULL ) return 0;
+		if( valeur_de_cle( arbre, pos.feuille->cles[ pos.indice ] ) != c )
+			return 0;
+		pos = position_precedente_arbre_b( arbre, pos );
+	}
+	if( pos.feuille != NULL ) return 0;
+	return 1;
+}
+
+static intptr_t cle_de( const Arbre_b* arbre, int* tampon, int c ){
+	if( ! arbre->comparer ) return c;
+	*tampon = c;
+	return (intptr_t) tampon;
+}
+
+/*
+ * Ajoute et retire des clés au hasard, en comparant l'arbre au tableau
+ * de présence 'ref'. Les retraits massifs provoquent les emprunts et les fusions.
+ */
+static int tester_ajouts_et_retraits(
+	Arbre_b* arbre, char* ref, uint64_t graine
+){
+	int result = 1;
+	int tampon, i, tour;
+
+	for( tour = 0; tour < 4; tour++ ){
+		for( i=0; i<3*TAILLE; i++ ){
+			int c = (int)( aleatoire( &graine ) % TAILLE ) - DECALAGE;
+			intptr_t cle = cle_de( arbre, &tampon, c );
+			int nouvelle = ajouter_arbre_b( arbre, cle, 2 * c );
+			TEST( nouvelle == ! ref[ c + DECALAGE ], result );
+			ref[ c + DECALAGE ] = 1;
+		}
+		TEST( est_conforme( arbre, ref ), result );
+
+		// Au dernier tour, on vide complètement l'arbre.
+		int proportion = tour == 3 ? 1 : 4 - tour;
+		for( i=0; i<TAILLE; i++ ){
+			if( tour < 3 && aleatoire( &graine ) % proportion ) continue;
+			int c = i - DECALAGE;
+			intptr_t valeur = -1;
+			int present = retirer_arbre_b(
+				arbre, cle_de( arbre, &tampon, c ), &valeur
+			);
+			TEST( present == ref[i], result );
+			TEST( ! present || valeur == 2 * c, result );
+			Arbre_b_position pos = trouver_arbre_b(
+				arbre, cle_de( arbre, &tampon, c )
+			);
+			TEST( pos.feuille == NULL, result );
+			ref[i] = 0;
+		}
+		TEST( est_conforme( arbre, ref ), result );
+	}
+	return result;
+}
+
+int test_ajouter_retirer(){
+	int result = 1;
+	char ref[TAILLE];
+	Arbre_b arbre;
+
+	memset( ref, 0, TAILLE );
+	initialiser_arbre_b( &arbre, NULL, NULL, NULL );
+	result &= tester_ajouts_et_retraits( &arbre, ref, 88172645463325252ull );
+	vider_arbre_b( &arbre );
+
+	initialiser_arbre_b( &arbre, comparer_cle, copier_cle, supprimer_cle );
+	result &= tester_ajouts_et_retraits( &arbre, ref, 1234567ull );
+	vider_arbre_b( &arbre );
+
+	// Remplacement de la valeur d'une clé présente.
+	initialiser_arbre_b( &arbre, NULL, NULL, NULL );
+	int nouvelle = ajouter_arbre_b( &arbre, 3, 1 );
+	TEST( nouvelle, result );
+	nouvelle = ajouter_arbre_b( &arbre, 3, 2 );
+	TEST( ! nouvelle, result );
+	Arbre_b_position pos = trouver_arbre_b( &arbre, 3 );
+	TEST( pos.feuille && pos.feuille->valeurs[ pos.indice ] == 2, result );
+	TEST( arbre.nb_elements == 1, result );
+	vider_arbre_b( &arbre );
+	return result;
+}
+
+int test_construire_copier(){
+	int result = 1;
+	char ref[TAILLE];
+	intptr_t cles[TAILLE], valeurs[TAILLE];
+	int entiers[TAILLE];
+	uint64_t graine = 42;
+	size_t nb = 0, i;
+	Arbre_b arbre, copie;
+
+	memset( ref, 0, TAILLE );
+	for( i=0; i<TAILLE; i++ ){
+		if( aleatoire( &graine ) % 3 ) continue;
+		int c = (int) i - DECALAGE;
+		ref[i] = 1;
+		entiers[nb] = c;
+		cles[nb] = (intptr_t) &entiers[nb];
+		valeurs[nb] = 2 * c;
+		nb++;
+	}
+
+	// Toutes les tailles jusqu'à quelques niveaux, pour les cas limites
+	// de la répartition des fils.
+	for( size_t n = 0; n <= 300; n++ ){
+		char petite_ref[TAILLE];
+		memset( petite_ref, 0, TAILLE );
+		for( i=0; i<n; i++ ) petite_ref[ entiers[i] + DECALAGE ] = 1;
+		initialiser_arbre_b( &arbre, comparer_cle, copier_cle, supprimer_cle );
+		construire_arbre_b( &arbre, cles, valeurs, n );
+		TEST( est_conforme( &arbre, petite_ref ), result );
+		vider_arbre_b( &arbre );
+	}
+
+	initialiser_arbre_b( &arbre, comparer_cle, copier_cle, supprimer_cle );
+	construire_arbre_b( &arbre, cles, valeurs, nb );
+	TEST( est_conforme( &arbre, ref ), result );
+
+	initialiser_arbre_b( &copie, comparer_cle, copier_cle, supprimer_cle );
+	copier_arbre_b( &copie, &arbre, NULL );
+	vider_arbre_b( &arbre );
+	TEST( est_conforme( &copie, ref ), result );
+
+	// La copie est un arbre comme un autre.
+	result &= tester_ajouts_et_retraits( &copie, ref, 99ull );
+	vider_arbre_b( &copie );
+	return result;
+}
+
+int main(){
+	int result = 1;
+
+	result &= test_ajouter_retirer();
+	result &= test_construire_copier();
+
+	if( ! result ){
+		fprintf( stderr, "Certains tests du fichier %s ont échoués.\n", __FILE__ );
+		return 1;
+	}
+	return 0;
+}
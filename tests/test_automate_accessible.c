@@ -57,6 +57,43 @@ int test_automate_accessible(){
 		liberer_automate( automate );
 	}
 
+	{
+		// Les états accessibles le sont en lisant un mot de longueur 
+		// quelconque.
+		Automate * automate = creer_automate();
+
+		ajouter_transition( automate, 1, 'a', 2 );
+		ajouter_transition( automate, 2, 'b', 3 );
+		ajouter_transition( automate, 3, 'a', 1 );
+		ajouter_transition( automate, 4, 'a', 3 );
+		ajouter_etat_initial( automate, 2 );
+		ajouter_etat_final( automate, 1 );
+		ajouter_etat_final( automate, 4 );
+
+		Ensemble * acc = accessibles( automate );
+		TEST( taille_ensemble( acc ) == 3, result );
+		TEST( ! est_dans_l_ensemble( acc, 4 ), result );
+		liberer_ensemble( acc );
+
+		acc = etats_accessibles( automate, 4 );
+		TEST( taille_ensemble( acc ) == 4, result );
+		liberer_ensemble( acc );
+
+		Automate * aut = automate_accessible( automate );
+		TEST(
+			1
+			&& le_mot_est_reconnu( aut, "ba" )
+			&& le_mot_est_reconnu( aut, "baaba" )
+			&& ! le_mot_est_reconnu( aut, "" )
+			&& ! est_un_etat_de_l_automate( aut, 4 )
+			&& ! est_un_etat_final_de_l_automate( aut, 4 )
+			&& est_un_etat_de_l_automate( aut, 3 )
+			, result
+		);
+		liberer_automate( aut );
+		liberer_automate( automate );
+	}
+
 	return result;
 }
 
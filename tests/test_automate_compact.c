@@ -0,0 +1,203 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "automate.h"
+#include "outils.h"
+
+typedef struct {
+	const Automate* compact;
+	const Renumerotation* renumerotation;
+	int result;
+} Verification;
+
+// Vérifie que chaque transition de l'automate d'origine est, renumérotée,
+// une transition de l'automate compact.
+void verifier_transition( int origine, char lettre, int fin, void* data ){
+	Verification* v = data;
+	v->result &= est_une_transition_de_l_automate(
+		v->compact,
+		nouveau_numero( v->renumerotation, origine ), lettre,
+		nouveau_numero( v->renumerotation, fin )
+	);
+}
+
+void compter_transition( int origine, char lettre, int fin, void* data ){
+	( *(int*) data )++;
+}
+
+int test_creer_automate_compact(){
+	int result = 1;
+
+	Automate* automate1 = mot_to_automate( "ab" );
+	Automate* automate2 = mot_to_automate( "ca" );
+	Automate* melange = creer_automate_du_melange( automate1, automate2 );
+	Automate* automate = translater_automate_entier( melange, -1000 );
+	ajouter_etat( automate, 5000 );
+	TEST( ! automate_est_compact( automate ), result );
+
+	Renumerotation renumerotation;
+	Automate* compact = creer_automate_compact( automate, &renumerotation );
+	int n = taille_ensemble( get_etats( automate ) );
+	TEST( automate_est_compact( compact ), result );
+	TEST( renumerotation.nb_etats == n, result );
+	TEST( (int) taille_ensemble( get_etats( compact ) ) == n, result );
+	TEST( get_min_etat( compact ) == 0 && get_max_etat( compact ) == n - 1, result );
+
+	// La renumérotation respecte l'ordre des états, dans les deux sens.
+	int i;
+	for( i=0; i<n; i++ ){
+		int ancien = renumerotation.anciens[i];
+		TEST( est_un_etat_de_l_automate( automate, ancien ), result );
+		TEST( nouveau_numero( &renumerotation, ancien ) == i, result );
+		TEST( i == 0 || renumerotation.anciens[i-1] < ancien, result );
+		TEST(
+			est_un_etat_initial_de_l_automate( automate, ancien ) ==
+			est_un_etat_initial_de_l_automate( compact, i ), result
+		);
+		TEST(
+			est_un_etat_final_de_l_automate( automate, ancien ) ==
+			est_un_etat_final_de_l_automate( compact, i ), result
+		);
+	}
+	TEST( nouveau_numero( &renumerotation, 4999 ) == -1, result );
+	TEST( nouveau_numero( &renumerotation, 5000 ) == n - 1, result );
+
+	Verification v = { compact, &renumerotation, 1 };
+	pour_toute_transition( automate, verifier_transition, &v );
+	TEST( v.result, result );
+	int nb1 = 0, nb2 = 0;
+	pour_toute_transition( automate, compter_transition, &nb1 );
+	pour_toute_transition( compact, compter_transition, &nb2 );
+	TEST( nb1 == nb2 && nb1 > 0, result );
+
+	TEST( le_mot_est_reconnu( compact, "abca" ), result );
+	TEST( le_mot_est_reconnu( compact, "caab" ), result );
+	TEST( ! le_mot_est_reconnu( compact, "abac" ), result );
+	TEST( ensembles_egaux( get_alphabet( compact ), get_alphabet( automate ) ), result );
+
+	liberer_renumerotation( &renumerotation );
+	liberer_automate( compact );
+
+	// Sans renumérotation demandée, et pour un automate vide.
+	compact = creer_automate_compact( automate, NULL );
+	TEST( automate_est_compact( compact ), result );
+	liberer_automate( compact );
+	liberer_automate( automate );
+	liberer_automate( melange );
+	liberer_automate( automate1 );
+	liberer_automate( automate2 );
+
+	automate = creer_automate();
+	TEST( automate_est_compact( automate ), result );
+	compact = creer_automate_compact( automate, &renumerotation );
+	TEST( renumerotation.nb_etats == 0, result );
+	TEST( ensemble_est_vide( get_etats( compact ) ), result );
+	liberer_renumerotation( &renumerotation );
+	liberer_automate( compact );
+	liberer_automate( automate );
+
+	// L'automate compact d'un automate alloué dans une arène est dans une
+	// autre arène.
+	automate = creer_automate_dans_une_arene();
+	ajouter_transition( automate, 30, 'a', 10 );
+	ajouter_transition( automate, 10, 'b', 20 );
+	ajouter_transition( automate, 10, 'b', 30 );
+	ajouter_etat_initial( automate, 30 );
+	ajouter_etat_final( automate, 20 );
+	compact = creer_automate_compact( automate, NULL );
+	liberer_automate( automate );
+	TEST( automate_est_compact( compact ), result );
+	TEST( est_une_transition_de_l_automate( compact, 0, 'b', 2 ), result );
+	TEST( le_mot_est_reconnu( compact, "abab" ), result );
+	TEST( ! le_mot_est_reconnu( compact, "aba" ), result );
+	liberer_automate( compact );
+
+	return result;
+}
+
+int test_accessibles_compact(){
+	int result = 1;
+
+	// Les états accessibles d'un automate compact se calculent avec des
+	// tableaux ; ils doivent correspondre à ceux de l'automate d'origine.
+	Automate* automate = creer_automate();
+	int i;
+	for( i=0; i<300; i++ ){
+		ajouter_transition( automate, 3 * i, 'a', 3 * ( ( i * 7 ) % 300 ) );
+		if( i % 5 ) ajouter_transition( automate, 3 * i, 'b', 3 * ( i + 1 ) );
+	}
+	ajouter_etat_initial( automate, 30 );
+	ajouter_etat_initial( automate, 600 );
+
+	Renumerotation renumerotation;
+	Automate* compact = creer_automate_compact( automate, &renumerotation );
+	Ensemble* acc = accessibles( automate );
+	Ensemble* acc_compact = accessibles( compact );
+	TEST( taille_ensemble( acc ) == taille_ensemble( acc_compact ), result );
+	Ensemble_iterateur it;
+	for(
+		it = premier_iterateur_ensemble( acc );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		TEST(
+			est_dans_l_ensemble(
+				acc_compact, nouveau_numero( &renumerotation, get_element( it ) )
+			), result
+		);
+	}
+	liberer_ensemble( acc );
+	liberer_ensemble( acc_compact );
+
+	// Un départ qui n'est pas un état est atteint, sans rien atteindre
+	// d'autre.
+	acc = etats_accessibles( compact, -7 );
+	TEST( taille_ensemble( acc ) == 1 && est_dans_l_ensemble( acc, -7 ), result );
+	liberer_ensemble( acc );
+	acc = etats_accessibles( compact, 100000 );
+	TEST( taille_ensemble( acc ) == 1, result );
+	liberer_ensemble( acc );
+
+	Automate* accessible = automate_accessible( compact );
+	TEST(
+		taille_ensemble( get_etats( accessible ) ) < taille_ensemble( get_etats( compact ) ),
+		result
+	);
+	liberer_automate( accessible );
+
+	liberer_renumerotation( &renumerotation );
+	liberer_automate( compact );
+	liberer_automate( automate );
+	return result;
+}
+
+int main(){
+	int result = 1;
+
+	result &= test_creer_automate_compact();
+	result &= test_accessibles_compact();
+
+	if( ! result ){
+		fprintf( stderr, "Certains tests du fichier %s ont échoués.\n", __FILE__ );
+		return 1;
+	}
+	return 0;
+}
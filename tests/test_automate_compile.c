@@ -0,0 +1,288 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "automate.h"
+#include "automate_compile.h"
+#include "outils.h"
+#include "tests/aleatoire.h"
+
+#include <stdint.h>
+#include <string.h>
+
+// Lettres de l'automate, dont une lettre de code négatif, et une lettre
+// absente de l'automate.
+static const char lettres[] = { 'a', 'b', 'c', (char) 0xe9, 'z' };
+#define NB_LETTRES 5
+
+/*
+ * Crée un automate non déterministe aléatoire à 'nb_etats' états, numérotés
+ * de manière creuse et en partie négative.
+ */
+static Automate* automate_aleatoire( int nb_etats, int nb_transitions, uint64_t* graine ){
+	Automate* automate = creer_automate();
+	int i;
+	for( i=0; i<nb_etats; i++ ){
+		ajouter_etat( automate, 7 * i - 50 );
+	}
+	for( i=0; i<nb_transitions; i++ ){
+		int origine = aleatoire( graine ) % nb_etats;
+		int fin = aleatoire( graine ) % nb_etats;
+		char lettre = lettres[ aleatoire( graine ) % ( NB_LETTRES - 1 ) ];
+		ajouter_transition( automate, 7 * origine - 50, lettre, 7 * fin - 50 );
+	}
+	for( i=0; i<nb_etats; i++ ){
+		if( aleatoire( graine ) % 8 == 0 ) ajouter_etat_initial( automate, 7 * i - 50 );
+		if( aleatoire( graine ) % 4 == 0 ) ajouter_etat_final( automate, 7 * i - 50 );
+	}
+	return automate;
+}
+
+/*
+ * Crée un automate déterministe aléatoire, non complet, à 'nb_etats' états.
+ * La lettre 'c' se comporte comme la lettre 'a'.
+ */
+static Automate* automate_deterministe_aleatoire( int nb_etats, uint64_t* graine ){
+	Automate* automate = creer_automate();
+	int i, l;
+	for( i=0; i<nb_etats; i++ ){
+		ajouter_etat( automate, 7 * i - 50 );
+		for( l=0; l<NB_LETTRES-1; l++ ){
+			if( lettres[l] == 'c' || aleatoire( graine ) % 4 == 0 ) continue;
+			int fin = 7 * ( aleatoire( graine ) % nb_etats ) - 50;
+			ajouter_transition( automate, 7 * i - 50, lettres[l], fin );
+			if( lettres[l] == 'a' ){
+				ajouter_transition( automate, 7 * i - 50, 'c', fin );
+			}
+		}
+		if( aleatoire( graine ) % 3 == 0 ) ajouter_etat_final( automate, 7 * i - 50 );
+	}
+	ajouter_etat_initial( automate, 7 * ( nb_etats / 2 ) - 50 );
+	return automate;
+}
+
+/*
+ * Compare l'automate compilé (et l'automate dense, s'il ne vaut pas NULL)
+ * à l'automate sur tous les mots de longueur au plus 'longueur', et compare
+ * delta_compile() et delta_star_compile() à delta() et delta_star().
+ */
+static int comparer_sur_les_mots(
+	const Automate* automate, const Automate_compile* compile,
+	const Automate_dense* dense, int longueur
+){
+	int result = 1;
+	char mot[16];
+	int indices[16];
+	int n, i;
+	for( n=0; n<=longueur; n++ ){
+		memset( indices, 0, sizeof(indices) );
+		while( 1 ){
+			for( i=0; i<n; i++ ) mot[i] = lettres[ indices[i] ];
+			mot[n] = '\0';
+			int attendu = le_mot_est_reconnu( automate, mot );
+			int obtenu = le_mot_est_reconnu_compile( compile, mot );
+			TEST( attendu == obtenu, result );
+			if( dense ){
+				obtenu = le_mot_est_reconnu_dense( dense, mot );
+				TEST( attendu == obtenu, result );
+			}
+
+			Ensemble* e1 = delta_star( automate, get_initiaux( automate ), mot );
+			Ensemble* e2 = delta_star_compile( compile, get_initiaux( automate ), mot );
+			TEST( ensembles_egaux( e1, e2 ), result );
+			if( n > 0 ){
+				Ensemble* d1 = delta( automate, e1, mot[0] );
+				Ensemble* d2 = delta_compile( compile, e1, mot[0] );
+				TEST( ensembles_egaux( d1, d2 ), result );
+				liberer_ensemble( d1 );
+				liberer_ensemble( d2 );
+			}
+			liberer_ensemble( e1 );
+			liberer_ensemble( e2 );
+
+			for( i=0; i<n && ++indices[i] == NB_LETTRES; i++ ) indices[i] = 0;
+			if( i == n ) break;
+		}
+	}
+	return result;
+}
+
+int test_compiler_automate(){
+	int result = 1;
+
+	Automate* automate = creer_automate();
+	ajouter_transition( automate, 3, 'a', 5 );
+	ajouter_transition( automate, 5, 'b', 3 );
+	ajouter_transition( automate, 5, 'a', 5 );
+	ajouter_transition( automate, 5, 'c', 6 );
+	ajouter_etat( automate, -4 );
+	ajouter_etat_initial( automate, 3 );
+	ajouter_etat_final( automate, 6 );
+	Automate_compile* compile = compiler_automate( automate );
+	liberer_automate( automate );
+
+	// L'automate compilé ne dépend plus de l'automate.
+	TEST( compile->nb_etats == 4, result );
+	TEST( compile->nb_lettres == 3, result );
+	TEST( numero_de_l_etat( compile, -4 ) == 0, result );
+	TEST( numero_de_l_etat( compile, 3 ) == 1, result );
+	TEST( numero_de_l_etat( compile, 6 ) == 3, result );
+	TEST( numero_de_l_etat( compile, 4 ) == -1, result );
+	TEST( numero_de_l_etat( compile, 7 ) == -1, result );
+	TEST( le_mot_est_reconnu_compile( compile, "aac" ), result );
+	TEST( le_mot_est_reconnu_compile( compile, "abac" ), result );
+	TEST( ! le_mot_est_reconnu_compile( compile, "ab" ), result );
+	TEST( ! le_mot_est_reconnu_compile( compile, "acc" ), result );
+	TEST( ! le_mot_est_reconnu_compile( compile, "adc" ), result );
+	TEST( ! le_mot_est_reconnu_compile( compile, "" ), result );
+
+	uint64_t* depart = creer_etats_compile( compile );
+	uint64_t* arrivee = creer_etats_compile( compile );
+	depart[0] = 1 << numero_de_l_etat( compile, 5 );
+	int non_vide = delta_compile_bits( compile, depart, 'a', arrivee );
+	TEST( non_vide && arrivee[0] == depart[0], result );
+	non_vide = delta_compile_bits( compile, depart, 'd', arrivee );
+	TEST( ! non_vide && arrivee[0] == 0, result );
+	xfree( depart );
+	xfree( arrivee );
+	liberer_automate_compile( compile );
+
+	// Automate vide.
+	automate = creer_automate();
+	compile = compiler_automate( automate );
+	TEST( ! le_mot_est_reconnu_compile( compile, "" ), result );
+	TEST( ! le_mot_est_reconnu_compile( compile, "a" ), result );
+	liberer_automate_compile( compile );
+	liberer_automate( automate );
+
+	return result;
+}
+
+int test_automates_aleatoires(){
+	int result = 1;
+	uint64_t graine = 88172645463325252ull;
+	int nb_etats[] = { 1, 5, 40, 130, 5000 };
+	int i;
+	for( i=0; i<5; i++ ){
+		Automate* automate = automate_aleatoire(
+			nb_etats[i], 2 * nb_etats[i] + 1, &graine
+		);
+		Automate_compile* compile = compiler_automate( automate );
+		result &= comparer_sur_les_mots(
+			automate, compile, NULL, nb_etats[i] > 1000 ? 3 : 5
+		);
+		liberer_automate_compile( compile );
+		liberer_automate( automate );
+	}
+	return result;
+}
+
+int test_automate_dense(){
+	int result = 1;
+
+	Automate* automate = creer_automate();
+	ajouter_transition( automate, 3, 'a', 5 );
+	ajouter_transition( automate, 3, 'b', 5 );
+	ajouter_transition( automate, 5, 'a', 5 );
+	ajouter_transition( automate, 5, 'b', 5 );
+	ajouter_transition( automate, 5, 'c', 6 );
+	ajouter_lettre( automate, 'd' );
+	ajouter_etat_initial( automate, 3 );
+	ajouter_etat_final( automate, 6 );
+	Automate_dense* dense = compiler_automate_dense( automate );
+	liberer_automate( automate );
+
+	// 'a' et 'b' sont dans la même classe, 'd' et les autres octets dans la 
+	// classe 0.
+	TEST( dense != NULL, result );
+	TEST( dense->nb_etats == 4, result );
+	TEST( dense->nb_classes == 3, result );
+	TEST( dense->classes['a'] == dense->classes['b'], result );
+	TEST( dense->classes['a'] != 0 && dense->classes['c'] != 0, result );
+	TEST( dense->classes['a'] != dense->classes['c'], result );
+	TEST( dense->classes['d'] == 0 && dense->classes['z'] == 0, result );
+	TEST( le_mot_est_reconnu_dense( dense, "abbac" ), result );
+	TEST( le_mot_est_reconnu_dense( dense, "bc" ), result );
+	TEST( ! le_mot_est_reconnu_dense( dense, "c" ), result );
+	TEST( ! le_mot_est_reconnu_dense( dense, "abca" ), result );
+	TEST( ! le_mot_est_reconnu_dense( dense, "adc" ), result );
+	TEST( ! le_mot_est_reconnu_dense( dense, "" ), result );
+	liberer_automate_dense( dense );
+
+	// Automates non déterministes.
+	automate = creer_automate();
+	ajouter_transition( automate, 3, 'a', 5 );
+	ajouter_transition( automate, 3, 'a', 6 );
+	ajouter_etat_initial( automate, 3 );
+	dense = compiler_automate_dense( automate );
+	TEST( dense == NULL, result );
+	liberer_automate( automate );
+
+	automate = creer_automate();
+	ajouter_transition( automate, 3, 'a', 5 );
+	ajouter_etat_initial( automate, 3 );
+	ajouter_etat_initial( automate, 5 );
+	dense = compiler_automate_dense( automate );
+	TEST( dense == NULL, result );
+	liberer_automate( automate );
+
+	// Sans état initial, aucun mot n'est reconnu.
+	automate = creer_automate();
+	ajouter_transition( automate, 3, 'a', 3 );
+	ajouter_etat_final( automate, 3 );
+	dense = compiler_automate_dense( automate );
+	TEST( dense && ! le_mot_est_reconnu_dense( dense, "" ), result );
+	TEST( dense && ! le_mot_est_reconnu_dense( dense, "aa" ), result );
+	liberer_automate_dense( dense );
+	liberer_automate( automate );
+
+	// Automates déterministes aléatoires.
+	uint64_t graine = 1234567ull;
+	int nb_etats[] = { 1, 5, 40, 300 };
+	int i;
+	for( i=0; i<4; i++ ){
+		automate = automate_deterministe_aleatoire( nb_etats[i], &graine );
+		Automate_compile* compile = compiler_automate( automate );
+		dense = compiler_automate_dense( automate );
+		TEST( dense && dense->classes['a'] == dense->classes['c'], result );
+		if( dense ){
+			result &= comparer_sur_les_mots( automate, compile, dense, 6 );
+			liberer_automate_dense( dense );
+		}
+		liberer_automate_compile( compile );
+		liberer_automate( automate );
+	}
+	return result;
+}
+
+int main(){
+	int result = 1;
+
+	result &= test_compiler_automate();
+	result &= test_automates_aleatoires();
+	result &= test_automate_dense();
+
+	if( ! result ){
+		fprintf( stderr, "Certains tests du fichier %s ont échoués.\n", __FILE__ );
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,199 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "bitset.h"
+#include "outils.h"
+#include "tests/aleatoire.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define NB_MOTS_MAX 70
+
+/*
+ * Remplit a et b de mots aléatoires : selon 'cas', b est une copie de a, 
+ * contient a, ou n'a aucun bit en commun avec a.
+ */
+static void remplir( uint64_t* a, uint64_t* b, size_t nb_mots, int cas, uint64_t* graine ){
+	size_t i;
+	for( i=0; i<nb_mots; i++ ){
+		a[i] = aleatoire( graine ) & aleatoire( graine );
+		switch( cas ){
+			case 0 : b[i] = aleatoire( graine ); break;
+			case 1 : b[i] = a[i]; break;
+			case 2 : b[i] = a[i] | aleatoire( graine ); break;
+			default : b[i] = ~a[i]; break;
+		}
+	}
+}
+
+/*
+ * Compare chaque opération à un calcul bit par bit, pour toutes les 
+ * longueurs jusqu'à NB_MOTS_MAX et des tableaux non alignés.
+ */
+static int tester_noyaux(){
+	int result = 1;
+	uint64_t graine = 88172645463325252ULL;
+	uint64_t a[NB_MOTS_MAX + 1], b[NB_MOTS_MAX + 1];
+	uint64_t dest[NB_MOTS_MAX + 1], attendu[NB_MOTS_MAX + 1];
+	size_t nb_mots, i;
+	int cas;
+
+	for( nb_mots=0; nb_mots<=NB_MOTS_MAX; nb_mots++ ){
+		for( cas=0; cas<4; cas++ ){
+			remplir( a + 1, b + 1, nb_mots, cas, &graine );
+			const uint64_t* x = a + 1;
+			const uint64_t* y = b + 1;
+
+			size_t bits_x = 0, bits_x_ou_y = 0, bits_x_et_y = 0;
+			int inclus = 1, egaux = 1, se_coupent = 0;
+			for( i=0; i<nb_mots; i++ ){
+				int bit;
+				for( bit=0; bit<64; bit++ ){
+					int dans_x = ( x[i] >> bit ) & 1;
+					int dans_y = ( y[i] >> bit ) & 1;
+					bits_x += dans_x;
+					bits_x_ou_y += dans_x | dans_y;
+					bits_x_et_y += dans_x & dans_y;
+					if( dans_x && ! dans_y ) inclus = 0;
+					if( dans_x != dans_y ) egaux = 0;
+					if( dans_x && dans_y ) se_coupent = 1;
+				}
+			}
+
+			for( i=0; i<nb_mots; i++ ) attendu[i] = x[i] | y[i];
+			bitset_union( dest + 1, x, y, nb_mots );
+			TEST( ! memcmp( dest + 1, attendu, nb_mots * sizeof(uint64_t) ), result );
+
+			for( i=0; i<nb_mots; i++ ) attendu[i] = x[i] & y[i];
+			bitset_intersection( dest + 1, x, y, nb_mots );
+			TEST( ! memcmp( dest + 1, attendu, nb_mots * sizeof(uint64_t) ), result );
+
+			for( i=0; i<nb_mots; i++ ) attendu[i] = x[i] & ~y[i];
+			bitset_difference( dest + 1, x, y, nb_mots );
+			TEST( ! memcmp( dest + 1, attendu, nb_mots * sizeof(uint64_t) ), result );
+
+			memcpy( dest + 1, x, nb_mots * sizeof(uint64_t) );
+			size_t ajoutes = bitset_ajouter( dest + 1, y, nb_mots );
+			TEST( ajoutes == bits_x_ou_y - bits_x, result );
+			for( i=0; i<nb_mots; i++ ) attendu[i] = x[i] | y[i];
+			TEST( ! memcmp( dest + 1, attendu, nb_mots * sizeof(uint64_t) ), result );
+
+			memcpy( dest + 1, x, nb_mots * sizeof(uint64_t) );
+			size_t retires = bitset_retirer( dest + 1, y, nb_mots );
+			TEST( retires == bits_x_et_y, result );
+			for( i=0; i<nb_mots; i++ ) attendu[i] = x[i] & ~y[i];
+			TEST( ! memcmp( dest + 1, attendu, nb_mots * sizeof(uint64_t) ), result );
+
+			size_t nb_bits = bitset_popcount( x, nb_mots );
+			TEST( nb_bits == bits_x, result );
+			int est_inclus = bitset_est_inclus( x, y, nb_mots );
+			TEST( est_inclus == inclus, result );
+			int sont_egaux = bitset_egaux( x, y, nb_mots );
+			TEST( sont_egaux == egaux, result );
+			int se_coupe = bitset_se_coupent( x, y, nb_mots );
+			TEST( se_coupe == se_coupent, result );
+			int est_nul = bitset_est_nul( x, nb_mots );
+			TEST( est_nul == ( bits_x == 0 ), result );
+		}
+	}
+	return result;
+}
+
+int test_noyaux_bitset(){
+	int result = 1;
+
+	Bitset_noyaux par_defaut = bitset_noyaux();
+	TEST( par_defaut != BITSET_NOYAUX_AUCUN, result );
+
+	// Toutes les versions que le processeur sait exécuter donnent les mêmes
+	// résultats ; la version scalaire existe toujours.
+	int scalaires = bitset_choisir_noyaux( BITSET_NOYAUX_SCALAIRES );
+	TEST( scalaires, result );
+	Bitset_noyaux noyaux;
+	for( 
+		noyaux = BITSET_NOYAUX_SCALAIRES; noyaux <= BITSET_NOYAUX_AVX2; 
+		noyaux++ 
+	){
+		if( bitset_choisir_noyaux( noyaux ) ){
+			TEST( bitset_noyaux() == noyaux, result );
+			result &= tester_noyaux();
+		}
+	}
+	int retour = bitset_choisir_noyaux( par_defaut );
+	TEST( retour, result );
+
+	return result;
+}
+
+int test_suivant_precedent(){
+	int result = 1;
+
+	uint64_t mots[3] = { 0, ( (uint64_t) 1 ) << 63 | 1, 4 };
+	TEST( bitset_suivant( mots, 3, 0 ) == 64, result );
+	TEST( bitset_suivant( mots, 3, 65 ) == 127, result );
+	TEST( bitset_suivant( mots, 3, 128 ) == 130, result );
+	TEST( bitset_suivant( mots, 3, 131 ) == -1, result );
+	TEST( bitset_precedent( mots, 3, 1000 ) == 130, result );
+	TEST( bitset_precedent( mots, 3, 126 ) == 64, result );
+	TEST( bitset_precedent( mots, 3, 63 ) == -1, result );
+
+	return result;
+}
+
+int test_rang_ieme(){
+	int result = 1;
+	uint64_t mots[200];
+	uint64_t graine = 42;
+	size_t i, rang = 0;
+
+	for( i=0; i<200; i++ ){
+		mots[i] = i % 50 < 20 ? 0 : aleatoire( &graine ) & aleatoire( &graine );
+	}
+	for( i=0; i<200*64; i++ ){
+		TEST( bitset_rang( mots, 200, i ) == rang, result );
+		if( mots[ BITSET_MOT( i ) ] & BITSET_MASQUE( i ) ){
+			TEST( bitset_ieme( mots, 200, rang ) == (intptr_t) i, result );
+			rang++;
+		}
+	}
+	TEST( bitset_rang( mots, 200, 200*64 + 5 ) == rang, result );
+	TEST( bitset_rang( mots, 200, -3 ) == 0, result );
+	TEST( bitset_ieme( mots, 200, rang ) == -1, result );
+
+	return result;
+}
+
+int main(){
+	int result = 1;
+
+	result &= test_noyaux_bitset();
+	result &= test_suivant_precedent();
+	result &= test_rang_ieme();
+
+	if( ! result ){
+		fprintf( stderr, "Certains tests du fichier %s ont échoués.\n", __FILE__ );
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,160 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "conteneurs.h"
+#include "outils.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+DEFINIR_VECTEUR( Vecteur, vecteur, int32_t )
+DEFINIR_TABLE_DE_HACHAGE(
+	Table_entiers, table_entiers, int32_t, int32_t,
+	CONTENEURS_HACHER_ENTIER, CONTENEURS_EGAUX
+)
+
+#define N 2000
+
+/* Générateur pseudo-aléatoire reproductible. */
+static uint32_t suivant_aleatoire( uint32_t* graine ){
+	*graine = *graine * 1103515245u + 12345u;
+	return *graine >> 8;
+}
+
+int test_vecteur(){
+	int result = 1;
+	int i;
+
+	Vecteur v;
+	initialiser_vecteur( &v );
+	TEST( taille_vecteur( &v ) == 0, result );
+
+	for( i=0; i<N; i++ ){
+		ajouter_vecteur( &v, -i );
+	}
+	TEST( taille_vecteur( &v ) == N, result );
+	TEST( v.capacite >= N, result );
+	int dans_l_ordre = 1;
+	for( i=0; i<N; i++ ){
+		dans_l_ordre &= ( v.elements[i] == -i );
+	}
+	TEST( dans_l_ordre, result );
+
+	// Réserver ne change ni la taille ni les éléments.
+	reserver_vecteur( &v, 4*N );
+	TEST( v.capacite >= 4*N, result );
+	TEST( taille_vecteur( &v ) == N && v.elements[N-1] == -(N-1), result );
+
+	vider_vecteur( &v );
+	TEST( taille_vecteur( &v ) == 0, result );
+	liberer_vecteur( &v );
+	TEST( v.elements == NULL && v.capacite == 0, result );
+
+	return result;
+}
+
+int test_table_de_hachage(){
+	int result = 1;
+	int i;
+
+	Table_entiers t;
+	initialiser_table_entiers( &t );
+	TEST( trouver_table_entiers( &t, 0 ) == NULL, result );
+	TEST( ! retirer_table_entiers( &t, 0 ), result );
+	TEST( suivante_table_entiers( &t, 0 ) == t.capacite, result );
+
+	// Une valeur nulle est ajoutée aux clés absentes.
+	int32_t* v = obtenir_table_entiers( &t, 7 );
+	TEST( v && *v == 0, result );
+	*v = 70;
+	TEST( *trouver_table_entiers( &t, 7 ) == 70, result );
+	TEST( taille_table_entiers( &t ) == 1, result );
+
+	// On compare à un tableau de présence, avec assez d'ajouts pour que la
+	// table s'agrandisse plusieurs fois, et assez de retraits pour que les 
+	// cases reculent.
+	vider_table_entiers( &t );
+	TEST( taille_table_entiers( &t ) == 0, result );
+	TEST( trouver_table_entiers( &t, 7 ) == NULL, result );
+	int32_t valeurs[N];
+	char present[N] = {0};
+	uint32_t graine = 2;
+	int conforme = 1;
+	for( i=0; i<10*N; i++ ){
+		int32_t cle = suivant_aleatoire( &graine ) % N;
+		if( suivant_aleatoire( &graine ) % 4 ){
+			int32_t valeur = suivant_aleatoire( &graine );
+			ajouter_table_entiers( &t, cle - N/2, valeur );
+			valeurs[cle] = valeur;
+			present[cle] = 1;
+		}else{
+			conforme &= ( retirer_table_entiers( &t, cle - N/2 ) == present[cle] );
+			present[cle] = 0;
+		}
+	}
+	TEST( conforme, result );
+
+	size_t nb = 0;
+	for( i=0; i<N; i++ ){
+		int32_t* valeur = trouver_table_entiers( &t, i - N/2 );
+		if( present[i] ){
+			conforme &= ( valeur && *valeur == valeurs[i] );
+			nb++;
+		}else{
+			conforme &= ( valeur == NULL );
+		}
+	}
+	TEST( conforme, result );
+	TEST( taille_table_entiers( &t ) == nb, result );
+	TEST( 8 * taille_table_entiers( &t ) <= 7 * t.capacite, result );
+
+	// Le parcours des cases occupées voit chaque clé une fois.
+	size_t vues = 0;
+	size_t j;
+	for(
+		j = suivante_table_entiers( &t, 0 );
+		j < t.capacite;
+		j = suivante_table_entiers( &t, j + 1 )
+	){
+		int32_t cle = t.cases[j].cle + N/2;
+		conforme &= ( cle >= 0 && cle < N && present[cle] );
+		conforme &= ( t.cases[j].valeur == valeurs[cle] );
+		vues++;
+	}
+	TEST( conforme, result );
+	TEST( vues == nb, result );
+
+	liberer_table_entiers( &t );
+	return result;
+}
+
+int main(){
+	int result = 1;
+
+	result &= test_vecteur();
+	result &= test_table_de_hachage();
+
+	if( ! result ){
+		fprintf( stderr, "Certains tests du fichier %s ont échoués.\n", __FILE__ );
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,136 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "automate.h"
+#include "outils.h"
+
+int test_copier_automate(){
+	int result = 1;
+
+	{
+		Automate * automate = creer_automate();
+
+		ajouter_transition( automate, 1, 'a', 1 );
+		ajouter_transition( automate, 1, 'b', 2 );
+		ajouter_transition( automate, 2, 'a', 3 );
+		ajouter_etat_initial( automate, 1);
+		ajouter_etat_final( automate, 3);
+
+		Automate * aut = copier_automate( automate );
+
+		// La copie ne partage rien avec l'original.
+		ajouter_transition( automate, 3, 'b', 1 );
+		ajouter_etat_final( automate, 1 );
+		liberer_automate( automate );
+
+		TEST(
+			1
+			&& aut
+			&& le_mot_est_reconnu( aut, "ba" )
+			&& le_mot_est_reconnu( aut, "aaba" )
+			&& ! le_mot_est_reconnu( aut, "" )
+			&& ! le_mot_est_reconnu( aut, "b" )
+			&& ! le_mot_est_reconnu( aut, "bab" )
+			&& est_une_transition_de_l_automate( aut, 1, 'b', 2 )
+			&& ! est_une_transition_de_l_automate( aut, 3, 'b', 1 )
+			&& est_un_etat_initial_de_l_automate( aut, 1 )
+			&& est_un_etat_final_de_l_automate( aut, 3 )
+			&& ! est_un_etat_final_de_l_automate( aut, 1 )
+			&& est_un_etat_de_l_automate( aut, 2 )
+			&& est_dans_l_ensemble( get_alphabet( aut ), 'b' )
+			, result
+		);
+
+		// La copie reste modifiable.
+		ajouter_transition( aut, 3, 'a', 3 );
+		TEST( le_mot_est_reconnu( aut, "baaa" ), result );
+		liberer_automate( aut );
+	}
+
+	return result;
+}
+
+int test_automate_dans_une_arene(){
+	int result = 1;
+	int i;
+
+	{
+		Automate * automate = creer_automate_dans_une_arene();
+		for( i=0; i<1000; i++ ){
+			ajouter_transition( automate, i, 'a', i+1 );
+			ajouter_transition( automate, i, 'b', 0 );
+		}
+		ajouter_etat_initial( automate, 0 );
+		ajouter_etat_final( automate, 1000 );
+		TEST( est_dans_une_arene( automate ), result );
+		TEST( est_dans_une_arene( get_etats( automate ) ), result );
+		TEST( est_dans_une_arene( get_alphabet( automate ) ), result );
+
+		// Une copie d'un ensemble de l'automate lui survit.
+		Ensemble * etats = copier_ensemble( get_etats( automate ) );
+		TEST( ! est_dans_une_arene( etats ), result );
+
+		// Les automates construits à partir de l'automate ont leur propre 
+		// arène.
+		Automate * copie = copier_automate( automate );
+		Automate * m = miroir( automate );
+		TEST( est_dans_une_arene( copie ) && est_dans_une_arene( m ), result );
+
+		// L'automate n'alloue pas dans l'arène de l'appelant, et inversement.
+		Arene * arene = creer_arene();
+		Arene * precedente = utiliser_arene( arene );
+		Automate * ordinaire = creer_automate();
+		ajouter_transition( ordinaire, 0, 'a', 1 );
+		ajouter_transition( automate, 1000, 'a', 0 );
+		Ensemble * accessibles_m = accessibles( m );
+		utiliser_arene( precedente );
+		TEST( ! est_dans_une_arene( ordinaire ), result );
+		TEST( ! est_dans_une_arene( get_alphabet( ordinaire ) ), result );
+		TEST( est_dans_une_arene( accessibles_m ), result );
+		TEST( taille_ensemble( accessibles_m ) == 1001, result );
+		liberer_arene( arene );
+		liberer_automate( ordinaire );
+
+		liberer_automate( automate );
+
+		TEST( taille_ensemble( etats ) == 1001, result );
+		TEST( est_dans_l_ensemble( etats, 1000 ), result );
+		liberer_ensemble( etats );
+
+		TEST( le_mot_est_reconnu( copie, "aaa" ) == 0, result );
+		TEST( est_une_transition_de_l_automate( copie, 999, 'a', 1000 ), result );
+		TEST( ! est_une_transition_de_l_automate( copie, 1000, 'a', 0 ), result );
+		TEST( est_une_transition_de_l_automate( m, 1000, 'a', 999 ), result );
+		ajouter_transition( copie, 1000, 'b', 1000 );
+		TEST( est_une_transition_de_l_automate( copie, 1000, 'b', 1000 ), result );
+		liberer_automate( copie );
+		liberer_automate( m );
+	}
+
+	return result;
+}
+
+int main(){
+
+	if( ! test_copier_automate() ){ return 1; };
+	if( ! test_automate_dans_une_arene() ){ return 1; };
+
+	return 0;
+	
+}
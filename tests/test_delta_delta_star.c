@@ -19,9 +19,13 @@
  */
 
 
+#define _POSIX_C_SOURCE 200809L
+
 #include "automate.h"
 #include "outils.h"
 
+#include <pthread.h>
+
 
 int test_delta_delta_star(){
 
@@ -136,10 +140,75 @@ int test_delta_delta_star(){
 	return result;
 }
 
+#define NB_THREADS 4
+
+typedef struct {
+	const Automate* automate;
+	const Ensemble* attendu;
+	int result;
+} Lecture;
+
+static void* lire_automate( void* data ){
+	Lecture* lecture = data;
+	int i;
+	for( i=0; i<200; i++ ){
+		Ensemble* arrivee = delta_star(
+			lecture->automate, get_initiaux( lecture->automate ), "aab"
+		);
+		lecture->result &= ensembles_egaux( arrivee, lecture->attendu );
+		lecture->result &= le_mot_est_reconnu( lecture->automate, "aab" );
+		lecture->result &= ! le_mot_est_reconnu( lecture->automate, "ba" );
+		liberer_ensemble( arrivee );
+	}
+	return NULL;
+}
+
+/*
+ * delta(), delta_star() et le_mot_est_reconnu() ne font que lire 
+ * l'automate : plusieurs threads peuvent les appeler en même temps sur le 
+ * même automate. Les ensembles d'arrivée sont assez grands pour être des 
+ * tableaux de bits.
+ */
+int test_lectures_concurrentes(){
+	int result = 1;
+	int i, j;
+
+	Automate* automate = creer_automate();
+	for( i=0; i<300; i++ ){
+		for( j=i; j<i+100; j++ ){
+			ajouter_transition( automate, i, 'a', j );
+		}
+		ajouter_transition( automate, i, 'b', 1000 + i );
+	}
+	ajouter_etat_initial( automate, 0 );
+	ajouter_etat_initial( automate, 1 );
+	ajouter_etat_final( automate, 1150 );
+	Ensemble* attendu = delta_star( automate, get_initiaux( automate ), "aab" );
+	TEST( taille_ensemble( attendu ) == 200, result );
+
+	pthread_t threads[NB_THREADS];
+	Lecture lectures[NB_THREADS];
+	for( i=0; i<NB_THREADS; i++ ){
+		lectures[i].automate = automate;
+		lectures[i].attendu = attendu;
+		lectures[i].result = 1;
+		pthread_create( &threads[i], NULL, lire_automate, &lectures[i] );
+	}
+	for( i=0; i<NB_THREADS; i++ ){
+		pthread_join( threads[i], NULL );
+		TEST( lectures[i].result, result );
+	}
+
+	liberer_ensemble( attendu );
+	liberer_automate( automate );
+	return result;
+}
+
 
 int main(){
 
 	if( ! test_delta_delta_star() ){ return 1; }
+	if( ! test_lectures_concurrentes() ){ return 1; }
 
 	return 0;
 }
@@ -22,6 +22,7 @@
 #include "automate.h"
 #include "outils.h"
 
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -469,6 +470,20 @@ int test_taille_ensemble(){
 	);
 
 	TEST( taille_ensemble(ens) == 0 , result );
+	TEST( ensemble_est_vide(ens), result );
+
+	// Assez d'éléments pour passer par un arbre.
+	Elmt e;
+	int i;
+	for( i=0; i<40; i++ ){
+		initialiser_elmt( &e, i );
+		ajouter_element( ens, (intptr_t) &e );
+	}
+	TEST( taille_ensemble(ens) == 40 , result );
+	TEST( ! ensemble_est_vide(ens), result );
+	initialiser_elmt( &e, 7 );
+	retirer_element( ens, (intptr_t) &e );
+	TEST( taille_ensemble(ens) == 39 , result );
 
 	liberer_ensemble( ens );
 
@@ -534,6 +549,30 @@ int test_comparer_ensemble(){
 	liberer_ensemble( ens1 );
 	liberer_ensemble( ens2 );
 
+#if INTPTR_MAX > INT32_MAX
+	// Des éléments qui diffèrent d'un multiple de 2^32 sont distincts, quelle
+	// que soit la représentation des ensembles.
+	int i, k;
+	for( k=0; k<3; k++ ){
+		int nb = ( k == 0 ) ? 1 : 200;
+		intptr_t pas = ( k == 2 ) ? 100000 : 1;
+		ens1 = creer_ensemble( NULL, NULL, NULL );
+		ens2 = creer_ensemble( NULL, NULL, NULL );
+		for( i=0; i<nb; i++ ){
+			ajouter_element( ens1, i*pas );
+			ajouter_element( ens2, i*pas );
+		}
+		retirer_element( ens2, 0 );
+		ajouter_element( ens2, (intptr_t) 1 << 32 );
+		TEST( comparer_ensemble( ens1, ens2 ) == -1, result );
+		TEST( comparer_ensemble( ens2, ens1 ) == 1, result );
+		TEST( ! ensembles_egaux( ens1, ens2 ), result );
+		TEST( ! ensembles_egaux( ens2, ens1 ), result );
+		liberer_ensemble( ens1 );
+		liberer_ensemble( ens2 );
+	}
+#endif
+
 	return result;
 }
 
@@ -609,6 +648,63 @@ int test_copier_ensemble(){
 	return result;
 }
 
+int test_copie_independante(){
+	int result = 1;
+	int i, k;
+
+	// Pour chaque représentation : un tableau trié, un tableau de bits et 
+	// un ensemble compressé.
+	for( k=0; k<3; k++ ){
+		int nb = ( k == 0 ) ? 10 : 200;
+		int pas = ( k == 2 ) ? 100000 : 1;
+		Ensemble * ens1 = creer_ensemble( NULL, NULL, NULL );
+		for( i=0; i<nb; i++ ){
+			ajouter_element( ens1, i*pas );
+		}
+		Ensemble * ens2 = copier_ensemble( ens1 );
+		Ensemble * ens3 = copier_ensemble( ens2 );
+		TEST( ens1->representation == ens2->representation, result );
+
+		// Modifier une copie ne change pas les autres.
+		ajouter_element( ens2, -1 );
+		retirer_element( ens3, 0 );
+		TEST( taille_ensemble( ens1 ) == nb, result );
+		TEST( ! est_dans_l_ensemble( ens1, -1 ) && est_dans_l_ensemble( ens1, 0 ), result );
+		TEST( taille_ensemble( ens2 ) == nb + 1, result );
+		TEST( est_dans_l_ensemble( ens2, 0 ), result );
+		TEST( taille_ensemble( ens3 ) == nb - 1, result );
+		TEST( ! est_dans_l_ensemble( ens3, -1 ), result );
+
+		liberer_ensemble( ens1 );
+		liberer_ensemble( ens3 );
+		TEST( taille_ensemble( ens2 ) == nb + 1, result );
+		liberer_ensemble( ens2 );
+	}
+
+	// Chaque copie a ses propres éléments.
+	Ensemble * ens1 = creer_ensemble(
+		(int (*)( const intptr_t, const intptr_t)) comparer_elmt, 
+		(intptr_t (*)( const intptr_t )) copier_elmt, 
+		(void (*)( intptr_t )) supprimer_elmt
+	);
+	Elmt elmt;
+	for( i=0; i<30; i++ ){
+		initialiser_elmt( &elmt, i );
+		ajouter_element( ens1, (intptr_t) &elmt );
+	}
+	Ensemble * ens2 = copier_ensemble( ens1 );
+	initialiser_elmt( &elmt, 3 );
+	retirer_element( ens2, (intptr_t) &elmt );
+	TEST( est_dans_l_ensemble( ens1, (intptr_t) &elmt ), result );
+	TEST( taille_ensemble( ens2 ) == 29, result );
+	liberer_ensemble( ens1 );
+	TEST( ! est_dans_l_ensemble( ens2, (intptr_t) &elmt ), result );
+	TEST( taille_ensemble( ens2 ) == 29, result );
+	liberer_ensemble( ens2 );
+
+	return result;
+}
+
 typedef struct {
 	int min;
 	int max;
@@ -938,6 +1034,456 @@ int test_get_element(){
 }
 
 
+int test_petit_ensemble(){
+	int result = 1;
+	int i;
+	Elmt elmt;
+
+	Ensemble * ens = creer_ensemble(
+		(int (*)( const intptr_t, const intptr_t)) comparer_elmt, 
+		(intptr_t (*)( const intptr_t )) copier_elmt, 
+		(void (*)( intptr_t )) supprimer_elmt
+	);
+	for( i=0; i<3; i++ ){
+		initialiser_elmt( &elmt, 10 - i );
+		ajouter_element( ens, (intptr_t) &elmt );
+	}
+	TEST( ens->representation == ENSEMBLE_TABLEAU, result );
+	TEST( ens->elements == NULL, result );
+	TEST( taille_ensemble( ens ) == 3, result );
+	TEST( ( (Elmt*) get_element( premier_iterateur_ensemble( ens ) ) )->elmt == 8, result );
+
+	Ensemble * copie = copier_ensemble( ens );
+	TEST( comparer_ensemble( ens, copie ) == 0, result );
+
+	for( i=0; i<40; i++ ){
+		initialiser_elmt( &elmt, i );
+		ajouter_element( ens, (intptr_t) &elmt );
+	}
+	TEST( ens->representation == ENSEMBLE_ARBRE, result );
+	TEST( taille_ensemble( ens ) == 40, result );
+	initialiser_elmt( &elmt, 9 );
+	TEST( est_dans_l_ensemble( ens, (intptr_t) &elmt ), result );
+	initialiser_elmt( &elmt, 40 );
+	TEST( ! est_dans_l_ensemble( ens, (intptr_t) &elmt ), result );
+
+	initialiser_elmt( &elmt, 9 );
+	retirer_element( copie, (intptr_t) &elmt );
+	TEST( taille_ensemble( copie ) == 2, result );
+	TEST( ! est_dans_l_ensemble( copie, (intptr_t) &elmt ), result );
+
+	liberer_ensemble( ens );
+	liberer_ensemble( copie );
+
+	// Un petit ensemble d'entiers qui grossit devient un tableau de bits.
+	ens = creer_ensemble( NULL, NULL, NULL );
+	for( i=20; i>0; i-- ){
+		ajouter_element( ens, i );
+		TEST( 
+			ens->representation == 
+				( i > 4 ? ENSEMBLE_TABLEAU : ENSEMBLE_BITSET ), 
+			result 
+		);
+	}
+	TEST( taille_ensemble( ens ) == 20, result );
+	TEST( get_element( premier_iterateur_ensemble( ens ) ) == 1, result );
+	liberer_ensemble( ens );
+
+	return result;
+}
+
+
+int test_ensemble_d_entiers(){
+	int result = 1;
+	int i;
+
+	Ensemble * pairs = creer_ensemble( NULL, NULL, NULL );
+	Ensemble * multiples_de_3 = creer_ensemble( NULL, NULL, NULL );
+	for( i=-500; i<1000; i++ ){
+		if( i % 2 == 0 ) ajouter_element( pairs, i );
+		if( i % 3 == 0 ) ajouter_element( multiples_de_3, i );
+	}
+	TEST( pairs->representation == ENSEMBLE_BITSET, result );
+	TEST( taille_ensemble( pairs ) == 750, result );
+	TEST( taille_ensemble( multiples_de_3 ) == 500, result );
+
+	Ensemble * u = creer_union_ensemble( pairs, multiples_de_3 );
+	Ensemble * n = creer_intersection_ensemble( pairs, multiples_de_3 );
+	Ensemble * d = creer_difference_ensemble( pairs, multiples_de_3 );
+	TEST( taille_ensemble( u ) == 1000, result );
+	TEST( taille_ensemble( n ) == 250, result );
+	TEST( taille_ensemble( d ) == 500, result );
+	for( i=-500; i<1000; i++ ){
+		TEST( est_dans_l_ensemble( u, i ) == ( i%2 == 0 || i%3 == 0 ), result );
+		TEST( est_dans_l_ensemble( n, i ) == ( i%2 == 0 && i%3 == 0 ), result );
+		TEST( est_dans_l_ensemble( d, i ) == ( i%2 == 0 && i%3 != 0 ), result );
+	}
+
+	Ensemble_iterateur it = premier_iterateur_ensemble( n );
+	TEST( get_element( it ) == -498, result );
+	it = iterateur_precedent_ensemble( it );
+	TEST( iterateur_ensemble_est_vide( it ), result );
+	it = iterateur_precedent_ensemble( it );
+	TEST( get_element( it ) == 996, result );
+
+	// Un élément très éloigné des autres : l'ensemble est compressé.
+	ajouter_element( n, ( (intptr_t) 1 ) << 40 );
+	TEST( n->representation == ENSEMBLE_COMPRESSE, result );
+	TEST( taille_ensemble( n ) == 251, result );
+	TEST( est_dans_l_ensemble( n, ( (intptr_t) 1 ) << 40 ), result );
+	TEST( est_dans_l_ensemble( n, -498 ), result );
+	TEST( ! est_dans_l_ensemble( n, -497 ), result );
+
+	Ensemble * v = creer_union_ensemble( n, d );
+	TEST( taille_ensemble( v ) == 751, result );
+	retirer_elements( v, pairs );
+	TEST( taille_ensemble( v ) == 1, result );
+
+	vider_ensemble( n );
+	TEST( n->representation == ENSEMBLE_TABLEAU, result );
+	TEST( taille_ensemble( n ) == 0, result );
+	ajouter_element( n, 7 );
+	TEST( est_dans_l_ensemble( n, 7 ), result );
+
+	liberer_ensemble( pairs );
+	liberer_ensemble( multiples_de_3 );
+	liberer_ensemble( u );
+	liberer_ensemble( n );
+	liberer_ensemble( d );
+	liberer_ensemble( v );
+
+	return result;
+}
+
+
+Ensemble * creer_ensemble_d_elmts(){
+	return creer_ensemble(
+		(int (*)( const intptr_t, const intptr_t)) comparer_elmt, 
+		(intptr_t (*)( const intptr_t )) copier_elmt, 
+		(void (*)( intptr_t )) supprimer_elmt
+	);
+}
+
+int contient_elmt( const Ensemble* ens, int i ){
+	Elmt e;
+	initialiser_elmt( &e, i );
+	return est_dans_l_ensemble( ens, (intptr_t) &e );
+}
+
+int est_trie( const Ensemble* ens ){
+	Ensemble_iterateur it = premier_iterateur_ensemble( ens );
+	if( iterateur_ensemble_est_vide( it ) ) return 1;
+	int precedent = ( (Elmt*) get_element( it ) )->elmt;
+	for(
+		it = iterateur_suivant_ensemble( it );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		int courant = ( (Elmt*) get_element( it ) )->elmt;
+		if( courant <= precedent ) return 0;
+		precedent = courant;
+	}
+	return 1;
+}
+
+int test_operations_ensemblistes(){
+	int result = 1;
+	int i;
+	Elmt e;
+
+	// Ensembles codés par des arbres
+	Ensemble * pairs = creer_ensemble_d_elmts();
+	Ensemble * multiples_de_3 = creer_ensemble_d_elmts();
+	for( i=0; i<600; i++ ){
+		initialiser_elmt( &e, i );
+		if( i % 2 == 0 ) ajouter_element( pairs, (intptr_t) &e );
+		if( i % 3 == 0 ) ajouter_element( multiples_de_3, (intptr_t) &e );
+	}
+
+	Ensemble * u = creer_union_ensemble( pairs, multiples_de_3 );
+	Ensemble * n = creer_intersection_ensemble( pairs, multiples_de_3 );
+	Ensemble * d = creer_difference_ensemble( pairs, multiples_de_3 );
+	TEST( taille_ensemble( u ) == 400, result );
+	TEST( taille_ensemble( n ) == 100, result );
+	TEST( taille_ensemble( d ) == 200, result );
+	TEST( est_trie( u ) && est_trie( n ) && est_trie( d ), result );
+	for( i=0; i<600; i++ ){
+		TEST( contient_elmt( u, i ) == ( i%2 == 0 || i%3 == 0 ), result );
+		TEST( contient_elmt( n, i ) == ( i%2 == 0 && i%3 == 0 ), result );
+		TEST( contient_elmt( d, i ) == ( i%2 == 0 && i%3 != 0 ), result );
+	}
+
+	// Les ensembles construits restent modifiables.
+	for( i=0; i<600; i+=6 ){
+		initialiser_elmt( &e, i );
+		retirer_element( u, (intptr_t) &e );
+		initialiser_elmt( &e, i+1 );
+		ajouter_element( n, (intptr_t) &e );
+	}
+	TEST( taille_ensemble( u ) == 300, result );
+	TEST( taille_ensemble( n ) == 200, result );
+	TEST( est_trie( u ) && est_trie( n ), result );
+	TEST( ! contient_elmt( u, 12 ) && contient_elmt( u, 14 ), result );
+	TEST( contient_elmt( n, 13 ) && ! contient_elmt( n, 14 ), result );
+
+	// Résultats vides ou petits
+	Ensemble * vide = creer_difference_ensemble( pairs, pairs );
+	Ensemble * petit = creer_intersection_ensemble( d, n );
+	TEST( ensemble_est_vide( vide ), result );
+	TEST( taille_ensemble( petit ) == 0, result );
+	liberer_ensemble( petit );
+	petit = creer_union_ensemble( vide, vide );
+	TEST( ensemble_est_vide( petit ), result );
+
+	liberer_ensemble( pairs );
+	liberer_ensemble( multiples_de_3 );
+	liberer_ensemble( u );
+	liberer_ensemble( n );
+	liberer_ensemble( d );
+	liberer_ensemble( vide );
+	liberer_ensemble( petit );
+
+	// Ensembles d'entiers de représentations différentes
+	Ensemble * epars = creer_ensemble( NULL, NULL, NULL );
+	Ensemble * dense = creer_ensemble( NULL, NULL, NULL );
+	for( i=0; i<100; i++ ){
+		ajouter_element( epars, ( (intptr_t) i ) << 20 );
+		ajouter_element( dense, i );
+	}
+	TEST( epars->representation == ENSEMBLE_COMPRESSE, result );
+	TEST( dense->representation == ENSEMBLE_BITSET, result );
+	u = creer_union_ensemble( epars, dense );
+	n = creer_intersection_ensemble( epars, dense );
+	d = creer_difference_ensemble( dense, epars );
+	TEST( taille_ensemble( u ) == 199, result );
+	TEST( taille_ensemble( n ) == 1 && est_dans_l_ensemble( n, 0 ), result );
+	TEST( taille_ensemble( d ) == 99 && ! est_dans_l_ensemble( d, 0 ), result );
+	TEST( d->representation == ENSEMBLE_BITSET, result );
+	TEST( est_dans_l_ensemble( u, ( (intptr_t) 99 ) << 20 ), result );
+	liberer_ensemble( epars );
+	liberer_ensemble( dense );
+	liberer_ensemble( u );
+	liberer_ensemble( n );
+	liberer_ensemble( d );
+
+	return result;
+}
+
+int test_inclusion_et_intersection(){
+	int result = 1;
+	int i, k;
+
+	// Pour chaque représentation : un tableau trié, un tableau de bits et 
+	// un arbre. ens2 contient les multiples de 2, ens3 ceux de 4 et ens4 les
+	// nombres impairs ; ens5 est décalé pour que son tableau de bits ne 
+	// couvre pas les mêmes mots.
+	for( k=0; k<3; k++ ){
+		int nb = ( k == 0 ) ? 4 : 300;
+		int pas = ( k == 2 ) ? 100000 : 1;
+		Ensemble * ens2 = creer_ensemble( NULL, NULL, NULL );
+		Ensemble * ens3 = creer_ensemble( NULL, NULL, NULL );
+		Ensemble * ens4 = creer_ensemble( NULL, NULL, NULL );
+		Ensemble * ens5 = creer_ensemble( NULL, NULL, NULL );
+		for( i=0; i<nb; i++ ){
+			ajouter_element( ens2, 2*i*pas );
+			if( i % 2 == 0 ) ajouter_element( ens3, 2*i*pas );
+			ajouter_element( ens4, (2*i+1)*pas );
+			ajouter_element( ens5, 2*(i+nb)*pas );
+		}
+		Ensemble * vide = creer_ensemble( NULL, NULL, NULL );
+
+		TEST( est_inclus_dans_ensemble( ens3, ens2 ), result );
+		TEST( ! est_inclus_dans_ensemble( ens2, ens3 ), result );
+		TEST( est_inclus_dans_ensemble( vide, ens2 ), result );
+		TEST( ! est_inclus_dans_ensemble( ens2, vide ), result );
+		TEST( ! est_inclus_dans_ensemble( ens4, ens2 ), result );
+
+		TEST( ensembles_se_coupent( ens2, ens3 ), result );
+		TEST( ensembles_se_coupent( ens3, ens2 ), result );
+		TEST( ! ensembles_se_coupent( ens2, ens4 ), result );
+		TEST( ! ensembles_se_coupent( ens2, ens5 ), result );
+		TEST( ! ensembles_se_coupent( vide, ens2 ), result );
+
+		// Les mêmes éléments, dans des tableaux de bits de tailles 
+		// différentes.
+		Ensemble * copie = copier_ensemble( ens5 );
+		ajouter_elements( ens5, ens2 );
+		retirer_elements( ens5, ens2 );
+		TEST( ensembles_egaux( ens5, copie ), result );
+		TEST( est_inclus_dans_ensemble( ens5, copie ), result );
+		TEST( est_inclus_dans_ensemble( copie, ens5 ), result );
+		retirer_element( ens5, 2*nb*pas );
+		TEST( ! ensembles_egaux( ens5, copie ), result );
+		TEST( est_inclus_dans_ensemble( ens5, copie ), result );
+		TEST( ! est_inclus_dans_ensemble( copie, ens5 ), result );
+
+		liberer_ensemble( copie );
+		liberer_ensemble( vide );
+		liberer_ensemble( ens2 );
+		liberer_ensemble( ens3 );
+		liberer_ensemble( ens4 );
+		liberer_ensemble( ens5 );
+	}
+
+	return result;
+}
+
+int test_creer_ensemble_depuis_tableau(){
+	int result = 1;
+	int i;
+	intptr_t tableau[1000];
+
+	// Entiers dans le désordre, avec des doublons
+	for( i=0; i<1000; i++ ){
+		tableau[i] = ( i * 37 ) % 500;
+	}
+	Ensemble * ens = creer_ensemble_depuis_tableau( NULL, NULL, NULL, tableau, 1000 );
+	TEST( taille_ensemble( ens ) == 500, result );
+	TEST( ens->representation == ENSEMBLE_BITSET, result );
+	TEST( ensemble_vers_tableau( ens, tableau ) == 500, result );
+	for( i=0; i<500; i++ ){
+		TEST( tableau[i] == i, result );
+	}
+	liberer_ensemble( ens );
+
+	// Entiers épars, déjà triés
+	for( i=0; i<100; i++ ){
+		tableau[i] = ( (intptr_t) i ) << 30;
+	}
+	ens = creer_ensemble_depuis_tableau( NULL, NULL, NULL, tableau, 100 );
+	TEST( ens->representation == ENSEMBLE_COMPRESSE, result );
+	TEST( est_dans_l_ensemble( ens, ( (intptr_t) 42 ) << 30 ), result );
+	ajouter_element( ens, 1 );
+	TEST( taille_ensemble( ens ) == 101, result );
+	liberer_ensemble( ens );
+
+	// Petit ensemble
+	tableau[0] = 3; tableau[1] = -2; tableau[2] = 3;
+	ens = creer_ensemble_depuis_tableau( NULL, NULL, NULL, tableau, 3 );
+	TEST( ens->representation == ENSEMBLE_TABLEAU, result );
+	TEST( taille_ensemble( ens ) == 2, result );
+	TEST( get_element( premier_iterateur_ensemble( ens ) ) == -2, result );
+	liberer_ensemble( ens );
+
+	// Éléments copiés par l'ensemble
+	Elmt elmts[50];
+	for( i=0; i<50; i++ ){
+		initialiser_elmt( &elmts[i], 49 - i );
+		tableau[i] = (intptr_t) &elmts[i];
+	}
+	ens = creer_ensemble_depuis_tableau(
+		(int (*)( const intptr_t, const intptr_t)) comparer_elmt, 
+		(intptr_t (*)( const intptr_t )) copier_elmt, 
+		(void (*)( intptr_t )) supprimer_elmt,
+		tableau, 50
+	);
+	TEST( taille_ensemble( ens ) == 50, result );
+	TEST( est_trie( ens ), result );
+	TEST( ensemble_vers_tableau( ens, tableau ) == 50, result );
+	for( i=0; i<50; i++ ){
+		TEST( ( (Elmt*) tableau[i] )->elmt == i, result );
+		TEST( tableau[i] != (intptr_t) &elmts[49-i], result );
+	}
+	liberer_ensemble( ens );
+
+	return result;
+}
+
+static int comparer_entiers( const intptr_t a, const intptr_t b ){
+	return ( a > b ) - ( a < b );
+}
+
+/*
+ * Vérifie les statistiques d'ordre d'un ensemble dont les 'n' éléments 
+ * sont ceux de 'ref', triés et espacés d'au moins 2.
+ */
+static int statistiques_correctes(
+	const Ensemble* ens, const intptr_t* ref, unsigned int n
+){
+	int result = 1;
+	unsigned int k;
+	TEST( taille_ensemble( ens ) == n, result );
+	TEST( min_ensemble( ens ) == ref[0], result );
+	TEST( max_ensemble( ens ) == ref[n-1], result );
+	TEST( get_element( dernier_iterateur_ensemble( ens ) ) == ref[n-1], result );
+	for( k=0; k<n; k++ ){
+		Ensemble_iterateur it = ieme_iterateur_ensemble( ens, k );
+		TEST( ! iterateur_ensemble_est_vide( it ), result );
+		TEST( get_element( it ) == ref[k], result );
+		TEST( rang_dans_l_ensemble( ens, ref[k] ) == k, result );
+		TEST( rang_dans_l_ensemble( ens, ref[k] + 1 ) == k + 1, result );
+		// L'itérateur obtenu par le rang se parcourt comme les autres.
+		if( k + 1 < n ){
+			TEST( get_element( iterateur_suivant_ensemble( it ) ) == ref[k+1], result );
+		}
+	}
+	TEST( iterateur_ensemble_est_vide( ieme_iterateur_ensemble( ens, n ) ), result );
+	TEST( rang_dans_l_ensemble( ens, ref[0] - 1 ) == 0, result );
+
+	TEST( nombre_d_elements_entre( ens, ref[0], ref[n-1] ) == n, result );
+	TEST( nombre_d_elements_entre( ens, ref[0] - 1, ref[n-1] + 1 ) == n, result );
+	TEST( nombre_d_elements_entre( ens, ref[0] + 1, ref[n-1] - 1 ) == n - 2, result );
+	TEST( nombre_d_elements_entre( ens, ref[n/3], ref[n/2] ) == n/2 - n/3 + 1, result );
+	TEST( nombre_d_elements_entre( ens, ref[1], ref[0] ) == 0, result );
+	return result;
+}
+
+int test_statistiques_d_ordre(){
+	int result = 1;
+	intptr_t ref[2000];
+	unsigned int i, n;
+	Ensemble* ens;
+
+	// Un petit tableau.
+	intptr_t petit[3] = { -3, 5, 10 };
+	ens = creer_ensemble_depuis_tableau( NULL, NULL, NULL, petit, 3 );
+	TEST( ens->representation == ENSEMBLE_TABLEAU, result );
+	TEST( statistiques_correctes( ens, petit, 3 ), result );
+	liberer_ensemble( ens );
+
+	// Un tableau de bits, dont les premiers mots sont vides.
+	ens = creer_ensemble( NULL, NULL, NULL );
+	for( i=0; i<1000; i++ ){
+		ajouter_element( ens, 3*i );
+	}
+	for( i=0; i<100; i++ ){
+		retirer_element( ens, 3*i );
+	}
+	n = 0;
+	for( i=100; i<1000; i++ ) ref[n++] = 3*i;
+	TEST( ens->representation == ENSEMBLE_BITSET, result );
+	TEST( statistiques_correctes( ens, ref, n ), result );
+	TEST( rang_dans_l_ensemble( ens, -1000000 ) == 0, result );
+	TEST( rang_dans_l_ensemble( ens, 1000000 ) == n, result );
+	liberer_ensemble( ens );
+
+	// Un ensemble compressé, avec des éléments négatifs.
+	n = 0;
+	for( i=0; i<2000; i++ ) ref[n++] = ( (intptr_t) i - 1000 ) * 100003;
+	ens = creer_ensemble_depuis_tableau( NULL, NULL, NULL, ref, n );
+	TEST( ens->representation == ENSEMBLE_COMPRESSE, result );
+	TEST( statistiques_correctes( ens, ref, n ), result );
+	liberer_ensemble( ens );
+
+	// Un arbre, construit élément par élément dans le désordre.
+	ens = creer_ensemble( comparer_entiers, NULL, NULL );
+	for( i=0; i<2000; i++ ){
+		ajouter_element( ens, 2 * ( ( i * 7919 ) % 2000 ) );
+	}
+	for( i=0; i<2000; i+=3 ){
+		retirer_element( ens, 2*i );
+	}
+	n = 0;
+	for( i=0; i<2000; i++ ){
+		if( i % 3 ) ref[n++] = 2*i;
+	}
+	TEST( ens->representation == ENSEMBLE_ARBRE, result );
+	TEST( statistiques_correctes( ens, ref, n ), result );
+	liberer_ensemble( ens );
+
+	return result;
+}
+
 int main(){
 	int result = 1;
 
@@ -953,6 +1499,7 @@ int main(){
 	result &= test_taille_ensemble();
 	result &= test_comparer_ensemble();
 	result &= test_copier_ensemble();
+	result &= test_copie_independante();
 	result &= test_pour_tout_element();
 //	result &= test_print_ensemble();
 	result &= test_swap_ensemble();
@@ -962,6 +1509,12 @@ int main(){
 	result &= test_iterateur_precedent_ensemble();
 	result &= test_iterateur_ensemble_est_vide();
 	result &= test_get_element();
+	result &= test_petit_ensemble();
+	result &= test_ensemble_d_entiers();
+	result &= test_operations_ensemblistes();
+	result &= test_creer_ensemble_depuis_tableau();
+	result &= test_inclusion_et_intersection();
+	result &= test_statistiques_d_ordre();
 
 	if( ! result ){
 		fprintf( stderr, "Certains tests du fichier %s ont échoués.\n", __FILE__ );
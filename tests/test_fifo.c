@@ -0,0 +1,172 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "fifo.h"
+#include "outils.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+int test_ajouter_retirer_fifo(){
+	int result = 1;
+	int i;
+
+	Fifo* fifo = creer_fifo();
+	TEST( est_vide( fifo ), result );
+
+	// Les éléments sortent dans l'ordre où ils sont entrés, y compris quand
+	// le tableau circulaire s'agrandit alors que la file a fait le tour.
+	for( i=0; i<10; i++ ){
+		ajouter_fifo( fifo, i );
+	}
+	int dans_l_ordre = 1;
+	for( i=0; i<8; i++ ){
+		dans_l_ordre &= ( retirer_fifo( fifo ) == i );
+	}
+	TEST( dans_l_ordre, result );
+	for( i=10; i<1000; i++ ){
+		ajouter_fifo( fifo, i );
+	}
+	TEST( taille_fifo( fifo ) == 992, result );
+	TEST( obtenir_fifo( fifo ) == 8, result );
+	TEST( obtenir_fin_fifo( fifo ) == 999, result );
+	for( i=8; i<1000; i++ ){
+		dans_l_ordre &= ( retirer_fifo( fifo ) == i );
+	}
+	TEST( dans_l_ordre, result );
+	TEST( est_vide( fifo ), result );
+
+	// Utilisation comme file à double entrée.
+	ajouter_fifo( fifo, 1 );
+	ajouter_debut_fifo( fifo, 0 );
+	ajouter_fifo( fifo, 2 );
+	ajouter_debut_fifo( fifo, -1 );
+	TEST( taille_fifo( fifo ) == 4, result );
+	TEST( obtenir_fifo( fifo ) == -1, result );
+	intptr_t a = retirer_fin_fifo( fifo );
+	intptr_t b = retirer_fin_fifo( fifo );
+	intptr_t c = retirer_fifo( fifo );
+	intptr_t d = retirer_fin_fifo( fifo );
+	TEST( a == 2 && b == 1 && c == -1 && d == 0, result );
+	TEST( est_vide( fifo ), result );
+
+	// Utilisation comme pile.
+	for( i=0; i<100; i++ ){
+		ajouter_debut_fifo( fifo, i );
+	}
+	dans_l_ordre = 1;
+	for( i=99; i>=0; i-- ){
+		dans_l_ordre &= ( retirer_fifo( fifo ) == i );
+	}
+	TEST( dans_l_ordre, result );
+
+	liberer_fifo( fifo );
+
+	return result;
+}
+
+int test_tableau_fifo(){
+	int result = 1;
+	int i;
+	intptr_t elements[100];
+	intptr_t sortis[100];
+
+	for( i=0; i<100; i++ ){
+		elements[i] = i;
+	}
+	Fifo* fifo = creer_fifo();
+	size_t nb = retirer_tableau_fifo( fifo, sortis, 10 );
+	TEST( nb == 0, result );
+	ajouter_tableau_fifo( fifo, elements, 0 );
+	TEST( est_vide( fifo ), result );
+
+	// Le tableau circulaire fait le tour entre deux ajouts groupés.
+	ajouter_tableau_fifo( fifo, elements, 12 );
+	nb = retirer_tableau_fifo( fifo, sortis, 10 );
+	TEST( nb == 10, result );
+	TEST( sortis[0] == 0 && sortis[9] == 9, result );
+	ajouter_tableau_fifo( fifo, elements + 12, 10 );
+	TEST( taille_fifo( fifo ) == 12, result );
+	nb = retirer_tableau_fifo( fifo, sortis, 100 );
+	TEST( nb == 12, result );
+	int dans_l_ordre = 1;
+	for( i=0; i<12; i++ ){
+		dans_l_ordre &= ( sortis[i] == i + 10 );
+	}
+	TEST( dans_l_ordre, result );
+
+	ajouter_fifo( fifo, -1 );
+	ajouter_tableau_fifo( fifo, elements, 100 );
+	TEST( taille_fifo( fifo ) == 101, result );
+	intptr_t premier = retirer_fifo( fifo );
+	TEST( premier == -1, result );
+	nb = retirer_tableau_fifo( fifo, sortis, 100 );
+	TEST( nb == 100, result );
+	dans_l_ordre = 1;
+	for( i=0; i<100; i++ ){
+		dans_l_ordre &= ( sortis[i] == i );
+	}
+	TEST( dans_l_ordre, result );
+
+	liberer_fifo( fifo );
+
+	return result;
+}
+
+int test_vider_fifo(){
+	int result = 1;
+	int i;
+
+	Fifo* fifo = creer_fifo();
+	reserver_fifo( fifo, 1000000 );
+	for( i=0; i<1000000; i++ ){
+		ajouter_fifo( fifo, i );
+	}
+	vider_fifo( fifo );
+	TEST( est_vide( fifo ), result );
+	ajouter_fifo( fifo, 7 );
+	intptr_t element = retirer_fifo( fifo );
+	TEST( element == 7, result );
+
+	// Libérer une file très longue ne parcourt pas ses éléments.
+	for( i=0; i<1000000; i++ ){
+		ajouter_fifo( fifo, i );
+	}
+	liberer_fifo( fifo );
+
+	return result;
+}
+
+int main(){
+
+	int result = 1;
+
+	result &= test_ajouter_retirer_fifo();
+	result &= test_tableau_fifo();
+	result &= test_vider_fifo();
+
+	if( ! result ){
+		fprintf( stderr, "Certains tests du fichier %s ont échoués.\n", __FILE__ );
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,245 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "file_mpmc.h"
+#include "outils.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NB_PRODUCTEURS 4
+#define NB_CONSOMMATEURS 4
+#define NB_PAR_PRODUCTEUR 50000
+#define NB_ELEMENTS ( NB_PRODUCTEURS * NB_PAR_PRODUCTEUR )
+
+int test_file_mpmc_un_thread(){
+	int result = 1;
+	int i;
+	intptr_t element;
+
+	File_mpmc* file = creer_file_mpmc( 5 );
+	TEST( capacite_file_mpmc( file ) == 8, result );
+	int vide = ! retirer_file_mpmc( file, &element );
+	TEST( vide, result );
+
+	// La file fait plusieurs fois le tour de son tableau.
+	int dans_l_ordre = 1;
+	int suivant = 0;
+	for( i=0; i<100; i++ ){
+		dans_l_ordre &= ajouter_file_mpmc( file, i );
+		if( i >= 5 ){
+			dans_l_ordre &= retirer_file_mpmc( file, &element );
+			dans_l_ordre &= ( element == suivant++ );
+		}
+	}
+	TEST( dans_l_ordre, result );
+
+	// La file se remplit, puis refuse les ajouts.
+	while( ajouter_file_mpmc( file, i ) ){
+		i++;
+	}
+	int nb = 0;
+	while( retirer_file_mpmc( file, &element ) ){
+		dans_l_ordre &= ( element == suivant++ );
+		nb++;
+	}
+	TEST( dans_l_ordre, result );
+	TEST( nb == 8, result );
+	TEST( suivant == i, result );
+
+	liberer_file_mpmc( file );
+	return result;
+}
+
+typedef struct {
+	File_mpmc* file;
+	File_bloquante* bloquante;
+	int numero;
+	// Éléments retirés par un consommateur, dans l'ordre.
+	intptr_t* recus;
+	int nb_recus;
+	// Nombre total d'éléments à retirer, partagé par les consommateurs.
+	atomic_int* restants;
+} Travailleur;
+
+void* produire( void* data ){
+	Travailleur* t = (Travailleur*) data;
+	int i;
+	for( i=0; i<NB_PAR_PRODUCTEUR; i++ ){
+		intptr_t element = (intptr_t) t->numero * NB_PAR_PRODUCTEUR + i;
+		if( t->bloquante ){
+			ajouter_file_bloquante( t->bloquante, element );
+		}else{
+			while( ! ajouter_file_mpmc( t->file, element ) ){
+				sched_yield();
+			}
+		}
+	}
+	return NULL;
+}
+
+void* consommer( void* data ){
+	Travailleur* t = (Travailleur*) data;
+	intptr_t element;
+	if( t->bloquante ){
+		while( retirer_file_bloquante( t->bloquante, &element ) ){
+			t->recus[ t->nb_recus++ ] = element;
+		}
+		return NULL;
+	}
+	while( atomic_load( t->restants ) > 0 ){
+		if( retirer_file_mpmc( t->file, &element ) ){
+			atomic_fetch_sub( t->restants, 1 );
+			t->recus[ t->nb_recus++ ] = element;
+		}else{
+			sched_yield();
+		}
+	}
+	return NULL;
+}
+
+/*
+ * Vérifie que chaque élément a été reçu exactement une fois, et que chaque
+ * consommateur a reçu les éléments d'un même producteur dans l'ordre où ils
+ * ont été ajoutés.
+ */
+int verifier_reception( Travailleur* consommateurs ){
+	int result = 1;
+	int i, c;
+	char* vus = calloc( NB_ELEMENTS, 1 );
+	for( c=0; c<NB_CONSOMMATEURS; c++ ){
+		intptr_t derniers[NB_PRODUCTEURS];
+		for( i=0; i<NB_PRODUCTEURS; i++ ){
+			derniers[i] = -1;
+		}
+		int dans_l_ordre = 1;
+		for( i=0; i<consommateurs[c].nb_recus; i++ ){
+			intptr_t element = consommateurs[c].recus[i];
+			int producteur = element / NB_PAR_PRODUCTEUR;
+			dans_l_ordre &= ( element > derniers[producteur] );
+			derniers[producteur] = element;
+			vus[element]++;
+		}
+		TEST( dans_l_ordre, result );
+	}
+	int une_fois = 1;
+	for( i=0; i<NB_ELEMENTS; i++ ){
+		une_fois &= ( vus[i] == 1 );
+	}
+	TEST( une_fois, result );
+	free( vus );
+	return result;
+}
+
+int executer( File_mpmc* file, File_bloquante* bloquante ){
+	int i;
+	atomic_int restants;
+	atomic_init( &restants, NB_ELEMENTS );
+	pthread_t producteurs[NB_PRODUCTEURS];
+	pthread_t consommateurs[NB_CONSOMMATEURS];
+	Travailleur p[NB_PRODUCTEURS];
+	Travailleur c[NB_CONSOMMATEURS];
+	for( i=0; i<NB_CONSOMMATEURS; i++ ){
+		c[i].file = file;
+		c[i].bloquante = bloquante;
+		c[i].recus = xmalloc( NB_ELEMENTS * sizeof(intptr_t) );
+		c[i].nb_recus = 0;
+		c[i].restants = &restants;
+		pthread_create( &consommateurs[i], NULL, consommer, &c[i] );
+	}
+	for( i=0; i<NB_PRODUCTEURS; i++ ){
+		p[i].file = file;
+		p[i].bloquante = bloquante;
+		p[i].numero = i;
+		pthread_create( &producteurs[i], NULL, produire, &p[i] );
+	}
+	for( i=0; i<NB_PRODUCTEURS; i++ ){
+		pthread_join( producteurs[i], NULL );
+	}
+	if( bloquante ){
+		fermer_file_bloquante( bloquante );
+	}
+	for( i=0; i<NB_CONSOMMATEURS; i++ ){
+		pthread_join( consommateurs[i], NULL );
+	}
+	int result = verifier_reception( c );
+	for( i=0; i<NB_CONSOMMATEURS; i++ ){
+		xfree( c[i].recus );
+	}
+	return result;
+}
+
+int test_file_mpmc_plusieurs_threads(){
+	// Une petite capacité oblige les threads à se gêner souvent.
+	File_mpmc* file = creer_file_mpmc( 64 );
+	int result = executer( file, NULL );
+	liberer_file_mpmc( file );
+	return result;
+}
+
+int test_file_bloquante(){
+	int result = 1;
+	intptr_t element;
+
+	File_bloquante* file = creer_file_bloquante( 4 );
+	result &= executer( NULL, file );
+	// La file est fermée et vide.
+	int retire = retirer_file_bloquante( file, &element );
+	int ajoute = ajouter_file_bloquante( file, 1 );
+	TEST( ! retire && ! ajoute, result );
+	liberer_file_bloquante( file );
+
+	// Les éléments restants peuvent être retirés après la fermeture.
+	file = creer_file_bloquante( 4 );
+	ajouter_file_bloquante( file, 1 );
+	ajouter_file_bloquante( file, 2 );
+	fermer_file_bloquante( file );
+	retire = retirer_file_bloquante( file, &element );
+	TEST( retire && element == 1, result );
+	retire = retirer_file_bloquante( file, &element );
+	TEST( retire && element == 2, result );
+	retire = retirer_file_bloquante( file, &element );
+	TEST( ! retire, result );
+	liberer_file_bloquante( file );
+
+	return result;
+}
+
+int main(){
+
+	int result = 1;
+
+	result &= test_file_mpmc_un_thread();
+	result &= test_file_mpmc_plusieurs_threads();
+	result &= test_file_bloquante();
+
+	if( ! result ){
+		fprintf( stderr, "Certains tests du fichier %s ont échoués.\n", __FILE__ );
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,302 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "outils.h"
+
+#include <pthread.h>
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef OUTILS_STATISTIQUES
+
+static Statistiques_memoire statistiques_de( const char* etiquette ){
+	Statistiques_memoire stats[1024 + 1];
+	size_t nb = statistiques_memoire_par_etiquette( stats, 1024 + 1 );
+	size_t i;
+	for( i=0; i<nb; i++ ){
+		if( stats[i].etiquette == etiquette ){
+			return stats[i];
+		}
+	}
+	Statistiques_memoire vide = { etiquette, 0, 0, 0, 0, 0 };
+	return vide;
+}
+
+int test_statistiques_memoire(){
+	int result = 1;
+
+	Statistiques_memoire avant = statistiques_memoire();
+	char* bloc = xmalloc( 100 );
+	Statistiques_memoire pendant = statistiques_memoire();
+	TEST( pendant.nb_allocations == avant.nb_allocations + 1, result );
+	TEST( pendant.octets_alloues == avant.octets_alloues + 100, result );
+	TEST( pendant.octets_vivants == avant.octets_vivants + 100, result );
+	TEST( pendant.pic_octets_vivants >= pendant.octets_vivants, result );
+
+	xfree( bloc );
+	xfree( NULL );
+	Statistiques_memoire apres = statistiques_memoire();
+	TEST( apres.nb_liberations == avant.nb_liberations + 1, result );
+	TEST( apres.octets_vivants == avant.octets_vivants, result );
+	TEST( apres.pic_octets_vivants == pendant.pic_octets_vivants, result );
+
+	return result;
+}
+
+int test_etiquettes(){
+	int result = 1;
+	int i;
+
+	static const char* const etiquette = "test_etiquettes";
+	char* blocs[3];
+	const char* precedente = etiqueter_allocations( etiquette );
+	TEST( precedente == NULL, result );
+	for( i=0; i<3; i++ ){
+		blocs[i] = xmalloc( 10 * (i+1) );
+	}
+	const char* courante = etiqueter_allocations( precedente );
+	TEST( courante == etiquette, result );
+
+	// Ce bloc est attribué à l'endroit de l'appel, pas à l'étiquette.
+	char* autre = xmalloc( 1000 );
+
+	Statistiques_memoire stats = statistiques_de( etiquette );
+	TEST( stats.nb_allocations == 3, result );
+	TEST( stats.octets_vivants == 60, result );
+	TEST( stats.pic_octets_vivants == 60, result );
+
+	for( i=0; i<3; i++ ){
+		xfree( blocs[i] );
+	}
+	stats = statistiques_de( etiquette );
+	TEST( stats.nb_liberations == 3, result );
+	TEST( stats.octets_vivants == 0, result );
+	TEST( stats.pic_octets_vivants == 60, result );
+
+	// Après une remise à zéro, le pic repart de la mémoire vivante.
+	reinitialiser_statistiques_memoire();
+	stats = statistiques_de( etiquette );
+	TEST( stats.nb_allocations == 0, result );
+	TEST( stats.pic_octets_vivants == 0, result );
+	Statistiques_memoire total = statistiques_memoire();
+	TEST( total.nb_allocations == 0, result );
+	TEST( total.pic_octets_vivants == total.octets_vivants, result );
+	TEST( total.octets_vivants >= 1000, result );
+
+	xfree( autre );
+
+	FILE* flux = fopen( "/dev/null", "w" );
+	if( flux ){
+		afficher_statistiques_memoire( flux );
+		fclose( flux );
+	}
+
+	return result;
+}
+
+#endif
+
+typedef struct {
+	Allocateur allocateur;
+	size_t nb_allouer;
+	size_t nb_liberer;
+	size_t octets_vivants;
+} Allocateur_compteur;
+
+static void* allouer_compteur( Allocateur* allocateur, size_t n ){
+	Allocateur_compteur* a = (Allocateur_compteur*) allocateur;
+	a->nb_allouer++;
+	a->octets_vivants += n;
+	return malloc( n );
+}
+
+static void liberer_compteur( Allocateur* allocateur, void* bloc, size_t n ){
+	Allocateur_compteur* a = (Allocateur_compteur*) allocateur;
+	a->nb_liberer++;
+	a->octets_vivants -= n;
+	free( bloc );
+}
+
+int test_changer_allocateur(){
+	int result = 1;
+	int i;
+
+	Allocateur_compteur compteur = {
+		{ allouer_compteur, liberer_compteur }, 0, 0, 0
+	};
+	Allocateur* precedent = changer_allocateur( &compteur.allocateur );
+	TEST( precedent == NULL, result );
+
+	int* tableau = xmalloc( 10 * sizeof(int) );
+	for( i=0; i<10; i++ ){
+		tableau[i] = i;
+	}
+	TEST( compteur.nb_allouer == 1, result );
+	TEST( compteur.octets_vivants >= 10 * sizeof(int), result );
+	xfree( tableau );
+	TEST( compteur.nb_liberer == 1, result );
+	TEST( compteur.octets_vivants == 0, result );
+
+	Allocateur* courant = changer_allocateur( precedent );
+	TEST( courant == &compteur.allocateur, result );
+
+	tableau = xmalloc( sizeof(int) );
+	xfree( tableau );
+	TEST( compteur.nb_allouer == 1, result );
+
+	return result;
+}
+
+int test_arene(){
+	int result = 1;
+	int i;
+
+#ifdef OUTILS_STATISTIQUES
+	Statistiques_memoire avant = statistiques_memoire();
+#endif
+	Arene* arene = creer_arene();
+	TEST( ! arene_est_utilisee(), result );
+	Arene* precedente = utiliser_arene( arene );
+	TEST( precedente == NULL, result );
+	TEST( arene_est_utilisee(), result );
+
+	// Des blocs de toutes tailles, dont certains plus grands qu'une dalle, 
+	// alignés comme ceux de malloc() et qui ne se recouvrent pas.
+#ifdef OUTILS_STATISTIQUES
+	Statistiques_memoire debut = statistiques_memoire();
+#endif
+	char* blocs[200];
+	int conforme = 1;
+	for( i=0; i<200; i++ ){
+		size_t taille = ( i % 7 == 0 ) ? 10000 + i : (size_t) i + 1;
+		blocs[i] = xmalloc( taille );
+		memset( blocs[i], i, taille );
+		conforme &= est_dans_une_arene( blocs[i] );
+		conforme &= ( (uintptr_t) blocs[i] % alignof(max_align_t) == 0 );
+	}
+	for( i=0; i<200; i++ ){
+		conforme &= ( blocs[i][0] == (char) i );
+		// Ne fait rien : le bloc est rendu avec l'arène.
+		xfree( blocs[i] );
+	}
+	TEST( conforme, result );
+	TEST( blocs[1][0] == 1 && blocs[1][1] == 1, result );
+#ifdef OUTILS_STATISTIQUES
+	Statistiques_memoire pendant = statistiques_memoire();
+	// Seules les dalles de l'arène sont comptées.
+	TEST( pendant.nb_allocations - debut.nb_allocations < 20, result );
+	TEST( pendant.nb_liberations == debut.nb_liberations, result );
+#endif
+
+	Arene* utilisee = utiliser_arene( precedente );
+	TEST( utilisee == arene, result );
+	TEST( ! arene_est_utilisee(), result );
+	char* bloc = xmalloc( 10 );
+	TEST( ! est_dans_une_arene( bloc ), result );
+	xfree( bloc );
+
+	liberer_arene( arene );
+	rendre_dalles_libres();
+#ifdef OUTILS_STATISTIQUES
+	Statistiques_memoire apres = statistiques_memoire();
+	TEST( apres.octets_vivants == avant.octets_vivants, result );
+#endif
+	liberer_arene( NULL );
+
+	// Les dalles rendues sont réutilisées, et remises à zéro.
+	arene = creer_arene();
+	precedente = utiliser_arene( arene );
+	char* grand = xmalloc( 100000 );
+	utiliser_arene( precedente );
+	TEST( est_dans_une_arene( grand ), result );
+	TEST( grand[50000] == 0, result );
+	memset( grand, 1, 100000 );
+	liberer_arene( arene );
+	rendre_dalles_libres();
+	arene = creer_arene();
+	precedente = utiliser_arene( arene );
+	char* autre = xmalloc( 100000 );
+	utiliser_arene( precedente );
+	TEST( autre == grand, result );
+	TEST( autre[50000] == 0, result );
+	liberer_arene( arene );
+
+	return result;
+}
+
+static void* detruire_une_arene( void* data ){
+	Arene* arene = creer_arene();
+	Arene* precedente = utiliser_arene( arene );
+	*(char**) data = xmalloc( 100000 );
+	utiliser_arene( precedente );
+	// La dalle est gardée par le thread, jusqu'à ce qu'il se termine.
+	liberer_arene( arene );
+	return NULL;
+}
+
+int test_dalles_d_un_thread_termine(){
+	int result = 1;
+
+	rendre_dalles_libres();
+	char* bloc_du_thread = NULL;
+	pthread_t thread;
+	int cree = pthread_create( &thread, NULL, detruire_une_arene, &bloc_du_thread ) == 0;
+	TEST( cree, result );
+	if( cree ){
+		pthread_join( thread, NULL );
+	}
+
+	// La dalle du thread a été rendue : elle sert à la prochaine arène.
+	Arene* arene = creer_arene();
+	Arene* precedente = utiliser_arene( arene );
+	char* bloc = xmalloc( 100000 );
+	utiliser_arene( precedente );
+	TEST( bloc_du_thread != NULL && bloc == bloc_du_thread, result );
+	liberer_arene( arene );
+	rendre_dalles_libres();
+
+	return result;
+}
+
+int main(){
+	int result = 1;
+
+#ifdef OUTILS_STATISTIQUES
+	result &= test_statistiques_memoire();
+	result &= test_etiquettes();
+#endif
+	result &= test_changer_allocateur();
+	result &= test_arene();
+	result &= test_dalles_d_un_thread_termine();
+
+	if( ! result ){
+		fprintf( stderr, "Certains tests du fichier %s ont échoués.\n", __FILE__ );
+		return 1;
+	}
+	return 0;
+}
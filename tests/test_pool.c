@@ -0,0 +1,122 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "pool.h"
+#include "table.h"
+#include "outils.h"
+
+#include <stdint.h>
+
+int test_allouer_bloc(){
+	int result = 1;
+	int i;
+
+	Pool * pool = creer_pool( 3 );
+	TEST( pool->taille_bloc == sizeof(void*), result );
+
+	intptr_t* blocs[2000];
+	for( i=0; i<2000; i++ ){
+		blocs[i] = allouer_bloc( pool );
+		*blocs[i] = i;
+	}
+	for( i=0; i<2000; i++ ){
+		TEST( *blocs[i] == i, result );
+	}
+
+	// Un bloc rendu est réutilisé par l'allocation suivante.
+	liberer_bloc( pool, blocs[10] );
+	TEST( allouer_bloc( pool ) == blocs[10], result );
+
+	vider_pool( pool );
+	TEST( pool->dalles == NULL, result );
+	blocs[0] = allouer_bloc( pool );
+	*blocs[0] = 1;
+	TEST( *blocs[0] == 1, result );
+
+	liberer_pool( pool );
+
+	return result;
+}
+
+int test_reserver_pool(){
+	int result = 1;
+	int i;
+
+	Pool * pool = creer_pool( sizeof(intptr_t) );
+	allouer_bloc( pool );
+	reserver_pool( pool, 5000 );
+	char* premier = allouer_bloc( pool );
+	int contigus = 1;
+	for( i=1; i<5000; i++ ){
+		contigus &= ( (char*) allouer_bloc( pool ) == premier + i * pool->taille_bloc );
+	}
+	TEST( contigus, result );
+	// Les allocations suivantes continuent normalement.
+	intptr_t* bloc = allouer_bloc( pool );
+	*bloc = 42;
+	TEST( *bloc == 42, result );
+
+	// Une réservation déjà couverte par la dalle courante n'alloue rien.
+	reserver_pool( pool, 1 );
+	TEST( (intptr_t*) allouer_bloc( pool ) != bloc, result );
+	liberer_pool( pool );
+
+	return result;
+}
+
+int test_table_et_pool(){
+	int result = 1;
+	int i;
+
+	Table * table = creer_table( NULL, NULL, NULL );
+	for( i=0; i<5000; i++ ){
+		add_table( table, i, 2*i );
+	}
+	for( i=0; i<5000; i+=2 ){
+		delete_table( table, i );
+	}
+	for( i=0; i<5000; i++ ){
+		TEST( iterateur_est_vide( trouver_table( table, i ) ) == ( i%2 == 0 ), result );
+	}
+	vider_table( table );
+	TEST( iterateur_est_vide( premier_iterateur_table( table ) ), result );
+	add_table( table, 3, 4 );
+	TEST( get_valeur( trouver_table( table, 3 ) ) == 4, result );
+	liberer_table( table );
+
+	return result;
+}
+
+int main(){
+
+	int result = 1;
+
+	result &= test_allouer_bloc();
+	result &= test_reserver_pool();
+	result &= test_table_et_pool();
+
+	if( ! result ){
+		fprintf( stderr, "Certains tests du fichier %s ont échoués.\n", __FILE__ );
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,173 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "registre.h"
+#include "ensemble.h"
+#include "outils.h"
+
+#include <stdint.h>
+
+static Ensemble* creer_ensemble_d_elmts( const intptr_t* elements, int nb ){
+	Ensemble* ens = creer_ensemble( NULL, NULL, NULL );
+	int i;
+	for( i=0; i<nb; i++ ){
+		ajouter_element( ens, elements[i] );
+	}
+	return ens;
+}
+
+// Ne garde que les 32 bits de poids faible : 0 et 2^32 ont le même haché.
+static size_t hacher_32_bits( const intptr_t elem ){
+	return (uint32_t) elem;
+}
+
+int test_ensembles_egaux(){
+	int result = 1;
+	int i;
+
+	intptr_t a[] = { 3, 1, 2 };
+	intptr_t b[] = { 1, 2, 3, 2 };
+	Ensemble* e1 = creer_ensemble_d_elmts( a, 3 );
+	Ensemble* e2 = creer_ensemble_d_elmts( b, 4 );
+	TEST( ensembles_egaux( e1, e2 ), result );
+	TEST( hacher_ensemble( e1, NULL ) == hacher_ensemble( e2, NULL ), result );
+	ajouter_element( e2, 4 );
+	TEST( ! ensembles_egaux( e1, e2 ), result );
+	retirer_element( e2, 4 );
+	TEST( ensembles_egaux( e1, e2 ), result );
+	liberer_ensemble( e1 );
+	liberer_ensemble( e2 );
+
+	// Le hachage ne dépend pas de la représentation : e1 est un tableau de 
+	// bits, e2 un arbre, e3 un tableau trié.
+	e1 = creer_ensemble( NULL, NULL, NULL );
+	e2 = creer_ensemble( NULL, NULL, NULL );
+	for( i=0; i<200; i++ ){
+		ajouter_element( e1, i );
+		ajouter_element( e2, 1000000 * i );
+	}
+	ajouter_element( e2, 3 );
+	for( i=0; i<200; i++ ){
+		retirer_element( e2, 1000000 * i );
+	}
+	for( i=10; i<200; i++ ){
+		retirer_element( e1, i );
+	}
+	retirer_element( e1, 0 );
+	retirer_element( e1, 1 );
+	retirer_element( e1, 2 );
+	for( i=4; i<10; i++ ){
+		retirer_element( e1, i );
+	}
+	Ensemble* e3 = creer_ensemble( NULL, NULL, NULL );
+	ajouter_element( e3, 3 );
+	TEST( ensembles_egaux( e1, e2 ) && ensembles_egaux( e2, e3 ), result );
+	TEST( hacher_ensemble( e1, NULL ) == hacher_ensemble( e2, NULL ), result );
+	TEST( hacher_ensemble( e1, NULL ) == hacher_ensemble( e3, NULL ), result );
+	liberer_ensemble( e1 );
+	liberer_ensemble( e2 );
+	liberer_ensemble( e3 );
+
+	return result;
+}
+
+int test_interner_ensemble(){
+	int result = 1;
+	int i;
+
+	Registre* registre = creer_registre( NULL );
+	Ensemble* vide = creer_ensemble( NULL, NULL, NULL );
+	TEST( chercher_registre( registre, vide ) == -1, result );
+	int id = interner_ensemble( registre, vide );
+	TEST( id == 0, result );
+	id = interner_ensemble( registre, vide );
+	TEST( id == 0, result );
+	TEST( nombre_ensembles_registre( registre ) == 1, result );
+
+	// Les parties de { 0, ..., 9 } reçoivent des identifiants distincts, 
+	// attribués dans l'ordre.
+	for( i=0; i<1024; i++ ){
+		Ensemble* ens = creer_ensemble( NULL, NULL, NULL );
+		int j;
+		for( j=0; j<10; j++ ){
+			if( i & ( 1 << j ) ) ajouter_element( ens, j );
+		}
+		id = interner_ensemble_et_libere( registre, ens );
+		TEST( id == i, result );
+	}
+	TEST( nombre_ensembles_registre( registre ) == 1024, result );
+
+	intptr_t elements[] = { 9, 0, 5 };
+	Ensemble* ens = creer_ensemble_d_elmts( elements, 3 );
+	int attendu = ( 1 << 9 ) | ( 1 << 5 ) | 1;
+	TEST( chercher_registre( registre, ens ) == attendu, result );
+	id = interner_ensemble( registre, ens );
+	TEST( id == attendu, result );
+	TEST( get_taille_registre( registre, id ) == 3, result );
+	TEST( get_hache_registre( registre, id ) == hacher_ensemble( ens, NULL ), result );
+	TEST( ensembles_egaux( get_ensemble_registre( registre, id ), ens ), result );
+	// Le registre garde sa propre copie.
+	TEST( get_ensemble_registre( registre, id ) != ens, result );
+	ajouter_element( ens, 100 );
+	TEST( chercher_registre( registre, ens ) == -1, result );
+	id = interner_ensemble( registre, ens );
+	TEST( id == 1024, result );
+	TEST( get_taille_registre( registre, id ) == 4, result );
+	TEST( get_taille_registre( registre, attendu ) == 3, result );
+
+	liberer_ensemble( ens );
+	liberer_ensemble( vide );
+	liberer_registre( registre );
+
+#if INTPTR_MAX > INT32_MAX
+	// Deux ensembles dont les hachés sont égaux mais qui diffèrent d'un 
+	// multiple de 2^32 reçoivent des identifiants distincts.
+	registre = creer_registre( hacher_32_bits );
+	Ensemble* e1 = creer_ensemble( NULL, NULL, NULL );
+	Ensemble* e2 = creer_ensemble( NULL, NULL, NULL );
+	ajouter_element( e1, 0 );
+	ajouter_element( e2, (intptr_t) 1 << 32 );
+	TEST( hacher_ensemble( e1, hacher_32_bits ) == hacher_ensemble( e2, hacher_32_bits ), result );
+	TEST( interner_ensemble( registre, e1 ) == 0, result );
+	TEST( interner_ensemble( registre, e2 ) == 1, result );
+	TEST( nombre_ensembles_registre( registre ) == 2, result );
+	liberer_ensemble( e1 );
+	liberer_ensemble( e2 );
+	liberer_registre( registre );
+#endif
+
+	return result;
+}
+
+int main(){
+
+	int result = 1;
+
+	result &= test_ensembles_egaux();
+	result &= test_interner_ensemble();
+
+	if( ! result ){
+		fprintf( stderr, "Certains tests du fichier %s ont échoués.\n", __FILE__ );
+		return 1;
+	}
+
+	return 0;
+}
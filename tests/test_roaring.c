@@ -0,0 +1,284 @@
+/*
+ *   Ce fichier fait partie d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux
+ *
+ *   Copyright (C) 2015 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "roaring.h"
+#include "outils.h"
+#include "tests/aleatoire.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// Les éléments testés sont dans [ -DECALAGE, TAILLE - DECALAGE [, soit 8 
+// conteneurs dont 4 de clé négative.
+#define TAILLE ( 1 << 19 )
+#define DECALAGE ( 1 << 18 )
+
+/*
+ * Remplit la référence d'éléments dont la densité dépend du conteneur, 
+ * pour obtenir des tableaux, des tableaux de bits et des plages.
+ */
+static void remplir_reference( char* ref, uint64_t* graine ){
+	size_t i;
+	memset( ref, 0, TAILLE );
+	for( i=0; i<TAILLE; i++ ){
+		switch( ( i >> 16 ) % 4 ){
+			case 0 : ref[i] = ( aleatoire( graine ) % 64 ) == 0; break;
+			case 1 : ref[i] = ( aleatoire( graine ) % 3 ) != 0; break;
+			case 2 : ref[i] = ( ( i >> 10 ) % 3 ) == 0; break;
+			default : break;
+		}
+	}
+}
+
+static void construire( Roaring* r, const char* ref ){
+	size_t i;
+	roaring_initialiser( r );
+	for( i=0; i<TAILLE; i++ ){
+		if( ref[i] ) roaring_ajouter( r, (intptr_t) i - DECALAGE );
+	}
+}
+
+static int est_conforme( const Roaring* r, const char* ref ){
+	int result = 1;
+	size_t i, cardinal = 0;
+	for( i=0; i<TAILLE; i++ ){
+		cardinal += ref[i];
+		if( roaring_contient( r, (intptr_t) i - DECALAGE ) != ref[i] ){
+			result = 0;
+		}
+	}
+	TEST( r->cardinal == cardinal, result );
+
+	// Parcours dans l'ordre croissant puis décroissant, et rangs.
+	intptr_t position = roaring_suivant( r, -1 );
+	size_t rang = 0;
+	for( i=0; i<TAILLE; i++ ){
+		if( i % 101 == 0 && roaring_rang( r, (intptr_t) i - DECALAGE ) != rang ){
+			return 0;
+		}
+		if( ! ref[i] ) continue;
+		if( position == -1 ||
+			roaring_element( r, position ) != (intptr_t) i - DECALAGE ||
+			roaring_position( r, (intptr_t) i - DECALAGE ) != position ||
+			roaring_ieme( r, rang ) != position
+		){
+			return 0;
+		}
+		position = roaring_suivant( r, position );
+		rang++;
+	}
+	TEST( roaring_ieme( r, rang ) == -1, result );
+	TEST( position == -1, result );
+	position = roaring_precedent( r, -1 );
+	for( i=TAILLE; i-- > 0; ){
+		if( ! ref[i] ) continue;
+		if( position == -1 ||
+			roaring_element( r, position ) != (intptr_t) i - DECALAGE
+		){
+			return 0;
+		}
+		position = roaring_precedent( r, position );
+	}
+	TEST( position == -1, result );
+	return result;
+}
+
+int test_ajouter_retirer(){
+	int result = 1;
+	Roaring r;
+	roaring_initialiser( &r );
+
+	TEST( roaring_suivant( &r, -1 ) == -1, result );
+	TEST( roaring_precedent( &r, -1 ) == -1, result );
+	TEST( roaring_position( &r, 3 ) == -1, result );
+
+	TEST( roaring_ajouter( &r, 3 ) == 1, result );
+	TEST( roaring_ajouter( &r, 3 ) == 0, result );
+	TEST( roaring_ajouter( &r, -5 ) == 1, result );
+	TEST( roaring_ajouter( &r, ( (intptr_t) 1 ) << 40 ) == 1, result );
+	TEST( r.cardinal == 3, result );
+	TEST( r.nb_conteneurs == 3, result );
+	TEST( roaring_contient( &r, -5 ), result );
+	TEST( ! roaring_contient( &r, 4 ), result );
+	TEST( roaring_element( &r, roaring_suivant( &r, -1 ) ) == -5, result );
+	TEST(
+		roaring_element( &r, roaring_precedent( &r, -1 ) ) == 
+			( (intptr_t) 1 ) << 40,
+		result
+	);
+
+	TEST( roaring_retirer( &r, 3 ) == 1, result );
+	TEST( roaring_retirer( &r, 3 ) == 0, result );
+	TEST( r.nb_conteneurs == 2, result );
+
+	// Passage d'un tableau à un tableau de bits, puis retour.
+	intptr_t i;
+	for( i=0; i<2*ROARING_TAILLE_MAX_TABLEAU; i++ ){
+		roaring_ajouter( &r, 65536 + 7*i );
+	}
+	TEST( r.conteneurs[1].type == ROARING_BITMAP, result );
+	for( i=0; i<2*ROARING_TAILLE_MAX_TABLEAU; i+=2 ){
+		roaring_retirer( &r, 65536 + 7*i );
+	}
+	TEST( r.conteneurs[1].cardinal == ROARING_TAILLE_MAX_TABLEAU, result );
+	for( i=1; i<2*ROARING_TAILLE_MAX_TABLEAU; i+=4 ){
+		roaring_retirer( &r, 65536 + 7*i );
+	}
+	TEST( r.conteneurs[1].type == ROARING_TABLEAU, result );
+	TEST( r.cardinal == 2 + ROARING_TAILLE_MAX_TABLEAU / 2, result );
+	TEST( roaring_contient( &r, 65536 + 7*3 ), result );
+	TEST( ! roaring_contient( &r, 65536 + 7*5 ), result );
+
+	roaring_liberer( &r );
+	return result;
+}
+
+int test_plages(){
+	int result = 1;
+	Roaring r, copie;
+	intptr_t elements[ 3*65536 ];
+	size_t i;
+
+	for( i=0; i<3*65536; i++ ) elements[i] = (intptr_t) i - 65536 + 10;
+	roaring_initialiser( &r );
+	roaring_remplir( &r, elements, 3*65536 );
+	TEST( r.cardinal == 3*65536, result );
+	TEST( r.nb_conteneurs == 4, result );
+	for( i=0; i<r.nb_conteneurs; i++ ){
+		TEST( r.conteneurs[i].type == ROARING_PLAGES, result );
+	}
+	TEST( roaring_memoire( &r ) < 1024, result );
+	TEST( roaring_contient( &r, -65536 + 10 ), result );
+	TEST( ! roaring_contient( &r, -65536 + 9 ), result );
+	TEST( roaring_contient( &r, 2*65536 + 9 ), result );
+	TEST( ! roaring_contient( &r, 2*65536 + 10 ), result );
+
+	// Une modification isolée au milieu d'une plage.
+	roaring_copier( &copie, &r );
+	TEST( roaring_retirer( &copie, 100 ) == 1, result );
+	TEST( copie.cardinal == 3*65536 - 1, result );
+	TEST( ! roaring_contient( &copie, 100 ), result );
+	TEST( roaring_contient( &copie, 99 ) && roaring_contient( &copie, 101 ), result );
+	TEST( ! roaring_egaux( &r, &copie ), result );
+	TEST( roaring_ajouter( &copie, 100 ) == 1, result );
+	TEST( roaring_egaux( &r, &copie ), result );
+	TEST( roaring_element( &copie, roaring_precedent( &copie, -1 ) ) == 2*65536 + 9, result );
+
+	roaring_liberer( &copie );
+	roaring_liberer( &r );
+	return result;
+}
+
+int test_operations(){
+	int result = 1;
+	static char ref_a[ TAILLE ], ref_b[ TAILLE ], ref_res[ TAILLE ];
+	uint64_t graine = 0x9e3779b97f4a7c15;
+	Roaring a, b, res;
+	size_t i, commun;
+
+	remplir_reference( ref_a, &graine );
+	remplir_reference( ref_b, &graine );
+	// Décale b d'un conteneur pour croiser les représentations.
+	memmove( ref_b + 65536, ref_b, TAILLE - 65536 );
+	memset( ref_b, 1, 65536 );
+
+	construire( &a, ref_a );
+	construire( &b, ref_b );
+	TEST( est_conforme( &a, ref_a ), result );
+	TEST( est_conforme( &b, ref_b ), result );
+
+	commun = 0;
+	for( i=0; i<TAILLE; i++ ) commun += ref_a[i] && ref_b[i];
+	TEST( roaring_cardinal_intersection( &a, &b ) == commun, result );
+	TEST( roaring_se_coupent( &a, &b ) == ( commun > 0 ), result );
+
+	roaring_intersection( &res, &a, &b );
+	for( i=0; i<TAILLE; i++ ) ref_res[i] = ref_a[i] && ref_b[i];
+	TEST( est_conforme( &res, ref_res ), result );
+	roaring_liberer( &res );
+
+	roaring_copier( &res, &a );
+	roaring_union( &res, &b );
+	for( i=0; i<TAILLE; i++ ) ref_res[i] = ref_a[i] || ref_b[i];
+	TEST( est_conforme( &res, ref_res ), result );
+	roaring_liberer( &res );
+
+	roaring_copier( &res, &a );
+	roaring_difference( &res, &b );
+	for( i=0; i<TAILLE; i++ ) ref_res[i] = ref_a[i] && ! ref_b[i];
+	TEST( est_conforme( &res, ref_res ), result );
+	TEST( roaring_cardinal_intersection( &res, &b ) == 0, result );
+	TEST( ! roaring_se_coupent( &res, &b ), result );
+	roaring_difference( &res, &a );
+	TEST( res.cardinal == 0 && res.nb_conteneurs == 0, result );
+	roaring_liberer( &res );
+
+	roaring_liberer( &a );
+	roaring_liberer( &b );
+	return result;
+}
+
+int test_ajouter_mots(){
+	int result = 1;
+	static char ref[ TAILLE ];
+	uint64_t mots[ 3000 ];
+	uint64_t graine = 12345;
+	Roaring r;
+	size_t i;
+	// Le premier mot code l'entier -64*1000, à cheval sur deux conteneurs.
+	intptr_t premier_mot = -1000;
+
+	memset( ref, 0, TAILLE );
+	for( i=0; i<3000; i++ ){
+		mots[i] = aleatoire( &graine ) & aleatoire( &graine );
+		if( i > 2000 ) mots[i] = 0;
+		size_t j;
+		for( j=0; j<64; j++ ){
+			if( mots[i] & ( ( (uint64_t) 1 ) << j ) ){
+				ref[ ( premier_mot + (intptr_t) i ) * 64 + j + DECALAGE ] = 1;
+			}
+		}
+	}
+	roaring_initialiser( &r );
+	roaring_ajouter( &r, 5 );
+	ref[ 5 + DECALAGE ] = 1;
+	roaring_ajouter_mots( &r, mots, 3000, premier_mot );
+	TEST( est_conforme( &r, ref ), result );
+	roaring_liberer( &r );
+	return result;
+}
+
+int main(){
+	int result = 1;
+
+	result &= test_ajouter_retirer();
+	result &= test_plages();
+	result &= test_operations();
+	result &= test_ajouter_mots();
+
+	if( ! result ){
+		fprintf( stderr, "Certains tests du fichier %s ont échoués.\n", __FILE__ );
+		return 1;
+	}
+	return 0;
+}
@@ -23,6 +23,7 @@
 #include "outils.h"
 
 #include <stdarg.h>
+#include <string.h>
 
 #include "ensemble.h"
 
@@ -81,6 +82,11 @@ Cle * copier_cle( const Cle * cle ) {
 	return creer_cle( cle->cle );
 };
 
+// Fonction de hachage volontairement mauvaise, pour provoquer des collisions.
+size_t hacher_cle( const Cle * cle ) {
+	return cle->cle / 4;
+};
+
 
 int general_test(){
 	int result = 1;
@@ -395,6 +401,408 @@ int test_trouver_table(){
 	return result;
 }
 
+int test_chercher_table(){
+	int result = 1;
+	intptr_t valeur = 0;
+	Table * table = creer_table(
+		(int (*)( const intptr_t, const intptr_t )) comparer_cle, 
+		(intptr_t (*)( const intptr_t )) copier_cle, 
+		(void (*)(intptr_t)) supprimer_cle 
+	);
+
+	Cle cle;
+	initialiser_cle( &cle, 4 ); 	
+	add_table( table, (intptr_t) &cle, 40 );
+	initialiser_cle( &cle, 2 ); 	
+	add_table( table, (intptr_t) &cle, 20 );
+
+	initialiser_cle( &cle, 4 ); 	
+	TEST( chercher_table( table, (intptr_t) &cle, &valeur ), result );
+	TEST( valeur == 40, result );
+	TEST( chercher_table( table, (intptr_t) &cle, NULL ), result );
+	initialiser_cle( &cle, 3 ); 	
+	TEST( ! chercher_table( table, (intptr_t) &cle, &valeur ), result );
+	TEST( valeur == 40, result );
+
+	// La clé enregistrée est une copie de celle passée à add_table().
+	initialiser_cle( &cle, 2 ); 	
+	TEST( get_cle( trouver_table( table, (intptr_t) &cle ) ) != (intptr_t) &cle, result );
+	add_table( table, (intptr_t) &cle, 21 );
+	TEST( chercher_table( table, (intptr_t) &cle, &valeur ), result );
+	TEST( valeur == 21, result );
+
+	TEST( delete_table( table, (intptr_t) &cle ) == 21, result );
+	TEST( ! chercher_table( table, (intptr_t) &cle, NULL ), result );
+
+	liberer_table( table );
+
+	return result;
+}
+
+int test_taille_table(){
+	int result = 1;
+	Table * table = creer_table(
+		(int (*)( const intptr_t, const intptr_t )) comparer_cle, 
+		(intptr_t (*)( const intptr_t )) copier_cle, 
+		(void (*)(intptr_t)) supprimer_cle 
+	);
+
+	TEST( taille_table( table ) == 0, result );
+	TEST( table_est_vide( table ), result );
+
+	Cle cle;
+	int i;
+	for( i=0; i<10; i++ ){
+		initialiser_cle( &cle, i ); 	
+		add_table( table, (intptr_t) &cle, i );
+	}
+	TEST( taille_table( table ) == 10, result );
+	TEST( ! table_est_vide( table ), result );
+
+	initialiser_cle( &cle, 3 ); 	
+	add_table( table, (intptr_t) &cle, 30 );
+	TEST( taille_table( table ) == 10, result );
+	delete_table( table, (intptr_t) &cle );
+	TEST( taille_table( table ) == 9, result );
+
+	vider_table( table );
+	TEST( taille_table( table ) == 0, result );
+	TEST( table_est_vide( table ), result );
+
+	liberer_table( table );
+
+	return result;
+}
+
+int test_table_de_hachage(){
+	int result = 1;
+	intptr_t valeur;
+	int i;
+
+	// Clés entières
+	Table * table = creer_table_de_hachage( NULL, NULL, NULL, NULL );
+	TEST( get_type_table( table ) == TABLE_HACHAGE, result );
+	TEST( table_est_vide( table ), result );
+	TEST( iterateur_est_vide( premier_iterateur_table( table ) ), result );
+	TEST( ! chercher_table( table, 3, NULL ), result );
+
+	for( i=0; i<1000; i++ ){
+		add_table( table, 3*i, i );
+	}
+	TEST( taille_table( table ) == 1000, result );
+	for( i=0; i<3000; i++ ){
+		int trouve = chercher_table( table, i, &valeur );
+		TEST( trouve == ( i % 3 == 0 ), result );
+		if( trouve ) TEST( valeur == i/3, result );
+	}
+	add_table( table, 30, 7 );
+	TEST( taille_table( table ) == 1000, result );
+	TEST( get_valeur( trouver_table( table, 30 ) ) == 7, result );
+
+	// Les suppressions ne doivent pas casser les chaînes de recherche.
+	for( i=0; i<1000; i+=2 ){
+		TEST( delete_table( table, 3*i ) == ( i == 10 ? 7 : i ), result );
+	}
+	TEST( taille_table( table ) == 500, result );
+	for( i=0; i<1000; i++ ){
+		TEST( chercher_table( table, 3*i, NULL ) == ( i % 2 ), result );
+	}
+
+	// Le parcours rencontre chaque clé une seule fois.
+	long somme = 0;
+	int nb = 0;
+	Table_iterateur it;
+	for(
+		it = premier_iterateur_table( table );
+		! iterateur_est_vide( it );
+		it = iterateur_suivant_table( it )
+	){
+		TEST( get_valeur( it ) == get_cle( it ) / 3, result );
+		somme += get_cle( it );
+		nb++;
+	}
+	TEST( nb == 500, result );
+	TEST( somme == 3L * 500 * 500, result );
+	TEST( iterateur_est_vide( trouver_table( table, 0 ) ), result );
+
+	vider_table( table );
+	TEST( table_est_vide( table ), result );
+	add_table( table, 5, 50 );
+	TEST( chercher_table( table, 5, &valeur ) && valeur == 50, result );
+	liberer_table( table );
+
+	// Clés copiées par la table, avec des collisions
+	table = creer_table_de_hachage(
+		(int (*)( const intptr_t, const intptr_t )) comparer_cle, 
+		(intptr_t (*)( const intptr_t )) copier_cle, 
+		(void (*)(intptr_t)) supprimer_cle,
+		(size_t (*)( const intptr_t )) hacher_cle
+	);
+	Cle cle;
+	for( i=0; i<200; i++ ){
+		initialiser_cle( &cle, i ); 	
+		add_table( table, (intptr_t) &cle, 10*i );
+	}
+	for( i=0; i<200; i+=3 ){
+		initialiser_cle( &cle, i ); 	
+		TEST( delete_table( table, (intptr_t) &cle ) == 10*i, result );
+	}
+	for( i=0; i<200; i++ ){
+		initialiser_cle( &cle, i ); 	
+		int trouve = chercher_table( table, (intptr_t) &cle, &valeur );
+		TEST( trouve == ( i % 3 != 0 ), result );
+		if( trouve ) TEST( valeur == 10*i, result );
+	}
+	initialiser_cle( &cle, 1 ); 	
+	TEST( get_cle( trouver_table( table, (intptr_t) &cle ) ) != (intptr_t) &cle, result );
+	liberer_table( table );
+
+	return result;
+}
+
+intptr_t doubler_valeur( const intptr_t valeur ){
+	return 2 * valeur;
+}
+
+int verifier_copie_de_table( Table* table ){
+	int result = 1;
+	intptr_t valeur;
+	int i;
+	Cle cle;
+	for( i=0; i<300; i++ ){
+		initialiser_cle( &cle, i );
+		add_table( table, (intptr_t) &cle, i );
+	}
+	Table* copie = copier_table( table, doubler_valeur );
+	TEST( get_type_table( copie ) == get_type_table( table ), result );
+	TEST( taille_table( copie ) == 300, result );
+	for( i=0; i<300; i++ ){
+		initialiser_cle( &cle, i );
+		TEST( chercher_table( copie, (intptr_t) &cle, &valeur ), result );
+		TEST( valeur == 2*i, result );
+		TEST( 
+			get_cle( trouver_table( copie, (intptr_t) &cle ) ) != 
+			get_cle( trouver_table( table, (intptr_t) &cle ) ),
+			result
+		);
+	}
+
+	// La copie et l'original sont indépendants.
+	initialiser_cle( &cle, 5 );
+	delete_table( table, (intptr_t) &cle );
+	initialiser_cle( &cle, 1000 );
+	add_table( copie, (intptr_t) &cle, 1 );
+	TEST( taille_table( table ) == 299, result );
+	TEST( taille_table( copie ) == 301, result );
+	initialiser_cle( &cle, 5 );
+	TEST( chercher_table( copie, (intptr_t) &cle, NULL ), result );
+	liberer_table( table );
+
+	// La copie reste utilisable : on la parcourt dans l'ordre si c'est un arbre.
+	if( get_type_table( copie ) != TABLE_HACHAGE ){
+		Table_iterateur it;
+		int precedente = -1;
+		for(
+			it = premier_iterateur_table( copie );
+			! iterateur_est_vide( it );
+			it = iterateur_suivant_table( it )
+		){
+			TEST( precedente < ( (Cle*) get_cle( it ) )->cle, result );
+			precedente = ( (Cle*) get_cle( it ) )->cle;
+		}
+		TEST( precedente == 1000, result );
+	}
+	liberer_table( copie );
+
+	table = creer_table( NULL, NULL, NULL );
+	copie = copier_table( table, NULL );
+	TEST( table_est_vide( copie ), result );
+	liberer_table( copie );
+	liberer_table( table );
+
+	return result;
+}
+
+int test_copier_table(){
+	int result = 1;
+	result &= verifier_copie_de_table( 
+		creer_table(
+			(int (*)( const intptr_t, const intptr_t )) comparer_cle, 
+			(intptr_t (*)( const intptr_t )) copier_cle, 
+			(void (*)(intptr_t)) supprimer_cle 
+		)
+	);
+	result &= verifier_copie_de_table( 
+		creer_table_de_hachage(
+			(int (*)( const intptr_t, const intptr_t )) comparer_cle, 
+			(intptr_t (*)( const intptr_t )) copier_cle, 
+			(void (*)(intptr_t)) supprimer_cle,
+			(size_t (*)( const intptr_t )) hacher_cle
+		)
+	);
+	result &= verifier_copie_de_table( 
+		creer_table_arbre_b(
+			(int (*)( const intptr_t, const intptr_t )) comparer_cle, 
+			(intptr_t (*)( const intptr_t )) copier_cle, 
+			(void (*)(intptr_t)) supprimer_cle 
+		)
+	);
+	return result;
+}
+
+int test_remplir_table_triee(){
+	int result = 1;
+	int i;
+	intptr_t valeur;
+	intptr_t cles[1000];
+	intptr_t valeurs[1000];
+	for( i=0; i<1000; i++ ){
+		cles[i] = 2*i;
+		valeurs[i] = i;
+	}
+	Table * table = creer_table( NULL, NULL, NULL );
+	remplir_table_triee( table, cles, valeurs, 1000 );
+	TEST( taille_table( table ) == 1000, result );
+	for( i=0; i<2000; i++ ){
+		TEST( chercher_table( table, i, &valeur ) == ( i % 2 == 0 ), result );
+	}
+	TEST( get_valeur( trouver_table( table, 1998 ) ) == 999, result );
+
+	// L'arbre construit doit rester équilibré après des modifications.
+	for( i=0; i<1000; i++ ){
+		add_table( table, 2*i+1, -i );
+	}
+	for( i=0; i<2000; i+=3 ){
+		delete_table( table, i );
+	}
+	int precedente = -1;
+	int nb = 0;
+	Table_iterateur it;
+	for(
+		it = premier_iterateur_table( table );
+		! iterateur_est_vide( it );
+		it = iterateur_suivant_table( it )
+	){
+		TEST( precedente < get_cle( it ), result );
+		TEST( get_cle( it ) % 3 != 0, result );
+		precedente = get_cle( it );
+		nb++;
+	}
+	TEST( nb == taille_table( table ), result );
+	TEST( nb == 2000 - 667, result );
+	liberer_table( table );
+
+	// Les clés sont copiées par la table.
+	Cle c[3];
+	for( i=0; i<3; i++ ){
+		initialiser_cle( &c[i], 10*i );
+		cles[i] = (intptr_t) &c[i];
+	}
+	table = creer_table(
+		(int (*)( const intptr_t, const intptr_t )) comparer_cle, 
+		(intptr_t (*)( const intptr_t )) copier_cle, 
+		(void (*)(intptr_t)) supprimer_cle 
+	);
+	remplir_table_triee( table, cles, NULL, 3 );
+	TEST( taille_table( table ) == 3, result );
+	TEST( get_cle( trouver_table( table, cles[1] ) ) != cles[1], result );
+	TEST( chercher_table( table, cles[2], &valeur ) && valeur == 0, result );
+	liberer_table( table );
+
+	return result;
+}
+
+int test_creer_table_depuis_tableau(){
+	int result = 1;
+	int i;
+	intptr_t valeur;
+	intptr_t cles[] = { 5, 1, 9, 1, 3, 5 };
+	intptr_t valeurs[] = { 50, 10, 90, 11, 30, 51 };
+
+	Table * table = creer_table_depuis_tableau( NULL, NULL, NULL, cles, valeurs, 6 );
+	TEST( get_type_table( table ) == TABLE_ARBRE, result );
+	TEST( taille_table( table ) == 4, result );
+	TEST( chercher_table( table, 1, &valeur ) && valeur == 11, result );
+	TEST( chercher_table( table, 5, &valeur ) && valeur == 51, result );
+	TEST( chercher_table( table, 9, &valeur ) && valeur == 90, result );
+	TEST( get_cle( premier_iterateur_table( table ) ) == 1, result );
+	add_table( table, 4, 40 );
+	TEST( taille_table( table ) == 5, result );
+	liberer_table( table );
+
+	Cle c[100];
+	intptr_t pointeurs[100];
+	for( i=0; i<100; i++ ){
+		initialiser_cle( &c[i], 99 - i );
+		pointeurs[i] = (intptr_t) &c[i];
+	}
+	table = creer_table_depuis_tableau(
+		(int (*)( const intptr_t, const intptr_t )) comparer_cle, 
+		(intptr_t (*)( const intptr_t )) copier_cle, 
+		(void (*)(intptr_t)) supprimer_cle,
+		pointeurs, NULL, 100
+	);
+	TEST( taille_table( table ) == 100, result );
+	TEST( ( (Cle*) get_cle( premier_iterateur_table( table ) ) )->cle == 0, result );
+	TEST( get_cle( trouver_table( table, pointeurs[7] ) ) != pointeurs[7], result );
+	liberer_table( table );
+
+	table = creer_table_depuis_tableau( NULL, NULL, NULL, NULL, NULL, 0 );
+	TEST( table_est_vide( table ), result );
+	liberer_table( table );
+
+	return result;
+}
+
+int test_iterateur_table(){
+	int result = 1;
+	int i;
+	Table_iterateur it;
+	Table * table = creer_table( NULL, NULL, NULL );
+
+	// Les itérateurs sont circulaires.
+	TEST( iterateur_est_vide( premier_iterateur_table( table ) ), result );
+	for( i=0; i<500; i++ ){
+		add_table( table, (i*7919) % 500, i );
+	}
+	it = trouver_table( table, 1000 );
+	TEST( iterateur_est_vide( it ), result );
+	TEST( get_cle( iterateur_suivant_table( it ) ) == 0, result );
+	TEST( get_cle( iterateur_precedent_table( it ) ) == 499, result );
+	it = trouver_table( table, 499 );
+	TEST( iterateur_est_vide( iterateur_suivant_table( it ) ), result );
+
+	// Parcours à l'envers.
+	int attendue = 499;
+	for(
+		it = trouver_table( table, 499 );
+		! iterateur_est_vide( it );
+		it = iterateur_precedent_table( it )
+	){
+		TEST( get_cle( it ) == attendue, result );
+		attendue--;
+	}
+	TEST( attendue == -1, result );
+
+	// Un itérateur reste valide lorsque l'on supprime d'autres associations.
+	it = trouver_table( table, 250 );
+	for( i=0; i<500; i++ ){
+		if( i != 250 && i != 251 && i % 2 == 0 ){
+			delete_table( table, i );
+		}
+	}
+	TEST( get_cle( it ) == 250, result );
+	it = iterateur_suivant_table( it );
+	TEST( get_cle( it ) == 251, result );
+	it = iterateur_suivant_table( it );
+	TEST( get_cle( it ) == 253, result );
+	it = iterateur_precedent_table( trouver_table( table, 250 ) );
+	TEST( get_cle( it ) == 249, result );
+	liberer_table( table );
+
+	return result;
+}
+
 int test_get_cle(){
 	// Voir general_test
 	return 1;
@@ -406,6 +814,180 @@ int test_get_valeur(){
 }
 
 
+/*
+ * Vérifie que chaque clé de la table, qui contient les clés paires i telles 
+ * que presente[i/2], a le bon rang, et réciproquement.
+ */
+static int rangs_corrects( const Table* table, const char* presente, int n ){
+	int result = 1;
+	int i;
+	size_t rang = 0;
+	for( i=0; i<n; i++ ){
+		TEST( rang_table( table, 2*i ) == rang, result );
+		TEST( rang_table( table, 2*i - 1 ) == rang, result );
+		if( presente[i] ){
+			Table_iterateur it = ieme_iterateur_table( table, rang );
+			TEST( ! iterateur_est_vide( it ) && get_cle( it ) == 2*i, result );
+			rang++;
+		}
+	}
+	TEST( rang == (size_t) taille_table( table ), result );
+	TEST( iterateur_est_vide( ieme_iterateur_table( table, rang ) ), result );
+	TEST( rang_table( table, 2*n ) == rang, result );
+	return result;
+}
+
+int test_rang_table(){
+	int result = 1;
+	const int n = 3000;
+	char presente[3000];
+	int i;
+	Table * table = creer_table( NULL, NULL, NULL );
+	memset( presente, 0, sizeof(presente) );
+
+	// Insertions dans le désordre, puis suppressions de la moitié des clés :
+	// les tailles des sous-arbres doivent suivre toutes les rotations.
+	for( i=0; i<n; i++ ){
+		int k = ( i * 7919 ) % n;
+		add_table( table, 2*k, i );
+		presente[k] = 1;
+	}
+	TEST( rangs_corrects( table, presente, n ), result );
+	for( i=0; i<n; i++ ){
+		int k = ( i * 104729 ) % n;
+		if( k % 3 ){
+			delete_table( table, 2*k );
+			presente[k] = 0;
+		}
+	}
+	TEST( rangs_corrects( table, presente, n ), result );
+
+	// Les arbres copiés ou construits directement connaissent aussi les 
+	// tailles de leurs sous-arbres.
+	Table * copie = copier_table( table, NULL );
+	TEST( rangs_corrects( copie, presente, n ), result );
+	liberer_table( copie );
+
+	intptr_t cles[3000];
+	int nb = 0;
+	for( i=0; i<n; i++ ){
+		if( presente[i] ) cles[nb++] = 2*i;
+	}
+	copie = creer_table_depuis_tableau( NULL, NULL, NULL, cles, NULL, nb );
+	TEST( rangs_corrects( copie, presente, n ), result );
+	add_table( copie, 1, 0 );
+	TEST( rang_table( copie, 2 ) == 2, result );
+	TEST( get_cle( ieme_iterateur_table( copie, 1 ) ) == 1, result );
+	liberer_table( copie );
+
+	liberer_table( table );
+
+	// Pour une table de hachage, le rang est celui du parcours.
+	table = creer_table_de_hachage( NULL, NULL, NULL, NULL );
+	for( i=0; i<100; i++ ){
+		add_table( table, i, i );
+	}
+	Table_iterateur it = premier_iterateur_table( table );
+	for( i=0; i<100; i++ ){
+		TEST( get_cle( ieme_iterateur_table( table, i ) ) == get_cle( it ), result );
+		it = iterateur_suivant_table( it );
+	}
+	TEST( iterateur_est_vide( ieme_iterateur_table( table, 100 ) ), result );
+	liberer_table( table );
+	return result;
+}
+
+int test_table_arbre_b(){
+	int result = 1;
+	const int n = 3000;
+	char presente[3000];
+	intptr_t cles[3000];
+	intptr_t valeur;
+	int i, nb;
+	Table_iterateur it;
+	Table * table = creer_table_arbre_b( NULL, NULL, NULL );
+	memset( presente, 0, sizeof(presente) );
+
+	TEST( get_type_table( table ) == TABLE_ARBRE_B, result );
+	TEST( table_est_vide( table ), result );
+	TEST( iterateur_est_vide( premier_iterateur_table( table ) ), result );
+	TEST( iterateur_est_vide( iterateur_precedent_table( trouver_table( table, 0 ) ) ), result );
+
+	// Les mêmes insertions et suppressions que pour l'arbre AVL : les 
+	// feuilles se divisent, puis empruntent et fusionnent.
+	for( i=0; i<n; i++ ){
+		int k = ( i * 7919 ) % n;
+		add_table( table, 2*k, i );
+		presente[k] = 1;
+	}
+	TEST( rangs_corrects( table, presente, n ), result );
+	for( i=0; i<n; i++ ){
+		int k = ( i * 104729 ) % n;
+		if( k % 3 ){
+			delete_table( table, 2*k );
+			presente[k] = 0;
+		}
+	}
+	TEST( rangs_corrects( table, presente, n ), result );
+	add_table( table, 0, 42 );
+	TEST( chercher_table( table, 0, &valeur ) && valeur == 42, result );
+	TEST( taille_table( table ) == n / 3, result );
+
+	// Les itérateurs sont circulaires.
+	it = trouver_table( table, 1 );
+	TEST( iterateur_est_vide( it ), result );
+	TEST( get_cle( iterateur_suivant_table( it ) ) == 0, result );
+	TEST( get_cle( iterateur_precedent_table( it ) ) == 2 * ( n - 3 ), result );
+	nb = 0;
+	for(
+		it = iterateur_precedent_table( trouver_table( table, 1 ) );
+		! iterateur_est_vide( it );
+		it = iterateur_precedent_table( it )
+	){
+		TEST( get_cle( it ) == 2 * ( n - 3 ) - 6 * nb, result );
+		nb++;
+	}
+	TEST( nb == n / 3, result );
+
+	Table * copie = copier_table( table, NULL );
+	TEST( get_type_table( copie ) == TABLE_ARBRE_B, result );
+	TEST( rangs_corrects( copie, presente, n ), result );
+	liberer_table( copie );
+
+	vider_table( table );
+	TEST( table_est_vide( table ), result );
+	nb = 0;
+	for( i=0; i<n; i++ ){
+		if( presente[i] ) cles[nb++] = 2*i;
+	}
+	remplir_table_triee( table, cles, NULL, nb );
+	TEST( rangs_corrects( table, presente, n ), result );
+	liberer_table( table );
+
+	// Clés copiées par la table, y compris dans les noeuds internes.
+	Cle c[1000];
+	for( i=0; i<1000; i++ ){
+		initialiser_cle( &c[i], i );
+		cles[i] = (intptr_t) &c[i];
+	}
+	table = creer_table_arbre_b(
+		(int (*)( const intptr_t, const intptr_t )) comparer_cle, 
+		(intptr_t (*)( const intptr_t )) copier_cle, 
+		(void (*)(intptr_t)) supprimer_cle 
+	);
+	remplir_table_triee( table, cles, NULL, 1000 );
+	for( i=0; i<1000; i+=2 ){
+		delete_table( table, cles[i] );
+	}
+	TEST( taille_table( table ) == 500, result );
+	TEST( get_cle( trouver_table( table, cles[7] ) ) != cles[7], result );
+	TEST( ! chercher_table( table, cles[8], NULL ), result );
+	TEST( rang_table( table, cles[8] ) == 4, result );
+	liberer_table( table );
+
+	return result;
+}
+
 int main(){
 
 	int result = 1;
@@ -420,6 +1002,15 @@ int main(){
 	result &= test_pour_toute_valeur_table();
 	result &= test_pour_toute_cle_valeur_table();
 	result &= test_trouver_table();
+	result &= test_chercher_table();
+	result &= test_taille_table();
+	result &= test_table_de_hachage();
+	result &= test_copier_table();
+	result &= test_remplir_table_triee();
+	result &= test_creer_table_depuis_tableau();
+	result &= test_iterateur_table();
+	result &= test_rang_table();
+	result &= test_table_arbre_b();
 	result &= test_get_cle();
 	result &= test_get_valeur();
 